@@ -8,7 +8,26 @@ gpick.global = gpick_module
 gpick.options = {}
 
 require('helpers')
-require('layouts')
+
+-- Layouts are only needed by layout preview, so they are loaded when gpick.layouts, gpick.layouts_get or layouts is first accessed
+local function load_layouts()
+	setmetatable(gpick, nil)
+	setmetatable(_G, nil)
+	require('layouts')
+end
+setmetatable(gpick, {__index = function(table, key)
+	if key == 'layouts' or key == 'layouts_get' then
+		load_layouts()
+		return rawget(table, key)
+	end
+end})
+setmetatable(_G, {__index = function(table, key)
+	if key == 'layouts' then
+		load_layouts()
+		return rawget(table, key)
+	end
+end})
+
 suggest('user_init')
 
 gpick.serialize_web_hex = function(color_object, params)
@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "BatchMode.h"
+#include "GlobalState.h"
+#include "ColorList.h"
+#include "ColorObject.h"
+#include "ColorSort.h"
+#include "ColorHistogram.h"
+#include "Converter.h"
+#include "ImportExport.h"
+#include "ImageLoader.h"
+#include "DynvHelpers.h"
+#include "Parallel.h"
+#include "color_names/ColorNames.h"
+#include "quantizer/Factory.h"
+#include <boost/filesystem.hpp>
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <thread>
+using namespace std;
+
+namespace {
+struct FileResult
+{
+	string output;
+	string error;
+	bool finished;
+};
+struct BatchState
+{
+	GlobalState *gs;
+	const BatchOptions &options;
+	Converter *converter;
+	const ColorSortType *sort_type;
+	FileType output_type;
+	/** Lower case file name extensions of image formats supported by GdkPixbuf, including leading dot. */
+	set<string> image_extensions;
+	/** Converters share one Lua state, so all conversions are serialized. */
+	mutex lua_lock;
+	mutex output_lock;
+	vector<FileResult> results;
+	size_t next_output;
+	atomic<size_t> next_input;
+	bool failed;
+	BatchState(GlobalState *gs, const BatchOptions &options):
+		gs(gs),
+		options(options),
+		converter(nullptr),
+		sort_type(nullptr),
+		output_type(FileType::unknown),
+		results(options.input_files.size(), FileResult{"", "", false}),
+		next_output(0),
+		next_input(0),
+		failed(false)
+	{
+	}
+};
+}
+BatchOptions::BatchOptions():
+	reverse(false),
+	name_colors(false),
+	image_colors(16),
+	jobs(0)
+{
+}
+static bool uses_converters(FileType type)
+{
+	return type != FileType::gpa && type != FileType::gpl && type != FileType::ase;
+}
+static void find_image_extensions(BatchState &state)
+{
+	GSList *formats = gdk_pixbuf_get_formats();
+	for (GSList *i = formats; i; i = g_slist_next(i)){
+		gchar **extensions = gdk_pixbuf_format_get_extensions(static_cast<GdkPixbufFormat*>(i->data));
+		if (!extensions) continue;
+		for (int j = 0; extensions[j]; j++)
+			state.image_extensions.insert(boost::algorithm::to_lower_copy("." + string(extensions[j])));
+		g_strfreev(extensions);
+	}
+	g_slist_free(formats);
+}
+static bool is_image_file(BatchState &state, const string &filename)
+{
+	string extension = boost::algorithm::to_lower_copy(boost::filesystem::path(filename).extension().string());
+	return !extension.empty() && state.image_extensions.count(extension) != 0;
+}
+static void add_colors(ColorList *color_list, const vector<Color> &colors)
+{
+	for (auto &color: colors)
+		color_list_add_color(color_list, &color);
+}
+static bool import_text(BatchState &state, istream &stream, ColorList *color_list, string &error)
+{
+	vector<string> texts;
+	string line;
+	while (getline(stream, line)){
+		if (!line.empty()) texts.push_back(line);
+	}
+	vector<Color> colors;
+	vector<bool> valid;
+	{
+		lock_guard<mutex> lock(state.lua_lock);
+		converter_get_colors(texts, state.gs, colors, valid);
+	}
+	for (size_t i = 0; i < texts.size(); i++){
+		if (!valid[i]){
+			error = "could not parse color \"" + texts[i] + "\"";
+			return false;
+		}
+	}
+	add_colors(color_list, colors);
+	return true;
+}
+static bool import_image(BatchState &state, const string &filename, ColorList *color_list, string &error)
+{
+	ColorHistogram histogram;
+	GError *gerror = nullptr;
+	if (!image_loader_add_to_histogram(filename.c_str(), 1, histogram, nullptr, nullptr, nullptr, &gerror)){
+		error = gerror ? gerror->message : "could not load image";
+		if (gerror) g_error_free(gerror);
+		return false;
+	}
+	const char *quantizer_name = state.options.quantizer.empty() ? quantizer::Factory::getAllTypes().front().name : state.options.quantizer.c_str();
+	auto palette_quantizer = quantizer::Factory::create(quantizer_name);
+	vector<Color> palette;
+	palette_quantizer->quantize(histogram, state.options.image_colors, palette);
+	add_colors(color_list, palette);
+	return true;
+}
+static bool import_file(BatchState &state, const string &filename, ColorList *color_list, string &error)
+{
+	if (filename == "-")
+		return import_text(state, cin, color_list, error);
+	FileType type = ImportExport::getFileType(filename.c_str());
+	if (type == FileType::unknown && is_image_file(state, filename))
+		return import_image(state, filename, color_list, error);
+	if (type != FileType::gpa && type != FileType::gpl && type != FileType::ase && type != FileType::txt){
+		error = "unsupported input format";
+		return false;
+	}
+	ImportExport import_export(color_list, filename.c_str(), state.gs);
+	import_export.setConverters(state.gs->getConverters());
+	bool result;
+	if (uses_converters(type)){
+		lock_guard<mutex> lock(state.lua_lock);
+		result = import_export.importType(type);
+	}else{
+		result = import_export.importType(type);
+	}
+	if (!result){
+		error = "import failed";
+		return false;
+	}
+	return true;
+}
+static void name_colors(BatchState &state, ColorList *color_list)
+{
+	vector<Color> colors;
+	for (auto color_object: color_list->colors)
+		colors.push_back(color_object->getColor());
+	vector<string> names(colors.size());
+	bool imprecision_postfix = dynv_get_bool_wd(state.gs->getSettings(), "gpick.color_names.imprecision_postfix", true);
+	color_names_get_multiple(state.gs->getColorNames(), colors.data(), colors.size(), imprecision_postfix, names.data());
+	size_t index = 0;
+	for (auto color_object: color_list->colors)
+		color_object->setName(names[index++]);
+}
+static void sort_colors(BatchState &state, ColorList *color_list)
+{
+	vector<pair<double, ColorObject*>> sorted;
+	for (auto color_object: color_list->colors)
+		sorted.push_back(make_pair(state.sort_type->get_value(&color_object->getColor()), color_object));
+	stable_sort(sorted.begin(), sorted.end(), [](const pair<double, ColorObject*> &a, const pair<double, ColorObject*> &b){
+		return a.first < b.first;
+	});
+	if (state.options.reverse)
+		reverse(sorted.begin(), sorted.end());
+	color_list->colors.clear();
+	for (auto &item: sorted)
+		color_list->colors.push_back(item.second);
+}
+static bool write_text(BatchState &state, const string &filename, ColorList *color_list, string &output, string &error)
+{
+	vector<Color> colors;
+	for (auto color_object: color_list->colors)
+		colors.push_back(color_object->getColor());
+	vector<string> texts;
+	bool result;
+	{
+		lock_guard<mutex> lock(state.lua_lock);
+		result = converter_get_texts(colors, state.converter, texts);
+	}
+	if (!result){
+		error = "could not convert colors";
+		return false;
+	}
+	string prefix = state.options.input_files.size() > 1 ? filename + "\t" : "";
+	size_t index = 0;
+	for (auto color_object: color_list->colors){
+		output += prefix + texts[index++];
+		if (state.options.name_colors)
+			output += "\t" + color_object->getName();
+		output += "\n";
+	}
+	return true;
+}
+static bool write_file(BatchState &state, const string &filename, ColorList *color_list, string &output, string &error)
+{
+	size_t position = 0;
+	for (auto color_object: color_list->colors)
+		color_object->setPosition(position++);
+	boost::filesystem::path path(state.options.output_directory.empty() ? "." : state.options.output_directory);
+	path /= (filename == "-" ? boost::filesystem::path("stdin") : boost::filesystem::path(filename).stem());
+	path += "." + state.options.output_format;
+	string output_filename = path.string();
+	ImportExport import_export(color_list, output_filename.c_str(), state.gs);
+	import_export.setConverter(state.converter);
+	import_export.setConverters(state.gs->getConverters());
+	bool result;
+	if (uses_converters(state.output_type)){
+		lock_guard<mutex> lock(state.lua_lock);
+		result = import_export.exportType(state.output_type);
+	}else{
+		result = import_export.exportType(state.output_type);
+	}
+	if (!result){
+		error = "could not write \"" + output_filename + "\"";
+		return false;
+	}
+	output = output_filename + "\n";
+	return true;
+}
+static void flush_results(BatchState &state)
+{
+	while (state.next_output < state.results.size() && state.results[state.next_output].finished){
+		FileResult &result = state.results[state.next_output];
+		if (!result.error.empty()){
+			cerr << state.options.input_files[state.next_output] << ": " << result.error << endl;
+			state.failed = true;
+		}
+		cout << result.output;
+		cout.flush();
+		result.output.clear();
+		state.next_output++;
+	}
+}
+static void process_files(BatchState &state)
+{
+	// Handler maps are reference counted without locking, so each thread uses a separate one
+	struct dynvHandlerMap *handler_map = dynv_create_default_handler_map();
+	for (;;){
+		size_t index = state.next_input++;
+		if (index >= state.options.input_files.size()) break;
+		const string &filename = state.options.input_files[index];
+		ColorList *color_list = color_list_new(handler_map);
+		string output, error;
+		if (import_file(state, filename, color_list, error)){
+			if (state.options.name_colors)
+				name_colors(state, color_list);
+			if (state.sort_type)
+				sort_colors(state, color_list);
+			if (state.options.output_format.empty())
+				write_text(state, filename, color_list, output, error);
+			else
+				write_file(state, filename, color_list, output, error);
+		}
+		color_list_destroy(color_list);
+		lock_guard<mutex> lock(state.output_lock);
+		state.results[index].output = move(output);
+		state.results[index].error = move(error);
+		state.results[index].finished = true;
+		flush_results(state);
+	}
+	dynv_handler_map_release(handler_map);
+}
+int batch_mode_run(GlobalState *gs, const BatchOptions &options)
+{
+	BatchState state(gs, options);
+	Converters *converters = gs->getConverters();
+	state.converter = options.converter_name.empty() ? converters_get_first(converters, ConverterArrayType::copy) : converters_get(converters, options.converter_name.c_str());
+	if (!state.converter || !state.converter->serialize_available){
+		cerr << "Unknown converter \"" << options.converter_name << "\"" << endl;
+		return 1;
+	}
+	if (!options.sort_type.empty()){
+		state.sort_type = color_sort_get_type(options.sort_type.c_str());
+		if (!state.sort_type){
+			size_t count;
+			const ColorSortType *types = color_sort_get_types(count);
+			cerr << "Unknown sort type \"" << options.sort_type << "\", available types:";
+			for (size_t i = 0; i < count; i++)
+				cerr << " " << types[i].name;
+			cerr << endl;
+			return 1;
+		}
+	}
+	if (!options.output_format.empty()){
+		state.output_type = ImportExport::getFileType(("output." + options.output_format).c_str());
+		if (state.output_type == FileType::unknown){
+			cerr << "Unknown output format \"" << options.output_format << "\"" << endl;
+			return 1;
+		}
+	}
+	if (!options.quantizer.empty() && !quantizer::Factory::create(options.quantizer.c_str())){
+		cerr << "Unknown quantizer \"" << options.quantizer << "\"" << endl;
+		return 1;
+	}
+	find_image_extensions(state);
+	size_t jobs = std::min(options.jobs ? options.jobs : parallel_get_thread_count(), options.input_files.size());
+	vector<thread> threads;
+	for (size_t i = 1; i < jobs; i++)
+		threads.emplace_back(process_files, ref(state));
+	process_files(state);
+	for (auto &thread: threads)
+		thread.join();
+	return state.failed ? 1 : 0;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GPICK_BATCH_MODE_H_
+#define GPICK_BATCH_MODE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+class GlobalState;
+
+/** \file source/BatchMode.h
+ * \brief Headless palette processing for command line use.
+ */
+
+/** \struct BatchOptions
+ * \brief Batch mode pipeline configuration.
+ *
+ * Each input file goes through import, naming, sorting and output steps. Palette files are imported by their extension, other files are decoded as images and reduced to a palette.
+ * Input file "-" reads one color per line from standard input.
+ */
+struct BatchOptions
+{
+	std::vector<std::string> input_files; /**< Input palette or image files */
+	std::string output_format; /**< Export file type extension. Colors are written to standard output as text when empty */
+	std::string output_directory; /**< Directory for exported files */
+	std::string converter_name; /**< Converter used for text output and text file export. First copy converter is used when empty */
+	std::string sort_type; /**< Color sort type system name. Colors are not sorted when empty */
+	bool reverse; /**< Reverse sort order */
+	bool name_colors; /**< Set color names to nearest known color names */
+	size_t image_colors; /**< Maximum number of colors extracted from images */
+	std::string quantizer; /**< Quantizer system name used for images. Default quantizer is used when empty */
+	size_t jobs; /**< Number of files processed in parallel. Number of hardware threads is used when zero */
+	BatchOptions();
+};
+
+/**
+ * Process all input files. Files are processed in parallel, but results are written to standard output in input file order as soon as all preceding files are finished.
+ * Errors are written to standard error.
+ * @param[in] gs Global state with loaded converters and color names.
+ * @param[in] options Pipeline configuration.
+ * @return Process exit code, zero if all files were processed successfully.
+ */
+int batch_mode_run(GlobalState *gs, const BatchOptions &options);
+
+#endif /* GPICK_BATCH_MODE_H_ */
@@ -44,6 +44,71 @@ static matrix3x3 sRGB_transformation_inverted;
 static matrix3x3 d65_d50_adaptation_matrix;
 static matrix3x3 d50_d65_adaptation_matrix;
 
+// Exact linear values for all 8-bit RGB values
+static float rgb_8bit_linear_table[256];
+
+#ifdef GAMMA_LOOKUP_TABLES
+// Interpolated tables for floating point values in [0, 1] range. RGB to linear table is indexed by value, linear to RGB table is indexed by
+// square root of value, which keeps interpolation error below 1e-6 near zero, where gamma curve is steepest.
+#define GAMMA_TABLE_SIZE 4096
+static float rgb_linear_table[GAMMA_TABLE_SIZE + 2];
+static float linear_rgb_table[GAMMA_TABLE_SIZE + 2];
+#endif
+
+static inline float rgb_to_linear_exact(double value)
+{
+	if (value > 0.04045)
+		return pow((value + 0.055) / 1.055, 2.4);
+	else
+		return value / 12.92;
+}
+
+static inline float linear_to_rgb_exact(double value)
+{
+	if (value > 0.0031308)
+		return 1.055 * pow(value, 1 / 2.4) - 0.055;
+	else
+		return value * 12.92;
+}
+
+static inline float rgb_to_linear(float value)
+{
+#ifdef GAMMA_LOOKUP_TABLES
+	if (value >= 0 && value <= 1){
+		float position = value * GAMMA_TABLE_SIZE;
+		int index = int(position);
+		return rgb_linear_table[index] + (rgb_linear_table[index + 1] - rgb_linear_table[index]) * (position - index);
+	}
+#endif
+	return rgb_to_linear_exact(value);
+}
+
+static inline float linear_to_rgb(float value)
+{
+#ifdef GAMMA_LOOKUP_TABLES
+	if (value >= 0 && value <= 1){
+		float position = sqrt(value) * GAMMA_TABLE_SIZE;
+		int index = int(position);
+		return linear_rgb_table[index] + (linear_rgb_table[index + 1] - linear_rgb_table[index]) * (position - index);
+	}
+#endif
+	return linear_to_rgb_exact(value);
+}
+
+static void init_gamma_tables()
+{
+	for (int i = 0; i < 256; i++){
+		rgb_8bit_linear_table[i] = rgb_to_linear_exact(i / 255.0);
+	}
+#ifdef GAMMA_LOOKUP_TABLES
+	for (int i = 0; i < GAMMA_TABLE_SIZE + 2; i++){
+		double position = double(i) / GAMMA_TABLE_SIZE;
+		rgb_linear_table[i] = rgb_to_linear_exact(position);
+		linear_rgb_table[i] = linear_to_rgb_exact(position * position);
+	}
+#endif
+}
+
 
 void color_init()
 {
@@ -54,6 +119,7 @@ void color_init()
 	color_get_chromatic_adaptation_matrix(color_get_reference(REFERENCE_ILLUMINANT_D65, REFERENCE_OBSERVER_2), color_get_reference(REFERENCE_ILLUMINANT_D50, REFERENCE_OBSERVER_2), &d65_d50_adaptation_matrix);
 	color_get_chromatic_adaptation_matrix(color_get_reference(REFERENCE_ILLUMINANT_D50, REFERENCE_OBSERVER_2), color_get_reference(REFERENCE_ILLUMINANT_D65, REFERENCE_OBSERVER_2), &d50_d65_adaptation_matrix);
 
+	init_gamma_tables();
 }
 
 
@@ -143,30 +209,24 @@ void color_hsv_to_rgb(const Color* a, Color* b)
 
 void color_rgb_to_xyz(const Color* a, Color* b, const matrix3x3* transformation)
 {
-	float R=a->rgb.red, G=a->rgb.green, B=a->rgb.blue;
-
-	if (R>0.04045){
-		R=pow(((R+0.055)/1.055),2.4);
-	}else{
-		R=R/12.92;
-	}
+	vector3 rgb;
+	rgb.x = rgb_to_linear(a->rgb.red);
+	rgb.y = rgb_to_linear(a->rgb.green);
+	rgb.z = rgb_to_linear(a->rgb.blue);
 
-	if (G>0.04045){
-		G=pow(((G+0.055)/1.055),2.4);
-	}else{
-		G=G/12.92;
-	}
+	vector3_multiply_matrix3x3(&rgb, transformation, &rgb);
 
-	if (B>0.04045){
-		B=pow(((B+0.055)/1.055),2.4);
-	}else{
-		B=B/12.92;
-	}
+	b->xyz.x = rgb.x;
+	b->xyz.y = rgb.y;
+	b->xyz.z = rgb.z;
+}
 
+void color_linear_to_xyz(const Color* a, Color* b, const matrix3x3* transformation)
+{
 	vector3 rgb;
-	rgb.x = R;
-	rgb.y = G;
-	rgb.z = B;
+	rgb.x = a->rgb.red;
+	rgb.y = a->rgb.green;
+	rgb.z = a->rgb.blue;
 
 	vector3_multiply_matrix3x3(&rgb, transformation, &rgb);
 
@@ -178,32 +238,12 @@ void color_rgb_to_xyz(const Color* a, Color* b, const matrix3x3* transformation)
 void color_xyz_to_rgb(const Color* a, Color* b, const matrix3x3* transformation_inverted)
 {
 	vector3 rgb;
-	float R,G,B;
 
 	vector3_multiply_matrix3x3((vector3*)a, transformation_inverted, &rgb);
-	R=rgb.x;
-	G=rgb.y;
-	B=rgb.z;
-
-	if (R>0.0031308){
-		R=1.055*(pow(R,1/2.4f))-0.055;
-	}else{
-		R=12.92*R;
-	}
-	if (G>0.0031308){
-		G=1.055*(pow(G,1/2.4f))-0.055;
-	}else{
-		G=12.92*G;
-	}
-	if(B>0.0031308){
-		B=1.055*(pow(B,1/2.4f))-0.055;
-	}else{
-		B=12.92*B;
-	}
 
-	b->rgb.red=R;
-	b->rgb.green=G;
-	b->rgb.blue=B;
+	b->rgb.red = linear_to_rgb(rgb.x);
+	b->rgb.green = linear_to_rgb(rgb.y);
+	b->rgb.blue = linear_to_rgb(rgb.z);
 }
 
 
@@ -469,17 +509,17 @@ void color_xyz_to_lab(const Color* a, Color* b, const vector3* reference_white)
 	Z = a->xyz.z / reference_white->z; //108.883f;
 
 	if (X>EPSILON){
-		X=pow(X,1.0f/3.0f);
+		X=cbrt(X);
 	}else{
 		X=(Kk*X+16.0f)/116.0f;
 	}
 	if (Y>EPSILON){
-		Y=pow(Y,1.0f/3.0f);
+		Y=cbrt(Y);
 	}else{
 		Y=(Kk*Y+16.0f)/116.0f;
 	}
 	if (Z>EPSILON){
-		Z=pow(Z,1.0f/3.0f);
+		Z=cbrt(Z);
 	}else{
 		Z=(Kk*Z+16.0f)/116.0f;
 	}
@@ -691,39 +731,28 @@ void color_hsv_to_hsl(const Color *a, Color *b)
 
 void color_rgb_get_linear(const Color* a, Color* b)
 {
-	if (a->rgb.red > 0.04045f)
-		b->rgb.red = pow((a->rgb.red + 0.055f) / 1.055f, 2.4f);
-	else
-		b->rgb.red = a->rgb.red / 12.92f;
-
-	if (a->rgb.green > 0.04045f)
-		b->rgb.green = pow((a->rgb.green + 0.055f) / 1.055f, 2.4f);
-	else
-		b->rgb.green = a->rgb.green / 12.92f;
+	b->rgb.red = rgb_to_linear(a->rgb.red);
+	b->rgb.green = rgb_to_linear(a->rgb.green);
+	b->rgb.blue = rgb_to_linear(a->rgb.blue);
+}
 
-	if (a->rgb.blue > 0.04045f)
-		b->rgb.blue = pow((a->rgb.blue + 0.055f) / 1.055f, 2.4f);
-	else
-		b->rgb.blue = a->rgb.blue / 12.92f;
+void color_rgb8_get_linear(unsigned char red, unsigned char green, unsigned char blue, Color* b)
+{
+	b->rgb.red = rgb_8bit_linear_table[red];
+	b->rgb.green = rgb_8bit_linear_table[green];
+	b->rgb.blue = rgb_8bit_linear_table[blue];
+}
 
+float color_rgb8_get_linear_value(unsigned char value)
+{
+	return rgb_8bit_linear_table[value];
 }
 
 void color_linear_get_rgb(const Color* a, Color* b)
 {
-	if (a->rgb.red > 0.0031308f)
-		b->rgb.red = (1.055f * pow(a->rgb.red, 1.0f / 2.4f)) - 0.055f;
-	else
-		b->rgb.red = a->rgb.red * 12.92f;
-
-	if (a->rgb.green > 0.0031308f)
-		b->rgb.green = (1.055f * pow(a->rgb.green, 1.0f / 2.4f)) - 0.055f;
-	else
-		b->rgb.green = a->rgb.green * 12.92f;
-
-	if (a->rgb.blue > 0.0031308f)
-		b->rgb.blue = (1.055f * pow(a->rgb.blue, 1.0f / 2.4f)) - 0.055f;
-	else
-		b->rgb.blue = a->rgb.blue * 12.92f;
+	b->rgb.red = linear_to_rgb(a->rgb.red);
+	b->rgb.green = linear_to_rgb(a->rgb.green);
+	b->rgb.blue = linear_to_rgb(a->rgb.blue);
 }
 
 const matrix3x3* color_get_sRGB_transformation_matrix()
@@ -107,6 +107,8 @@ enum ReferenceObserver {
 
 /**
  * Initialize things needed for color conversion functions. Must be called before using any other functions.
+ * Builds sRGB gamma lookup tables. When compiled with GAMMA_LOOKUP_TABLES, RGB/linear RGB conversions of values in [0, 1] range use interpolated tables
+ * with absolute error below 1e-6 instead of calling pow().
  */
 void color_init();
 
@@ -160,6 +162,14 @@ void color_hsv_to_rgb(const Color* a, Color* b);
  */
 void color_rgb_to_xyz(const Color* a, Color* b, const matrix3x3* transformation);
 
+/**
+ * Convert linear RGB color to XYZ color space.
+ * @param[in] a Source color in linear RGB color space.
+ * @param[out] b Destination color in XYZ color space.
+ * @param[in] transformation Transformation matrix for RGB to XYZ conversion.
+ */
+void color_linear_to_xyz(const Color* a, Color* b, const matrix3x3* transformation);
+
 /**
  * Convert XYZ color space to RGB color space.
  * @param[in] a Source color in XYZ color space.
@@ -329,6 +339,22 @@ bool color_is_rgb_out_of_gamut(const Color* a);
  */
 void color_rgb_get_linear(const Color* a, Color* b);
 
+/**
+ * Transform 8-bit RGB values to linear RGB color. Uses exact precomputed values.
+ * @param[in] red Red value.
+ * @param[in] green Green value.
+ * @param[in] blue Blue value.
+ * @param[out] b Linear color in RGB color space.
+ */
+void color_rgb8_get_linear(unsigned char red, unsigned char green, unsigned char blue, Color* b);
+
+/**
+ * Transform 8-bit RGB component value to linear value. Uses exact precomputed values.
+ * @param[in] value Component value.
+ * @return Linear component value.
+ */
+float color_rgb8_get_linear_value(unsigned char value);
+
 /**
  * Transform linear RGB color to RGB color.
  * @param[in] a Linear color in RGB color space.
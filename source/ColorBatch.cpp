@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ColorBatch.h"
+#include "simd/ColorBatchKernels.h"
+#include <atomic>
+#include <cmath>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+static bool cpu_supports(ColorBatchKernel kernel)
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	__builtin_cpu_init();
+	switch (kernel){
+		case COLOR_BATCH_KERNEL_SCALAR:
+			return true;
+		case COLOR_BATCH_KERNEL_SSE41:
+			return __builtin_cpu_supports("sse4.1");
+		case COLOR_BATCH_KERNEL_AVX2:
+			return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	}
+	return false;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	int info[4];
+	__cpuid(info, 1);
+	bool sse41 = (info[2] & (1 << 19)) != 0;
+	bool fma = (info[2] & (1 << 12)) != 0;
+	bool os_avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+	__cpuidex(info, 7, 0);
+	bool avx2 = (info[1] & (1 << 5)) != 0;
+	switch (kernel){
+		case COLOR_BATCH_KERNEL_SCALAR:
+			return true;
+		case COLOR_BATCH_KERNEL_SSE41:
+			return sse41;
+		case COLOR_BATCH_KERNEL_AVX2:
+			return os_avx && avx2 && fma;
+	}
+	return false;
+#else
+	return kernel == COLOR_BATCH_KERNEL_SCALAR;
+#endif
+}
+
+static const color_batch::Kernels* get_kernels(ColorBatchKernel kernel)
+{
+	switch (kernel){
+		case COLOR_BATCH_KERNEL_SCALAR:
+			return nullptr;
+		case COLOR_BATCH_KERNEL_SSE41:
+			return color_batch::sse41_kernels();
+		case COLOR_BATCH_KERNEL_AVX2:
+			return color_batch::avx2_kernels();
+	}
+	return nullptr;
+}
+
+bool color_batch_is_kernel_supported(ColorBatchKernel kernel)
+{
+	if (kernel == COLOR_BATCH_KERNEL_SCALAR) return true;
+	return get_kernels(kernel) != nullptr && cpu_supports(kernel);
+}
+
+static ColorBatchKernel best_supported_kernel(ColorBatchKernel kernel)
+{
+	for (int i = kernel; i > COLOR_BATCH_KERNEL_SCALAR; i--){
+		if (color_batch_is_kernel_supported(ColorBatchKernel(i)))
+			return ColorBatchKernel(i);
+	}
+	return COLOR_BATCH_KERNEL_SCALAR;
+}
+
+static std::atomic<int> &current_kernel()
+{
+	static std::atomic<int> kernel(best_supported_kernel(COLOR_BATCH_KERNEL_AVX2));
+	return kernel;
+}
+
+ColorBatchKernel color_batch_get_kernel()
+{
+	return ColorBatchKernel(current_kernel().load());
+}
+
+ColorBatchKernel color_batch_set_kernel(ColorBatchKernel kernel)
+{
+	ColorBatchKernel selected = best_supported_kernel(kernel);
+	current_kernel().store(selected);
+	return selected;
+}
+
+const char* color_batch_get_kernel_name(ColorBatchKernel kernel)
+{
+	switch (kernel){
+		case COLOR_BATCH_KERNEL_SCALAR:
+			return "scalar";
+		case COLOR_BATCH_KERNEL_SSE41:
+			return "sse4.1";
+		case COLOR_BATCH_KERNEL_AVX2:
+			return "avx2";
+	}
+	return "unknown";
+}
+
+static const color_batch::Kernels* active_kernels()
+{
+	return get_kernels(color_batch_get_kernel());
+}
+
+/** Combine RGB to XYZ transformation, chromatic adaptation and division by reference white into a single matrix. */
+static void get_rgb_to_lab_matrix(const vector3* reference_white, const matrix3x3* transformation, const matrix3x3* adaptation_matrix, float *result)
+{
+	matrix3x3 m;
+	matrix3x3_multiply(transformation, adaptation_matrix, &m);
+	for (int i = 0; i < 3; i++){
+		for (int j = 0; j < 3; j++){
+			result[i * 3 + j] = float(m.m[i][j] / reference_white->m[i]);
+		}
+	}
+}
+
+/** Combine multiplication by reference white, inverted chromatic adaptation and inverted transformation into a single matrix. */
+static void get_lab_to_rgb_matrix(const vector3* reference_white, const matrix3x3* transformation_inverted, const matrix3x3* adaptation_matrix_inverted, float *result)
+{
+	matrix3x3 m;
+	matrix3x3_multiply(adaptation_matrix_inverted, transformation_inverted, &m);
+	for (int i = 0; i < 3; i++){
+		for (int j = 0; j < 3; j++){
+			result[i * 3 + j] = float(m.m[i][j] * reference_white->m[j]);
+		}
+	}
+}
+
+/** Per-color functions are not safe to use in-place, so every source color is copied first. */
+template<typename Function>
+static void scalar_loop(const Color* a, Color* b, size_t count, Function function)
+{
+	Color input;
+	for (size_t i = 0; i < count; i++){
+		input = a[i];
+		function(&input, &b[i]);
+		b[i].ma[3] = input.ma[3];
+	}
+}
+
+void color_batch_rgb_to_hsl(const Color* a, Color* b, size_t count)
+{
+	scalar_loop(a, b, count, color_rgb_to_hsl);
+}
+
+void color_batch_hsl_to_rgb(const Color* a, Color* b, size_t count)
+{
+	scalar_loop(a, b, count, color_hsl_to_rgb);
+}
+
+void color_batch_rgb_to_hsv(const Color* a, Color* b, size_t count)
+{
+	scalar_loop(a, b, count, color_rgb_to_hsv);
+}
+
+void color_batch_hsv_to_rgb(const Color* a, Color* b, size_t count)
+{
+	scalar_loop(a, b, count, color_hsv_to_rgb);
+}
+
+void color_batch_rgb_get_linear(const Color* a, Color* b, size_t count)
+{
+	const color_batch::Kernels *kernels = active_kernels();
+	if (kernels){
+		kernels->rgb_get_linear(a, b, count);
+		return;
+	}
+	scalar_loop(a, b, count, color_rgb_get_linear);
+}
+
+void color_batch_linear_get_rgb(const Color* a, Color* b, size_t count)
+{
+	const color_batch::Kernels *kernels = active_kernels();
+	if (kernels){
+		kernels->linear_get_rgb(a, b, count);
+		return;
+	}
+	scalar_loop(a, b, count, color_linear_get_rgb);
+}
+
+void color_batch_rgb_to_lab(const Color* a, Color* b, size_t count, const vector3* reference_white, const matrix3x3* transformation, const matrix3x3* adaptation_matrix)
+{
+	const color_batch::Kernels *kernels = active_kernels();
+	if (kernels){
+		float matrix[9];
+		get_rgb_to_lab_matrix(reference_white, transformation, adaptation_matrix, matrix);
+		kernels->rgb_to_lab(a, b, count, matrix);
+		return;
+	}
+	scalar_loop(a, b, count, [=](const Color *input, Color *output){
+		color_rgb_to_lab(input, output, reference_white, transformation, adaptation_matrix);
+	});
+}
+
+void color_batch_lab_to_rgb(const Color* a, Color* b, size_t count, const vector3* reference_white, const matrix3x3* transformation_inverted, const matrix3x3* adaptation_matrix_inverted)
+{
+	const color_batch::Kernels *kernels = active_kernels();
+	if (kernels){
+		float matrix[9];
+		get_lab_to_rgb_matrix(reference_white, transformation_inverted, adaptation_matrix_inverted, matrix);
+		kernels->lab_to_rgb(a, b, count, matrix);
+		return;
+	}
+	scalar_loop(a, b, count, [=](const Color *input, Color *output){
+		color_lab_to_rgb(input, output, reference_white, transformation_inverted, adaptation_matrix_inverted);
+	});
+}
+
+void color_batch_rgb_to_lch(const Color* a, Color* b, size_t count, const vector3* reference_white, const matrix3x3* transformation, const matrix3x3* adaptation_matrix)
+{
+	const color_batch::Kernels *kernels = active_kernels();
+	if (kernels){
+		float matrix[9];
+		get_rgb_to_lab_matrix(reference_white, transformation, adaptation_matrix, matrix);
+		kernels->rgb_to_lch(a, b, count, matrix);
+		return;
+	}
+	scalar_loop(a, b, count, [=](const Color *input, Color *output){
+		color_rgb_to_lch(input, output, reference_white, transformation, adaptation_matrix);
+	});
+}
+
+void color_batch_lch_to_rgb(const Color* a, Color* b, size_t count, const vector3* reference_white, const matrix3x3* transformation_inverted, const matrix3x3* adaptation_matrix_inverted)
+{
+	const color_batch::Kernels *kernels = active_kernels();
+	if (kernels){
+		float matrix[9];
+		get_lab_to_rgb_matrix(reference_white, transformation_inverted, adaptation_matrix_inverted, matrix);
+		kernels->lch_to_rgb(a, b, count, matrix);
+		return;
+	}
+	scalar_loop(a, b, count, [=](const Color *input, Color *output){
+		color_lch_to_rgb(input, output, reference_white, transformation_inverted, adaptation_matrix_inverted);
+	});
+}
+
+void color_batch_rgb_to_lab_d50(const Color* a, Color* b, size_t count)
+{
+	color_batch_rgb_to_lab(a, b, count, color_get_reference(REFERENCE_ILLUMINANT_D50, REFERENCE_OBSERVER_2), color_get_sRGB_transformation_matrix(), color_get_d65_d50_adaptation_matrix());
+}
+
+void color_batch_lab_to_rgb_d50(const Color* a, Color* b, size_t count)
+{
+	color_batch_lab_to_rgb(a, b, count, color_get_reference(REFERENCE_ILLUMINANT_D50, REFERENCE_OBSERVER_2), color_get_inverted_sRGB_transformation_matrix(), color_get_d50_d65_adaptation_matrix());
+}
+
+void color_batch_rgb_to_lch_d50(const Color* a, Color* b, size_t count)
+{
+	color_batch_rgb_to_lch(a, b, count, color_get_reference(REFERENCE_ILLUMINANT_D50, REFERENCE_OBSERVER_2), color_get_sRGB_transformation_matrix(), color_get_d65_d50_adaptation_matrix());
+}
+
+void color_batch_lch_to_rgb_d50(const Color* a, Color* b, size_t count)
+{
+	color_batch_lch_to_rgb(a, b, count, color_get_reference(REFERENCE_ILLUMINANT_D50, REFERENCE_OBSERVER_2), color_get_inverted_sRGB_transformation_matrix(), color_get_d50_d65_adaptation_matrix());
+}
+
+void color_batch_lab_to_lch(const Color* a, Color* b, size_t count)
+{
+	const color_batch::Kernels *kernels = active_kernels();
+	if (kernels){
+		kernels->lab_to_lch(a, b, count);
+		return;
+	}
+	scalar_loop(a, b, count, color_lab_to_lch);
+}
+
+void color_batch_lch_to_lab(const Color* a, Color* b, size_t count)
+{
+	const color_batch::Kernels *kernels = active_kernels();
+	if (kernels){
+		kernels->lch_to_lab(a, b, count);
+		return;
+	}
+	scalar_loop(a, b, count, color_lch_to_lab);
+}
+
+void color_batch_rgb_gamma(const Color* a, Color* b, size_t count, float exponent)
+{
+	const color_batch::Kernels *kernels = active_kernels();
+	if (kernels){
+		kernels->rgb_gamma(a, b, count, exponent);
+		return;
+	}
+	scalar_loop(a, b, count, [exponent](const Color *input, Color *output){
+		Color linear;
+		color_rgb_get_linear(input, &linear);
+		for (int i = 0; i < 3; i++)
+			linear.ma[i] = pow(linear.ma[i], exponent);
+		color_linear_get_rgb(&linear, output);
+		color_rgb_normalize(output);
+	});
+}
+
+void color_batch_rgb_linear_transform(const Color* a, Color* b, size_t count, const matrix3x3* matrix)
+{
+	const color_batch::Kernels *kernels = active_kernels();
+	if (kernels){
+		float m[9];
+		for (int i = 0; i < 3; i++){
+			for (int j = 0; j < 3; j++){
+				m[i * 3 + j] = float(matrix->m[i][j]);
+			}
+		}
+		kernels->rgb_linear_transform(a, b, count, m);
+		return;
+	}
+	scalar_loop(a, b, count, [matrix](const Color *input, Color *output){
+		Color linear;
+		color_rgb_get_linear(input, &linear);
+		vector3 vector;
+		vector3_set(&vector, linear.rgb.red, linear.rgb.green, linear.rgb.blue);
+		vector3_multiply_matrix3x3(&vector, matrix, &vector);
+		color_set(&linear, vector.x, vector.y, vector.z);
+		color_linear_get_rgb(&linear, output);
+		color_rgb_normalize(output);
+	});
+}
+
+void color_batch_accumulate_bgra(const uint8_t *pixels, const int16_t *weights, size_t count, int32_t *sums)
+{
+	const color_batch::Kernels *kernels = active_kernels();
+	if (kernels){
+		kernels->accumulate_bgra(pixels, weights, count, sums);
+		return;
+	}
+	for (size_t i = 0; i < count; i++){
+		for (int j = 0; j < 4; j++)
+			sums[j] += pixels[i * 4 + j] * weights[i];
+	}
+}
+
+void color_batch_replicate_pixels(const uint32_t *pixels, size_t count, size_t factor, uint32_t *output)
+{
+	const color_batch::Kernels *kernels = active_kernels();
+	if (kernels){
+		kernels->replicate_pixels(pixels, count, factor, output);
+		return;
+	}
+	for (size_t i = 0; i < count; i++, output += factor){
+		for (size_t j = 0; j < factor; j++)
+			output[j] = pixels[i];
+	}
+}
+
+void color_batch_find_nearest(const float *x, const float *y, const float *z, size_t count, const float *centers, size_t center_count, uint32_t *index, float *distance)
+{
+	const color_batch::Kernels *kernels = active_kernels();
+	if (kernels){
+		kernels->find_nearest(x, y, z, count, centers, center_count, index, distance);
+		return;
+	}
+	for (size_t i = 0; i < count; i++){
+		float best_distance = 3.4e38f;
+		uint32_t best_index = 0;
+		for (size_t j = 0; j < center_count; j++){
+			float dx = x[i] - centers[j * 3 + 0], dy = y[i] - centers[j * 3 + 1], dz = z[i] - centers[j * 3 + 2];
+			float d = dx * dx + dy * dy + dz * dz;
+			if (d < best_distance){
+				best_distance = d;
+				best_index = j;
+			}
+		}
+		index[i] = best_index;
+		if (distance) distance[i] = best_distance;
+	}
+}
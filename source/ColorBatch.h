@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GPICK_COLOR_BATCH_H_
+#define GPICK_COLOR_BATCH_H_
+
+#include "Color.h"
+#include <cstddef>
+#include <cstdint>
+
+/** \file source/ColorBatch.h
+ * \brief Functions to convert arrays of colors from one color space to another.
+ *
+ * Every function converts count colors from array a into array b. Arrays a and b can be the same array, but must not partially overlap.
+ * Fourth color component is copied from source to destination unchanged.
+ *
+ * Results match per-color functions from Color.h within following absolute tolerances:
+ * COLOR_BATCH_RGB_TOLERANCE for RGB and linear RGB components, COLOR_BATCH_LAB_TOLERANCE for Lab components and LCH lightness and chroma,
+ * COLOR_BATCH_HUE_TOLERANCE for LCH hue in degrees when chroma is above COLOR_BATCH_HUE_CHROMA_THRESHOLD (hue of almost achromatic colors is not stable in either implementation).
+ * Scalar kernel calls per-color functions and produces identical results.
+ */
+
+#define COLOR_BATCH_RGB_TOLERANCE 1e-5f
+#define COLOR_BATCH_LAB_TOLERANCE 1e-3f
+#define COLOR_BATCH_HUE_TOLERANCE 1e-2f
+#define COLOR_BATCH_HUE_CHROMA_THRESHOLD 0.1f
+
+/** \enum ColorBatchKernel
+ * \brief Implementations of batch color conversion functions.
+ */
+enum ColorBatchKernel {
+	COLOR_BATCH_KERNEL_SCALAR = 0, /**< Portable implementation */
+	COLOR_BATCH_KERNEL_SSE41 = 1, /**< SSE4.1 implementation processing 4 colors at once */
+	COLOR_BATCH_KERNEL_AVX2 = 2, /**< AVX2 and FMA implementation processing 8 colors at once */
+};
+
+/**
+ * Get currently used kernel. Best kernel supported by the CPU is selected on first use.
+ * @return Kernel.
+ */
+ColorBatchKernel color_batch_get_kernel();
+
+/**
+ * Select kernel. Kernels not supported by the CPU or not compiled in are replaced by the best supported kernel below it.
+ * @param[in] kernel Requested kernel.
+ * @return Selected kernel.
+ */
+ColorBatchKernel color_batch_set_kernel(ColorBatchKernel kernel);
+
+/**
+ * Check if kernel is compiled in and supported by the CPU.
+ * @param[in] kernel Kernel.
+ * @return True, when kernel can be used.
+ */
+bool color_batch_is_kernel_supported(ColorBatchKernel kernel);
+
+/**
+ * Get kernel name.
+ * @param[in] kernel Kernel.
+ * @return Kernel name.
+ */
+const char* color_batch_get_kernel_name(ColorBatchKernel kernel);
+
+/**
+ * Convert RGB color space to HSL color space.
+ * @param[in] a Source colors in RGB color space.
+ * @param[out] b Destination colors in HSL color space.
+ * @param[in] count Number of colors.
+ */
+void color_batch_rgb_to_hsl(const Color* a, Color* b, size_t count);
+
+/**
+ * Convert HSL color space to RGB color space.
+ * @param[in] a Source colors in HSL color space.
+ * @param[out] b Destination colors in RGB color space.
+ * @param[in] count Number of colors.
+ */
+void color_batch_hsl_to_rgb(const Color* a, Color* b, size_t count);
+
+/**
+ * Convert RGB color space to HSV color space.
+ * @param[in] a Source colors in RGB color space.
+ * @param[out] b Destination colors in HSV color space.
+ * @param[in] count Number of colors.
+ */
+void color_batch_rgb_to_hsv(const Color* a, Color* b, size_t count);
+
+/**
+ * Convert HSV color space to RGB color space.
+ * @param[in] a Source colors in HSV color space.
+ * @param[out] b Destination colors in RGB color space.
+ * @param[in] count Number of colors.
+ */
+void color_batch_hsv_to_rgb(const Color* a, Color* b, size_t count);
+
+/**
+ * Transform RGB colors to linear RGB colors.
+ * @param[in] a Colors in RGB color space.
+ * @param[out] b Linear colors in RGB color space.
+ * @param[in] count Number of colors.
+ */
+void color_batch_rgb_get_linear(const Color* a, Color* b, size_t count);
+
+/**
+ * Transform linear RGB colors to RGB colors.
+ * @param[in] a Linear colors in RGB color space.
+ * @param[out] b Colors in RGB color space.
+ * @param[in] count Number of colors.
+ */
+void color_batch_linear_get_rgb(const Color* a, Color* b, size_t count);
+
+/**
+ * Convert RGB color space to Lab color space.
+ * @param[in] a Source colors in RGB color space.
+ * @param[out] b Destination colors in Lab color space.
+ * @param[in] count Number of colors.
+ * @param[in] reference_white Reference white color values.
+ * @param[in] transformation Transformation matrix for RGB to XYZ conversion.
+ * @param[in] adaptation_matrix XYZ chromatic adaptation matrix.
+ */
+void color_batch_rgb_to_lab(const Color* a, Color* b, size_t count, const vector3* reference_white, const matrix3x3* transformation, const matrix3x3* adaptation_matrix);
+
+/**
+ * Convert Lab color space to RGB color space.
+ * @param[in] a Source colors in Lab color space.
+ * @param[out] b Destination colors in RGB color space.
+ * @param[in] count Number of colors.
+ * @param[in] reference_white Reference white color values.
+ * @param[in] transformation_inverted Transformation matrix for XYZ to RGB conversion.
+ * @param[in] adaptation_matrix_inverted Inverted XYZ chromatic adaptation matrix.
+ */
+void color_batch_lab_to_rgb(const Color* a, Color* b, size_t count, const vector3* reference_white, const matrix3x3* transformation_inverted, const matrix3x3* adaptation_matrix_inverted);
+
+/**
+ * Convert RGB color space to LCH color space.
+ * @param[in] a Source colors in RGB color space.
+ * @param[out] b Destination colors in LCH color space.
+ * @param[in] count Number of colors.
+ * @param[in] reference_white Reference white color values.
+ * @param[in] transformation Transformation matrix for RGB to XYZ conversion.
+ * @param[in] adaptation_matrix XYZ chromatic adaptation matrix.
+ */
+void color_batch_rgb_to_lch(const Color* a, Color* b, size_t count, const vector3* reference_white, const matrix3x3* transformation, const matrix3x3* adaptation_matrix);
+
+/**
+ * Convert LCH color space to RGB color space.
+ * @param[in] a Source colors in LCH color space.
+ * @param[out] b Destination colors in RGB color space.
+ * @param[in] count Number of colors.
+ * @param[in] reference_white Reference white color values.
+ * @param[in] transformation_inverted Transformation matrix for XYZ to RGB conversion.
+ * @param[in] adaptation_matrix_inverted Inverted XYZ chromatic adaptation matrix.
+ */
+void color_batch_lch_to_rgb(const Color* a, Color* b, size_t count, const vector3* reference_white, const matrix3x3* transformation_inverted, const matrix3x3* adaptation_matrix_inverted);
+
+/**
+ * Convert RGB color space to Lab color space with illuminant D50, observer 2, sRGB transformation matrix and D65-D50 adaptation matrix.
+ * @param[in] a Source colors in RGB color space.
+ * @param[out] b Destination colors in Lab color space.
+ * @param[in] count Number of colors.
+ */
+void color_batch_rgb_to_lab_d50(const Color* a, Color* b, size_t count);
+
+/**
+ * Convert Lab color space to RGB color space with illuminant D50, observer 2, inverted sRGB transformation matrix and D50-D65 adaptation matrix.
+ * @param[in] a Source colors in Lab color space.
+ * @param[out] b Destination colors in RGB color space.
+ * @param[in] count Number of colors.
+ */
+void color_batch_lab_to_rgb_d50(const Color* a, Color* b, size_t count);
+
+/**
+ * Convert RGB color space to LCH color space with illuminant D50, observer 2, sRGB transformation matrix and D65-D50 adaptation matrix.
+ * @param[in] a Source colors in RGB color space.
+ * @param[out] b Destination colors in LCH color space.
+ * @param[in] count Number of colors.
+ */
+void color_batch_rgb_to_lch_d50(const Color* a, Color* b, size_t count);
+
+/**
+ * Convert LCH color space to RGB color space with illuminant D50, observer 2, inverted sRGB transformation matrix and D50-D65 adaptation matrix.
+ * @param[in] a Source colors in LCH color space.
+ * @param[out] b Destination colors in RGB color space.
+ * @param[in] count Number of colors.
+ */
+void color_batch_lch_to_rgb_d50(const Color* a, Color* b, size_t count);
+
+/**
+ * Convert Lab color space to LCH color space.
+ * @param[in] a Source colors in Lab color space.
+ * @param[out] b Destination colors in LCH color space.
+ * @param[in] count Number of colors.
+ */
+void color_batch_lab_to_lch(const Color* a, Color* b, size_t count);
+
+/**
+ * Convert LCH color space to Lab color space.
+ * @param[in] a Source colors in LCH color space.
+ * @param[out] b Destination colors in Lab color space.
+ * @param[in] count Number of colors.
+ */
+void color_batch_lch_to_lab(const Color* a, Color* b, size_t count);
+
+/**
+ * Raise linear RGB components to a power. Result is transformed back to RGB color space and clamped to [0, 1] range.
+ * @param[in] a Colors in RGB color space.
+ * @param[out] b Colors in RGB color space.
+ * @param[in] count Number of colors.
+ * @param[in] exponent Power.
+ */
+void color_batch_rgb_gamma(const Color* a, Color* b, size_t count, float exponent);
+
+/**
+ * Multiply linear RGB components by a matrix. Result is transformed back to RGB color space and clamped to [0, 1] range.
+ * @param[in] a Colors in RGB color space.
+ * @param[out] b Colors in RGB color space.
+ * @param[in] count Number of colors.
+ * @param[in] matrix Transformation matrix, used the same way as in vector3_multiply_matrix3x3.
+ */
+void color_batch_rgb_linear_transform(const Color* a, Color* b, size_t count, const matrix3x3* matrix);
+
+/**
+ * Add weighted 8-bit BGRA pixels to per channel sums using integer arithmetic. Result does not depend on selected kernel.
+ * @param[in] pixels First pixel. Each pixel has blue, green, red and alpha bytes.
+ * @param[in] weights Weight of each pixel.
+ * @param[in] count Number of pixels.
+ * @param[in,out] sums Blue, green, red and alpha sums. Caller must make sure that sums can not overflow.
+ */
+void color_batch_accumulate_bgra(const uint8_t *pixels, const int16_t *weights, size_t count, int32_t *sums);
+
+/**
+ * Repeat each 32-bit pixel multiple times, as needed for nearest neighbour upscaling by integer factor.
+ * @param[in] pixels Source pixels.
+ * @param[in] count Number of source pixels.
+ * @param[in] factor Number of times each pixel is repeated.
+ * @param[out] output Destination for count * factor pixels. Must not overlap source pixels.
+ */
+void color_batch_replicate_pixels(const uint32_t *pixels, size_t count, size_t factor, uint32_t *output);
+
+/**
+ * Find nearest center for each point using squared Euclidean distance. Points and centers are usually colors in Lab color space.
+ * When multiple centers are at the same distance, the first one is selected.
+ * @param[in] x First component of points.
+ * @param[in] y Second component of points.
+ * @param[in] z Third component of points.
+ * @param[in] count Number of points.
+ * @param[in] centers Center components, three consecutive values per center.
+ * @param[in] center_count Number of centers.
+ * @param[out] index Index of nearest center for each point.
+ * @param[out] distance Squared distance to nearest center for each point. Can be null.
+ */
+void color_batch_find_nearest(const float *x, const float *y, const float *z, size_t count, const float *centers, size_t center_count, uint32_t *index, float *distance);
+
+#endif /* GPICK_COLOR_BATCH_H_ */
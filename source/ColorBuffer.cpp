@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ColorBuffer.h"
+#include "ColorBatch.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+using namespace std;
+
+int color_space_get_channel_count(ColorSpace color_space)
+{
+	return color_space == ColorSpace::cmyk ? 4 : 3;
+}
+
+ColorBuffer::ColorBuffer():
+	m_color_space(ColorSpace::rgb),
+	m_channels(3),
+	m_size(0),
+	m_stride(0),
+	m_data(nullptr)
+{
+}
+ColorBuffer::ColorBuffer(ColorSpace color_space, size_t size):
+	m_color_space(color_space),
+	m_channels(0),
+	m_size(0),
+	m_stride(0),
+	m_data(nullptr)
+{
+	allocate(size, color_space_get_channel_count(color_space));
+}
+ColorBuffer::ColorBuffer(ColorSpace color_space, const Color *colors, size_t count):
+	ColorBuffer(color_space, count)
+{
+	assign(colors, count);
+}
+ColorBuffer::ColorBuffer(ColorSpace color_space, const std::vector<Color> &colors):
+	ColorBuffer(color_space, colors.data(), colors.size())
+{
+}
+ColorBuffer::ColorBuffer(const ColorBuffer &buffer):
+	ColorBuffer(buffer.m_color_space, buffer.m_size)
+{
+	if (m_data)
+		memcpy(m_data, buffer.m_data, m_stride * m_channels * sizeof(float));
+}
+ColorBuffer::ColorBuffer(ColorBuffer &&buffer):
+	m_color_space(buffer.m_color_space),
+	m_channels(buffer.m_channels),
+	m_size(buffer.m_size),
+	m_stride(buffer.m_stride),
+	m_storage(std::move(buffer.m_storage)),
+	m_data(buffer.m_data)
+{
+	buffer.m_size = buffer.m_stride = 0;
+	buffer.m_data = nullptr;
+}
+ColorBuffer &ColorBuffer::operator=(const ColorBuffer &buffer)
+{
+	if (this == &buffer) return *this;
+	m_color_space = buffer.m_color_space;
+	allocate(buffer.m_size, buffer.m_channels);
+	if (m_data)
+		memcpy(m_data, buffer.m_data, m_stride * m_channels * sizeof(float));
+	return *this;
+}
+ColorBuffer &ColorBuffer::operator=(ColorBuffer &&buffer)
+{
+	if (this == &buffer) return *this;
+	m_color_space = buffer.m_color_space;
+	m_channels = buffer.m_channels;
+	m_size = buffer.m_size;
+	m_stride = buffer.m_stride;
+	m_storage = std::move(buffer.m_storage);
+	m_data = buffer.m_data;
+	buffer.m_size = buffer.m_stride = 0;
+	buffer.m_data = nullptr;
+	return *this;
+}
+void ColorBuffer::allocate(size_t size, int channels)
+{
+	m_size = size;
+	m_channels = channels;
+	m_stride = (size + block_size - 1) / block_size * block_size;
+	if (m_stride == 0){
+		m_storage.reset();
+		m_data = nullptr;
+		return;
+	}
+	size_t values = m_stride * channels;
+	m_storage.reset(new float[values + block_size]);
+	uintptr_t address = reinterpret_cast<uintptr_t>(m_storage.get());
+	m_data = reinterpret_cast<float*>((address + alignment - 1) / alignment * alignment);
+	memset(m_data, 0, values * sizeof(float));
+}
+size_t ColorBuffer::size() const
+{
+	return m_size;
+}
+bool ColorBuffer::empty() const
+{
+	return m_size == 0;
+}
+size_t ColorBuffer::stride() const
+{
+	return m_stride;
+}
+int ColorBuffer::channels() const
+{
+	return m_channels;
+}
+ColorSpace ColorBuffer::colorSpace() const
+{
+	return m_color_space;
+}
+void ColorBuffer::setColorSpace(ColorSpace color_space)
+{
+	int channels = color_space_get_channel_count(color_space);
+	if (channels != m_channels){
+		ColorBuffer buffer(color_space, m_size);
+		int common = std::min(channels, m_channels);
+		for (int i = 0; i < common; i++)
+			memcpy(buffer.plane(i), plane(i), m_size * sizeof(float));
+		*this = std::move(buffer);
+	}
+	m_color_space = color_space;
+}
+void ColorBuffer::resize(size_t size)
+{
+	if (size == m_size) return;
+	if (size <= m_stride){
+		for (int i = 0; i < m_channels; i++){
+			float *values = plane(i);
+			if (size < m_size)
+				memset(values + size, 0, (m_size - size) * sizeof(float));
+		}
+		m_size = size;
+		return;
+	}
+	ColorBuffer buffer(m_color_space, size);
+	for (int i = 0; i < m_channels; i++)
+		memcpy(buffer.plane(i), plane(i), m_size * sizeof(float));
+	*this = std::move(buffer);
+}
+void ColorBuffer::clear()
+{
+	allocate(0, m_channels);
+}
+float *ColorBuffer::plane(int channel)
+{
+	return m_data + channel * m_stride;
+}
+const float *ColorBuffer::plane(int channel) const
+{
+	return m_data + channel * m_stride;
+}
+void ColorBuffer::get(size_t index, Color &color) const
+{
+	color_zero(&color);
+	for (int i = 0; i < m_channels; i++)
+		color.ma[i] = m_data[i * m_stride + index];
+}
+void ColorBuffer::set(size_t index, const Color &color)
+{
+	for (int i = 0; i < m_channels; i++)
+		m_data[i * m_stride + index] = color.ma[i];
+}
+void ColorBuffer::assign(const Color *colors, size_t count)
+{
+	if (count != m_size)
+		allocate(count, m_channels);
+	for (int i = 0; i < m_channels; i++){
+		float *values = plane(i);
+		for (size_t j = 0; j < count; j++)
+			values[j] = colors[j].ma[i];
+	}
+}
+void ColorBuffer::assign(const std::vector<Color> &colors)
+{
+	assign(colors.data(), colors.size());
+}
+void ColorBuffer::copyTo(Color *colors) const
+{
+	for (size_t j = 0; j < m_size; j++)
+		color_zero(&colors[j]);
+	for (int i = 0; i < m_channels; i++){
+		const float *values = plane(i);
+		for (size_t j = 0; j < m_size; j++)
+			colors[j].ma[i] = values[j];
+	}
+}
+std::vector<Color> ColorBuffer::toVector() const
+{
+	vector<Color> colors(m_size);
+	if (m_size > 0)
+		copyTo(&colors[0]);
+	return colors;
+}
+template<typename Function>
+static void convert_each(Color *colors, size_t count, Function function)
+{
+	for (size_t i = 0; i < count; i++)
+		function(&colors[i], &colors[i]);
+}
+static void convert_to_rgb(ColorSpace color_space, Color *colors, size_t count)
+{
+	switch (color_space){
+		case ColorSpace::rgb:
+			break;
+		case ColorSpace::linear_rgb:
+			color_batch_linear_get_rgb(colors, colors, count);
+			break;
+		case ColorSpace::hsv:
+			color_batch_hsv_to_rgb(colors, colors, count);
+			break;
+		case ColorSpace::hsl:
+			color_batch_hsl_to_rgb(colors, colors, count);
+			break;
+		case ColorSpace::xyz:
+			convert_each(colors, count, [](const Color *a, Color *b){
+				color_xyz_to_rgb(a, b, color_get_inverted_sRGB_transformation_matrix());
+			});
+			break;
+		case ColorSpace::lab:
+			color_batch_lab_to_rgb_d50(colors, colors, count);
+			break;
+		case ColorSpace::lch:
+			color_batch_lch_to_rgb_d50(colors, colors, count);
+			break;
+		case ColorSpace::cmy:
+			convert_each(colors, count, color_cmy_to_rgb);
+			break;
+		case ColorSpace::cmyk:
+			convert_each(colors, count, color_cmyk_to_rgb);
+			for (size_t i = 0; i < count; i++)
+				colors[i].ma[3] = 0;
+			break;
+	}
+}
+static void convert_from_rgb(ColorSpace color_space, Color *colors, size_t count)
+{
+	switch (color_space){
+		case ColorSpace::rgb:
+			break;
+		case ColorSpace::linear_rgb:
+			color_batch_rgb_get_linear(colors, colors, count);
+			break;
+		case ColorSpace::hsv:
+			color_batch_rgb_to_hsv(colors, colors, count);
+			break;
+		case ColorSpace::hsl:
+			color_batch_rgb_to_hsl(colors, colors, count);
+			break;
+		case ColorSpace::xyz:
+			convert_each(colors, count, [](const Color *a, Color *b){
+				color_rgb_to_xyz(a, b, color_get_sRGB_transformation_matrix());
+			});
+			break;
+		case ColorSpace::lab:
+			color_batch_rgb_to_lab_d50(colors, colors, count);
+			break;
+		case ColorSpace::lch:
+			color_batch_rgb_to_lch_d50(colors, colors, count);
+			break;
+		case ColorSpace::cmy:
+			convert_each(colors, count, color_rgb_to_cmy);
+			break;
+		case ColorSpace::cmyk:
+			convert_each(colors, count, color_rgb_to_cmyk);
+			break;
+	}
+}
+void ColorBuffer::convert(ColorSpace color_space)
+{
+	if (color_space == m_color_space) return;
+	ColorBuffer result(color_space, m_size);
+	const size_t chunk_size = 256;
+	Color chunk[chunk_size];
+	for (size_t offset = 0; offset < m_size; offset += chunk_size){
+		size_t count = std::min(chunk_size, m_size - offset);
+		for (size_t j = 0; j < count; j++)
+			get(offset + j, chunk[j]);
+		convert_to_rgb(m_color_space, chunk, count);
+		convert_from_rgb(color_space, chunk, count);
+		for (size_t j = 0; j < count; j++)
+			result.set(offset + j, chunk[j]);
+	}
+	*this = std::move(result);
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GPICK_COLOR_BUFFER_H_
+#define GPICK_COLOR_BUFFER_H_
+
+#include "Color.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/** \file source/ColorBuffer.h
+ * \brief Structure-of-arrays color container for bulk color processing.
+ */
+
+/** \enum ColorSpace
+ * \brief Color space of values stored in a ColorBuffer.
+ */
+enum class ColorSpace: int
+{
+	rgb,
+	linear_rgb,
+	hsv,
+	hsl,
+	xyz,
+	lab, /**< Lab with illuminant D50, observer 2 */
+	lch, /**< LCH with illuminant D50, observer 2 */
+	cmy,
+	cmyk,
+};
+
+/**
+ * Get number of components used by color space.
+ * @param[in] color_space Color space.
+ * @return 4 for CMYK, 3 for all other color spaces.
+ */
+int color_space_get_channel_count(ColorSpace color_space);
+
+/** \class ColorBuffer
+ * \brief Colors stored as separate planes of component values.
+ *
+ * Every plane starts at ColorBuffer::alignment byte boundary and is padded with zeroes up to the multiple of ColorBuffer::block_size values,
+ * so vectorized loops can process whole blocks without handling the tail separately.
+ */
+class ColorBuffer
+{
+	public:
+		static const size_t alignment = 32; /**< Plane alignment in bytes */
+		static const size_t block_size = alignment / sizeof(float); /**< Plane padding in values */
+
+		ColorBuffer();
+		ColorBuffer(ColorSpace color_space, size_t size);
+		ColorBuffer(ColorSpace color_space, const Color *colors, size_t count);
+		ColorBuffer(ColorSpace color_space, const std::vector<Color> &colors);
+		ColorBuffer(const ColorBuffer &buffer);
+		ColorBuffer(ColorBuffer &&buffer);
+		ColorBuffer &operator=(const ColorBuffer &buffer);
+		ColorBuffer &operator=(ColorBuffer &&buffer);
+
+		size_t size() const;
+		bool empty() const;
+		/**
+		 * Get number of values in each plane including padding.
+		 * @return Padded plane size.
+		 */
+		size_t stride() const;
+		int channels() const;
+		ColorSpace colorSpace() const;
+
+		/**
+		 * Change color space tag without converting values. Planes are reallocated if the channel count changes.
+		 * @param[in] color_space New color space.
+		 */
+		void setColorSpace(ColorSpace color_space);
+
+		/**
+		 * Resize buffer keeping existing values. New values are set to zero.
+		 * @param[in] size New color count.
+		 */
+		void resize(size_t size);
+		void clear();
+
+		float *plane(int channel);
+		const float *plane(int channel) const;
+
+		void get(size_t index, Color &color) const;
+		void set(size_t index, const Color &color);
+
+		/**
+		 * Replace buffer contents with colors from an array.
+		 * @param[in] colors Colors in buffer color space.
+		 * @param[in] count Number of colors.
+		 */
+		void assign(const Color *colors, size_t count);
+		void assign(const std::vector<Color> &colors);
+
+		/**
+		 * Copy colors into an array. Unused components are set to zero.
+		 * @param[out] colors Array with space for size() colors.
+		 */
+		void copyTo(Color *colors) const;
+		std::vector<Color> toVector() const;
+
+		/**
+		 * Convert all values into another color space. Conversions go through RGB and use batch color conversion functions.
+		 * @param[in] color_space Destination color space.
+		 */
+		void convert(ColorSpace color_space);
+	private:
+		ColorSpace m_color_space;
+		int m_channels;
+		size_t m_size;
+		size_t m_stride;
+		std::unique_ptr<float[]> m_storage;
+		float *m_data;
+		void allocate(size_t size, int channels);
+};
+
+#endif /* GPICK_COLOR_BUFFER_H_ */
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ColorHistogram.h"
+#include "Parallel.h"
+#include <mutex>
+using namespace std;
+
+ColorHistogram::ColorHistogram():
+	m_bins(bin_count, Bin{0, {0, 0, 0}, 0}),
+	m_pixels(0)
+{
+}
+uint32_t ColorHistogram::getKey(uint8_t red, uint8_t green, uint8_t blue)
+{
+	const int shift = 8 - bits;
+	return ((red >> shift) << (2 * bits)) | ((green >> shift) << bits) | (blue >> shift);
+}
+void ColorHistogram::add(const uint8_t *pixels, size_t count, size_t pixel_stride)
+{
+	for (size_t i = 0; i < count; i++, pixels += pixel_stride){
+		Bin &bin = m_bins[getKey(pixels[0], pixels[1], pixels[2])];
+		bin.pixels++;
+		bin.sum[0] += pixels[0];
+		bin.sum[1] += pixels[1];
+		bin.sum[2] += pixels[2];
+		bin.squares += pixels[0] * pixels[0] + pixels[1] * pixels[1] + pixels[2] * pixels[2];
+	}
+	m_pixels += count;
+}
+bool ColorHistogram::addImage(const uint8_t *image, size_t width, size_t height, size_t rowstride, size_t pixel_stride, std::atomic<size_t> *processed_rows, const std::atomic<bool> *cancel)
+{
+	mutex lock;
+	ColorHistogram result;
+	bool cancelled = false;
+	parallel_for(height, 16, [&](size_t begin, size_t end){
+		ColorHistogram part;
+		for (size_t y = begin; y < end; y++){
+			if (cancel && *cancel) break;
+			part.add(image + rowstride * y, width, pixel_stride);
+			if (processed_rows) (*processed_rows)++;
+		}
+		lock_guard<mutex> guard(lock);
+		if (cancel && *cancel) cancelled = true;
+		result.add(part);
+	});
+	if (cancelled) return false;
+	add(result);
+	return true;
+}
+void ColorHistogram::add(const ColorHistogram &histogram)
+{
+	for (uint32_t key = 0; key < bin_count; key++){
+		const Bin &source = histogram.m_bins[key];
+		if (!source.pixels) continue;
+		Bin &bin = m_bins[key];
+		bin.pixels += source.pixels;
+		for (int i = 0; i < 3; i++)
+			bin.sum[i] += source.sum[i];
+		bin.squares += source.squares;
+	}
+	m_pixels += histogram.m_pixels;
+}
+void ColorHistogram::clear()
+{
+	m_bins.assign(bin_count, Bin{0, {0, 0, 0}, 0});
+	m_pixels = 0;
+}
+const ColorHistogram::Bin &ColorHistogram::getBin(uint32_t key) const
+{
+	return m_bins[key];
+}
+void ColorHistogram::getColor(uint32_t key, Color &color) const
+{
+	const Bin &bin = m_bins[key];
+	color.rgb.red = bin.sum[0] / (255.0 * bin.pixels);
+	color.rgb.green = bin.sum[1] / (255.0 * bin.pixels);
+	color.rgb.blue = bin.sum[2] / (255.0 * bin.pixels);
+	color.ma[3] = 0;
+}
+void ColorHistogram::getLinearColor(uint32_t key, Color &color) const
+{
+	const Bin &bin = m_bins[key];
+	for (int i = 0; i < 3; i++){
+		uint64_t value = bin.sum[i] / bin.pixels;
+		float linear = color_rgb8_get_linear_value(value);
+		if (value < 255)
+			linear += (color_rgb8_get_linear_value(value + 1) - linear) * float(bin.sum[i] % bin.pixels) / bin.pixels;
+		color.ma[i] = linear;
+	}
+	color.ma[3] = 0;
+}
+void ColorHistogram::getKeys(std::vector<uint32_t> &keys) const
+{
+	keys.clear();
+	for (uint32_t key = 0; key < bin_count; key++){
+		if (m_bins[key].pixels)
+			keys.push_back(key);
+	}
+}
+size_t ColorHistogram::getColorCount() const
+{
+	size_t result = 0;
+	for (auto &bin: m_bins){
+		if (bin.pixels)
+			result++;
+	}
+	return result;
+}
+uint64_t ColorHistogram::getPixelCount() const
+{
+	return m_pixels;
+}
+bool ColorHistogram::empty() const
+{
+	return m_pixels == 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GPICK_COLOR_HISTOGRAM_H_
+#define GPICK_COLOR_HISTOGRAM_H_
+
+#include "Color.h"
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <vector>
+
+/** \file source/ColorHistogram.h
+ * \brief Histogram of 8-bit RGB colors used as an input for palette quantizers.
+ */
+
+/** \class ColorHistogram
+ * \brief Histogram of 8-bit RGB colors with 5 bits per channel.
+ *
+ * Each bin keeps integer sums of exact color values, so average color of each bin is not affected by binning and results do not depend on pixel order.
+ * One histogram can be quantized multiple times with different quantizers and color counts without going through image pixels again.
+ */
+class ColorHistogram
+{
+	public:
+		/** Number of bits per channel used for bin index. */
+		static const int bits = 5;
+		/** Total number of bins. */
+		static const uint32_t bin_count = 1 << (3 * bits);
+		struct Bin
+		{
+			uint64_t pixels; /**< Number of pixels in bin */
+			uint64_t sum[3]; /**< Sum of 8-bit color values of pixels in bin */
+			uint64_t squares; /**< Sum of squared 8-bit color values of pixels in bin */
+		};
+		ColorHistogram();
+		/**
+		 * Get bin index of 8-bit RGB color.
+		 * @param[in] red Red value.
+		 * @param[in] green Green value.
+		 * @param[in] blue Blue value.
+		 * @return Bin index.
+		 */
+		static uint32_t getKey(uint8_t red, uint8_t green, uint8_t blue);
+		/**
+		 * Add 8-bit RGB pixels.
+		 * @param[in] pixels First pixel. Each pixel starts with red, green and blue bytes.
+		 * @param[in] count Number of pixels.
+		 * @param[in] pixel_stride Distance between pixels in bytes.
+		 */
+		void add(const uint8_t *pixels, size_t count, size_t pixel_stride);
+		/**
+		 * Add 8-bit RGB image. Rows are split between multiple threads, each thread builds separate histogram and results are summed.
+		 * @param[in] image First pixel of the first row.
+		 * @param[in] width Number of pixels in a row.
+		 * @param[in] height Number of rows.
+		 * @param[in] rowstride Distance between rows in bytes.
+		 * @param[in] pixel_stride Distance between pixels in bytes.
+		 * @param[out] processed_rows Incremented after each processed row. Can be null.
+		 * @param[in] cancel Processing is stopped when cancel is set. Can be null.
+		 * @return False if processing was cancelled. Histogram is not modified in that case.
+		 */
+		bool addImage(const uint8_t *image, size_t width, size_t height, size_t rowstride, size_t pixel_stride, std::atomic<size_t> *processed_rows = nullptr, const std::atomic<bool> *cancel = nullptr);
+		/**
+		 * Add all pixels from another histogram.
+		 * @param[in] histogram Histogram.
+		 */
+		void add(const ColorHistogram &histogram);
+		void clear();
+		const Bin &getBin(uint32_t key) const;
+		/**
+		 * Get average color of pixels in bin.
+		 * @param[in] key Bin index of a non-empty bin.
+		 * @param[out] color Color in RGB color space.
+		 */
+		void getColor(uint32_t key, Color &color) const;
+		/**
+		 * Get average color of pixels in bin in linear RGB color space.
+		 * Values are interpolated from exact linear values of 8-bit components, so gamma function is not evaluated.
+		 * @param[in] key Bin index of a non-empty bin.
+		 * @param[out] color Color in linear RGB color space.
+		 */
+		void getLinearColor(uint32_t key, Color &color) const;
+		/**
+		 * Get indices of all non-empty bins in increasing order.
+		 * @param[out] keys Bin indices.
+		 */
+		void getKeys(std::vector<uint32_t> &keys) const;
+		/** Get number of non-empty bins. */
+		size_t getColorCount() const;
+		uint64_t getPixelCount() const;
+		bool empty() const;
+	private:
+		std::vector<Bin> m_bins;
+		uint64_t m_pixels;
+};
+
+#endif /* GPICK_COLOR_HISTOGRAM_H_ */
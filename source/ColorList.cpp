@@ -18,6 +18,7 @@
 
 #include "ColorList.h"
 #include "ColorObject.h"
+#include "ColorBuffer.h"
 #include "dynv/DynvSystem.h"
 #include <algorithm>
 using namespace std;
@@ -136,3 +137,33 @@ int color_list_get_positions(ColorList *color_list)
 	}
 	return 0;
 }
+void color_list_get_colors(ColorList *color_list, ColorBuffer &buffer)
+{
+	buffer = ColorBuffer(ColorSpace::rgb, color_list->colors.size());
+	float *red = buffer.plane(0), *green = buffer.plane(1), *blue = buffer.plane(2);
+	size_t index = 0;
+	for (auto color_object: color_list->colors){
+		const Color &color = color_object->getColor();
+		red[index] = color.rgb.red;
+		green[index] = color.rgb.green;
+		blue[index] = color.rgb.blue;
+		index++;
+	}
+}
+int color_list_add_colors(ColorList *color_list, const ColorBuffer &buffer, int add_to_palette)
+{
+	if (buffer.colorSpace() != ColorSpace::rgb){
+		ColorBuffer rgb_buffer(buffer);
+		rgb_buffer.convert(ColorSpace::rgb);
+		return color_list_add_colors(color_list, rgb_buffer, add_to_palette);
+	}
+	const float *red = buffer.plane(0), *green = buffer.plane(1), *blue = buffer.plane(2);
+	Color color;
+	for (size_t i = 0; i < buffer.size(); i++){
+		color_set(&color, red[i], green[i], blue[i]);
+		ColorObject *color_object = color_list_new_color_object(color_list, &color);
+		color_list_add_color_object(color_list, color_object, add_to_palette);
+		color_object->release();
+	}
+	return 0;
+}
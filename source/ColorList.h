@@ -20,6 +20,7 @@
 #define GPICK_COLOR_LIST_H_
 
 class ColorObject;
+class ColorBuffer;
 struct dynvSystem;
 #include "Color.h"
 #include <list>
@@ -51,5 +52,7 @@ int color_list_remove_selected(ColorList *color_list);
 int color_list_remove_all(ColorList *color_list);
 size_t color_list_get_count(ColorList *color_list);
 int color_list_get_positions(ColorList *color_list);
+void color_list_get_colors(ColorList *color_list, ColorBuffer &buffer);
+int color_list_add_colors(ColorList *color_list, const ColorBuffer &buffer, int add_to_palette);
 
 #endif /* GPICK_COLOR_LIST_H_ */
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "ColorLut.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+using namespace std;
+
+ColorLut::ColorLut():
+	m_size(0)
+{
+}
+void ColorLut::build(size_t size, const Function &function)
+{
+	m_size = std::max<size_t>(size, 2);
+	m_table.resize(m_size * m_size * m_size * 3);
+	float scale = 1.0f / (m_size - 1);
+	parallel_for(m_size, 1, [&](size_t begin, size_t end){
+		for (size_t r = begin; r < end; r++){
+			float *value = &m_table[r * m_size * m_size * 3];
+			for (size_t g = 0; g < m_size; g++){
+				for (size_t b = 0; b < m_size; b++, value += 3){
+					Color input, output;
+					color_set(&input, r * scale, g * scale, b * scale);
+					function(input, output);
+					value[0] = output.rgb.red;
+					value[1] = output.rgb.green;
+					value[2] = output.rgb.blue;
+				}
+			}
+		}
+	});
+}
+void ColorLut::apply(const Color &input, Color &output) const
+{
+	const float max_index = float(m_size - 1);
+	float position[3];
+	size_t index[3];
+	for (int i = 0; i < 3; i++){
+		// NaN fails the comparison and is clamped to zero, so index is always valid
+		float value = (input.ma[i] > 0 ? std::min(input.ma[i], 1.0f) : 0.0f) * max_index;
+		index[i] = std::min(size_t(value), m_size - 2);
+		position[i] = value - index[i];
+	}
+	const size_t stride_b = 3, stride_g = m_size * 3, stride_r = m_size * m_size * 3;
+	const float *c000 = &m_table[index[0] * stride_r + index[1] * stride_g + index[2] * stride_b];
+	const float *c111 = c000 + stride_r + stride_g + stride_b;
+	float fr = position[0], fg = position[1], fb = position[2];
+	// Unit cube is split into six tetrahedra along the diagonal from c000 to c111, each color is interpolated inside one of them
+	const float *first, *second;
+	float w0, w1, w2;
+	if (fr >= fg){
+		if (fg >= fb){
+			first = c000 + stride_r;
+			second = first + stride_g;
+			w0 = fr; w1 = fg; w2 = fb;
+		}else if (fr >= fb){
+			first = c000 + stride_r;
+			second = first + stride_b;
+			w0 = fr; w1 = fb; w2 = fg;
+		}else{
+			first = c000 + stride_b;
+			second = first + stride_r;
+			w0 = fb; w1 = fr; w2 = fg;
+		}
+	}else{
+		if (fb >= fg){
+			first = c000 + stride_b;
+			second = first + stride_g;
+			w0 = fb; w1 = fg; w2 = fr;
+		}else if (fb >= fr){
+			first = c000 + stride_g;
+			second = first + stride_b;
+			w0 = fg; w1 = fb; w2 = fr;
+		}else{
+			first = c000 + stride_g;
+			second = first + stride_r;
+			w0 = fg; w1 = fr; w2 = fb;
+		}
+	}
+	for (int i = 0; i < 3; i++)
+		output.ma[i] = c000[i] + w0 * (first[i] - c000[i]) + w1 * (second[i] - first[i]) + w2 * (c111[i] - second[i]);
+	output.ma[3] = input.ma[3];
+}
+float ColorLut::getError(const Function &function, size_t samples) const
+{
+	// Interpolation error is largest near cell centers, so one center point is checked in each of the selected cells. First and last cells are always selected
+	const size_t cells = m_size - 1;
+	samples = std::min(std::max<size_t>(samples, 2), cells);
+	vector<float> positions(samples);
+	for (size_t i = 0; i < samples; i++)
+		positions[i] = (size_t(i * (cells - 1) / double(samples - 1) + 0.5) + 0.5f) / cells;
+	mutex lock;
+	float max_error = 0;
+	parallel_for(samples, 1, [&](size_t begin, size_t end){
+		float error = 0;
+		for (size_t r = begin; r < end; r++){
+			for (size_t g = 0; g < samples; g++){
+				for (size_t b = 0; b < samples; b++){
+					Color input, exact, interpolated;
+					color_set(&input, positions[r], positions[g], positions[b]);
+					function(input, exact);
+					apply(input, interpolated);
+					for (int i = 0; i < 3; i++)
+						error = std::max(error, std::abs(exact.ma[i] - interpolated.ma[i]));
+				}
+			}
+		}
+		lock_guard<mutex> guard(lock);
+		max_error = std::max(max_error, error);
+	});
+	return max_error;
+}
+size_t ColorLut::getSize() const
+{
+	return m_size;
+}
+bool ColorLut::empty() const
+{
+	return m_size == 0;
+}
+void ColorLut::clear()
+{
+	m_size = 0;
+	m_table.clear();
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef GPICK_COLOR_LUT_H_
+#define GPICK_COLOR_LUT_H_
+
+#include "Color.h"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/** \file source/ColorLut.h
+ * \brief 3D lookup table for RGB to RGB color functions.
+ */
+
+/** \class ColorLut
+ * \brief RGB to RGB function sampled on a regular grid over the unit cube.
+ *
+ * Values between grid nodes are found with tetrahedral interpolation, which is exact on the gray axis and needs only four table values for each color.
+ */
+class ColorLut
+{
+	public:
+		typedef std::function<void(const Color &input, Color &output)> Function;
+		ColorLut();
+		/**
+		 * Sample function at all grid nodes. Nodes are sampled in multiple threads, so function must be safe to call concurrently.
+		 * @param[in] size Number of nodes for each axis, at least 2.
+		 * @param[in] function RGB to RGB color function.
+		 */
+		void build(size_t size, const Function &function);
+		/**
+		 * Find function value by interpolating table values.
+		 * @param[in] input Color in RGB color space. Values are clamped to [0, 1] range, NaN is treated as 0.
+		 * @param[out] output Color in RGB color space.
+		 */
+		void apply(const Color &input, Color &output) const;
+		/**
+		 * Compare interpolated values with exact function values at centers of grid cells.
+		 * @param[in] function RGB to RGB color function which was used to build the table.
+		 * @param[in] samples Number of checked cells for each axis. Cells are spread evenly and always include first and last cell.
+		 * @return Largest absolute difference of a single component.
+		 */
+		float getError(const Function &function, size_t samples) const;
+		size_t getSize() const;
+		bool empty() const;
+		void clear();
+	private:
+		size_t m_size;
+		std::vector<float> m_table;
+};
+
+#endif /* GPICK_COLOR_LUT_H_ */
@@ -43,6 +43,7 @@
 #include "Internationalisation.h"
 #include "color_names/ColorNames.h"
 #include "ScreenReader.h"
+#include "RefreshScheduler.h"
 #include "Sampler.h"
 #include <gdk/gdkkeysyms.h>
 #include <math.h>
@@ -53,6 +54,7 @@
 #include <sstream>
 #include <iostream>
 #include <iomanip>
+#include <memory>
 #include <cmath>
 using namespace std;
 using namespace math;
@@ -84,7 +86,10 @@ typedef struct ColorPickerArgs{
 	GtkWidget *contrastCheck;
 	GtkWidget *contrastCheckMsg;
 	GtkWidget *pick_button;
-	guint timeout_source_id;
+	std::unique_ptr<RefreshScheduler> refresh_scheduler;
+	Vec2<int> last_pointer;
+	Color last_color;
+	bool last_sample_valid;
 	FloatingPicker floating_picker;
 	struct dynvSystem *params;
 	struct dynvSystem *global_params;
@@ -113,46 +118,57 @@ static void updateMainColorNow(ColorPickerArgs* args)
 	}
 }
 
-static gboolean updateMainColor( gpointer data ){
-	ColorPickerArgs* args=(ColorPickerArgs*)data;
-	GdkScreen *screen;
-	GdkModifierType state;
-	int x, y;
-	gdk_display_get_pointer(gdk_display_get_default(), &screen, &x, &y, &state);
-	int monitor = gdk_screen_get_monitor_at_point(screen, x, y);
-	GdkRectangle monitor_geometry;
-	gdk_screen_get_monitor_geometry(screen, monitor, &monitor_geometry);
-	Vec2<int> pointer(x,y);
-	Rect2<int> screen_rect(monitor_geometry.x, monitor_geometry.y, monitor_geometry.x + monitor_geometry.width, monitor_geometry.y + monitor_geometry.height);
+/** Sample color under the pointer and update widgets. Returns true if pointer has moved or sampled color has changed. */
+static bool updateMainColorSample(ColorPickerArgs* args)
+{
 	auto screen_reader = args->gs->getScreenReader();
+	Vec2<int> pointer;
+	Rect2<int> screen_rect;
+	if (!screen_reader_get_pointer(screen_reader, pointer, screen_rect)) return false;
 	screen_reader_reset_rect(screen_reader);
 	Rect2<int> sampler_rect, zoomed_rect, final_rect;
 	sampler_get_screen_rect(args->gs->getSampler(), pointer, screen_rect, &sampler_rect);
-	screen_reader_add_rect(screen_reader, screen, sampler_rect);
+	screen_reader_add_rect(screen_reader, sampler_rect);
 	bool zoomed_enabled = dynv_get_bool_wd(args->params, "zoomed_enabled", true);
 	if (zoomed_enabled){
 		gtk_zoomed_get_screen_rect(GTK_ZOOMED(args->zoomed_display), pointer, screen_rect, &zoomed_rect);
-		screen_reader_add_rect(screen_reader, screen, zoomed_rect);
+		screen_reader_add_rect(screen_reader, zoomed_rect);
 	}
-	screen_reader_update_surface(screen_reader, &final_rect);
+	bool surface_changed = screen_reader_update_surface(screen_reader, &final_rect);
 	Vec2<int> offset;
 	offset = Vec2<int>(sampler_rect.getX() - final_rect.getX(), sampler_rect.getY() - final_rect.getY());
 	Color c;
 	sampler_get_color_sample(args->gs->getSampler(), pointer, screen_rect, offset, &c);
-	string text;
-	converter_get_text(c, ConverterArrayType::display, args->gs, text);
-	gtk_color_set_color(GTK_COLOR(args->color_code), &c, text.c_str());
-	gtk_swatch_set_main_color(GTK_SWATCH(args->swatch_display), &c);
-	if (zoomed_enabled){
+	bool color_changed = !args->last_sample_valid || !color_equal(&c, &args->last_color);
+	bool pointer_moved = !args->last_sample_valid || args->last_pointer != pointer;
+	if (color_changed){
+		string text;
+		converter_get_text(c, ConverterArrayType::display, args->gs, text);
+		gtk_color_set_color(GTK_COLOR(args->color_code), &c, text.c_str());
+		gtk_swatch_set_main_color(GTK_SWATCH(args->swatch_display), &c);
+	}
+	if (zoomed_enabled && (surface_changed || gtk_zoomed_is_update_needed(GTK_ZOOMED(args->zoomed_display), pointer, screen_rect))){
 		offset = Vec2<int>(zoomed_rect.getX()-final_rect.getX(), zoomed_rect.getY()-final_rect.getY());
 		gtk_zoomed_update(GTK_ZOOMED(args->zoomed_display), pointer, screen_rect, offset, screen_reader_get_surface(screen_reader));
 	}
-	return TRUE;
+	args->last_pointer = pointer;
+	args->last_color = c;
+	args->last_sample_valid = true;
+	return pointer_moved || color_changed;
 }
-static gboolean updateMainColorTimer(ColorPickerArgs* args)
+static void updateMainColor(ColorPickerArgs* args)
 {
-	updateMainColor(args);
-	return true;
+	screen_reader_invalidate(args->gs->getScreenReader());
+	args->last_sample_valid = false;
+	updateMainColorSample(args);
+}
+static void startRefresh(ColorPickerArgs* args)
+{
+	float refresh_rate = dynv_get_float_wd(args->global_params, "refresh_rate", 30);
+	float idle_refresh_rate = dynv_get_float_wd(args->global_params, "idle_refresh_rate", 5);
+	args->refresh_scheduler->setRates(refresh_rate, idle_refresh_rate);
+	args->last_sample_valid = false;
+	args->refresh_scheduler->start();
 }
 static void updateComponentText(ColorPickerArgs *args, GtkColorComponent *component, const char *type)
 {
@@ -496,6 +512,7 @@ static void on_oversample_value_changed(GtkRange *slider, gpointer data){
 static void on_zoom_value_changed(GtkRange *slider, gpointer data){
 	ColorPickerArgs* args=(ColorPickerArgs*)data;
 	gtk_zoomed_set_zoom(GTK_ZOOMED(args->zoomed_display), gtk_range_get_value(GTK_RANGE(slider)));
+	args->refresh_scheduler->wake();
 }
 
 static void color_component_change_value(GtkWidget *widget, Color* c, ColorPickerArgs* args){
@@ -784,10 +801,7 @@ static int source_set_color(ColorPickerArgs *args, ColorObject* color_object)
 }
 static int source_activate(ColorPickerArgs *args)
 {
-	if (args->timeout_source_id > 0) {
-		g_source_remove(args->timeout_source_id);
-		args->timeout_source_id = 0;
-	}
+	args->refresh_scheduler->stop();
 	struct{
 		GtkWidget *widget;
 		const char *setting;
@@ -825,8 +839,7 @@ static int source_activate(ColorPickerArgs *args)
 	gtk_color_set_transformation_chain(GTK_COLOR(args->contrastCheck), chain);
 
 	if (dynv_get_bool_wd(args->params, "zoomed_enabled", true)){
-		float refresh_rate = dynv_get_float_wd(args->global_params, "refresh_rate", 30);
-		args->timeout_source_id = g_timeout_add_full(G_PRIORITY_DEFAULT_IDLE, 1000/refresh_rate, (GSourceFunc)updateMainColorTimer, args, (GDestroyNotify)nullptr);
+		startRefresh(args);
 	}
 
 	gtk_zoomed_set_size(GTK_ZOOMED(args->zoomed_display), dynv_get_int32_wd(args->params, "zoom_size", 150));
@@ -840,10 +853,7 @@ static int source_deactivate(ColorPickerArgs *args){
 
 	gtk_statusbar_pop(GTK_STATUSBAR(args->statusbar), gtk_statusbar_get_context_id(GTK_STATUSBAR(args->statusbar), "focus_swatch"));
 
-	if (args->timeout_source_id > 0){
-		g_source_remove(args->timeout_source_id);
-		args->timeout_source_id = 0;
-	}
+	args->refresh_scheduler->stop();
 	return 0;
 }
 
@@ -899,20 +909,13 @@ static void on_zoomed_activate(GtkWidget *widget, ColorPickerArgs *args){
 		gtk_zoomed_set_fade(GTK_ZOOMED(args->zoomed_display), true);
 		dynv_set_bool(args->params, "zoomed_enabled", false);
 
-		if (args->timeout_source_id > 0){
-			g_source_remove(args->timeout_source_id);
-			args->timeout_source_id = 0;
-		}
+		args->refresh_scheduler->stop();
 	}else{
 		gtk_zoomed_set_fade(GTK_ZOOMED(args->zoomed_display), false);
 		dynv_set_bool(args->params, "zoomed_enabled", true);
 
-		if (args->timeout_source_id > 0){
-			g_source_remove(args->timeout_source_id);
-			args->timeout_source_id = 0;
-		}
-		float refresh_rate = dynv_get_float_wd(args->global_params, "refresh_rate", 30);
-		args->timeout_source_id = g_timeout_add_full(G_PRIORITY_DEFAULT_IDLE, 1000/refresh_rate, (GSourceFunc)updateMainColorTimer, args, (GDestroyNotify)nullptr);
+		args->refresh_scheduler->stop();
+		startRefresh(args);
 	}
 	return;
 }
@@ -935,7 +938,10 @@ static ColorSource* source_implement(ColorSource *source, GlobalState *gs, struc
 	args->source.deactivate = (int (*)(ColorSource *source))source_deactivate;
 
 	args->gs = gs;
-	args->timeout_source_id = 0;
+	args->refresh_scheduler = unique_ptr<RefreshScheduler>(new RefreshScheduler([args](){
+		return updateMainColorSample(args);
+	}));
+	args->last_sample_valid = false;
 
 	GtkWidget *vbox, *widget, *expander, *table, *main_hbox, *scrolled;
 	int table_y;
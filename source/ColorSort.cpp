@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ColorSort.h"
+#include "Internationalisation.h"
+#include <string.h>
+
+static double sort_rgb_red(const Color *color)
+{
+	return color->rgb.red;
+}
+static double sort_rgb_green(const Color *color)
+{
+	return color->rgb.green;
+}
+static double sort_rgb_blue(const Color *color)
+{
+	return color->rgb.blue;
+}
+static double sort_rgb_grayscale(const Color *color)
+{
+	return (color->rgb.red + color->rgb.green + color->rgb.blue) / 3.0;
+}
+static double sort_hsl_hue(const Color *color)
+{
+	Color hsl;
+	color_rgb_to_hsl(color, &hsl);
+	return hsl.hsl.hue;
+}
+static double sort_hsl_saturation(const Color *color)
+{
+	Color hsl;
+	color_rgb_to_hsl(color, &hsl);
+	return hsl.hsl.saturation;
+}
+static double sort_hsl_lightness(const Color *color)
+{
+	Color hsl;
+	color_rgb_to_hsl(color, &hsl);
+	return hsl.hsl.lightness;
+}
+static double sort_lab_lightness(const Color *color)
+{
+	Color lab;
+	color_rgb_to_lab_d50(color, &lab);
+	return lab.lab.L;
+}
+static double sort_lab_a(const Color *color)
+{
+	Color lab;
+	color_rgb_to_lab_d50(color, &lab);
+	return lab.lab.a;
+}
+static double sort_lab_b(const Color *color)
+{
+	Color lab;
+	color_rgb_to_lab_d50(color, &lab);
+	return lab.lab.b;
+}
+static double sort_lch_lightness(const Color *color)
+{
+	Color lch;
+	color_rgb_to_lch_d50(color, &lch);
+	return lch.lch.L;
+}
+static double sort_lch_chroma(const Color *color)
+{
+	Color lch;
+	color_rgb_to_lch_d50(color, &lch);
+	return lch.lch.C;
+}
+static double sort_lch_hue(const Color *color)
+{
+	Color lch;
+	color_rgb_to_lch_d50(color, &lch);
+	return lch.lch.h;
+}
+static const ColorSortType sort_types[] = {
+	{"rgb_red", N_("RGB Red"), sort_rgb_red},
+	{"rgb_green", N_("RGB Green"), sort_rgb_green},
+	{"rgb_blue", N_("RGB Blue"), sort_rgb_blue},
+	{"rgb_grayscale", N_("RGB Grayscale"), sort_rgb_grayscale},
+	{"hsl_hue", N_("HSL Hue"), sort_hsl_hue},
+	{"hsl_saturation", N_("HSL Saturation"), sort_hsl_saturation},
+	{"hsl_lightness", N_("HSL Lightness"), sort_hsl_lightness},
+	{"lab_lightness", N_("Lab Lightness"), sort_lab_lightness},
+	{"lab_a", N_("Lab A"), sort_lab_a},
+	{"lab_b", N_("Lab B"), sort_lab_b},
+	{"lch_lightness", N_("LCh Lightness"), sort_lch_lightness},
+	{"lch_chroma", N_("LCh Chroma"), sort_lch_chroma},
+	{"lch_hue", N_("LCh Hue"), sort_lch_hue},
+};
+const ColorSortType *color_sort_get_types(size_t &count)
+{
+	count = sizeof(sort_types) / sizeof(ColorSortType);
+	return sort_types;
+}
+const ColorSortType *color_sort_get_type(const char *name)
+{
+	for (auto &type: sort_types){
+		if (strcmp(type.name, name) == 0)
+			return &type;
+	}
+	return nullptr;
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GPICK_COLOR_SORT_H_
+#define GPICK_COLOR_SORT_H_
+
+#include "Color.h"
+#include <cstddef>
+
+/** \file source/ColorSort.h
+ * \brief Color sort keys shared by sort dialog and command line batch mode.
+ */
+
+/** \struct ColorSortType
+ * \brief Named color sort key.
+ */
+struct ColorSortType
+{
+	const char *name; /**< System name */
+	const char *human_name; /**< Human readable name, marked for translation */
+	double (*get_value)(const Color *color); /**< Get sort key of a color in RGB color space */
+};
+
+/**
+ * Get all sort types.
+ * @param[out] count Number of sort types.
+ * @return First sort type.
+ */
+const ColorSortType *color_sort_get_types(size_t &count);
+
+/**
+ * Find sort type by system name.
+ * @param[in] name Sort type system name.
+ * @return Sort type or null pointer if name is unknown.
+ */
+const ColorSortType *color_sort_get_type(const char *name);
+
+#endif /* GPICK_COLOR_SORT_H_ */
@@ -482,6 +482,52 @@ bool converter_get_color_object(const char *text, GlobalState* gs, ColorObject**
 		return true;
 	}
 }
+bool converter_get_texts(const std::vector<Color> &colors, Converter *converter, std::vector<std::string> &texts)
+{
+	texts.clear();
+	if (converter == nullptr || !converter->serialize_available) return false;
+	texts.resize(colors.size());
+	ColorObject color_object;
+	ConverterSerializePosition position;
+	for (size_t i = 0; i < colors.size(); i++){
+		color_object.setColor(colors[i]);
+		if (converters_color_serialize(converter, &color_object, position, texts[i]) != 0){
+			texts.clear();
+			return false;
+		}
+	}
+	return true;
+}
+void converter_get_colors(const std::vector<std::string> &texts, GlobalState* gs, std::vector<Color> &colors, std::vector<bool> &valid)
+{
+	auto converters = gs->getConverters();
+	vector<Converter*> deserializers;
+	Converter *converter = converters_get_first(converters, ConverterArrayType::display);
+	if (converter && converter->deserialize_available)
+		deserializers.push_back(converter);
+	size_t table_size;
+	Converter **converter_table;
+	if ((converter_table = converters_get_all_type(converters, ConverterArrayType::paste, &table_size))){
+		for (size_t i = 0; i != table_size; ++i){
+			if (converter_table[i]->deserialize_available)
+				deserializers.push_back(converter_table[i]);
+		}
+	}
+	colors.assign(texts.size(), Color());
+	valid.assign(texts.size(), false);
+	ColorObject color_object;
+	for (size_t i = 0; i < texts.size(); i++){
+		float best_quality = 0;
+		for (auto deserializer: deserializers){
+			float quality;
+			if (converters_color_deserialize(deserializer, texts[i].c_str(), &color_object, &quality) == 0 && quality > best_quality){
+				best_quality = quality;
+				colors[i] = color_object.getColor();
+				valid[i] = true;
+			}
+		}
+	}
+}
 
 ConverterSerializePosition::ConverterSerializePosition():
 	first(true),
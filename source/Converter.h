@@ -26,6 +26,7 @@ class ColorObject;
 class GlobalState;
 struct Color;
 #include <string>
+#include <vector>
 #ifndef _MSC_VER
 #include <stdbool.h>
 #endif
@@ -79,5 +80,21 @@ bool converter_get_text(const ColorObject *color_object, ConverterArrayType type
 bool converter_get_text(const ColorObject *color_object, Converter *converter, GlobalState *gs, std::string &text);
 
 bool converter_get_color_object(const char *text, GlobalState* gs, ColorObject** output_color_object);
+/**
+ * Serialize multiple colors with the same converter.
+ * @param[in] colors Colors to serialize.
+ * @param[in] converter Converter used for all colors.
+ * @param[out] texts Serialized colors, one for each input color.
+ * @return False if converter is not set, can not serialize colors or serialization of any color fails. Texts are empty on failure.
+ */
+bool converter_get_texts(const std::vector<Color> &colors, Converter *converter, std::vector<std::string> &texts);
+/**
+ * Deserialize multiple texts. Display and paste converters are looked up once and the result with the highest quality is kept for each text, same as in converter_get_color_object.
+ * @param[in] texts Texts to deserialize.
+ * @param[in] gs Global state.
+ * @param[out] colors Deserialized colors, one for each input text.
+ * @param[out] valid Set for texts which were recognized by at least one converter.
+ */
+void converter_get_colors(const std::vector<std::string> &texts, GlobalState* gs, std::vector<Color> &colors, std::vector<bool> &valid);
 
 #endif /* GPICK_CONVERTER_H_ */
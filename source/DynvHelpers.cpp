@@ -17,37 +17,54 @@
  */
 
 #include "DynvHelpers.h"
-
-int32_t dynv_get_int32_wd(struct dynvSystem* dynv_system, const char *path, int32_t default_value){
+#include "dynv/DynvVarString.h"
+#include "dynv/DynvVarInt32.h"
+#include "dynv/DynvVarColor.h"
+#include "dynv/DynvVarPtr.h"
+#include "dynv/DynvVarFloat.h"
+#include "dynv/DynvVarDynv.h"
+#include "dynv/DynvVarBool.h"
+
+/** Get variable value. Path is either dynvPath or const char*, which is split without allocating atoms for missing variables. */
+template<typename T, typename Path>
+static T get_value(struct dynvSystem* dynv_system, const char* handler_name, const Path& path, T default_value){
 	int error;
-	void* r = dynv_get(dynv_system, "int32", path, &error);
+	void* r = dynv_get(dynv_system, handler_name, path, &error);
 	if (error){
 		return default_value;
-	}else return *(int32_t*)r;
+	}else return *(T*)r;
+}
+
+int32_t dynv_get_int32_wd(struct dynvSystem* dynv_system, const dynvPath& path, int32_t default_value){
+	return get_value(dynv_system, "int32", path, default_value);
+}
+
+int32_t dynv_get_int32_wd(struct dynvSystem* dynv_system, const char *path, int32_t default_value){
+	return get_value(dynv_system, "int32", path, default_value);
+}
+
+float dynv_get_float_wd(struct dynvSystem* dynv_system, const dynvPath& path, float default_value){
+	return get_value(dynv_system, "float", path, default_value);
 }
 
 float dynv_get_float_wd(struct dynvSystem* dynv_system, const char *path, float default_value){
-	int error;
-	void* r = dynv_get(dynv_system, "float", path, &error);
-	if (error){
-		return default_value;
-	}else return *(float*)r;
+	return get_value(dynv_system, "float", path, default_value);
+}
+
+bool dynv_get_bool_wd(struct dynvSystem* dynv_system, const dynvPath& path, bool default_value){
+	return get_value(dynv_system, "bool", path, default_value);
 }
 
 bool dynv_get_bool_wd(struct dynvSystem* dynv_system, const char *path, bool default_value){
-	int error;
-	void* r = dynv_get(dynv_system, "bool", path, &error);
-	if (error){
-		return default_value;
-	}else return *(bool*)r;
+	return get_value(dynv_system, "bool", path, default_value);
+}
+
+const char* dynv_get_string_wd(struct dynvSystem* dynv_system, const dynvPath& path, const char* default_value){
+	return get_value(dynv_system, "string", path, default_value);
 }
 
 const char* dynv_get_string_wd(struct dynvSystem* dynv_system, const char *path, const char* default_value){
-	int error;
-	void* r = dynv_get(dynv_system, "string", path, &error);
-	if (error){
-		return default_value;
-	}else return *(const char**)r;
+	return get_value(dynv_system, "string", path, default_value);
 }
 
 const Color* dynv_get_color_wd(struct dynvSystem* dynv_system, const char *path, const Color* default_value){
@@ -66,18 +83,34 @@ Color* dynv_get_color_wdc(struct dynvSystem* dynv_system, const char *path, Colo
 	}else return *(Color**)r;
 }
 
+void dynv_set_int32(struct dynvSystem* dynv_system, const dynvPath& path, int32_t value){
+	dynv_set(dynv_system, "int32", path, &value);
+}
+
 void dynv_set_int32(struct dynvSystem* dynv_system, const char *path, int32_t value){
 	dynv_set(dynv_system, "int32", path, &value);
 }
 
+void dynv_set_float(struct dynvSystem* dynv_system, const dynvPath& path, float value){
+	dynv_set(dynv_system, "float", path, &value);
+}
+
 void dynv_set_float(struct dynvSystem* dynv_system, const char *path, float value){
 	dynv_set(dynv_system, "float", path, &value);
 }
 
+void dynv_set_bool(struct dynvSystem* dynv_system, const dynvPath& path, bool value){
+	dynv_set(dynv_system, "bool", path, &value);
+}
+
 void dynv_set_bool(struct dynvSystem* dynv_system, const char *path, bool value){
 	dynv_set(dynv_system, "bool", path, &value);
 }
 
+void dynv_set_string(struct dynvSystem* dynv_system, const dynvPath& path, const char* value){
+	dynv_set(dynv_system, "string", path, &value);
+}
+
 void dynv_set_string(struct dynvSystem* dynv_system, const char *path, const char* value){
 	dynv_set(dynv_system, "string", path, &value);
 }
@@ -176,3 +209,15 @@ void dynv_set_color_array(struct dynvSystem* dynv_system, const char *path, cons
 void dynv_set_dynv_array(struct dynvSystem* dynv_system, const char *path, const struct dynvSystem** values, uint32_t count){
 	dynv_set_array(dynv_system, "dynv", path, (const void**)values, count);
 }
+struct dynvHandlerMap* dynv_create_default_handler_map()
+{
+	struct dynvHandlerMap* handler_map = dynv_handler_map_create();
+	dynv_handler_map_add_handler(handler_map, dynv_var_string_new());
+	dynv_handler_map_add_handler(handler_map, dynv_var_int32_new());
+	dynv_handler_map_add_handler(handler_map, dynv_var_color_new());
+	dynv_handler_map_add_handler(handler_map, dynv_var_ptr_new());
+	dynv_handler_map_add_handler(handler_map, dynv_var_float_new());
+	dynv_handler_map_add_handler(handler_map, dynv_var_dynv_new());
+	dynv_handler_map_add_handler(handler_map, dynv_var_bool_new());
+	return handler_map;
+}
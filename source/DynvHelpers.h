@@ -34,12 +34,22 @@ const char* dynv_get_string_wd(struct dynvSystem* dynv_system, const char *path,
 const Color* dynv_get_color_wd(struct dynvSystem* dynv_system, const char *path, const Color* default_value);
 Color* dynv_get_color_wdc(struct dynvSystem* dynv_system, const char *path, Color* default_value);
 
+int32_t dynv_get_int32_wd(struct dynvSystem* dynv_system, const dynvPath& path, int32_t default_value);
+float dynv_get_float_wd(struct dynvSystem* dynv_system, const dynvPath& path, float default_value);
+bool dynv_get_bool_wd(struct dynvSystem* dynv_system, const dynvPath& path, bool default_value);
+const char* dynv_get_string_wd(struct dynvSystem* dynv_system, const dynvPath& path, const char* default_value);
+
 void dynv_set_int32(struct dynvSystem* dynv_system, const char *path, int32_t value);
 void dynv_set_float(struct dynvSystem* dynv_system, const char *path, float value);
 void dynv_set_bool(struct dynvSystem* dynv_system, const char *path, bool value);
 void dynv_set_string(struct dynvSystem* dynv_system, const char *path, const char* value);
 void dynv_set_color(struct dynvSystem* dynv_system, const char *path, const Color* value);
 
+void dynv_set_int32(struct dynvSystem* dynv_system, const dynvPath& path, int32_t value);
+void dynv_set_float(struct dynvSystem* dynv_system, const dynvPath& path, float value);
+void dynv_set_bool(struct dynvSystem* dynv_system, const dynvPath& path, bool value);
+void dynv_set_string(struct dynvSystem* dynv_system, const dynvPath& path, const char* value);
+
 struct dynvSystem* dynv_get_dynv(struct dynvSystem* dynv_system, const char *path);
 
 int32_t* dynv_get_int32_array_wd(struct dynvSystem* dynv_system, const char *path, int32_t *default_value, uint32_t default_count, uint32_t *count);
@@ -56,4 +66,6 @@ void dynv_set_string_array(struct dynvSystem* dynv_system, const char *path, con
 void dynv_set_color_array(struct dynvSystem* dynv_system, const char *path, const Color** values, uint32_t count);
 void dynv_set_dynv_array(struct dynvSystem* dynv_system, const char *path, const struct dynvSystem** values, uint32_t count);
 
+struct dynvHandlerMap* dynv_create_default_handler_map();
+
 #endif /* DYNVHELPERS_H_ */
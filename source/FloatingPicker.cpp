@@ -30,20 +30,32 @@
 #include "DynvHelpers.h"
 #include "ToolColorNaming.h"
 #include "ScreenReader.h"
+#include "RefreshScheduler.h"
 #include "Sampler.h"
 #include "color_names/ColorNames.h"
 #include <gdk/gdkkeysyms.h>
 #include <string>
 #include <sstream>
+#include <memory>
 using namespace math;
 using namespace std;
 
+// Paths are resolved once, so that picker event handlers do not parse settings paths
+static const dynvPath zoom_path("gpick.picker.zoom");
+static const dynvPath refresh_rate_path("gpick.picker.refresh_rate");
+static const dynvPath idle_refresh_rate_path("gpick.picker.idle_refresh_rate");
+static const dynvPath copy_on_release_path("gpick.picker.sampler.copy_on_release");
+static const dynvPath add_on_release_path("gpick.picker.sampler.add_on_release");
+
 typedef struct FloatingPickerArgs
 {
 	GtkWidget* window;
 	GtkWidget* zoomed;
 	GtkWidget* color_widget;
-	guint timeout_source_id;
+	std::unique_ptr<RefreshScheduler> refresh_scheduler;
+	Vec2<int> last_pointer;
+	Color last_color;
+	bool last_sample_valid;
 	ColorSource *color_source;
 	Converter *converter;
 	GlobalState* gs;
@@ -78,40 +90,42 @@ class PickerColorNameAssigner: public ToolColorNameAssigner
 };
 static void get_color_sample(FloatingPickerArgs *args, bool update_widgets, Color* c)
 {
-	GdkScreen *screen;
-	GdkModifierType state;
-	int x, y;
-	gdk_display_get_pointer(gdk_display_get_default(), &screen, &x, &y, &state);
-	int monitor = gdk_screen_get_monitor_at_point(screen, x, y);
-	GdkRectangle monitor_geometry;
-	gdk_screen_get_monitor_geometry(screen, monitor, &monitor_geometry);
-	Vec2<int> pointer(x,y);
-	Rect2<int> screen_rect(monitor_geometry.x, monitor_geometry.y, monitor_geometry.x + monitor_geometry.width, monitor_geometry.y + monitor_geometry.height);
 	auto screen_reader = args->gs->getScreenReader();
+	Vec2<int> pointer;
+	Rect2<int> screen_rect;
+	if (!screen_reader_get_pointer(screen_reader, pointer, screen_rect)){
+		color_zero(c);
+		return;
+	}
+	if (!update_widgets)
+		screen_reader_invalidate(screen_reader);
 	screen_reader_reset_rect(screen_reader);
 	Rect2<int> sampler_rect, zoomed_rect, final_rect;
 	sampler_get_screen_rect(args->gs->getSampler(), pointer, screen_rect, &sampler_rect);
-	screen_reader_add_rect(screen_reader, screen, sampler_rect);
+	screen_reader_add_rect(screen_reader, sampler_rect);
 	if (update_widgets){
 		gtk_zoomed_get_screen_rect(GTK_ZOOMED(args->zoomed), pointer, screen_rect, &zoomed_rect);
-		screen_reader_add_rect(screen_reader, screen, zoomed_rect);
+		screen_reader_add_rect(screen_reader, zoomed_rect);
 	}
-	screen_reader_update_surface(screen_reader, &final_rect);
+	bool surface_changed = screen_reader_update_surface(screen_reader, &final_rect);
 	Vec2<int> offset;
 	offset = Vec2<int>(sampler_rect.getX() - final_rect.getX(), sampler_rect.getY() - final_rect.getY());
 	sampler_get_color_sample(args->gs->getSampler(), pointer, screen_rect, offset, c);
-	if (update_widgets){
+	if (update_widgets && (surface_changed || gtk_zoomed_is_update_needed(GTK_ZOOMED(args->zoomed), pointer, screen_rect))){
 		offset = Vec2<int>(zoomed_rect.getX() - final_rect.getX(), zoomed_rect.getY() - final_rect.getY());
 		gtk_zoomed_update(GTK_ZOOMED(args->zoomed), pointer, screen_rect, offset, screen_reader_get_surface(screen_reader));
 	}
 }
-static gboolean update_display(FloatingPickerArgs *args)
+/** Move picker window next to the pointer, sample color and update widgets. Returns true if pointer has moved or sampled color has changed. */
+static bool update_display(FloatingPickerArgs *args)
 {
 	GdkScreen *screen;
 	GdkModifierType state;
 	int x, y;
 	int width, height;
 	gdk_display_get_pointer(gdk_display_get_default(), &screen, &x, &y, &state);
+	Vec2<int> pointer(x, y);
+	bool pointer_moved = !args->last_sample_valid || args->last_pointer != pointer;
 	width = gdk_screen_get_width(screen);
 	height = gdk_screen_get_height(screen);
 	gint sx, sy;
@@ -129,19 +143,26 @@ static gboolean update_display(FloatingPickerArgs *args)
 	if (gtk_window_get_screen(GTK_WINDOW(args->window)) != screen){
 		gtk_window_set_screen(GTK_WINDOW(args->window), screen);
 	}
-	gtk_window_move(GTK_WINDOW(args->window), x, y);
+	if (pointer_moved)
+		gtk_window_move(GTK_WINDOW(args->window), x, y);
 	Color c;
 	get_color_sample(args, true, &c);
-	string text;
-	if (args->converter != nullptr){
-		auto color_object = color_list_new_color_object(args->gs->getColorList(), &c);
-		converter_get_text(color_object, args->converter, args->gs, text);
-		color_object->release();
-	}else{
-		converter_get_text(c, ConverterArrayType::display, args->gs, text);
+	bool color_changed = !args->last_sample_valid || !color_equal(&c, &args->last_color);
+	if (color_changed){
+		string text;
+		if (args->converter != nullptr){
+			auto color_object = color_list_new_color_object(args->gs->getColorList(), &c);
+			converter_get_text(color_object, args->converter, args->gs, text);
+			color_object->release();
+		}else{
+			converter_get_text(c, ConverterArrayType::display, args->gs, text);
+		}
+		gtk_color_set_color(GTK_COLOR(args->color_widget), &c, text.c_str());
 	}
-	gtk_color_set_color(GTK_COLOR(args->color_widget), &c, text.c_str());
-	return true;
+	args->last_pointer = pointer;
+	args->last_color = c;
+	args->last_sample_valid = true;
+	return pointer_moved || color_changed;
 }
 void floating_picker_activate(FloatingPickerArgs *args, bool hide_on_mouse_release, bool single_pick_mode, const char *converter_name)
 {
@@ -156,13 +177,17 @@ void floating_picker_activate(FloatingPickerArgs *args, bool hide_on_mouse_relea
 	args->click_mode = true;
 	GdkCursor* cursor;
 	cursor = gdk_cursor_new(GDK_TCROSS);
-	gtk_zoomed_set_zoom(GTK_ZOOMED(args->zoomed), dynv_get_float_wd(args->gs->getSettings(), "gpick.picker.zoom", 2));
+	gtk_zoomed_set_zoom(GTK_ZOOMED(args->zoomed), dynv_get_float_wd(args->gs->getSettings(), zoom_path, 2));
+	screen_reader_invalidate(args->gs->getScreenReader());
+	args->last_sample_valid = false;
 	update_display(args);
 	gtk_widget_show(args->window);
 	gdk_pointer_grab(gtk_widget_get_window(args->window), false, GdkEventMask(GDK_POINTER_MOTION_MASK | GDK_BUTTON_RELEASE_MASK | GDK_BUTTON_PRESS_MASK), nullptr, cursor, GDK_CURRENT_TIME);
 	gdk_keyboard_grab(gtk_widget_get_window(args->window), false, GDK_CURRENT_TIME);
-	float refresh_rate = dynv_get_float_wd(args->gs->getSettings(), "gpick.picker.refresh_rate", 30);
-	args->timeout_source_id = g_timeout_add_full(G_PRIORITY_DEFAULT_IDLE, 1000 / refresh_rate, (GSourceFunc)update_display, args, (GDestroyNotify)nullptr);
+	float refresh_rate = dynv_get_float_wd(args->gs->getSettings(), refresh_rate_path, 30);
+	float idle_refresh_rate = dynv_get_float_wd(args->gs->getSettings(), idle_refresh_rate_path, 5);
+	args->refresh_scheduler->setRates(refresh_rate, idle_refresh_rate);
+	args->refresh_scheduler->start();
 #if GTK_MAJOR_VERSION >= 3
 	g_object_unref(cursor);
 #else
@@ -174,10 +199,7 @@ void floating_picker_deactivate(FloatingPickerArgs *args)
 {
 	gdk_pointer_ungrab(GDK_CURRENT_TIME);
 	gdk_keyboard_ungrab(GDK_CURRENT_TIME);
-	if (args->timeout_source_id > 0){
-		g_source_remove(args->timeout_source_id);
-		args->timeout_source_id = 0;
-	}
+	args->refresh_scheduler->stop();
 	gtk_widget_hide(args->window);
 }
 static gboolean scroll_event_cb(GtkWidget *widget, GdkEventScroll *event, FloatingPickerArgs *args)
@@ -189,12 +211,13 @@ static gboolean scroll_event_cb(GtkWidget *widget, GdkEventScroll *event, Floati
 		zoom -= 1;
 	}
 	gtk_zoomed_set_zoom(GTK_ZOOMED(args->zoomed), zoom);
+	args->refresh_scheduler->wake();
 	return TRUE;
 }
 static void finish_picking(FloatingPickerArgs *args)
 {
 	floating_picker_deactivate(args);
-	dynv_set_float(args->gs->getSettings(), "gpick.picker.zoom", gtk_zoomed_get_zoom(GTK_ZOOMED(args->zoomed)));
+	dynv_set_float(args->gs->getSettings(), zoom_path, gtk_zoomed_get_zoom(GTK_ZOOMED(args->zoomed)));
 	if (args->custom_done_action)
 		args->custom_done_action(args);
 }
@@ -212,10 +235,10 @@ static void complete_picking(FloatingPickerArgs *args)
 			if (args->single_pick_mode){
 				Clipboard::set(color_object, args->gs, args->converter);
 			}else{
-				if (dynv_get_bool_wd(args->gs->getSettings(), "gpick.picker.sampler.copy_on_release", false)){
+				if (dynv_get_bool_wd(args->gs->getSettings(), copy_on_release_path, false)){
 					Clipboard::set(color_object, args->gs, args->converter);
 				}
-				if (dynv_get_bool_wd(args->gs->getSettings(), "gpick.picker.sampler.add_on_release", false)){
+				if (dynv_get_bool_wd(args->gs->getSettings(), add_on_release_path, false)){
 					PickerColorNameAssigner name_assigner(args->gs);
 					name_assigner.assign(color_object, &c);
 					color_list_add_color_object(args->gs->getColorList(), color_object, 1);
@@ -250,6 +273,11 @@ static gboolean button_release_cb(GtkWidget *widget, GdkEventButton *event, Floa
 	}
 	return false;
 }
+static gboolean motion_notify_cb(GtkWidget *widget, GdkEventMotion *event, FloatingPickerArgs *args)
+{
+	args->refresh_scheduler->wake();
+	return false;
+}
 static gboolean button_press_cb(GtkWidget *widget, GdkEventButton *event, FloatingPickerArgs *args)
 {
 	if ((event->type == GDK_BUTTON_PRESS) && (event->button == 3)) {
@@ -338,6 +366,10 @@ FloatingPickerArgs* floating_picker_new(GlobalState *gs)
 	args->color_source = nullptr;
 	args->perform_custom_pick_action = false;
 	args->menu_button_pressed = false;
+	args->refresh_scheduler = unique_ptr<RefreshScheduler>(new RefreshScheduler([args](){
+		return update_display(args);
+	}));
+	args->last_sample_valid = false;
 	gtk_window_set_skip_pager_hint(GTK_WINDOW(args->window), true);
 	gtk_window_set_skip_taskbar_hint(GTK_WINDOW(args->window), true);
 	gtk_window_set_decorated(GTK_WINDOW(args->window), false);
@@ -353,6 +385,7 @@ FloatingPickerArgs* floating_picker_new(GlobalState *gs)
 	gtk_box_pack_start(GTK_BOX(vbox), args->color_widget, true, true, 0);
 	g_signal_connect(G_OBJECT(args->window), "scroll_event", G_CALLBACK(scroll_event_cb), args);
 	g_signal_connect(G_OBJECT(args->window), "button-press-event", G_CALLBACK(button_press_cb), args);
+	g_signal_connect(G_OBJECT(args->window), "motion-notify-event", G_CALLBACK(motion_notify_cb), args);
 	g_signal_connect(G_OBJECT(args->window), "button-release-event", G_CALLBACK(button_release_cb), args);
 	g_signal_connect(G_OBJECT(args->window), "key_press_event", G_CALLBACK(key_up_cb), args);
 	g_signal_connect(G_OBJECT(args->window), "destroy", G_CALLBACK(destroy_cb), args);
@@ -25,20 +25,17 @@
 #include "color_names/ColorNames.h"
 #include "Sampler.h"
 #include "ColorList.h"
+#include "ImportExport.h"
+#include "Parallel.h"
 #include "layout/LuaBindings.h"
 #include "layout/Layout.h"
 #include "transformation/Chain.h"
 #include "transformation/Factory.h"
 #include "dynv/DynvMemoryIO.h"
-#include "dynv/DynvVarString.h"
-#include "dynv/DynvVarInt32.h"
-#include "dynv/DynvVarColor.h"
-#include "dynv/DynvVarPtr.h"
-#include "dynv/DynvVarFloat.h"
-#include "dynv/DynvVarDynv.h"
-#include "dynv/DynvVarBool.h"
 #include "dynv/DynvXml.h"
 #include "DynvHelpers.h"
+#include "LuaExt.h"
+#include "StartupTrace.h"
 #include <stdlib.h>
 #include <glib/gstdio.h>
 extern "C"{
@@ -47,6 +44,10 @@ extern "C"{
 }
 #include <fstream>
 #include <iostream>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
 using namespace std;
 
 class GlobalState::Impl
@@ -64,6 +65,14 @@ class GlobalState::Impl
 		transformation::Chain *m_transformation_chain;
 		GtkWidget *m_status_bar;
 		ColorSource *m_color_source;
+		future<dynvSystem*> m_settings_loader;
+		future<lua_State*> m_lua_loader;
+		future<ColorNames*> m_color_names_loader;
+		future<ColorList*> m_palette_loader;
+		string m_palette_filename;
+		once_flag m_lua_once, m_color_names_once, m_converters_once, m_layouts_once, m_transformation_chain_once;
+		/** Worker pool for independent startup loads. Each load is waited for when its result is first used. */
+		TaskGroup m_loader;
 		Impl():
 			m_color_names(nullptr),
 			m_sampler(nullptr),
@@ -76,11 +85,22 @@ class GlobalState::Impl
 			m_layouts(nullptr),
 			m_transformation_chain(nullptr),
 			m_status_bar(nullptr),
-			m_color_source(nullptr)
+			m_color_source(nullptr),
+			m_loader(4)
 		{
 		}
 		~Impl()
 		{
+			if (m_settings_loader.valid())
+				m_settings = m_settings_loader.get();
+			if (m_palette_loader.valid()){
+				ColorList *palette = m_palette_loader.get();
+				if (palette) color_list_destroy(palette);
+			}
+			if (m_lua_loader.valid())
+				m_lua = m_lua_loader.get();
+			if (m_color_names_loader.valid())
+				m_color_names = m_color_names_loader.get();
 			if (m_converters != nullptr)
 				converters_term(m_converters);
 			if (m_layouts != nullptr)
@@ -117,28 +137,85 @@ class GlobalState::Impl
 			g_free(config_file);
 			return true;
 		}
-		bool loadSettings()
+		template<typename T> future<T> load(T (*function)())
 		{
-			if (m_settings != nullptr) return false;
-			struct dynvHandlerMap* handler_map = dynv_handler_map_create();
-			dynv_handler_map_add_handler(handler_map, dynv_var_string_new());
-			dynv_handler_map_add_handler(handler_map, dynv_var_int32_new());
-			dynv_handler_map_add_handler(handler_map, dynv_var_color_new());
-			dynv_handler_map_add_handler(handler_map, dynv_var_ptr_new());
-			dynv_handler_map_add_handler(handler_map, dynv_var_float_new());
-			dynv_handler_map_add_handler(handler_map, dynv_var_dynv_new());
-			dynv_handler_map_add_handler(handler_map, dynv_var_bool_new());
-			m_settings = dynv_system_create(handler_map);
+			auto task = make_shared<packaged_task<T()>>(function);
+			m_loader.run([task]{
+				(*task)();
+			});
+			return task->get_future();
+		}
+		static dynvSystem *readSettings()
+		{
+			StartupTracePhase trace("settings");
+			struct dynvHandlerMap* handler_map = dynv_create_default_handler_map();
+			dynvSystem *settings = dynv_system_create(handler_map);
 			dynv_handler_map_release(handler_map);
 			gchar* config_file = build_config_path("settings.xml");
 			ifstream settings_file(config_file);
-			if (!settings_file.is_open()){
-				g_free(config_file);
-				return false;
+			if (settings_file.is_open()){
+				dynv_xml_deserialize(settings, settings_file);
+				settings_file.close();
 			}
-			dynv_xml_deserialize(m_settings, settings_file);
-			settings_file.close();
 			g_free(config_file);
+			return settings;
+		}
+		void loadSettingsInBackground()
+		{
+			if (m_settings != nullptr || m_settings_loader.valid()) return;
+			m_settings_loader = load(readSettings);
+		}
+		bool loadSettings()
+		{
+			if (m_settings != nullptr) return false;
+			if (m_settings_loader.valid()){
+				StartupTracePhase trace("waiting for settings");
+				m_settings = m_settings_loader.get();
+			}else{
+				m_settings = readSettings();
+			}
+			return true;
+		}
+		static ColorList *readPalette(const string &filename)
+		{
+			StartupTracePhase trace("palette");
+			// Handler maps are not thread safe, so palette is loaded with a separate one
+			struct dynvHandlerMap* handler_map = dynv_create_default_handler_map();
+			ColorList *color_list = color_list_new(handler_map);
+			dynv_handler_map_release(handler_map);
+			ImportExport import_export(color_list, filename.c_str(), nullptr);
+			bool result;
+			switch (ImportExport::getFileType(filename.c_str())){
+				case FileType::gpl:
+					result = import_export.importGPL();
+					break;
+				case FileType::ase:
+					result = import_export.importASE();
+					break;
+				default:
+					result = import_export.importGPA();
+			}
+			if (!result){
+				color_list_destroy(color_list);
+				return nullptr;
+			}
+			return color_list;
+		}
+		void preloadPalette(const char *filename)
+		{
+			if (m_palette_loader.valid()) return;
+			m_palette_filename = filename;
+			auto task = make_shared<packaged_task<ColorList*()>>(bind(readPalette, m_palette_filename));
+			m_loader.run([task]{
+				(*task)();
+			});
+			m_palette_loader = task->get_future();
+		}
+		bool takePreloadedPalette(const char *filename, ColorList *&color_list)
+		{
+			if (!m_palette_loader.valid() || m_palette_filename != filename) return false;
+			StartupTracePhase trace("waiting for palette");
+			color_list = m_palette_loader.get();
 			return true;
 		}
 		bool checkConfigurationDirectory()
@@ -175,22 +252,38 @@ class GlobalState::Impl
 			g_free(user_init_file);
 			return true;
 		}
-		bool loadColorNames()
+		static ColorNames *loadColorNames()
 		{
-			if (m_color_names != nullptr) return false;
-			m_color_names = color_names_new();
+			StartupTracePhase trace("color names");
+			ColorNames *color_names = color_names_new();
 			gchar* tmp;
-			if (color_names_load_from_file(m_color_names, tmp = build_filename("colors.txt")) != 0){
+			gchar* cache = build_config_path("colors.cache");
+			if (color_names_load(color_names, tmp = build_filename("colors.txt"), cache) != 0){
 				g_free(tmp);
-				if (color_names_load_from_file(m_color_names, tmp = build_config_path("colors.txt")) != 0){
+				if (color_names_load(color_names, tmp = build_config_path("colors.txt"), cache) != 0){
 					download_name_file(tmp);
-					color_names_load_from_file(m_color_names, tmp);
+					color_names_load(color_names, tmp, cache);
 				}
 			}
 			g_free(tmp);
-			color_names_load_from_file(m_color_names, tmp = build_filename("colors0.txt"));
+			g_free(cache);
+			cache = build_config_path("colors0.cache");
+			color_names_load(color_names, tmp = build_filename("colors0.txt"), cache);
 			g_free(tmp);
-			return true;
+			g_free(cache);
+			return color_names;
+		}
+		ColorNames *getColorNames()
+		{
+			call_once(m_color_names_once, [this]{
+				if (m_color_names_loader.valid()){
+					StartupTracePhase trace("waiting for color names");
+					m_color_names = m_color_names_loader.get();
+				}else{
+					m_color_names = loadColorNames();
+				}
+			});
+			return m_color_names;
 		}
 		bool initializeRandomGenerator()
 		{
@@ -208,8 +301,10 @@ class GlobalState::Impl
 			dynv_handler_map_release(handler_map);
 			return true;
 		}
-		bool initializeLua()
+		/** Creates Lua state and runs init script. Does not access any other state, so it can run in a background thread. */
+		static lua_State *initializeLua()
 		{
+			StartupTracePhase trace("lua");
 			lua_State *L = luaL_newstate();
 			luaL_openlibs(L);
 			int status;
@@ -233,13 +328,34 @@ class GlobalState::Impl
 				cerr << "init script load failed: " << lua_tostring(L, -1) << endl;
 			}
 			g_free(tmp);
-			m_lua = L;
-			return true;
+			return L;
+		}
+		lua_State *getLua()
+		{
+			call_once(m_lua_once, [this]{
+				if (m_lua_loader.valid()){
+					StartupTracePhase trace("waiting for lua");
+					m_lua = m_lua_loader.get();
+				}else{
+					m_lua = initializeLua();
+				}
+				StartupTracePhase trace("lua options");
+				lua_ext_options_update(m_lua, m_settings);
+			});
+			return m_lua;
 		}
-		bool loadConverters()
+		Converters *getConverters()
 		{
-			if (m_converters != nullptr) return false;
-			Converters *converters = converters_init(m_lua, m_settings);
+			call_once(m_converters_once, [this]{
+				lua_State *lua = getLua();
+				StartupTracePhase trace("converters");
+				m_converters = loadConverters(lua);
+			});
+			return m_converters;
+		}
+		Converters *loadConverters(lua_State *lua)
+		{
+			Converters *converters = converters_init(lua, m_settings);
 			char** source_array;
 			uint32_t source_array_size;
 			if ((source_array = (char**)dynv_get_string_array_wd(m_settings, "gpick.converters.names", 0, 0, &source_array_size))){
@@ -298,18 +414,27 @@ class GlobalState::Impl
 			converters_rebuild_arrays(converters, ConverterArrayType::paste);
 			converters_set(converters, converters_get(converters, dynv_get_string_wd(m_settings, "gpick.converters.display", "color_web_hex")), ConverterArrayType::display);
 			converters_set(converters, converters_get(converters, dynv_get_string_wd(m_settings, "gpick.converters.color_list", "color_web_hex")), ConverterArrayType::color_list);
-			m_converters = converters;
-			return true;
+			return converters;
 		}
-		bool loadLayouts()
+		layout::Layouts *getLayouts()
 		{
-			if (m_layouts != nullptr) return false;
-			m_layouts = layout::layouts_init(m_lua, m_settings);
-			return true;
+			call_once(m_layouts_once, [this]{
+				lua_State *lua = getLua();
+				StartupTracePhase trace("layouts");
+				m_layouts = layout::layouts_init(lua, m_settings);
+			});
+			return m_layouts;
 		}
-		bool loadTransformationChain()
+		transformation::Chain *getTransformationChain()
+		{
+			call_once(m_transformation_chain_once, [this]{
+				StartupTracePhase trace("transformations");
+				m_transformation_chain = loadTransformationChain();
+			});
+			return m_transformation_chain;
+		}
+		transformation::Chain *loadTransformationChain()
 		{
-			if (m_transformation_chain != nullptr) return false;
 			transformation::Chain *chain = new transformation::Chain();
 			chain->setEnabled(dynv_get_bool_wd(m_settings, "gpick.transformations.enabled", false));
 			struct dynvSystem** config_array;
@@ -328,23 +453,20 @@ class GlobalState::Impl
 				}
 				delete [] config_array;
 			}
-			m_transformation_chain = chain;
-			return true;
+			return chain;
 		}
+		/** Starts loading Lua state and color names on the loader pool. Converters, layouts and transformations are loaded on first use, so startup paths which do not need them do not wait for them. */
 		bool loadAll()
 		{
 			checkConfigurationDirectory();
 			checkUserInitFile();
+			m_lua_loader = load(initializeLua);
+			m_color_names_loader = load(loadColorNames);
 			m_screen_reader = screen_reader_new();
 			m_sampler = sampler_new(m_screen_reader);
 			initializeRandomGenerator();
-			loadColorNames();
 			loadSettings();
 			createColorList();
-			initializeLua();
-			loadConverters();
-			loadLayouts();
-			loadTransformationChain();
 			return true;
 		}
 };
@@ -360,6 +482,18 @@ bool GlobalState::loadSettings()
 {
 	return m_impl->loadSettings();
 }
+void GlobalState::loadSettingsInBackground()
+{
+	m_impl->loadSettingsInBackground();
+}
+void GlobalState::preloadPalette(const char *filename)
+{
+	m_impl->preloadPalette(filename);
+}
+bool GlobalState::takePreloadedPalette(const char *filename, ColorList *&color_list)
+{
+	return m_impl->takePreloadedPalette(filename, color_list);
+}
 bool GlobalState::loadAll()
 {
 	return m_impl->loadAll();
@@ -370,7 +504,7 @@ bool GlobalState::writeSettings()
 }
 ColorNames *GlobalState::getColorNames()
 {
-	return m_impl->m_color_names;
+	return m_impl->getColorNames();
 }
 Sampler *GlobalState::getSampler()
 {
@@ -390,7 +524,7 @@ dynvSystem *GlobalState::getSettings()
 }
 lua_State *GlobalState::getLua()
 {
-	return m_impl->m_lua;
+	return m_impl->getLua();
 }
 Random *GlobalState::getRandom()
 {
@@ -398,15 +532,15 @@ Random *GlobalState::getRandom()
 }
 Converters *GlobalState::getConverters()
 {
-	return m_impl->m_converters;
+	return m_impl->getConverters();
 }
 layout::Layouts *GlobalState::getLayouts()
 {
-	return m_impl->m_layouts;
+	return m_impl->getLayouts();
 }
 transformation::Chain *GlobalState::getTransformationChain()
 {
-	return m_impl->m_transformation_chain;
+	return m_impl->getTransformationChain();
 }
 GtkWidget *GlobalState::getStatusBar()
 {
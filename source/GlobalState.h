@@ -41,7 +41,21 @@ class GlobalState
 	public:
 		GlobalState();
 		~GlobalState();
+		/** Start reading settings in a background thread. loadSettings waits for the result. */
+		void loadSettingsInBackground();
 		bool loadSettings();
+		/**
+		 * Start loading palette file in a background thread.
+		 * @param[in] filename Palette file name.
+		 */
+		void preloadPalette(const char *filename);
+		/**
+		 * Wait for palette started with preloadPalette.
+		 * @param[in] filename Palette file name. Must match the name passed to preloadPalette.
+		 * @param[out] color_list Loaded colors, null if palette could not be loaded. Caller owns returned color list.
+		 * @return False if palette with this name was not preloaded.
+		 */
+		bool takePreloadedPalette(const char *filename, ColorList *&color_list);
 		bool loadAll();
 		bool writeSettings();
 		ColorNames *getColorNames();
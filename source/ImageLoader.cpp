@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "ImageLoader.h"
+#include "ColorHistogram.h"
+#include "Parallel.h"
+#include <png.h>
+#include <jpeglib.h>
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+using namespace std;
+
+/** Sampled pixels are added to histogram in batches of about this many pixels. */
+const size_t batch_pixels = 65536;
+/** Maximum number of copied batches waiting for worker threads. Decoding is paused when this limit is reached. */
+const size_t max_pending_batches = 16;
+/** Size of file chunks passed to image loader. */
+const size_t chunk_size = 65536;
+/** Maximum length of decoder error message. */
+const size_t max_message_length = 256;
+
+enum class DecodeResult
+{
+	done,
+	failed,
+	unsupported, /**< Image has to be decoded by GdkPixbuf */
+};
+struct LoaderState
+{
+	size_t stride;
+	size_t width; /**< Number of sampled pixels in a row */
+	size_t batch_rows; /**< Number of sampled rows in a batch */
+	size_t next_row; /**< First row which was not added to batch yet */
+	size_t decoded_rows; /**< Number of completely decoded rows */
+	bool multiple_passes; /**< Image is decoded in multiple passes, rows are added after decoding finishes */
+	std::atomic<size_t> *processed_rows;
+	std::atomic<size_t> *total_rows;
+	const std::atomic<bool> *cancel;
+	shared_ptr<vector<uint8_t>> batch; /**< Sampled pixels of rows which were not queued yet */
+	size_t batch_row_count;
+	mutex lock;
+	condition_variable batch_done;
+	size_t pending_batches; /**< Number of queued batches which were not added to histograms yet */
+	vector<unique_ptr<ColorHistogram>> histograms; /**< One histogram for each concurrently running task */
+	vector<ColorHistogram*> free_histograms;
+	TaskGroup tasks; /**< Workers adding rows to histograms, shared by all batches of an image */
+};
+static bool is_cancelled(LoaderState *state)
+{
+	return state->cancel && *state->cancel;
+}
+static ColorHistogram *take_histogram(LoaderState *state)
+{
+	lock_guard<mutex> guard(state->lock);
+	if (state->free_histograms.empty()){
+		state->histograms.emplace_back(new ColorHistogram());
+		return state->histograms.back().get();
+	}
+	ColorHistogram *histogram = state->free_histograms.back();
+	state->free_histograms.pop_back();
+	return histogram;
+}
+static void release_histogram(LoaderState *state, ColorHistogram *histogram)
+{
+	lock_guard<mutex> guard(state->lock);
+	state->free_histograms.push_back(histogram);
+}
+static void add_batch(LoaderState *state, const uint8_t *pixels, size_t width, size_t rows)
+{
+	if (is_cancelled(state)) return;
+	ColorHistogram *histogram = take_histogram(state);
+	for (size_t y = 0; y < rows; y++){
+		if (is_cancelled(state)) break;
+		histogram->add(pixels + y * width * 3, width, 3);
+		if (state->processed_rows) (*state->processed_rows)++;
+	}
+	release_histogram(state, histogram);
+}
+static void start_image(LoaderState *state, size_t width, size_t height)
+{
+	state->width = (width + state->stride - 1) / state->stride;
+	state->batch_rows = std::max<size_t>(batch_pixels / std::max<size_t>(state->width, 1), 1);
+	state->batch.reset();
+	state->batch_row_count = 0;
+	if (state->total_rows)
+		*state->total_rows = (height + state->stride - 1) / state->stride;
+}
+/**
+ * Queue copied rows for adding to histograms.
+ * Waits while maximum number of batches is pending, so memory used by copies does not depend on image size.
+ */
+static void queue_batch(LoaderState *state)
+{
+	if (state->batch_row_count == 0) return;
+	{
+		unique_lock<mutex> guard(state->lock);
+		state->batch_done.wait(guard, [state](){
+			return state->pending_batches < max_pending_batches;
+		});
+		state->pending_batches++;
+	}
+	auto batch = state->batch;
+	size_t width = state->width, rows = state->batch_row_count;
+	state->tasks.run([state, batch, width, rows](){
+		add_batch(state, batch->data(), width, rows);
+		lock_guard<mutex> guard(state->lock);
+		state->pending_batches--;
+		state->batch_done.notify_one();
+	});
+	state->batch.reset();
+	state->batch_row_count = 0;
+}
+/** Copy sampled pixels of decoded row y. Rows which are not sampled are ignored. */
+static void add_row(LoaderState *state, size_t y, const uint8_t *row, size_t channels)
+{
+	if (y % state->stride != 0) return;
+	if (!state->batch)
+		state->batch = make_shared<vector<uint8_t>>(state->batch_rows * state->width * 3);
+	uint8_t *out = state->batch->data() + state->batch_row_count * state->width * 3;
+	const uint8_t *pixel = row;
+	for (size_t x = 0; x < state->width; x++, pixel += channels * state->stride, out += 3){
+		out[0] = pixel[0];
+		out[1] = pixel[1];
+		out[2] = pixel[2];
+	}
+	if (++state->batch_row_count == state->batch_rows)
+		queue_batch(state);
+}
+static void png_error_cb(png_structp png, png_const_charp message)
+{
+	g_strlcpy(static_cast<char*>(png_get_error_ptr(png)), message, max_message_length);
+	png_longjmp(png, 1);
+}
+static void png_warning_cb(png_structp png, png_const_charp message)
+{
+}
+/** Decode non-interlaced PNG image one row at a time. */
+static DecodeResult decode_png(FILE *file, LoaderState *state, GError **error)
+{
+	char message[max_message_length] = "";
+	png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, message, png_error_cb, png_warning_cb);
+	if (!png) return DecodeResult::unsupported;
+	png_infop info = png_create_info_struct(png);
+	if (!info){
+		png_destroy_read_struct(&png, nullptr, nullptr);
+		return DecodeResult::unsupported;
+	}
+	vector<uint8_t> row;
+	if (setjmp(png_jmpbuf(png))){
+		png_destroy_read_struct(&png, &info, nullptr);
+		g_set_error(error, GDK_PIXBUF_ERROR, GDK_PIXBUF_ERROR_CORRUPT_IMAGE, "Could not decode PNG image: %s", message);
+		return DecodeResult::failed;
+	}
+	png_init_io(png, file);
+	png_read_info(png, info);
+	if (png_get_interlace_type(png, info) != PNG_INTERLACE_NONE){
+		png_destroy_read_struct(&png, &info, nullptr);
+		return DecodeResult::unsupported;
+	}
+	png_set_expand(png);
+	png_set_strip_16(png);
+	png_set_gray_to_rgb(png);
+	png_read_update_info(png, info);
+	size_t height = png_get_image_height(png, info);
+	size_t channels = png_get_channels(png, info);
+	start_image(state, png_get_image_width(png, info), height);
+	row.resize(png_get_rowbytes(png, info));
+	for (size_t y = 0; y < height; y++){
+		if (is_cancelled(state)) break;
+		png_read_row(png, row.data(), nullptr);
+		add_row(state, y, row.data(), channels);
+	}
+	png_destroy_read_struct(&png, &info, nullptr);
+	return is_cancelled(state) ? DecodeResult::failed : DecodeResult::done;
+}
+struct JpegErrorManager
+{
+	jpeg_error_mgr manager;
+	jmp_buf jump;
+};
+static void jpeg_error_exit_cb(j_common_ptr info)
+{
+	longjmp(reinterpret_cast<JpegErrorManager*>(info->err)->jump, 1);
+}
+static void jpeg_output_message_cb(j_common_ptr info)
+{
+}
+/** Decode JPEG image one row at a time. Progressive images are buffered by decoder as DCT coefficients. */
+static DecodeResult decode_jpeg(FILE *file, LoaderState *state, GError **error)
+{
+	jpeg_decompress_struct info;
+	memset(&info, 0, sizeof(info));
+	JpegErrorManager error_manager;
+	info.err = jpeg_std_error(&error_manager.manager);
+	error_manager.manager.error_exit = jpeg_error_exit_cb;
+	error_manager.manager.output_message = jpeg_output_message_cb;
+	vector<uint8_t> row;
+	if (setjmp(error_manager.jump)){
+		char message[JMSG_LENGTH_MAX];
+		error_manager.manager.format_message(reinterpret_cast<j_common_ptr>(&info), message);
+		jpeg_destroy_decompress(&info);
+		g_set_error(error, GDK_PIXBUF_ERROR, GDK_PIXBUF_ERROR_CORRUPT_IMAGE, "Could not decode JPEG image: %s", message);
+		return DecodeResult::failed;
+	}
+	jpeg_create_decompress(&info);
+	jpeg_stdio_src(&info, file);
+	jpeg_read_header(&info, TRUE);
+	if (info.jpeg_color_space == JCS_CMYK || info.jpeg_color_space == JCS_YCCK){
+		jpeg_destroy_decompress(&info);
+		return DecodeResult::unsupported;
+	}
+	info.out_color_space = JCS_RGB;
+	jpeg_start_decompress(&info);
+	start_image(state, info.output_width, info.output_height);
+	row.resize(info.output_width * info.output_components);
+	JSAMPROW rows[] = { row.data() };
+	while (info.output_scanline < info.output_height){
+		if (is_cancelled(state)){
+			jpeg_destroy_decompress(&info);
+			return DecodeResult::failed;
+		}
+		size_t y = info.output_scanline;
+		jpeg_read_scanlines(&info, rows, 1);
+		add_row(state, y, row.data(), info.output_components);
+	}
+	jpeg_finish_decompress(&info);
+	jpeg_destroy_decompress(&info);
+	return DecodeResult::done;
+}
+/** Copy rows from next_row up to end from pixbuf. */
+static void add_pixbuf_rows(LoaderState *state, GdkPixbuf *pixbuf, size_t end)
+{
+	size_t channels = gdk_pixbuf_get_n_channels(pixbuf);
+	size_t rowstride = gdk_pixbuf_get_rowstride(pixbuf);
+	const guchar *pixels = gdk_pixbuf_get_pixels(pixbuf);
+	for (size_t y = state->next_row; y < end; y++){
+		if (is_cancelled(state)) break;
+		add_row(state, y, pixels + y * rowstride, channels);
+	}
+	state->next_row = end;
+}
+static void size_prepared_cb(GdkPixbufLoader *loader, gint width, gint height, LoaderState *state)
+{
+	if (state->stride > 1){
+		// let decoder reduce image size, so full size image does not have to be kept in memory if decoder supports scaling
+		width = (width + state->stride - 1) / state->stride;
+		height = (height + state->stride - 1) / state->stride;
+		gdk_pixbuf_loader_set_size(loader, width, height);
+		state->stride = 1;
+	}
+	start_image(state, width, height);
+}
+static void area_updated_cb(GdkPixbufLoader *loader, gint x, gint y, gint width, gint height, LoaderState *state)
+{
+	if (state->multiple_passes) return;
+	GdkPixbuf *pixbuf = gdk_pixbuf_loader_get_pixbuf(loader);
+	if (x != 0 || width != gdk_pixbuf_get_width(pixbuf) || size_t(width) != state->width || size_t(y) != state->decoded_rows){
+		// area was already decoded or is not a continuation of decoded rows, so rows will be added when decoding is finished
+		state->multiple_passes = true;
+		return;
+	}
+	state->decoded_rows = y + height;
+	add_pixbuf_rows(state, pixbuf, state->decoded_rows);
+}
+/** Decode image using GdkPixbuf, which keeps whole decoded image in memory until decoding finishes. */
+static DecodeResult decode_pixbuf(FILE *file, LoaderState *state, GError **error)
+{
+	GdkPixbufLoader *loader = gdk_pixbuf_loader_new();
+	g_signal_connect(G_OBJECT(loader), "size-prepared", G_CALLBACK(size_prepared_cb), state);
+	g_signal_connect(G_OBJECT(loader), "area-updated", G_CALLBACK(area_updated_cb), state);
+	guchar buffer[chunk_size];
+	size_t length;
+	while ((length = fread(buffer, 1, chunk_size, file)) > 0){
+		if (is_cancelled(state) || !gdk_pixbuf_loader_write(loader, buffer, length, error)){
+			gdk_pixbuf_loader_close(loader, nullptr);
+			g_object_unref(loader);
+			return DecodeResult::failed;
+		}
+	}
+	if (ferror(file)){
+		g_set_error(error, G_FILE_ERROR, g_file_error_from_errno(errno), "Could not read file");
+		gdk_pixbuf_loader_close(loader, nullptr);
+		g_object_unref(loader);
+		return DecodeResult::failed;
+	}
+	if (!gdk_pixbuf_loader_close(loader, error)){
+		g_object_unref(loader);
+		return DecodeResult::failed;
+	}
+	GdkPixbuf *pixbuf = gdk_pixbuf_loader_get_pixbuf(loader);
+	if (!pixbuf){
+		g_object_unref(loader);
+		return DecodeResult::failed;
+	}
+	if (state->multiple_passes || size_t(gdk_pixbuf_get_width(pixbuf)) != state->width){
+		// rows added during decoding could have been changed by later passes
+		state->tasks.wait();
+		for (auto &part: state->histograms)
+			part->clear();
+		start_image(state, gdk_pixbuf_get_width(pixbuf), gdk_pixbuf_get_height(pixbuf));
+		state->next_row = 0;
+		if (state->processed_rows) *state->processed_rows = 0;
+	}
+	add_pixbuf_rows(state, pixbuf, gdk_pixbuf_get_height(pixbuf));
+	g_object_unref(loader);
+	return DecodeResult::done;
+}
+bool image_loader_add_to_histogram(const char *filename, size_t stride, ColorHistogram &histogram, std::atomic<size_t> *processed_rows, std::atomic<size_t> *total_rows, const std::atomic<bool> *cancel, GError **error)
+{
+	FILE *file = fopen(filename, "rb");
+	if (!file){
+		g_set_error(error, G_FILE_ERROR, g_file_error_from_errno(errno), "Could not open file \"%s\"", filename);
+		return false;
+	}
+	LoaderState state;
+	state.stride = std::max<size_t>(stride, 1);
+	state.width = 0;
+	state.batch_rows = 1;
+	state.next_row = 0;
+	state.decoded_rows = 0;
+	state.multiple_passes = false;
+	state.processed_rows = processed_rows;
+	state.total_rows = total_rows;
+	state.cancel = cancel;
+	state.batch_row_count = 0;
+	state.pending_batches = 0;
+	png_byte magic[8];
+	size_t magic_length = fread(magic, 1, sizeof(magic), file);
+	DecodeResult result = DecodeResult::unsupported;
+	if (fseek(file, 0, SEEK_SET) != 0){
+		g_set_error(error, G_FILE_ERROR, g_file_error_from_errno(errno), "Could not read file \"%s\"", filename);
+		result = DecodeResult::failed;
+	}else if (magic_length == sizeof(magic) && png_sig_cmp(magic, 0, sizeof(magic)) == 0){
+		result = decode_png(file, &state, error);
+	}else if (magic_length >= 3 && magic[0] == 0xff && magic[1] == 0xd8 && magic[2] == 0xff){
+		result = decode_jpeg(file, &state, error);
+	}
+	if (result == DecodeResult::done && ferror(file)){
+		g_set_error(error, G_FILE_ERROR, g_file_error_from_errno(errno), "Could not read file \"%s\"", filename);
+		result = DecodeResult::failed;
+	}
+	if (result == DecodeResult::unsupported){
+		// decoders return before adding any rows when image is not supported
+		fseek(file, 0, SEEK_SET);
+		clearerr(file);
+		result = decode_pixbuf(file, &state, error);
+	}
+	fclose(file);
+	if (result == DecodeResult::done)
+		queue_batch(&state);
+	state.tasks.wait();
+	if (result != DecodeResult::done || (cancel && *cancel)) return false;
+	for (auto &part: state.histograms)
+		histogram.add(*part);
+	return true;
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef GPICK_IMAGE_LOADER_H_
+#define GPICK_IMAGE_LOADER_H_
+
+#include <gdk-pixbuf/gdk-pixbuf.h>
+#include <atomic>
+#include <cstddef>
+class ColorHistogram;
+
+/** \file source/ImageLoader.h
+ * \brief Incremental image decoding for palette extraction.
+ */
+
+/**
+ * Decode image file incrementally and add pixels to histogram as soon as rows are decoded, so decoding and histogram building overlap.
+ * PNG and JPEG images are decoded one row at a time, so memory use does not depend on image size. Interlaced PNG, CMYK JPEG and other formats are
+ * decoded by GdkPixbuf, which keeps whole decoded image in memory until decoding finishes. GdkPixbuf decodes image at reduced size when stride is larger than 1.
+ * Sampled rows are copied in batches processed by a single pool of worker threads. Decoding waits when too many batches are pending.
+ * @param[in] filename Image file name.
+ * @param[in] stride Use only every stride-th pixel of every stride-th row. Value of 1 uses all pixels.
+ * @param[out] histogram Histogram to add pixels to.
+ * @param[out] processed_rows Incremented after each sampled row is added. Can be null.
+ * @param[out] total_rows Set to number of sampled rows when image size becomes known. Can be null.
+ * @param[in] cancel Decoding is stopped when cancel is set. Can be null.
+ * @param[out] error Decoding error. Can be null.
+ * @return False if image could not be decoded or decoding was cancelled.
+ */
+bool image_loader_add_to_histogram(const char *filename, size_t stride, ColorHistogram &histogram, std::atomic<size_t> *processed_rows, std::atomic<size_t> *total_rows, const std::atomic<bool> *cancel, GError **error);
+
+#endif /* GPICK_IMAGE_LOADER_H_ */
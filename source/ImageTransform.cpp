@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ImageTransform.h"
+#include "Color.h"
+#include "Parallel.h"
+#include "transformation/Chain.h"
+#include <algorithm>
+#include <vector>
+using namespace std;
+
+const int image_transform_tile_size = 64;
+
+namespace {
+/** Byte offsets of channels inside a pixel. Negative alpha offset means that pixels have no alpha channel. */
+struct PixelLayout
+{
+	size_t bytes_per_pixel;
+	int red, green, blue, alpha;
+};
+}
+
+static PixelLayout get_layout(ImagePixelFormat format)
+{
+	switch (format){
+		case ImagePixelFormat::rgb:
+			return PixelLayout{3, 0, 1, 2, -1};
+		case ImagePixelFormat::rgba:
+			return PixelLayout{4, 0, 1, 2, 3};
+		case ImagePixelFormat::argb32:
+#ifdef BIG_ENDIAN_P
+			return PixelLayout{4, 1, 2, 3, 0};
+#else
+			return PixelLayout{4, 2, 1, 0, 3};
+#endif
+	}
+	return PixelLayout{4, 0, 1, 2, 3};
+}
+
+static inline uint8_t to_byte(float value)
+{
+	if (value <= 0) return 0;
+	if (value >= 1) return 255;
+	return static_cast<uint8_t>(value * 255 + 0.5f);
+}
+
+size_t image_transform_get_tile_count(int width, int height)
+{
+	if (width <= 0 || height <= 0) return 0;
+	size_t columns = (width + image_transform_tile_size - 1) / image_transform_tile_size;
+	size_t rows = (height + image_transform_tile_size - 1) / image_transform_tile_size;
+	return columns * rows;
+}
+
+bool image_transform_apply(transformation::Chain &chain, const ImageView &input, const ImageView &output, std::atomic<size_t> *processed_tiles, std::atomic<bool> *cancel)
+{
+	const PixelLayout in = get_layout(input.format), out = get_layout(output.format);
+	const bool copy_alpha = in.alpha >= 0 && out.alpha >= 0;
+	const int width = std::min(input.width, output.width), height = std::min(input.height, output.height);
+	const size_t columns = (std::max(width, 0) + image_transform_tile_size - 1) / image_transform_tile_size;
+	float byte_to_float[256];
+	for (int i = 0; i < 256; i++)
+		byte_to_float[i] = i / 255.0f;
+	// Lookup table is compiled before workers start, so that they do not wait for each other
+	chain.isCompiled();
+	parallel_for(image_transform_get_tile_count(width, height), 1, [&](size_t begin, size_t end){
+		vector<Color> colors(image_transform_tile_size * image_transform_tile_size);
+		for (size_t tile = begin; tile < end; tile++){
+			if (cancel && *cancel) return;
+			int x = (tile % columns) * image_transform_tile_size, y = (tile / columns) * image_transform_tile_size;
+			int tile_width = std::min(image_transform_tile_size, width - x), tile_height = std::min(image_transform_tile_size, height - y);
+			Color *color = colors.data();
+			for (int j = 0; j < tile_height; j++){
+				const uint8_t *pixel = input.pixels + (y + j) * input.stride + x * in.bytes_per_pixel;
+				for (int i = 0; i < tile_width; i++, pixel += in.bytes_per_pixel, color++){
+					color->rgb.red = byte_to_float[pixel[in.red]];
+					color->rgb.green = byte_to_float[pixel[in.green]];
+					color->rgb.blue = byte_to_float[pixel[in.blue]];
+					color->ma[3] = 1;
+				}
+			}
+			size_t count = tile_width * tile_height;
+			chain.apply(colors.data(), colors.data(), count);
+			color = colors.data();
+			for (int j = 0; j < tile_height; j++){
+				const uint8_t *source = input.pixels + (y + j) * input.stride + x * in.bytes_per_pixel;
+				uint8_t *pixel = output.pixels + (y + j) * output.stride + x * out.bytes_per_pixel;
+				for (int i = 0; i < tile_width; i++, source += in.bytes_per_pixel, pixel += out.bytes_per_pixel, color++){
+					// Alpha is read before color components are written, because input and output can share memory
+					uint8_t alpha = copy_alpha ? source[in.alpha] : 255;
+					pixel[out.red] = to_byte(color->rgb.red);
+					pixel[out.green] = to_byte(color->rgb.green);
+					pixel[out.blue] = to_byte(color->rgb.blue);
+					if (out.alpha >= 0)
+						pixel[out.alpha] = alpha;
+				}
+			}
+			if (processed_tiles) (*processed_tiles)++;
+		}
+	});
+	return !(cancel && *cancel);
+}
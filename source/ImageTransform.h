@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GPICK_IMAGE_TRANSFORM_H_
+#define GPICK_IMAGE_TRANSFORM_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/** \file source/ImageTransform.h
+ * \brief Application of transformation chain to whole images.
+ */
+
+namespace transformation {
+	class Chain;
+}
+
+/** \enum ImagePixelFormat
+ * \brief Memory layout of pixels with 8 bits per channel.
+ */
+enum class ImagePixelFormat {
+	rgb, /**< Red, green and blue bytes. GdkPixbuf without alpha channel. */
+	rgba, /**< Red, green, blue and alpha bytes. GdkPixbuf with alpha channel. */
+	argb32, /**< Native endian 32-bit integers with alpha in bits 24-31 and red in bits 16-23. Cairo ARGB32 surface, alpha is treated as not premultiplied, so pixels should be opaque. */
+};
+
+/** \struct ImageView
+ * \brief Pixels of an image. View does not own pixel memory.
+ */
+struct ImageView
+{
+	uint8_t *pixels;
+	int width;
+	int height;
+	size_t stride; /**< Number of bytes between the starts of consecutive rows */
+	ImagePixelFormat format;
+};
+
+/** Width and height of tiles images are split into. */
+extern const int image_transform_tile_size;
+
+/**
+ * Get number of tiles image is split into.
+ * @param[in] width Image width.
+ * @param[in] height Image height.
+ * @return Number of tiles.
+ */
+size_t image_transform_get_tile_count(int width, int height);
+
+/**
+ * Apply transformation chain to every pixel of an image.
+ * Image is split into square tiles, which are processed in parallel. Each tile is converted into a color array and passed to the array path of the chain.
+ * Alpha is copied when both images have alpha channel, otherwise output pixels are opaque.
+ * @param[in] chain Transformation chain. Chain must not be modified while image is processed.
+ * @param[in] input Source image.
+ * @param[in] output Destination image of the same size. Can be the same image as input.
+ * @param[out] processed_tiles Number of processed tiles, incremented after each tile. Can be null.
+ * @param[in] cancel Processing stops before the next tile when set. Can be null.
+ * @return False if processing was cancelled.
+ */
+bool image_transform_apply(transformation::Chain &chain, const ImageView &input, const ImageView &output, std::atomic<size_t> *processed_tiles, std::atomic<bool> *cancel);
+
+#endif /* GPICK_IMAGE_TRANSFORM_H_ */
@@ -30,5 +30,10 @@ int lua_pushdynvsystem(lua_State *L, dynvSystem* params);
 dynvSystem* lua_checkdynvsystem(lua_State *L, int index);
 int lua_pushcolor(lua_State *L, const Color* color);
 Color* lua_checkcolor(lua_State *L, int index);
+/**
+ * Pass settings to gpick.options_update Lua function, so converters follow current options.
+ * @return Zero on success.
+ */
+int lua_ext_options_update(lua_State *lua, dynvSystem *settings);
 
 #endif /* GPICK_LUA_EXT_H_ */
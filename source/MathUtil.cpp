@@ -265,6 +265,10 @@ float vector3_length(const vector3* vector) {
 	return sqrt(vector->x * vector->x + vector->y * vector->y + vector->z * vector->z);
 }
 
+float vector3_dot(const vector3* v1, const vector3* v2) {
+	return v1->x * v2->x + v1->y * v2->y + v1->z * v2->z;
+}
+
 void vector3_clamp(vector3* vector, float a, float b){
 	vector->x = clamp_float(vector->x, a, b);
 	vector->y = clamp_float(vector->y, a, b);
@@ -85,6 +85,7 @@ void vector3_set(vector3* vector, float x, float y, float z);
 void vector3_copy(const vector3* vector, vector3* result);
 
 float vector3_length(const vector3* vector);
+float vector3_dot(const vector3* v1, const vector3* v2);
 
 void vector3_multiply_matrix3x3(const vector3* vector, const matrix3x3* matrix, vector3* result );
 
@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "PaletteOctree.h"
+#include "ColorHistogram.h"
+#include <cstring>
+#include <algorithm>
+using namespace std;
+
+struct PaletteOctree::Node
+{
+	uint32_t child[8]; /**< Indices of child nodes. Zero if child does not exist, as root node is never a child. */
+	uint32_t parent; /**< Index of parent node */
+	uint8_t depth; /**< Node depth, root node has depth 0 */
+	uint8_t origin[3]; /**< Smallest 8-bit color value inside of the node */
+	uint64_t pixels_in; /**< Number of pixels in current node */
+	uint64_t sum_in[3]; /**< Sum of 8-bit color values of pixels in current node */
+	uint64_t squares_in; /**< Sum of squared 8-bit color values of pixels in current node */
+	uint64_t pixels; /**< Number of pixels in current node and its children */
+	uint64_t sum[3]; /**< Sum of color values of pixels in current node and its children */
+	uint64_t squares; /**< Sum of squared color values of pixels in current node and its children */
+	double distance; /**< Sum of squared distances from node center of pixels in current node and its children */
+};
+struct PaletteOctree::Data
+{
+	std::vector<Node> nodes;
+	/** Leaf node index for each leaf cube, zero if leaf does not exist. */
+	std::vector<uint32_t> leaves;
+	/** Node statistics are up to date. */
+	bool updated;
+	bool reduced;
+	Data():
+		leaves(1 << (3 * max_depth), 0),
+		updated(true),
+		reduced(false)
+	{
+		Node root;
+		memset(&root, 0, sizeof(root));
+		nodes.push_back(root);
+	}
+	void update()
+	{
+		if (updated) return;
+		for (auto &node: nodes){
+			node.pixels = node.pixels_in;
+			for (int i = 0; i < 3; i++)
+				node.sum[i] = node.sum_in[i];
+			node.squares = node.squares_in;
+		}
+		// children are always created after their parents
+		for (size_t i = nodes.size() - 1; i > 0; i--){
+			Node &node = nodes[i], &parent = nodes[node.parent];
+			parent.pixels += node.pixels;
+			for (int j = 0; j < 3; j++)
+				parent.sum[j] += node.sum[j];
+			parent.squares += node.squares;
+		}
+		for (auto &node: nodes){
+			double half_size = (128 >> node.depth) / 256.0;
+			double distance = node.squares / (255.0 * 255.0);
+			for (int i = 0; i < 3; i++){
+				double center = node.origin[i] / 256.0 + half_size;
+				distance += node.pixels * center * center - 2 * center * node.sum[i] / 255.0;
+			}
+			node.distance = distance;
+		}
+		updated = true;
+	}
+	uint32_t countLeafs(uint32_t index) const
+	{
+		const Node &node = nodes[index];
+		uint32_t result = node.pixels_in ? 1 : 0;
+		for (int i = 0; i < 8; i++){
+			if (node.child[i])
+				result += countLeafs(node.child[i]);
+		}
+		return result;
+	}
+	void collect(uint32_t index, uint32_t target)
+	{
+		Node &node = nodes[index];
+		for (int i = 0; i < 8; i++){
+			if (node.child[i]){
+				collect(node.child[i], target);
+				node.child[i] = 0;
+			}
+		}
+		if (index == target) return;
+		Node &target_node = nodes[target];
+		target_node.pixels_in += node.pixels_in;
+		for (int i = 0; i < 3; i++)
+			target_node.sum_in[i] += node.sum_in[i];
+		node.pixels_in = 0;
+	}
+	/**
+	 * Merge node and its children into its parent node. Root node is merged into itself.
+	 */
+	void prune(uint32_t index)
+	{
+		collect(index, index == 0 ? 0 : nodes[index].parent);
+	}
+	/**
+	 * Check if node was not merged into its parent.
+	 */
+	bool isLinked(uint32_t index) const
+	{
+		if (index == 0) return true;
+		const Node &parent = nodes[nodes[index].parent];
+		for (int i = 0; i < 8; i++){
+			if (parent.child[i] == index)
+				return true;
+		}
+		return false;
+	}
+	/**
+	 * Merge nodes in the order of increasing distance until no more than requested number of colors remains.
+	 * All nodes with equal distance are merged together. Node distance does not change when its children are merged, so nodes are sorted only once.
+	 */
+	void reduce(uint32_t colors)
+	{
+		vector<uint32_t> order;
+		vector<uint32_t> stack(1, 0);
+		while (!stack.empty()){
+			uint32_t index = stack.back();
+			stack.pop_back();
+			order.push_back(index);
+			const Node &node = nodes[index];
+			for (int i = 7; i >= 0; i--){
+				if (node.child[i])
+					stack.push_back(node.child[i]);
+			}
+		}
+		vector<uint32_t> rank(nodes.size());
+		for (size_t i = 0; i < order.size(); i++)
+			rank[order[i]] = i;
+		// parents are merged before their children when distances are equal
+		sort(order.begin(), order.end(), [this, &rank](uint32_t a, uint32_t b){
+			if (nodes[a].distance != nodes[b].distance)
+				return nodes[a].distance < nodes[b].distance;
+			return rank[a] < rank[b];
+		});
+		uint32_t color_count = countLeafs(0);
+		double threshold = 0;
+		size_t position = 0;
+		while (color_count > colors && position < order.size()){
+			for (; position < order.size() && nodes[order[position]].distance <= threshold; position++){
+				uint32_t index = order[position];
+				if (!isLinked(index)) continue;
+				color_count -= countLeafs(index);
+				if (index == 0){
+					prune(0);
+					if (nodes[0].pixels_in) color_count++;
+					return;
+				}
+				Node &parent = nodes[nodes[index].parent];
+				if (parent.pixels_in == 0) color_count++;
+				prune(index);
+				for (int i = 0; i < 8; i++){
+					if (parent.child[i] == index)
+						parent.child[i] = 0;
+				}
+			}
+			while (position < order.size() && !isLinked(order[position]))
+				position++;
+			if (position < order.size())
+				threshold = nodes[order[position]].distance;
+		}
+	}
+	void getColors(uint32_t index, vector<Color> &colors) const
+	{
+		const Node &node = nodes[index];
+		if (node.pixels_in > 0){
+			Color color;
+			color.rgb.red = node.sum_in[0] / (255.0 * node.pixels_in);
+			color.rgb.green = node.sum_in[1] / (255.0 * node.pixels_in);
+			color.rgb.blue = node.sum_in[2] / (255.0 * node.pixels_in);
+			color.ma[3] = 0;
+			colors.push_back(color);
+		}
+		for (int i = 0; i < 8; i++){
+			if (node.child[i])
+				getColors(node.child[i], colors);
+		}
+	}
+};
+PaletteOctree::PaletteOctree():
+	m_data(make_shared<Data>())
+{
+}
+PaletteOctree::PaletteOctree(const PaletteOctree &octree):
+	m_data(octree.m_data)
+{
+}
+PaletteOctree &PaletteOctree::operator=(const PaletteOctree &octree)
+{
+	m_data = octree.m_data;
+	return *this;
+}
+PaletteOctree::~PaletteOctree()
+{
+}
+PaletteOctree::Data &PaletteOctree::modify()
+{
+	if (m_data.use_count() > 1)
+		m_data = make_shared<Data>(*m_data);
+	return *m_data;
+}
+uint32_t PaletteOctree::getLeaf(Data &data, uint32_t key)
+{
+	uint32_t index = data.leaves[key];
+	if (index) return index;
+	index = 0;
+	uint8_t value[3] = {
+		uint8_t((key >> (2 * max_depth)) << (8 - max_depth)),
+		uint8_t(((key >> max_depth) & ((1 << max_depth) - 1)) << (8 - max_depth)),
+		uint8_t((key & ((1 << max_depth) - 1)) << (8 - max_depth)),
+	};
+	for (int depth = 0; depth < max_depth; depth++){
+		int bit = 7 - depth;
+		int x = (value[0] >> bit) & 1, y = (value[1] >> bit) & 1, z = (value[2] >> bit) & 1;
+		int i = x | (y << 1) | (z << 2);
+		uint32_t child = data.nodes[index].child[i];
+		if (!child){
+			Node node;
+			memset(&node, 0, sizeof(node));
+			node.parent = index;
+			node.depth = depth + 1;
+			const Node &parent = data.nodes[index];
+			node.origin[0] = parent.origin[0] | (x << bit);
+			node.origin[1] = parent.origin[1] | (y << bit);
+			node.origin[2] = parent.origin[2] | (z << bit);
+			child = data.nodes.size();
+			data.nodes.push_back(node);
+			data.nodes[index].child[i] = child;
+		}
+		index = child;
+	}
+	data.leaves[key] = index;
+	return index;
+}
+void PaletteOctree::add(const uint8_t *pixels, size_t count, size_t pixel_stride)
+{
+	if (count == 0) return;
+	Data &data = modify();
+	if (data.reduced) return;
+	data.updated = false;
+	const int shift = 8 - max_depth;
+	for (size_t i = 0; i < count; i++, pixels += pixel_stride){
+		uint32_t key = ((pixels[0] >> shift) << (2 * max_depth)) | ((pixels[1] >> shift) << max_depth) | (pixels[2] >> shift);
+		Node &node = data.nodes[getLeaf(data, key)];
+		node.pixels_in++;
+		node.sum_in[0] += pixels[0];
+		node.sum_in[1] += pixels[1];
+		node.sum_in[2] += pixels[2];
+		node.squares_in += pixels[0] * pixels[0] + pixels[1] * pixels[1] + pixels[2] * pixels[2];
+	}
+}
+void PaletteOctree::add(const PaletteOctree &octree)
+{
+	const Data &source = *octree.m_data;
+	if (source.reduced || source.nodes.size() == 1) return;
+	if (m_data == octree.m_data){
+		PaletteOctree copy(octree);
+		copy.m_data = make_shared<Data>(source);
+		add(copy);
+		return;
+	}
+	Data &data = modify();
+	if (data.reduced) return;
+	data.updated = false;
+	for (size_t key = 0; key < source.leaves.size(); key++){
+		if (!source.leaves[key]) continue;
+		const Node &source_node = source.nodes[source.leaves[key]];
+		Node &node = data.nodes[getLeaf(data, key)];
+		node.pixels_in += source_node.pixels_in;
+		for (int i = 0; i < 3; i++)
+			node.sum_in[i] += source_node.sum_in[i];
+		node.squares_in += source_node.squares_in;
+	}
+}
+void PaletteOctree::add(const ColorHistogram &histogram)
+{
+	static_assert(ColorHistogram::bits == max_depth, "histogram bins must match leaf nodes");
+	if (histogram.empty()) return;
+	Data &data = modify();
+	if (data.reduced) return;
+	data.updated = false;
+	for (uint32_t key = 0; key < ColorHistogram::bin_count; key++){
+		const ColorHistogram::Bin &bin = histogram.getBin(key);
+		if (!bin.pixels) continue;
+		Node &node = data.nodes[getLeaf(data, key)];
+		node.pixels_in += bin.pixels;
+		for (int i = 0; i < 3; i++)
+			node.sum_in[i] += bin.sum[i];
+		node.squares_in += bin.squares;
+	}
+}
+void PaletteOctree::reduce(uint32_t colors)
+{
+	Data &data = modify();
+	data.update();
+	data.reduced = true;
+	data.reduce(colors);
+}
+void PaletteOctree::getColors(std::vector<Color> &colors) const
+{
+	colors.clear();
+	m_data->getColors(0, colors);
+}
+size_t PaletteOctree::getColorCount() const
+{
+	return m_data->countLeafs(0);
+}
+uint64_t PaletteOctree::getPixelCount() const
+{
+	uint64_t result = 0;
+	for (auto &node: m_data->nodes)
+		result += node.pixels_in;
+	return result;
+}
+bool PaletteOctree::empty() const
+{
+	return getPixelCount() == 0;
+}
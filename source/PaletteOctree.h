@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef GPICK_PALETTE_OCTREE_H_
+#define GPICK_PALETTE_OCTREE_H_
+
+#include "Color.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+class ColorHistogram;
+
+/** \file source/PaletteOctree.h
+ * \brief Octree color quantizer used to extract palettes from images.
+ */
+
+/** \class PaletteOctree
+ * \brief Octree of 8-bit RGB colors stored in a contiguous node pool.
+ *
+ * Each node is a cube in RGB space. Pixels are accumulated in leaf nodes at depth 5 as integer sums, so results do not depend on pixel order.
+ * Reduction merges nodes with the smallest spread of colors into their parents until requested number of colors remains.
+ * Copies share node pool until one of them is modified.
+ */
+class PaletteOctree
+{
+	public:
+		/** Depth of leaf nodes. */
+		static const int max_depth = 5;
+		PaletteOctree();
+		PaletteOctree(const PaletteOctree &octree);
+		PaletteOctree &operator=(const PaletteOctree &octree);
+		~PaletteOctree();
+		/**
+		 * Add 8-bit RGB pixels. Pixels can not be added after reduce.
+		 * @param[in] pixels First pixel. Each pixel starts with red, green and blue bytes.
+		 * @param[in] count Number of pixels.
+		 * @param[in] pixel_stride Distance between pixels in bytes.
+		 */
+		void add(const uint8_t *pixels, size_t count, size_t pixel_stride);
+		/**
+		 * Add all pixels from color histogram. Histogram bins match leaf nodes, so result is identical to adding the same pixels directly.
+		 * @param[in] histogram Color histogram.
+		 */
+		void add(const ColorHistogram &histogram);
+		/**
+		 * Add all pixels from another octree. Result does not depend on the order in which octrees are added.
+		 * @param[in] octree Octree which was not reduced.
+		 */
+		void add(const PaletteOctree &octree);
+		/**
+		 * Merge nodes until no more than requested number of colors remains.
+		 * @param[in] colors Number of colors.
+		 */
+		void reduce(uint32_t colors);
+		/**
+		 * Get average color of each node with pixels in it.
+		 * @param[out] colors Colors in RGB color space.
+		 */
+		void getColors(std::vector<Color> &colors) const;
+		size_t getColorCount() const;
+		uint64_t getPixelCount() const;
+		bool empty() const;
+	private:
+		struct Node;
+		struct Data;
+		std::shared_ptr<Data> m_data;
+		Data &modify();
+		uint32_t getLeaf(Data &data, uint32_t key);
+};
+
+#endif /* GPICK_PALETTE_OCTREE_H_ */
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "Parallel.h"
+#include <thread>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+size_t parallel_get_thread_count()
+{
+	static const size_t thread_count = std::max<size_t>(thread::hardware_concurrency(), 1);
+	return thread_count;
+}
+void parallel_for(size_t count, size_t min_chunk_size, const std::function<void(size_t begin, size_t end)> &function)
+{
+	if (count == 0) return;
+	size_t chunks = std::min(parallel_get_thread_count(), count / std::max<size_t>(min_chunk_size, 1));
+	if (chunks <= 1){
+		function(0, count);
+		return;
+	}
+	vector<thread> threads;
+	threads.reserve(chunks - 1);
+	for (size_t i = 1; i < chunks; i++){
+		threads.emplace_back(function, count * i / chunks, count * (i + 1) / chunks);
+	}
+	function(0, count / chunks);
+	for (auto &thread: threads)
+		thread.join();
+}
+TaskGroup::TaskGroup(size_t max_threads):
+	m_max_threads(max_threads ? max_threads : parallel_get_thread_count()),
+	m_unfinished(0),
+	m_idle(0),
+	m_stop(false)
+{
+}
+TaskGroup::~TaskGroup()
+{
+	{
+		unique_lock<mutex> lock(m_lock);
+		m_task_finished.wait(lock, [this]{ return m_unfinished == 0; });
+		m_stop = true;
+	}
+	m_task_added.notify_all();
+	for (auto &thread: m_threads)
+		thread.join();
+}
+void TaskGroup::run(const std::function<void()> &task)
+{
+	{
+		lock_guard<mutex> lock(m_lock);
+		m_tasks.push_back(task);
+		m_unfinished++;
+		if (m_tasks.size() > m_idle && m_threads.size() < m_max_threads)
+			m_threads.emplace_back(&TaskGroup::work, this);
+	}
+	m_task_added.notify_one();
+}
+void TaskGroup::wait()
+{
+	unique_lock<mutex> lock(m_lock);
+	m_task_finished.wait(lock, [this]{ return m_unfinished == 0; });
+}
+void TaskGroup::work()
+{
+	unique_lock<mutex> lock(m_lock);
+	for (;;){
+		m_idle++;
+		m_task_added.wait(lock, [this]{ return m_stop || !m_tasks.empty(); });
+		m_idle--;
+		if (m_tasks.empty()) return;
+		auto task = move(m_tasks.front());
+		m_tasks.pop_front();
+		lock.unlock();
+		task();
+		lock.lock();
+		m_unfinished--;
+		if (m_unfinished == 0)
+			m_task_finished.notify_all();
+	}
+}
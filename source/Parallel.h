@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef GPICK_PARALLEL_H_
+#define GPICK_PARALLEL_H_
+
+#include <cstddef>
+#include <functional>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** \file source/Parallel.h
+ * \brief Helpers for splitting work between multiple threads.
+ */
+
+/**
+ * Get number of threads used by parallel functions.
+ * @return Number of hardware threads, at least 1.
+ */
+size_t parallel_get_thread_count();
+
+/**
+ * Split range [0, count) into continuous chunks and process them in parallel. Calling thread processes one of the chunks.
+ * Function returns after all chunks are processed.
+ * @param[in] count Number of items.
+ * @param[in] min_chunk_size Minimum number of items in a chunk. Ranges smaller than two chunks are processed in calling thread.
+ * @param[in] function Function called for each chunk with range [begin, end).
+ */
+void parallel_for(size_t count, size_t min_chunk_size, const std::function<void(size_t begin, size_t end)> &function);
+
+/** \class TaskGroup
+ * \brief Runs independent tasks on a small pool of worker threads.
+ *
+ * Workers are started on demand, up to the thread limit. wait() is a barrier which returns after all queued tasks are finished.
+ * Destructor waits for all queued tasks.
+ */
+class TaskGroup
+{
+	public:
+		/**
+		 * @param[in] max_threads Maximum number of worker threads. Number of hardware threads is used when zero.
+		 */
+		TaskGroup(size_t max_threads = 0);
+		~TaskGroup();
+		/**
+		 * Queue task for execution in a worker thread.
+		 * @param[in] task Task function.
+		 */
+		void run(const std::function<void()> &task);
+		/** Wait until all queued tasks are finished. */
+		void wait();
+	private:
+		size_t m_max_threads;
+		std::vector<std::thread> m_threads;
+		std::deque<std::function<void()>> m_tasks;
+		std::mutex m_lock;
+		std::condition_variable m_task_added, m_task_finished;
+		size_t m_unfinished, m_idle;
+		bool m_stop;
+		void work();
+};
+
+#endif /* GPICK_PARALLEL_H_ */
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "PickStream.h"
+#include <glib.h>
+#include <algorithm>
+using namespace std;
+
+PickStream::PickStream(const SampleFunction &sample, const EmitFunction &emit):
+	m_sample(sample),
+	m_emit(emit),
+	m_last_id(0),
+	m_max_rate(default_max_rate),
+	m_max_batch_size(default_max_batch_size),
+	m_max_streams(default_max_streams),
+	m_source_id(0)
+{
+}
+PickStream::~PickStream()
+{
+	unschedule();
+}
+void PickStream::setLimits(float max_rate, uint32_t max_batch_size, size_t max_streams)
+{
+	m_max_rate = max_rate;
+	m_max_batch_size = max(max_batch_size, uint32_t(1));
+	m_max_streams = max_streams;
+}
+uint32_t PickStream::start(const std::string &owner, const std::string &converter_name, float rate, uint32_t batch_size)
+{
+	if (getStreamCount(owner) >= m_max_streams) return 0;
+	if (!(rate > 0) || rate > m_max_rate) rate = m_max_rate;
+	uint32_t id = ++m_last_id;
+	if (id == 0) id = ++m_last_id;
+	Stream &stream = m_streams[id];
+	stream.owner = owner;
+	stream.converter_name = converter_name;
+	stream.interval = max(int64_t(1000), int64_t(1000000 / rate));
+	stream.next_sample = g_get_monotonic_time();
+	stream.batch_size = min(max(batch_size, uint32_t(1)), m_max_batch_size);
+	schedule(0);
+	return id;
+}
+bool PickStream::stop(const std::string &owner, uint32_t stream_id)
+{
+	auto i = m_streams.find(stream_id);
+	if (i == m_streams.end() || i->second.owner != owner) return false;
+	if (!i->second.samples.empty() && m_emit)
+		m_emit(stream_id, i->second.samples);
+	m_streams.erase(i);
+	if (m_streams.empty()) unschedule();
+	return true;
+}
+void PickStream::stopOwner(const std::string &owner)
+{
+	for (auto i = m_streams.begin(); i != m_streams.end();){
+		if (i->second.owner == owner)
+			i = m_streams.erase(i);
+		else
+			++i;
+	}
+	if (m_streams.empty()) unschedule();
+}
+void PickStream::clear()
+{
+	m_streams.clear();
+	unschedule();
+}
+size_t PickStream::getStreamCount() const
+{
+	return m_streams.size();
+}
+size_t PickStream::getStreamCount(const std::string &owner) const
+{
+	size_t result = 0;
+	for (auto &stream: m_streams){
+		if (stream.second.owner == owner)
+			result++;
+	}
+	return result;
+}
+int PickStream::step(int64_t now)
+{
+	map<string, PickSample> samples;
+	vector<uint32_t> full;
+	for (auto &item: m_streams){
+		Stream &stream = item.second;
+		if (stream.next_sample > now) continue;
+		auto sample = samples.find(stream.converter_name);
+		if (sample == samples.end()){
+			PickSample value;
+			value.time = now;
+			if (m_sample && m_sample(stream.converter_name, value))
+				sample = samples.emplace(stream.converter_name, value).first;
+		}
+		if (sample != samples.end()){
+			stream.samples.push_back(sample->second);
+			if (stream.samples.size() >= stream.batch_size)
+				full.push_back(item.first);
+		}
+		stream.next_sample += stream.interval;
+		if (stream.next_sample <= now)
+			stream.next_sample = now + stream.interval;
+	}
+	// Emit function can start or stop streams, so batches are taken out of the streams first.
+	for (auto id: full){
+		auto i = m_streams.find(id);
+		if (i == m_streams.end()) continue;
+		vector<PickSample> batch;
+		batch.swap(i->second.samples);
+		if (m_emit) m_emit(id, batch);
+	}
+	if (m_streams.empty()) return -1;
+	int64_t next = m_streams.begin()->second.next_sample;
+	for (auto &item: m_streams)
+		next = min(next, item.second.next_sample);
+	return int(max(int64_t(0), (next - now + 999) / 1000));
+}
+void PickStream::schedule(int interval)
+{
+	unschedule();
+	m_source_id = g_timeout_add_full(G_PRIORITY_DEFAULT, interval, (GSourceFunc)onTimeout, this, nullptr);
+}
+void PickStream::unschedule()
+{
+	if (m_source_id){
+		g_source_remove(m_source_id);
+		m_source_id = 0;
+	}
+}
+int PickStream::onTimeout(void *data)
+{
+	PickStream *stream = reinterpret_cast<PickStream*>(data);
+	unsigned int source_id = stream->m_source_id;
+	int interval = stream->step(g_get_monotonic_time());
+	if (stream->m_source_id != source_id) return false;
+	stream->m_source_id = 0;
+	if (interval >= 0)
+		stream->schedule(interval);
+	return false;
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GPICK_PICK_STREAM_H_
+#define GPICK_PICK_STREAM_H_
+
+#include "Color.h"
+#include "Vector2.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/** \file source/PickStream.h
+ * \brief Periodic color sampling for external clients.
+ */
+
+/** \struct PickSample
+ * \brief Single color sample taken at pointer position.
+ */
+struct PickSample
+{
+	int64_t time; /**< Monotonic time of sampling in microseconds */
+	math::Vec2<int> position; /**< Pointer position */
+	Color color; /**< Sampled color in RGB color space */
+	std::string text; /**< Color converted to text using stream converter */
+};
+
+/** \class PickStream
+ * \brief Samples colors at rates requested by clients and delivers them in batches.
+ *
+ * Each client can have multiple streams. Requested rates and batch sizes are limited on the server side, and streams due at the same time share one sample per converter.
+ * Streams which fall behind skip missed samples instead of catching up in bursts.
+ */
+class PickStream
+{
+	public:
+		/**
+		 * Function taking one sample.
+		 * @param[in] converter_name Converter used to create sample text. Empty name selects display converter.
+		 * @param[out] sample Sample. Time is set by caller.
+		 * @return True on success.
+		 */
+		typedef std::function<bool(const std::string &converter_name, PickSample &sample)> SampleFunction;
+		/**
+		 * Function delivering a batch of samples.
+		 * @param[in] stream_id Stream identifier.
+		 * @param[in] samples Samples in order of sampling.
+		 */
+		typedef std::function<void(uint32_t stream_id, const std::vector<PickSample> &samples)> EmitFunction;
+		/** Default maximum number of samples per second for each stream. */
+		static const int default_max_rate = 60;
+		/** Default maximum number of samples in a batch. */
+		static const uint32_t default_max_batch_size = 256;
+		/** Default maximum number of streams for each client. */
+		static const size_t default_max_streams = 8;
+		PickStream(const SampleFunction &sample, const EmitFunction &emit);
+		~PickStream();
+		/**
+		 * Set server side limits. Existing streams keep their limits.
+		 * @param[in] max_rate Maximum number of samples per second for each stream.
+		 * @param[in] max_batch_size Maximum number of samples in a batch.
+		 * @param[in] max_streams Maximum number of streams for each client.
+		 */
+		void setLimits(float max_rate, uint32_t max_batch_size, size_t max_streams);
+		/**
+		 * Start new stream. Timer is started when the first stream is added.
+		 * @param[in] owner Client name. Only owner can stop a stream.
+		 * @param[in] converter_name Converter used to create sample text.
+		 * @param[in] rate Requested number of samples per second. Limited to maximum rate.
+		 * @param[in] batch_size Number of samples delivered at once. Limited to [1, maximum batch size].
+		 * @return Stream identifier, or 0 if owner already has maximum number of streams.
+		 */
+		uint32_t start(const std::string &owner, const std::string &converter_name, float rate, uint32_t batch_size);
+		/**
+		 * Stop stream. Samples which do not fill a whole batch are delivered before stopping.
+		 * @param[in] owner Client name.
+		 * @param[in] stream_id Stream identifier.
+		 * @return False if stream does not exist or belongs to another client.
+		 */
+		bool stop(const std::string &owner, uint32_t stream_id);
+		/**
+		 * Stop all streams of a client without delivering remaining samples, for example after client disconnects.
+		 * @param[in] owner Client name.
+		 */
+		void stopOwner(const std::string &owner);
+		/** Stop all streams without delivering remaining samples. */
+		void clear();
+		size_t getStreamCount() const;
+		size_t getStreamCount(const std::string &owner) const;
+		/**
+		 * Take samples for all due streams and deliver full batches.
+		 * @param[in] now Monotonic time in microseconds.
+		 * @return Milliseconds until the next stream is due, or -1 if there are no streams.
+		 */
+		int step(int64_t now);
+	private:
+		struct Stream
+		{
+			std::string owner;
+			std::string converter_name;
+			int64_t interval;
+			int64_t next_sample;
+			size_t batch_size;
+			std::vector<PickSample> samples;
+		};
+		SampleFunction m_sample;
+		EmitFunction m_emit;
+		std::map<uint32_t, Stream> m_streams;
+		uint32_t m_last_id;
+		float m_max_rate;
+		uint32_t m_max_batch_size;
+		size_t m_max_streams;
+		unsigned int m_source_id;
+		void schedule(int interval);
+		void unschedule();
+		static int onTimeout(void *data);
+};
+
+#endif /* GPICK_PICK_STREAM_H_ */
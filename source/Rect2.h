@@ -23,7 +23,7 @@ namespace math{
 template<typename T>
 class Rect2{
 public:
-	Rect2(){
+	Rect2():x1(0),y1(0),x2(0),y2(0){
 		empty=true;
 	};
 	Rect2(const T &x1_, const T &y1_, const T &x2_, const T &y2_):x1(x1_),y1(y1_),x2(x2_),y2(y2_){
@@ -45,6 +45,7 @@ public:
 		if (empty) return rect;
 
 		Rect2 r;
+		r.empty = false;
 
 		if (x1 < rect.x1) r.x1 = x1;
 		else r.x1 = rect.x1;
@@ -64,6 +65,26 @@ public:
 		return *this;
 	};
 
+	bool operator==(const Rect2 &rect) const{
+		if (empty || rect.empty) return empty == rect.empty;
+		return x1 == rect.x1 && y1 == rect.y1 && x2 == rect.x2 && y2 == rect.y2;
+	};
+
+	bool operator!=(const Rect2 &rect) const{
+		return !(*this == rect);
+	};
+
+	Rect2 intersect(const Rect2 &rect) const{
+		Rect2 r;
+		if (empty || rect.empty) return r;
+		r.x1 = x1 > rect.x1 ? x1 : rect.x1;
+		r.y1 = y1 > rect.y1 ? y1 : rect.y1;
+		r.x2 = x2 < rect.x2 ? x2 : rect.x2;
+		r.y2 = y2 < rect.y2 ? y2 : rect.y2;
+		r.empty = !(r.x1 < r.x2 && r.y1 < r.y2);
+		return r;
+	}
+
 	Rect2 impose(const Rect2 &rect) const{
 		Rect2 r;
 		r.x1 = rect.x1 + x1 * rect.getWidth();
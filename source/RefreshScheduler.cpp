@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "RefreshScheduler.h"
+#include <glib.h>
+#include <algorithm>
+
+/** Weight of the newest sample in moving averages */
+static const double average_weight = 0.1;
+
+static int rate_to_interval(float rate)
+{
+	if (rate <= 0) return 1000;
+	return std::max(1, int(1000 / rate + 0.5f));
+}
+static void add_sample(double &average, double value, uint64_t samples)
+{
+	if (samples <= 1)
+		average = value;
+	else
+		average += (value - average) * average_weight;
+}
+RefreshScheduler::RefreshScheduler(const std::function<bool()> &update):
+	m_update(update),
+	m_source_id(0),
+	m_active_interval(rate_to_interval(30)),
+	m_idle_interval(rate_to_interval(5)),
+	m_interval(m_active_interval),
+	m_scheduled_interval(0),
+	m_idle_delay(500000),
+	m_last_change(0),
+	m_last_update(0),
+	m_statistics{0, 0, 0, 0, 0, 0}
+{
+}
+RefreshScheduler::~RefreshScheduler()
+{
+	stop();
+}
+void RefreshScheduler::setRates(float active_rate, float idle_rate)
+{
+	m_active_interval = rate_to_interval(active_rate);
+	m_idle_interval = std::max(m_active_interval, rate_to_interval(idle_rate));
+	m_interval = std::min(std::max(m_interval, m_active_interval), m_idle_interval);
+	if (isRunning() && m_scheduled_interval != m_interval)
+		schedule(m_interval);
+}
+void RefreshScheduler::setIdleDelay(int idle_delay)
+{
+	m_idle_delay = int64_t(idle_delay) * 1000;
+}
+void RefreshScheduler::start()
+{
+	m_last_change = g_get_monotonic_time();
+	m_interval = m_active_interval;
+	schedule(m_interval);
+}
+void RefreshScheduler::stop()
+{
+	if (m_source_id){
+		g_source_remove(m_source_id);
+		m_source_id = 0;
+	}
+}
+bool RefreshScheduler::isRunning() const
+{
+	return m_source_id != 0;
+}
+void RefreshScheduler::wake()
+{
+	m_last_change = g_get_monotonic_time();
+	if (m_interval == m_active_interval) return;
+	m_interval = m_active_interval;
+	if (isRunning())
+		schedule(m_interval);
+}
+int RefreshScheduler::step(bool changed, int64_t now)
+{
+	if (changed){
+		m_last_change = now;
+		m_interval = m_active_interval;
+	}else if (now - m_last_change >= m_idle_delay){
+		m_interval = std::min(m_interval * 2, m_idle_interval);
+	}
+	m_statistics.rate = 1000.0 / m_interval;
+	return m_interval;
+}
+const RefreshScheduler::Statistics &RefreshScheduler::getStatistics() const
+{
+	return m_statistics;
+}
+void RefreshScheduler::schedule(int interval)
+{
+	stop();
+	m_scheduled_interval = interval;
+	m_statistics.rate = 1000.0 / interval;
+	m_source_id = g_timeout_add_full(G_PRIORITY_DEFAULT_IDLE, interval, (GSourceFunc)onTimeout, this, nullptr);
+}
+int RefreshScheduler::onTimeout(void *data)
+{
+	RefreshScheduler *scheduler = reinterpret_cast<RefreshScheduler*>(data);
+	unsigned int source_id = scheduler->m_source_id;
+	int64_t start = g_get_monotonic_time();
+	bool changed = scheduler->m_update();
+	int64_t end = g_get_monotonic_time();
+	Statistics &statistics = scheduler->m_statistics;
+	statistics.updates++;
+	if (changed) statistics.changed_updates++;
+	double time = (end - start) / 1000.0;
+	add_sample(statistics.average_time, time, statistics.updates);
+	statistics.max_time = std::max(statistics.max_time, time);
+	if (scheduler->m_last_update)
+		add_sample(statistics.average_interval, (start - scheduler->m_last_update) / 1000.0, statistics.updates - 1);
+	scheduler->m_last_update = start;
+	if (scheduler->m_source_id != source_id) return false;
+	int interval = scheduler->step(changed, end);
+	if (interval == scheduler->m_scheduled_interval) return true;
+	scheduler->m_source_id = 0;
+	scheduler->schedule(interval);
+	return false;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GPICK_REFRESH_SCHEDULER_H_
+#define GPICK_REFRESH_SCHEDULER_H_
+
+#include <cstdint>
+#include <functional>
+
+/** \file source/RefreshScheduler.h
+ * \brief Adaptive timer for periodic display updates.
+ */
+
+/** \class RefreshScheduler
+ * \brief Calls update function at active rate while updates report changes, and gradually backs off to idle rate when nothing changes.
+ */
+class RefreshScheduler
+{
+	public:
+		struct Statistics
+		{
+			uint64_t updates; /**< Number of update calls */
+			uint64_t changed_updates; /**< Number of update calls which reported a change */
+			double rate; /**< Currently scheduled number of updates per second */
+			double average_time; /**< Moving average of update duration in milliseconds */
+			double max_time; /**< Longest update duration in milliseconds */
+			double average_interval; /**< Moving average of time between update starts in milliseconds */
+		};
+		/**
+		 * Create scheduler. Timer is not started.
+		 * @param[in] update Function called on each timer tick. Returns true if anything has changed since the previous call.
+		 */
+		RefreshScheduler(const std::function<bool()> &update);
+		~RefreshScheduler();
+		/**
+		 * Set update rates.
+		 * @param[in] active_rate Updates per second while changes are reported.
+		 * @param[in] idle_rate Lowest number of updates per second when no changes are reported.
+		 */
+		void setRates(float active_rate, float idle_rate);
+		/**
+		 * Set time without changes after which update rate starts to decrease.
+		 * @param[in] idle_delay Delay in milliseconds.
+		 */
+		void setIdleDelay(int idle_delay);
+		void start();
+		void stop();
+		bool isRunning() const;
+		/** Switch to active rate immediately, for example after pointer motion event. */
+		void wake();
+		/**
+		 * Calculate interval until next update.
+		 * @param[in] changed Whether the last update reported a change.
+		 * @param[in] now Monotonic time of the last update in microseconds.
+		 * @return Interval in milliseconds.
+		 */
+		int step(bool changed, int64_t now);
+		const Statistics &getStatistics() const;
+	private:
+		std::function<bool()> m_update;
+		unsigned int m_source_id;
+		int m_active_interval, m_idle_interval, m_interval, m_scheduled_interval;
+		int64_t m_idle_delay, m_last_change, m_last_update;
+		Statistics m_statistics;
+		void schedule(int interval);
+		static int onTimeout(void *data);
+};
+
+#endif /* GPICK_REFRESH_SCHEDULER_H_ */
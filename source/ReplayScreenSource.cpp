@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ReplayScreenSource.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+using namespace math;
+using namespace std;
+
+ReplayScreenSource::ReplayScreenSource():
+	m_position(0)
+{
+}
+ReplayScreenSource::~ReplayScreenSource()
+{
+	for (auto surface: m_frames)
+		cairo_surface_destroy(surface);
+}
+bool ReplayScreenSource::load(const char *filename)
+{
+	ifstream file(filename);
+	if (!file.is_open()){
+		cerr << "failed to open screen recording \"" << filename << "\"" << endl;
+		return false;
+	}
+	string path = filename;
+	size_t separator = path.find_last_of("/\\");
+	path = separator == string::npos ? "" : path.substr(0, separator + 1);
+	string line, type;
+	size_t line_number = 0;
+	while (getline(file, line)){
+		line_number++;
+		istringstream stream(line);
+		if (!(stream >> type) || type[0] == '#') continue;
+		if (type == "frame"){
+			string name;
+			stream >> ws;
+			getline(stream, name);
+			if (name.empty()){
+				cerr << filename << ":" << line_number << ": frame file name is missing" << endl;
+				return false;
+			}
+			if (name[0] != '/' && !path.empty()) name = path + name;
+			if (!addFrame(name.c_str())) return false;
+		}else if (type == "pointer"){
+			Vec2<int> pointer;
+			if (!(stream >> pointer.x >> pointer.y) || !addPointer(pointer)){
+				cerr << filename << ":" << line_number << ": invalid pointer position" << endl;
+				return false;
+			}
+		}else{
+			cerr << filename << ":" << line_number << ": unknown entry \"" << type << "\"" << endl;
+			return false;
+		}
+	}
+	return true;
+}
+bool ReplayScreenSource::addFrame(const char *filename)
+{
+	cairo_surface_t *surface = cairo_image_surface_create_from_png(filename);
+	if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS){
+		cerr << "failed to load frame \"" << filename << "\"" << endl;
+		cairo_surface_destroy(surface);
+		return false;
+	}
+	m_frames.push_back(surface);
+	return true;
+}
+void ReplayScreenSource::addFrame(cairo_surface_t *surface)
+{
+	m_frames.push_back(cairo_surface_reference(surface));
+}
+bool ReplayScreenSource::addPointer(const Vec2<int> &pointer)
+{
+	if (m_frames.empty()) return false;
+	m_events.push_back(Event{m_frames.size() - 1, pointer});
+	return true;
+}
+bool ReplayScreenSource::next()
+{
+	if (m_position < m_events.size()) m_position++;
+	return valid();
+}
+void ReplayScreenSource::rewind()
+{
+	m_position = 0;
+}
+size_t ReplayScreenSource::getPointerCount() const
+{
+	return m_events.size();
+}
+size_t ReplayScreenSource::getFrameCount() const
+{
+	return m_frames.size();
+}
+bool ReplayScreenSource::valid() const
+{
+	return m_position < m_events.size();
+}
+bool ReplayScreenSource::getPointer(Vec2<int> &pointer, Rect2<int> &screen_rect)
+{
+	if (!valid()) return false;
+	const Event &event = m_events[m_position];
+	cairo_surface_t *surface = m_frames[event.frame];
+	pointer = event.pointer;
+	screen_rect = Rect2<int>(0, 0, cairo_image_surface_get_width(surface), cairo_image_surface_get_height(surface));
+	return true;
+}
+bool ReplayScreenSource::setSource(cairo_t *cr, int left, int top)
+{
+	if (!valid()) return false;
+	cairo_set_source_surface(cr, m_frames[m_events[m_position].frame], -left, -top);
+	cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_NEAREST);
+	return true;
+}
+uint64_t ReplayScreenSource::getSerial() const
+{
+	if (!valid()) return 0;
+	return m_events[m_position].frame;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GPICK_REPLAY_SCREEN_SOURCE_H_
+#define GPICK_REPLAY_SCREEN_SOURCE_H_
+
+#include "ScreenSource.h"
+#include <string>
+#include <vector>
+
+/** \file source/ReplayScreenSource.h
+ * \brief Screen source replaying recorded frames and pointer positions without a display.
+ */
+
+/** \class ReplayScreenSource
+ * \brief Screen source serving frames from images and a recorded sequence of pointer positions.
+ *
+ * Recording is a text file with one entry per line. Empty lines and lines starting with "#" are ignored.
+ * "frame <file>" loads PNG image, which is used as screen contents for all following pointer positions. Relative file names are resolved against recording file directory.
+ * "pointer <x> <y>" adds one pointer position.
+ * Screen area is equal to current frame area, with top-left corner at (0, 0).
+ */
+class ReplayScreenSource: public ScreenSource
+{
+	public:
+		ReplayScreenSource();
+		virtual ~ReplayScreenSource();
+		/**
+		 * Load recording file. Frames and pointer positions are appended to already existing ones.
+		 * @param[in] filename Recording file name.
+		 * @return True on success.
+		 */
+		bool load(const char *filename);
+		/**
+		 * Add PNG image as a new frame.
+		 * @param[in] filename Image file name.
+		 * @return True on success.
+		 */
+		bool addFrame(const char *filename);
+		/**
+		 * Add image surface as a new frame.
+		 * @param[in] surface Image surface. Reference is added to the surface.
+		 */
+		void addFrame(cairo_surface_t *surface);
+		/**
+		 * Add pointer position, which uses the last added frame as screen contents.
+		 * @param[in] pointer Pointer position.
+		 * @return False if there are no frames.
+		 */
+		bool addPointer(const math::Vec2<int> &pointer);
+		/**
+		 * Advance to the next pointer position.
+		 * @return False if there are no more pointer positions.
+		 */
+		bool next();
+		/** Move back to the first pointer position. */
+		void rewind();
+		size_t getPointerCount() const;
+		size_t getFrameCount() const;
+		virtual bool getPointer(math::Vec2<int> &pointer, math::Rect2<int> &screen_rect);
+		virtual bool setSource(cairo_t *cr, int left, int top);
+		virtual uint64_t getSerial() const;
+	private:
+		struct Event
+		{
+			size_t frame;
+			math::Vec2<int> pointer;
+		};
+		std::vector<cairo_surface_t *> m_frames;
+		std::vector<Event> m_events;
+		size_t m_position;
+		bool valid() const;
+};
+
+#endif /* GPICK_REPLAY_SCREEN_SOURCE_H_ */
@@ -19,7 +19,10 @@
 #include "Sampler.h"
 #include "ScreenReader.h"
 #include "MathUtil.h"
+#include "ColorBatch.h"
 #include <math.h>
+#include <stdint.h>
+#include <vector>
 #include <gdk/gdk.h>
 using namespace math;
 
@@ -28,6 +31,8 @@ struct Sampler
 	int oversample;
 	SamplerFalloff falloff;
 	float (*falloff_fnc)(float distance);
+	/** Fixed-point falloff weight of each pixel in the oversample window, row by row */
+	std::vector<int16_t> weights;
 	ScreenReader* screen_reader;
 };
 static float sampler_falloff_none(float distance)
@@ -50,6 +55,28 @@ static float sampler_falloff_exponential(float distance)
 {
 	return 1 / exp(5 * distance * distance);
 }
+/**
+ * Precompute falloff weights. Weights are scaled so that the weighted sum of all 8-bit pixel values in the window fits into 32-bit integer.
+ */
+static void sampler_update_weights(Sampler *sampler)
+{
+	int oversample = sampler->oversample;
+	int size = oversample * 2 + 1;
+	double scale = min_int(INT16_MAX, INT32_MAX / (255 * size * size));
+	float max_distance = oversample ? 1 / sqrt(2 * pow((double)oversample, 2)) : 0;
+	sampler->weights.resize(size * size);
+	for (int y = -oversample; y <= oversample; ++y){
+		for (int x = -oversample; x <= oversample; ++x){
+			float f;
+			if (oversample){
+				f = sampler->falloff_fnc(sqrt((double)(x * x + y * y)) * max_distance);
+			}else{
+				f = 1;
+			}
+			sampler->weights[(y + oversample) * size + x + oversample] = int16_t(floor(f * scale + 0.5));
+		}
+	}
+}
 struct Sampler* sampler_new(ScreenReader* screen_reader)
 {
 	Sampler* sampler = new Sampler;
@@ -82,59 +109,44 @@ void sampler_set_falloff(Sampler *sampler, SamplerFalloff falloff)
 		sampler->falloff_fnc = sampler_falloff_exponential;
 		break;
 	default:
-		sampler->falloff_fnc = 0;
+		sampler->falloff_fnc = sampler_falloff_none;
 	}
+	sampler_update_weights(sampler);
 }
 void sampler_set_oversample(Sampler *sampler, int oversample)
 {
+	if (sampler->oversample == oversample) return;
 	sampler->oversample = oversample;
-}
-static void get_pixel(unsigned char *data, int stride, int x, int y, Color* color)
-{
-	unsigned char *p;
-	p = data + y * stride + x * 4;
-	color->rgb.red = p[2] * (1 / 255.0);
-	color->rgb.green = p[1] * (1 / 255.0);
-	color->rgb.blue = p[0] * (1 / 255.0);
+	sampler_update_weights(sampler);
 }
 int sampler_get_color_sample(Sampler *sampler, Vec2<int>& pointer, Rect2<int>& screen_rect, Vec2<int>& offset, Color* color)
 {
-	Color sample, result;
-	float divider = 0;
-	color_zero(&result);
 	cairo_surface_t *surface = screen_reader_get_surface(sampler->screen_reader);
 	int x = pointer.x, y = pointer.y;
+	int oversample = sampler->oversample;
 	int left, right, top, bottom;
-	left = max_int(screen_rect.getLeft(), x - sampler->oversample);
-	right = min_int(screen_rect.getRight(), x + sampler->oversample + 1);
-	top = max_int(screen_rect.getTop(), y - sampler->oversample);
-	bottom = min_int(screen_rect.getBottom(), y + sampler->oversample + 1);
+	left = max_int(screen_rect.getLeft(), x - oversample);
+	right = min_int(screen_rect.getRight(), x + oversample + 1);
+	top = max_int(screen_rect.getTop(), y - oversample);
+	bottom = min_int(screen_rect.getBottom(), y + oversample + 1);
 	int width = right - left;
-	int height = bottom - top;
-	int center_x = x - left;
-	int center_y = y - top;
-	float max_distance = 1 / sqrt(2 * pow((double)sampler->oversample, 2));
+	int size = oversample * 2 + 1;
 	unsigned char *data = cairo_image_surface_get_data(surface);
 	int stride = cairo_image_surface_get_stride(surface);
-	for (int x=-sampler->oversample; x <= sampler->oversample; ++x){
-		for (int y=-sampler->oversample; y <= sampler->oversample; ++y){
-			if ((center_x + x < 0) || (center_y + y < 0)) continue;
-			if ((center_x + x >= width) || (center_y + y >= height)) continue;
-			get_pixel(data, stride, offset.x + center_x + x, offset.y + center_y + y, &sample);
-			float f;
-			if (sampler->oversample){
-				f = sampler->falloff_fnc(sqrt((double)(x * x + y * y)) * max_distance);
-			}else{
-				f = 1;
-			}
-			color_multiply(&sample, f);
-			color_add(&result, &sample);
-			divider += f;
-		}
+	int32_t sums[4] = {0, 0, 0, 0};
+	int32_t divider = 0;
+	for (int row = top; row < bottom; ++row){
+		const int16_t *weights = &sampler->weights[(row - y + oversample) * size + left - x + oversample];
+		color_batch_accumulate_bgra(data + (offset.y + row - top) * stride + offset.x * 4, weights, width, sums);
+		for (int i = 0; i < width; ++i)
+			divider += weights[i];
+	}
+	color_zero(color);
+	if (divider > 0){
+		color->rgb.red = sums[2] / (255.0 * divider);
+		color->rgb.green = sums[1] / (255.0 * divider);
+		color->rgb.blue = sums[0] / (255.0 * divider);
 	}
-	if (divider > 0)
-		color_multiply(&result, 1 / divider);
-	color_copy(&result, color);
 	return 0;
 }
 enum SamplerFalloff sampler_get_falloff(Sampler *sampler)
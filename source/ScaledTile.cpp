@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ScaledTile.h"
+#include "ColorBatch.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+using namespace std;
+
+/** Get first output position of each source position. Result has one additional element equal to output size. */
+static void get_starts(int area_size, int size, vector<int> &starts)
+{
+	starts.resize(area_size + 1);
+	int position = 0;
+	for (int i = 0; i <= area_size; i++){
+		while (position < size && int((2 * int64_t(position) + 1) * area_size / (2 * int64_t(size))) < i)
+			position++;
+		starts[i] = position;
+	}
+}
+ScaledTile::ScaledTile():
+	m_left(0),
+	m_top(0),
+	m_area_width(0),
+	m_area_height(0),
+	m_width(0),
+	m_height(0),
+	m_origin_x(0),
+	m_origin_y(0),
+	m_output(nullptr),
+	m_output_stride(0),
+	m_valid(false)
+{
+}
+void ScaledTile::invalidate()
+{
+	m_valid = false;
+}
+void ScaledTile::getOrigin(int &x, int &y) const
+{
+	if (m_columns.empty()){
+		x = y = 0;
+		return;
+	}
+	x = m_columns[m_origin_x];
+	y = m_rows[m_origin_y];
+}
+size_t ScaledTile::update(const uint8_t *source, int source_stride, int left, int top, int area_width, int area_height, uint8_t *output, int output_stride, int width, int height)
+{
+	if (area_width <= 0 || area_height <= 0 || width <= 0 || height <= 0) return 0;
+	if (area_width != m_area_width || area_height != m_area_height || width != m_width || height != m_height || output != m_output || output_stride != m_output_stride){
+		m_area_width = area_width;
+		m_area_height = area_height;
+		m_width = width;
+		m_height = height;
+		m_output = output;
+		m_output_stride = output_stride;
+		get_starts(area_width, width, m_columns);
+		get_starts(area_height, height, m_rows);
+		m_source.resize(area_width * area_height);
+		m_valid = false;
+	}
+	bool integer_factor = width % area_width == 0 && height % area_height == 0;
+	int dx = left - m_left, dy = top - m_top;
+	m_left = left;
+	m_top = top;
+	if (m_valid && (dx || dy) && (!integer_factor || abs(dx) >= area_width || abs(dy) >= area_height))
+		m_valid = false;
+	int known_left = 0, known_right = area_width, known_top = 0, known_bottom = area_height;
+	if (!m_valid){
+		m_origin_x = m_origin_y = 0;
+		known_right = known_bottom = 0;
+	}else{
+		// Moving the origin shifts both cached source pixels and output without copying them.
+		m_origin_x = (m_origin_x + dx % area_width + area_width) % area_width;
+		m_origin_y = (m_origin_y + dy % area_height + area_height) % area_height;
+		if (dx > 0) known_right -= dx; else known_left -= dx;
+		if (dy > 0) known_bottom -= dy; else known_top -= dy;
+	}
+	int factor = width / area_width;
+	size_t rendered = 0;
+	for (int y = 0; y < area_height; y++){
+		const uint32_t *source_row = reinterpret_cast<const uint32_t*>(source + y * source_stride);
+		int tile_y = (y + m_origin_y) % area_height;
+		uint32_t *cached_row = &m_source[tile_y * area_width];
+		int begin = area_width, end = 0;
+		if (y < known_top || y >= known_bottom){
+			begin = 0;
+			end = area_width;
+		}else{
+			for (int x = 0; x < area_width; x++){
+				if (x < known_left || x >= known_right || source_row[x] != cached_row[(x + m_origin_x) % area_width]){
+					begin = min(begin, x);
+					end = x + 1;
+				}
+			}
+		}
+		if (begin >= end) continue;
+		rendered += end - begin;
+		// Changed span can wrap around the right edge of the tile, so it is rendered as up to two parts.
+		int wrap = area_width - m_origin_x;
+		int parts[2][2] = {{begin, min(end, wrap)}, {max(begin, wrap), end}};
+		for (auto &part: parts){
+			if (part[0] >= part[1]) continue;
+			int tile_begin = (part[0] + m_origin_x) % area_width, tile_end = tile_begin + part[1] - part[0];
+			memcpy(cached_row + tile_begin, source_row + part[0], (part[1] - part[0]) * 4);
+			if (m_rows[tile_y] == m_rows[tile_y + 1]) continue;
+			uint32_t *output_row = reinterpret_cast<uint32_t*>(output + m_rows[tile_y] * output_stride);
+			if (integer_factor){
+				color_batch_replicate_pixels(source_row + part[0], part[1] - part[0], factor, output_row + tile_begin * factor);
+			}else{
+				for (int x = tile_begin; x < tile_end; x++)
+					std::fill(output_row + m_columns[x], output_row + m_columns[x + 1], source_row[part[0] + x - tile_begin]);
+			}
+			size_t offset = m_columns[tile_begin] * 4, length = (m_columns[tile_end] - m_columns[tile_begin]) * 4;
+			for (int output_y = m_rows[tile_y] + 1; output_y < m_rows[tile_y + 1]; output_y++)
+				memcpy(output + output_y * output_stride + offset, reinterpret_cast<uint8_t*>(output_row) + offset, length);
+		}
+	}
+	m_valid = true;
+	return rendered;
+}
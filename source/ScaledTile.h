@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GPICK_SCALED_TILE_H_
+#define GPICK_SCALED_TILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** \file source/ScaledTile.h
+ * \brief Incrementally updated nearest neighbour upscaling of a screen area.
+ */
+
+/** \class ScaledTile
+ * \brief Keeps nearest neighbour upscaled copy of a screen area in an output buffer and re-renders only parts which have changed.
+ *
+ * Source pixels of the last update are kept, so unchanged source pixels are not rendered again.
+ * Output is stored as a wrapping tile: logical output position (0, 0) is at getOrigin() and positions past the right and bottom edges continue from the left and top edges.
+ * When area moves by whole pixels and scaling factors are integers, only the origin moves and newly exposed rows and columns are rendered.
+ * Logical output pixel (x, y) shows source pixel (floor((x + 0.5) * area_width / width), floor((y + 0.5) * area_height / height)).
+ */
+class ScaledTile
+{
+	public:
+		ScaledTile();
+		/**
+		 * Update output to show source area.
+		 * @param[in] source First pixel of source area. Pixels are 32-bit values.
+		 * @param[in] source_stride Distance between source rows in bytes.
+		 * @param[in] left Screen position of source area, used to detect area movement.
+		 * @param[in] top Screen position of source area, used to detect area movement.
+		 * @param[in] area_width Source area width.
+		 * @param[in] area_height Source area height.
+		 * @param[out] output First pixel of output. Contents must not be modified between updates.
+		 * @param[in] output_stride Distance between output rows in bytes.
+		 * @param[in] width Output width.
+		 * @param[in] height Output height.
+		 * @return Number of source pixels rendered.
+		 */
+		size_t update(const uint8_t *source, int source_stride, int left, int top, int area_width, int area_height, uint8_t *output, int output_stride, int width, int height);
+		/** Render whole output on the next update. */
+		void invalidate();
+		/**
+		 * Get position of logical output pixel (0, 0) in output.
+		 * @param[out] x Column.
+		 * @param[out] y Row.
+		 */
+		void getOrigin(int &x, int &y) const;
+	private:
+		std::vector<int> m_columns, m_rows;
+		std::vector<uint32_t> m_source;
+		int m_left, m_top, m_area_width, m_area_height, m_width, m_height;
+		int m_origin_x, m_origin_y; /**< Origin in source pixels */
+		uint8_t *m_output;
+		int m_output_stride;
+		bool m_valid;
+};
+
+#endif /* GPICK_SCALED_TILE_H_ */
@@ -17,16 +17,11 @@
  */
 
 #include "ScreenReader.h"
+#include "ScreenSource.h"
 #include "Rect2.h"
-#include <gtk/gtk.h>
-#if GTK_MAJOR_VERSION >= 3
-#define COGL_ENABLE_EXPERIMENTAL_2_0_API
-#define CLUTTER_ENABLE_EXPERIMENTAL_API
-#include <clutter/clutter.h>
-#include <cogl/cogl.h>
-#endif
+#include <glib.h>
 #include <algorithm>
-#include <iostream>
+#include <cstring>
 using namespace math;
 using namespace std;
 
@@ -34,15 +29,37 @@ struct ScreenReader
 {
 	cairo_surface_t *surface;
 	int max_size;
-	GdkScreen *screen;
+	std::unique_ptr<ScreenSource> source;
 	Rect2<int> read_area;
+	uint64_t surface_serial;
+	Rect2<int> surface_area;
+	gint64 surface_time;
+	gint64 max_age;
+	bool damaged;
+	ScreenReaderStatistics statistics;
+	gint64 rate_time;
+	uint64_t rate_bytes;
 };
+static const gint64 rate_interval = 1000000;
+/** Default maximum age of surface contents in microseconds. Screen changes are not tracked, so this limits how long changed pixels can stay outdated. */
+static const gint64 default_max_age = 50000;
 struct ScreenReader* screen_reader_new()
+{
+	return screen_reader_new(std::unique_ptr<ScreenSource>(new GdkScreenSource()));
+}
+struct ScreenReader* screen_reader_new(std::unique_ptr<ScreenSource> source)
 {
 	ScreenReader* screen = new ScreenReader;
 	screen->max_size = 0;
 	screen->surface = 0;
-	screen->screen = 0;
+	screen->source = std::move(source);
+	screen->surface_serial = 0;
+	screen->surface_time = 0;
+	screen->max_age = default_max_age;
+	screen->damaged = true;
+	screen->statistics = ScreenReaderStatistics{0, 0, 0, 0, 0};
+	screen->rate_time = g_get_monotonic_time();
+	screen->rate_bytes = 0;
 	return screen;
 }
 void screen_reader_destroy(ScreenReader *screen)
@@ -50,48 +67,119 @@ void screen_reader_destroy(ScreenReader *screen)
 	if (screen->surface) cairo_surface_destroy(screen->surface);
 	delete screen;
 }
-void screen_reader_add_rect(ScreenReader *screen, GdkScreen *gdk_screen, Rect2<int>& rect)
+ScreenSource *screen_reader_get_source(ScreenReader *screen)
 {
-	if (screen->screen && (screen->screen == gdk_screen)){
-		screen->read_area += rect;
-	}else{
-		screen->read_area += rect;
-		screen->screen = gdk_screen;
-	}
+	return screen->source.get();
+}
+bool screen_reader_get_pointer(ScreenReader *screen, Vec2<int> &pointer, Rect2<int> &screen_rect)
+{
+	return screen->source->getPointer(pointer, screen_rect);
+}
+void screen_reader_add_rect(ScreenReader *screen, Rect2<int>& rect)
+{
+	screen->read_area += rect;
 }
 void screen_reader_reset_rect(ScreenReader *screen)
 {
 	screen->read_area = Rect2<int>();
-	screen->screen = NULL;
 }
-void screen_reader_update_surface(ScreenReader *screen, Rect2<int>* update_rect)
+void screen_reader_invalidate(ScreenReader *screen)
+{
+	screen->damaged = true;
+}
+void screen_reader_set_max_age(ScreenReader *screen, int max_age)
 {
-	if (!screen->screen) return;
-	int left = screen->read_area.getX();
-	int top = screen->read_area.getY();
+	screen->max_age = gint64(max_age) * 1000;
+}
+static void update_rate(ScreenReader *screen, gint64 now)
+{
+	gint64 elapsed = now - screen->rate_time;
+	if (elapsed < rate_interval) return;
+	screen->statistics.bytes_per_second = screen->rate_bytes * 1000000.0 / elapsed;
+	screen->rate_bytes = 0;
+	screen->rate_time = now;
+}
+static void add_captured_area(ScreenReader *screen, const Rect2<int> &rect, cairo_t *cr)
+{
+	if (rect.isEmpty()) return;
+	cairo_rectangle(cr, rect.getX() - screen->read_area.getX(), rect.getY() - screen->read_area.getY(), rect.getWidth(), rect.getHeight());
+	uint64_t bytes = uint64_t(rect.getWidth()) * rect.getHeight() * 4;
+	screen->statistics.bytes_captured += bytes;
+	screen->rate_bytes += bytes;
+}
+static void move_overlapping_pixels(ScreenReader *screen, const Rect2<int> &overlap)
+{
+	cairo_surface_flush(screen->surface);
+	unsigned char *data = cairo_image_surface_get_data(screen->surface);
+	int stride = cairo_image_surface_get_stride(screen->surface);
+	const Rect2<int> &from = screen->surface_area, &to = screen->read_area;
+	size_t row_size = overlap.getWidth() * 4;
+	int rows = overlap.getHeight();
+	int source_row = overlap.getY() - from.getY(), destination_row = overlap.getY() - to.getY();
+	unsigned char *source = data + (overlap.getX() - from.getX()) * 4;
+	unsigned char *destination = data + (overlap.getX() - to.getX()) * 4;
+	if (destination_row > source_row){
+		for (int y = rows - 1; y >= 0; y--)
+			memmove(destination + (destination_row + y) * stride, source + (source_row + y) * stride, row_size);
+	}else{
+		for (int y = 0; y < rows; y++)
+			memmove(destination + (destination_row + y) * stride, source + (source_row + y) * stride, row_size);
+	}
+	cairo_surface_mark_dirty(screen->surface);
+}
+bool screen_reader_update_surface(ScreenReader *screen, Rect2<int>* update_rect)
+{
+	if (screen->read_area.isEmpty()) return false;
+	gint64 now = g_get_monotonic_time();
+	update_rate(screen, now);
 	int width = screen->read_area.getWidth();
 	int height = screen->read_area.getHeight();
 	if (width > screen->max_size || height > screen->max_size){
 		if (screen->surface) cairo_surface_destroy(screen->surface);
 		screen->max_size = (std::max(width, height) / 150 + 1) * 150;
 		screen->surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, screen->max_size, screen->max_size);
+		screen->damaged = true;
 	}
-	GdkWindow* root_window = gdk_screen_get_root_window(screen->screen);
-	cairo_t *root_cr = gdk_cairo_create(root_window);
-	cairo_surface_t *root_surface = cairo_get_target(root_cr);
-	if (cairo_surface_status(root_surface) != CAIRO_STATUS_SUCCESS){
-		cerr << "can not get root window surface" << endl;
-		return;
+	uint64_t serial = screen->source->getSerial();
+	bool valid = !screen->damaged && screen->surface_serial == serial && now - screen->surface_time < screen->max_age;
+	if (valid && screen->surface_area == screen->read_area){
+		screen->statistics.skipped++;
+		*update_rect = screen->read_area;
+		return false;
 	}
+	Rect2<int> overlap;
+	if (valid) overlap = screen->surface_area.intersect(screen->read_area);
 	cairo_t *cr = cairo_create(screen->surface);
 	cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
-	cairo_set_source_surface(cr, root_surface, -left, -top);
-	cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_NEAREST);
-	cairo_rectangle(cr, 0, 0, width, height);
+	if (!screen->source->setSource(cr, screen->read_area.getX(), screen->read_area.getY())){
+		cairo_destroy(cr);
+		return false;
+	}
+	const Rect2<int> &area = screen->read_area;
+	if (overlap.isEmpty()){
+		add_captured_area(screen, area, cr);
+		screen->surface_time = now;
+		screen->statistics.captures++;
+	}else{
+		move_overlapping_pixels(screen, overlap);
+		add_captured_area(screen, Rect2<int>(area.getLeft(), area.getTop(), area.getRight(), overlap.getTop()).intersect(area), cr);
+		add_captured_area(screen, Rect2<int>(area.getLeft(), overlap.getBottom(), area.getRight(), area.getBottom()).intersect(area), cr);
+		add_captured_area(screen, Rect2<int>(area.getLeft(), overlap.getTop(), overlap.getLeft(), overlap.getBottom()).intersect(area), cr);
+		add_captured_area(screen, Rect2<int>(overlap.getRight(), overlap.getTop(), area.getRight(), overlap.getBottom()).intersect(area), cr);
+		screen->statistics.partial_captures++;
+	}
 	cairo_fill(cr);
 	cairo_destroy(cr);
-	cairo_destroy(root_cr);
+	screen->surface_area = screen->read_area;
+	screen->surface_serial = serial;
+	screen->damaged = false;
 	*update_rect = screen->read_area;
+	return true;
+}
+void screen_reader_get_statistics(ScreenReader *screen, ScreenReaderStatistics *statistics)
+{
+	update_rate(screen, g_get_monotonic_time());
+	*statistics = screen->statistics;
 }
 cairo_surface_t* screen_reader_get_surface(ScreenReader *screen)
 {
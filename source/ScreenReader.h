@@ -19,15 +19,67 @@
 #ifndef SCREENREADER_H_
 #define SCREENREADER_H_
 
-#include <gdk/gdk.h>
 #include <cairo/cairo.h>
 #include "Rect2.h"
+#include "Vector2.h"
+#include <cstdint>
+#include <memory>
 
 struct ScreenReader;
+class ScreenSource;
+struct ScreenReaderStatistics
+{
+	uint64_t captures; /**< Number of updates which read whole area from the screen */
+	uint64_t partial_captures; /**< Number of updates which reused overlapping pixels from the previous update */
+	uint64_t skipped; /**< Number of updates which did not read anything from the screen */
+	uint64_t bytes_captured; /**< Total number of bytes read from the screen */
+	double bytes_per_second; /**< Number of bytes read from the screen during the last second */
+};
+/**
+ * Create screen reader which reads screen containing the pointer.
+ * @return Screen reader.
+ */
 ScreenReader* screen_reader_new();
+/**
+ * Create screen reader which reads from a custom screen source.
+ * @param[in] source Screen source. Screen reader takes ownership of it.
+ * @return Screen reader.
+ */
+ScreenReader* screen_reader_new(std::unique_ptr<ScreenSource> source);
+ScreenSource *screen_reader_get_source(ScreenReader *screen);
+/**
+ * Get pointer position and area of the monitor containing the pointer from the screen source.
+ * @param[in] screen Screen reader.
+ * @param[out] pointer Pointer position.
+ * @param[out] screen_rect Monitor area.
+ * @return True on success.
+ */
+bool screen_reader_get_pointer(ScreenReader *screen, math::Vec2<int> &pointer, math::Rect2<int> &screen_rect);
 void screen_reader_reset_rect(ScreenReader *screen);
-void screen_reader_add_rect(ScreenReader *screen, GdkScreen *gdk_screen, math::Rect2<int>& rect);
-void screen_reader_update_surface(ScreenReader *screen, math::Rect2<int>* update_rect);
+void screen_reader_add_rect(ScreenReader *screen, math::Rect2<int>& rect);
+/**
+ * Make surface contain current screen pixels of read area.
+ * Pixels are read from the screen only when read area, screen or damage state has changed since the last update, or when surface contents are older than maximum age.
+ * Changes of screen contents are not tracked, so reused pixels can be outdated by up to maximum age, which is 50 ms by default.
+ * When read area overlaps previous read area, overlapping pixels are moved inside the surface and only newly exposed parts are read from the screen.
+ * @param[in] screen Screen reader.
+ * @param[out] update_rect Screen area contained in the surface, starting at surface origin.
+ * @return True if any pixels were read from the screen.
+ */
+bool screen_reader_update_surface(ScreenReader *screen, math::Rect2<int>* update_rect);
+/**
+ * Mark surface contents as outdated, so that next update reads whole area from the screen.
+ * @param[in] screen Screen reader.
+ */
+void screen_reader_invalidate(ScreenReader *screen);
+/**
+ * Set maximum age of surface contents, after which pixels are read from the screen even if read area has not changed.
+ * Value of 0 reads pixels from the screen on every update.
+ * @param[in] screen Screen reader.
+ * @param[in] max_age Maximum age in milliseconds.
+ */
+void screen_reader_set_max_age(ScreenReader *screen, int max_age);
+void screen_reader_get_statistics(ScreenReader *screen, ScreenReaderStatistics *statistics);
 cairo_surface_t* screen_reader_get_surface(ScreenReader *screen);
 void screen_reader_destroy(ScreenReader *screen);
 
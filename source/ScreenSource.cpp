@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ScreenSource.h"
+#include <gdk/gdk.h>
+#include <iostream>
+using namespace math;
+using namespace std;
+
+ScreenSource::~ScreenSource()
+{
+}
+GdkScreenSource::GdkScreenSource():
+	m_screen(nullptr),
+	m_serial(0)
+{
+}
+bool GdkScreenSource::getPointer(Vec2<int> &pointer, Rect2<int> &screen_rect)
+{
+	GdkScreen *screen;
+	GdkModifierType state;
+	int x, y;
+	gdk_display_get_pointer(gdk_display_get_default(), &screen, &x, &y, &state);
+	int monitor = gdk_screen_get_monitor_at_point(screen, x, y);
+	GdkRectangle monitor_geometry;
+	gdk_screen_get_monitor_geometry(screen, monitor, &monitor_geometry);
+	pointer = Vec2<int>(x, y);
+	screen_rect = Rect2<int>(monitor_geometry.x, monitor_geometry.y, monitor_geometry.x + monitor_geometry.width, monitor_geometry.y + monitor_geometry.height);
+	if (m_screen != screen){
+		m_screen = screen;
+		m_serial++;
+	}
+	return true;
+}
+bool GdkScreenSource::setSource(cairo_t *cr, int left, int top)
+{
+	if (!m_screen) return false;
+	GdkWindow* root_window = gdk_screen_get_root_window(m_screen);
+	cairo_t *root_cr = gdk_cairo_create(root_window);
+	cairo_surface_t *root_surface = cairo_get_target(root_cr);
+	if (cairo_surface_status(root_surface) != CAIRO_STATUS_SUCCESS){
+		cerr << "can not get root window surface" << endl;
+		cairo_destroy(root_cr);
+		return false;
+	}
+	cairo_set_source_surface(cr, root_surface, -left, -top);
+	cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_NEAREST);
+	cairo_destroy(root_cr);
+	return true;
+}
+uint64_t GdkScreenSource::getSerial() const
+{
+	return m_serial;
+}
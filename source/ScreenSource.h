@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GPICK_SCREEN_SOURCE_H_
+#define GPICK_SCREEN_SOURCE_H_
+
+#include "Rect2.h"
+#include "Vector2.h"
+#include <cairo/cairo.h>
+#include <cstdint>
+typedef struct _GdkScreen GdkScreen;
+
+/** \file source/ScreenSource.h
+ * \brief Sources of screen contents and pointer position used by ScreenReader.
+ */
+
+/** \class ScreenSource
+ * \brief Interface of screen contents and pointer position provider.
+ */
+class ScreenSource
+{
+	public:
+		virtual ~ScreenSource();
+		/**
+		 * Get pointer position and area of the monitor containing the pointer.
+		 * @param[out] pointer Pointer position.
+		 * @param[out] screen_rect Monitor area.
+		 * @return True on success.
+		 */
+		virtual bool getPointer(math::Vec2<int> &pointer, math::Rect2<int> &screen_rect) = 0;
+		/**
+		 * Set screen contents as a source of cairo context.
+		 * @param[in] cr Cairo context.
+		 * @param[in] left Screen position placed at the context origin.
+		 * @param[in] top Screen position placed at the context origin.
+		 * @return True on success.
+		 */
+		virtual bool setSource(cairo_t *cr, int left, int top) = 0;
+		/**
+		 * Get number which changes every time screen contents are known to change, for example when different screen or frame is used.
+		 * Unknown changes are not reflected in this number.
+		 */
+		virtual uint64_t getSerial() const = 0;
+};
+
+/** \class GdkScreenSource
+ * \brief Screen source reading root window of the screen which contains the pointer.
+ */
+class GdkScreenSource: public ScreenSource
+{
+	public:
+		GdkScreenSource();
+		virtual bool getPointer(math::Vec2<int> &pointer, math::Rect2<int> &screen_rect);
+		virtual bool setSource(cairo_t *cr, int left, int top);
+		virtual uint64_t getSerial() const;
+	private:
+		GdkScreen *m_screen;
+		uint64_t m_serial;
+};
+
+#endif /* GPICK_SCREEN_SOURCE_H_ */
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "StartupTrace.h"
+#include <glib.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <cstdio>
+using namespace std;
+
+static const int64_t program_start_time = g_get_monotonic_time();
+static const thread::id main_thread_id = this_thread::get_id();
+static atomic<bool> enabled(false);
+static mutex output_lock;
+
+void startup_trace_enable(bool enable)
+{
+	enabled = enable;
+}
+bool startup_trace_is_enabled()
+{
+	return enabled;
+}
+void startup_trace_add(const char *phase, int64_t start_time)
+{
+	if (!enabled) return;
+	int64_t now = g_get_monotonic_time();
+	bool main_thread = this_thread::get_id() == main_thread_id;
+	lock_guard<mutex> lock(output_lock);
+	fprintf(stderr, "startup %9.3f ms: %s took %.3f ms%s\n", (now - program_start_time) / 1000.0, phase, (now - start_time) / 1000.0, main_thread ? "" : " (background)");
+}
+void startup_trace_mark(const char *event)
+{
+	if (!enabled) return;
+	int64_t now = g_get_monotonic_time();
+	lock_guard<mutex> lock(output_lock);
+	fprintf(stderr, "startup %9.3f ms: %s\n", (now - program_start_time) / 1000.0, event);
+}
+StartupTracePhase::StartupTracePhase(const char *phase):
+	m_phase(phase),
+	m_start_time(g_get_monotonic_time())
+{
+}
+StartupTracePhase::~StartupTracePhase()
+{
+	startup_trace_add(m_phase, m_start_time);
+}
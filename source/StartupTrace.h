@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GPICK_STARTUP_TRACE_H_
+#define GPICK_STARTUP_TRACE_H_
+
+#include <cstdint>
+
+/** \file source/StartupTrace.h
+ * \brief Timing of startup phases, written to standard error when enabled.
+ */
+
+/**
+ * Enable or disable trace output. Trace is disabled by default.
+ * @param[in] enable Enable trace output.
+ */
+void startup_trace_enable(bool enable);
+bool startup_trace_is_enabled();
+/**
+ * Write phase duration and time since program start.
+ * @param[in] phase Phase name.
+ * @param[in] start_time Monotonic phase start time in microseconds.
+ */
+void startup_trace_add(const char *phase, int64_t start_time);
+/**
+ * Write time since program start.
+ * @param[in] event Event name.
+ */
+void startup_trace_mark(const char *event);
+
+/** \class StartupTracePhase
+ * \brief Traces duration of a scope. Can be used from any thread.
+ */
+class StartupTracePhase
+{
+	public:
+		StartupTracePhase(const char *phase);
+		~StartupTracePhase();
+	private:
+		const char *m_phase;
+		int64_t m_start_time;
+};
+
+#endif /* GPICK_STARTUP_TRACE_H_ */
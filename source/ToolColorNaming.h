@@ -20,6 +20,7 @@
 #define GPICK_TOOL_COLOR_NAMING_H_
 
 #include <string>
+#include <cstddef>
 class GlobalState;
 struct Color;
 class ColorObject;
@@ -47,6 +48,10 @@ class ToolColorNameAssigner{
 		ToolColorNameAssigner(GlobalState *gs);
 		virtual ~ToolColorNameAssigner();
 		void assign(ColorObject *color_object, const Color *color);
+		/**
+		 * Assign names to multiple color objects. Automatic names are searched in parallel.
+		 */
+		void assignMultiple(ColorObject **color_objects, const Color *colors, size_t count);
 		virtual std::string getToolSpecificName(ColorObject *color_object, const Color *color) = 0;
 };
 
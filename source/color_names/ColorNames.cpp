@@ -18,16 +18,158 @@
 
 #include "ColorNames.h"
 #include "../Color.h"
+#include "../Parallel.h"
 #include <string.h>
+#include <math.h>
+#include <limits>
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
 #include <sstream>
 #include <fstream>
+#include <glib/gstdio.h>
 using namespace std;
 
+/** Ranges of up to this many entries are not split further and are searched linearly. */
+const size_t leaf_size = 8;
+/** Cache file version. Must be changed when entry layout, color space or index building changes. */
+const uint32_t cache_version = 1;
+const char cache_magic[8] = {'G', 'P', 'C', 'N', 'A', 'M', 'E', 'S'};
+
+/** Default maximum number of results kept in name cache of each thread. */
+const size_t default_cache_size = 16384;
+
+/** Cache settings and counters shared by all threads using the same color names. */
+struct ColorNamesCache
+{
+	/** Identifies color names and loaded segments. Changes when segments are added, so that thread caches drop old results. */
+	atomic<uint64_t> id;
+	atomic<size_t> capacity;
+	atomic<size_t> hits, misses;
+	ColorNamesCache():
+		capacity(default_cache_size),
+		hits(0),
+		misses(0)
+	{
+		reset();
+	}
+	void reset()
+	{
+		static atomic<uint64_t> next_id(1);
+		id = next_id++;
+	}
+};
+namespace {
+/** Exact RGB value of a color. */
+struct CacheKey
+{
+	uint32_t value[3];
+	CacheKey(const Color* color)
+	{
+		memcpy(value, color->ma, sizeof(value));
+	}
+	bool operator==(const CacheKey &key) const
+	{
+		return value[0] == key.value[0] && value[1] == key.value[1] && value[2] == key.value[2];
+	}
+};
+struct CacheKeyHash
+{
+	size_t operator()(const CacheKey &key) const
+	{
+		uint64_t hash = key.value[0];
+		hash = hash * 0x9e3779b97f4a7c15ull + key.value[1];
+		hash = hash * 0x9e3779b97f4a7c15ull + key.value[2];
+		return size_t(hash ^ (hash >> 32));
+	}
+};
+/** Bounded LRU cache of search results, owned by a single thread. */
+struct ThreadCache
+{
+	typedef list<pair<CacheKey, ColorNameMatch>> Items;
+	uint64_t id;
+	/** Most recently used items first. */
+	Items items;
+	unordered_map<CacheKey, Items::iterator, CacheKeyHash> index;
+	ThreadCache():
+		id(0)
+	{
+	}
+	/** Drop results of other color names and items over capacity. */
+	void prepare(uint64_t cache_id, size_t capacity)
+	{
+		if (id != cache_id){
+			items.clear();
+			index.clear();
+			id = cache_id;
+		}
+		while (items.size() > capacity){
+			index.erase(items.back().first);
+			items.pop_back();
+		}
+	}
+	bool get(const CacheKey &key, ColorNameMatch &match)
+	{
+		auto i = index.find(key);
+		if (i == index.end()) return false;
+		items.splice(items.begin(), items, i->second);
+		match = i->second->second;
+		return true;
+	}
+	void put(const CacheKey &key, const ColorNameMatch &match, size_t capacity)
+	{
+		if (capacity == 0 || index.find(key) != index.end()) return;
+		items.push_front(make_pair(key, match));
+		index[key] = items.begin();
+		while (items.size() > capacity){
+			index.erase(items.back().first);
+			items.pop_back();
+		}
+	}
+};
+}
+static thread_local ThreadCache thread_cache;
+
+struct CacheHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t entry_size;
+	uint64_t source_size;
+	int64_t source_modified;
+	uint64_t source_path_size;
+	uint64_t entry_count;
+	uint64_t names_size;
+};
+
+/* Lower bound of color_distance_lch(entry, color) for any entry inside of a Lab box.
+ * Lightness term is bounded by the distance to box lightness range. For hue term, let e be
+ * the distance in ab plane. As chroma difference can not exceed e, and entry chroma can not
+ * exceed color chroma + e, hue term is at least (e^2 - e) / (1 + 0.015 * (C + e)), which is
+ * increasing for e >= 1, so the nearest point of box ab rectangle gives the bound.
+ */
+static float color_distance_lch_bound(const Color* color, const Color* box_min, const Color* box_max)
+{
+	float d[3];
+	for (int i = 0; i < 3; i++){
+		d[i] = std::max(std::max(box_min->ma[i] - color->ma[i], color->ma[i] - box_max->ma[i]), 0.0f);
+	}
+	float result = d[0] * d[0];
+	float e = sqrt(d[1] * d[1] + d[2] * d[2]);
+	if (e > 1){
+		float chroma = sqrt(color->lab.a * color->lab.a + color->lab.b * color->lab.b);
+		float hue_term = (e * e - e) / (1 + 0.015f * (chroma + e));
+		result += hue_term * hue_term;
+	}
+	return sqrt(result);
+}
 ColorNames* color_names_new()
 {
 	ColorNames* cnames = new ColorNames;
 	cnames->color_space_convert = color_rgb_to_lab_d50;
 	cnames->color_space_distance = color_distance_lch;
+	cnames->color_space_distance_bound = color_distance_lch_bound;
+	cnames->cache = new ColorNamesCache;
 	return cnames;
 }
 static void color_names_strip_spaces(string& string_x, string& stripchars)
@@ -42,27 +184,37 @@ static void color_names_strip_spaces(string& string_x, string& stripchars)
 	}
 	string_x = string_x.substr(startIndex, (endIndex-startIndex)+1 );
 }
-void color_names_get_color_xyz(ColorNames* cnames, Color* c, int* x1, int* y1, int* z1, int* x2, int* y2, int* z2)
+static void color_names_build_index(ColorEntry* entries, size_t begin, size_t end)
 {
-	*x1 = clamp_int(int(c->xyz.x * 8 - 0.5), 0, 7);
-	*y1 = clamp_int(int(c->xyz.y * 8 - 0.5), 0, 7);
-	*z1 = clamp_int(int(c->xyz.z * 8 - 0.5), 0, 7);
-	*x2 = clamp_int(int(c->xyz.x * 8 + 0.5), 0, 7);
-	*y2 = clamp_int(int(c->xyz.y * 8 + 0.5), 0, 7);
-	*z2 = clamp_int(int(c->xyz.z * 8 + 0.5), 0, 7);
-}
-list<ColorEntry*>* color_names_get_color_list(ColorNames* cnames, Color* c)
-{
-	int x,y,z;
-	x = clamp_int(int(c->xyz.x * 8), 0, 7);
-	y = clamp_int(int(c->xyz.y * 8), 0, 7);
-	z = clamp_int(int(c->xyz.z * 8), 0, 7);
-	return &cnames->colors[x][y][z];
+	if (end - begin <= leaf_size) return;
+	float min[3], max[3];
+	for (int i = 0; i < 3; i++){
+		min[i] = max[i] = entries[begin].color.ma[i];
+	}
+	for (size_t j = begin + 1; j < end; j++){
+		for (int i = 0; i < 3; i++){
+			min[i] = std::min(min[i], entries[j].color.ma[i]);
+			max[i] = std::max(max[i], entries[j].color.ma[i]);
+		}
+	}
+	int axis = 0;
+	for (int i = 1; i < 3; i++){
+		if (max[i] - min[i] > max[axis] - min[axis]) axis = i;
+	}
+	size_t middle = begin + (end - begin) / 2;
+	nth_element(entries + begin, entries + middle, entries + end, [axis](const ColorEntry &a, const ColorEntry &b){
+		return a.color.ma[axis] < b.color.ma[axis];
+	});
+	entries[middle].split_axis = axis;
+	color_names_build_index(entries, begin, middle);
+	color_names_build_index(entries, middle + 1, end);
 }
 int color_names_load_from_file(ColorNames* cnames, const char* filename)
 {
 	ifstream file(filename, ifstream::in);
 	if (file.is_open()) {
+		ColorNamesSegment* segment = new ColorNamesSegment;
+		segment->mapped_file = nullptr;
 		string line;
 		stringstream rline (ios::in | ios::out);
 		Color color;
@@ -84,76 +236,285 @@ int color_names_load_from_file(ColorNames* cnames, const char* filename)
 				*i = tolower((unsigned char)*i);
 			}
 			color_multiply(&color, 1/255.0);
-			ColorNameEntry* name_entry = new ColorNameEntry;
-			name_entry->name=name;
-			cnames->names.push_back(name_entry);
-			ColorEntry* color_entry = new ColorEntry;
-			color_entry->name=name_entry;
-			cnames->color_space_convert(&color, &color_entry->color);
-			color_names_get_color_list(cnames, &color_entry->color)->push_back(color_entry);
+			ColorEntry color_entry;
+			color_entry.name = segment->name_storage.size();
+			color_entry.split_axis = 0;
+			segment->name_storage.insert(segment->name_storage.end(), name.c_str(), name.c_str() + name.length() + 1);
+			cnames->color_space_convert(&color, &color_entry.color);
+			color_entry.color.ma[3] = 0;
+			segment->entry_storage.push_back(color_entry);
 		}
 		file.close();
+		color_names_build_index(segment->entry_storage.data(), 0, segment->entry_storage.size());
+		segment->entries = segment->entry_storage.data();
+		segment->entry_count = segment->entry_storage.size();
+		segment->names = segment->name_storage.data();
+		segment->names_size = segment->name_storage.size();
+		cnames->segments.push_back(segment);
+		cnames->cache->reset();
 		return 0;
 	}
 	return -1;
 }
-void color_names_destroy(ColorNames* cnames)
+static bool color_names_check_entries(const ColorEntry* entries, size_t entry_count, size_t names_size)
 {
-	for (list<ColorNameEntry*>::iterator i=cnames->names.begin();i != cnames->names.end();++i){
-		delete (*i);
+	for (size_t i = 0; i < entry_count; i++){
+		if (entries[i].name >= names_size || entries[i].split_axis >= 3) return false;
 	}
-	for (int x=0;x<8;x++){
-		for (int y=0;y<8;y++){
-			for (int z=0;z<8;z++){
-				for (list<ColorEntry*>::iterator i=cnames->colors[x][y][z].begin();i != cnames->colors[x][y][z].end();++i){
-					delete (*i);
-				}
-			}
+	return true;
+}
+static int color_names_load_cache(ColorNames* cnames, const char* filename, const GStatBuf &source_stat, const char* cache_filename)
+{
+	GMappedFile* mapped_file = g_mapped_file_new(cache_filename, false, nullptr);
+	if (mapped_file == nullptr) return -1;
+	const char* data = g_mapped_file_get_contents(mapped_file);
+	size_t size = g_mapped_file_get_length(mapped_file);
+	CacheHeader header;
+	bool valid = size >= sizeof(header);
+	if (valid){
+		memcpy(&header, data, sizeof(header));
+		size_t path_size = strlen(filename);
+		size_t entries_offset = sizeof(header) + (path_size + 7) / 8 * 8;
+		valid = memcmp(header.magic, cache_magic, sizeof(cache_magic)) == 0 &&
+			header.version == cache_version &&
+			header.entry_size == sizeof(ColorEntry) &&
+			header.source_size == uint64_t(source_stat.st_size) &&
+			header.source_modified == int64_t(source_stat.st_mtime) &&
+			header.source_path_size == path_size &&
+			header.entry_count <= size / sizeof(ColorEntry) &&
+			header.names_size <= size &&
+			size == entries_offset + header.entry_count * sizeof(ColorEntry) + header.names_size &&
+			memcmp(data + sizeof(header), filename, path_size) == 0 &&
+			(header.names_size == 0 || data[size - 1] == 0) &&
+			color_names_check_entries(reinterpret_cast<const ColorEntry*>(data + entries_offset), header.entry_count, header.names_size);
+		if (valid){
+			ColorNamesSegment* segment = new ColorNamesSegment;
+			segment->mapped_file = mapped_file;
+			segment->entries = reinterpret_cast<const ColorEntry*>(data + entries_offset);
+			segment->entry_count = header.entry_count;
+			segment->names = data + entries_offset + header.entry_count * sizeof(ColorEntry);
+			segment->names_size = header.names_size;
+			cnames->segments.push_back(segment);
+			cnames->cache->reset();
+			return 0;
 		}
 	}
+	g_mapped_file_unref(mapped_file);
+	return -1;
+}
+int color_names_save_cache(const ColorNamesSegment* segment, const char* filename, const char* cache_filename)
+{
+	GStatBuf source_stat;
+	if (g_stat(filename, &source_stat) != 0) return -1;
+	CacheHeader header;
+	memcpy(header.magic, cache_magic, sizeof(cache_magic));
+	header.version = cache_version;
+	header.entry_size = sizeof(ColorEntry);
+	header.source_size = source_stat.st_size;
+	header.source_modified = source_stat.st_mtime;
+	header.source_path_size = strlen(filename);
+	header.entry_count = segment->entry_count;
+	header.names_size = segment->names_size;
+	string data;
+	data.reserve(sizeof(header) + header.source_path_size + 8 + segment->entry_count * sizeof(ColorEntry) + segment->names_size);
+	data.append(reinterpret_cast<const char*>(&header), sizeof(header));
+	data.append(filename);
+	data.append((8 - data.size() % 8) % 8, '\0');
+	data.append(reinterpret_cast<const char*>(segment->entries), segment->entry_count * sizeof(ColorEntry));
+	data.append(segment->names, segment->names_size);
+	if (!g_file_set_contents(cache_filename, data.data(), data.size(), nullptr)) return -1;
+	return 0;
+}
+int color_names_load(ColorNames* cnames, const char* filename, const char* cache_filename)
+{
+	GStatBuf source_stat;
+	if (g_stat(filename, &source_stat) != 0) return -1;
+	if (color_names_load_cache(cnames, filename, source_stat, cache_filename) == 0) return 0;
+	if (color_names_load_from_file(cnames, filename) != 0) return -1;
+	color_names_save_cache(cnames->segments.back(), filename, cache_filename);
+	return 0;
+}
+size_t color_names_get_entry_count(const ColorNames* cnames)
+{
+	size_t count = 0;
+	for (auto segment: cnames->segments)
+		count += segment->entry_count;
+	return count;
+}
+void color_names_destroy(ColorNames* cnames)
+{
+	for (auto segment: cnames->segments){
+		if (segment->mapped_file)
+			g_mapped_file_unref(segment->mapped_file);
+		delete segment;
+	}
+	delete cnames->cache;
 	delete cnames;
 }
-string color_names_get(ColorNames* cnames, const Color* color, bool imprecision_postfix)
+namespace {
+struct Candidate
 {
-	Color c1;
-	cnames->color_space_convert(color, &c1);
-	int x1, y1, z1, x2, y2, z2;
-	color_names_get_color_xyz(cnames, &c1, &x1, &y1, &z1, &x2, &y2, &z2);
-	float result_delta=1e5;
-	ColorEntry* color_entry = nullptr;
-	char skip_mask[8][8][8];
-	memset(&skip_mask, 0, sizeof(skip_mask));
-	/* Search expansion should be from 0 to 7, but this would only increase search time and return
-	 * wrong color names when no closely matching color is found. Search expansion is only useful
-	 * when color name database is very small (16 colors)
-	 */
-	for (int expansion = 0; expansion < 7; ++expansion){
-		int x_start = std::max(x1 - expansion, 0), x_end = std::min(x2 + expansion, 7);
-		int y_start = std::max(y1 - expansion, 0), y_end = std::min(y2 + expansion, 7);
-		int z_start = std::max(z1 - expansion, 0), z_end = std::min(z2 + expansion, 7);
-		for (int x_i = x_start; x_i <= x_end; ++x_i) {
-			for (int y_i = y_start; y_i <= y_end; ++y_i) {
-				for (int z_i = z_start; z_i <= z_end; ++z_i) {
-					if (skip_mask[x_i][y_i][z_i]) continue; // skip checked items
-					skip_mask[x_i][y_i][z_i] = 1;
-					for (list<ColorEntry*>::iterator i=cnames->colors[x_i][y_i][z_i].begin(); i != cnames->colors[x_i][y_i][z_i].end();++i){
-						float delta = cnames->color_space_distance(&(*i)->color, &c1);
-						if (delta < result_delta) {
-							result_delta=delta;
-							color_entry=*i;
-						}
-					}
-				}
+	float distance;
+	const ColorNamesSegment* segment;
+	const ColorEntry* entry;
+	bool operator<(const Candidate &candidate) const
+	{
+		return distance < candidate.distance;
+	}
+};
+struct NearestSearch
+{
+	const ColorNames* cnames;
+	const ColorNamesSegment* segment;
+	Color color;
+	size_t count;
+	/** Max-heap of best entries found so far. */
+	vector<Candidate> best;
+	Color box_min, box_max;
+	void check(const ColorEntry &entry)
+	{
+		float delta = cnames->color_space_distance(&entry.color, &color);
+		if (best.size() < count){
+			best.push_back(Candidate{delta, segment, &entry});
+			push_heap(best.begin(), best.end());
+		}else if (delta < best.front().distance){
+			pop_heap(best.begin(), best.end());
+			best.back() = Candidate{delta, segment, &entry};
+			push_heap(best.begin(), best.end());
+		}
+	}
+	bool canSkip()
+	{
+		if (best.size() < count) return false;
+		// small margin keeps search exact when bound and distance are rounded differently
+		return cnames->color_space_distance_bound(&color, &box_min, &box_max) * 0.9999f > best.front().distance;
+	}
+	void search(size_t begin, size_t end)
+	{
+		const ColorEntry* entries = segment->entries;
+		if (end - begin <= leaf_size){
+			for (size_t i = begin; i < end; i++)
+				check(entries[i]);
+			return;
+		}
+		size_t middle = begin + (end - begin) / 2;
+		int axis = entries[middle].split_axis;
+		float split = entries[middle].color.ma[axis];
+		check(entries[middle]);
+		bool lower_first = color.ma[axis] < split;
+		for (int side = 0; side < 2; side++){
+			if ((side == 0) == lower_first){
+				float previous = box_max.ma[axis];
+				box_max.ma[axis] = split;
+				if (!canSkip()) search(begin, middle);
+				box_max.ma[axis] = previous;
+			}else{
+				float previous = box_min.ma[axis];
+				box_min.ma[axis] = split;
+				if (!canSkip()) search(middle + 1, end);
+				box_min.ma[axis] = previous;
 			}
 		}
-		//no need for further expansion if we have found a match
-		if (color_entry) break;
 	}
-	if (color_entry){
-		stringstream s;
-		s << color_entry->name->name;
-		if (imprecision_postfix) if (result_delta>0.1) s<<" ~";
-		return s.str();
+};
+}
+size_t color_names_find_nearest(const ColorNames* cnames, const Color* color, size_t count, ColorNameMatch* matches)
+{
+	if (count == 0) return 0;
+	NearestSearch search;
+	search.cnames = cnames;
+	cnames->color_space_convert(color, &search.color);
+	search.count = count;
+	search.best.reserve(count);
+	for (auto segment: cnames->segments){
+		search.segment = segment;
+		for (int i = 0; i < 3; i++){
+			search.box_min.ma[i] = -numeric_limits<float>::infinity();
+			search.box_max.ma[i] = numeric_limits<float>::infinity();
+		}
+		search.search(0, segment->entry_count);
+	}
+	sort_heap(search.best.begin(), search.best.end());
+	for (size_t i = 0; i < search.best.size(); i++){
+		const Candidate &candidate = search.best[i];
+		matches[i].name = candidate.segment->names + candidate.entry->name;
+		matches[i].color = candidate.entry->color;
+		matches[i].distance = candidate.distance;
 	}
-	return string("");
+	return search.best.size();
+}
+void color_names_find_nearest_multiple(ColorNames* cnames, const Color* colors, size_t count, ColorNameMatch* matches)
+{
+	ColorNamesCache &cache = *cnames->cache;
+	size_t capacity = cache.capacity;
+	ThreadCache &local_cache = thread_cache;
+	local_cache.prepare(cache.id, capacity);
+	// indices of colors to search, repeated colors are searched once
+	vector<size_t> search;
+	unordered_map<CacheKey, size_t, CacheKeyHash> pending;
+	vector<pair<size_t, size_t>> repeated;
+	size_t hits = 0;
+	for (size_t i = 0; i < count; i++){
+		CacheKey key(&colors[i]);
+		if (local_cache.get(key, matches[i])){
+			hits++;
+			continue;
+		}
+		auto pending_item = pending.find(key);
+		if (pending_item != pending.end()){
+			repeated.push_back(make_pair(i, pending_item->second));
+			hits++;
+			continue;
+		}
+		pending[key] = i;
+		search.push_back(i);
+	}
+	cache.hits += hits;
+	cache.misses += search.size();
+	parallel_for(search.size(), 64, [&](size_t begin, size_t end){
+		for (size_t i = begin; i < end; i++){
+			ColorNameMatch &match = matches[search[i]];
+			if (color_names_find_nearest(cnames, &colors[search[i]], 1, &match) == 0){
+				match.name = nullptr;
+				match.distance = 0;
+			}
+		}
+	});
+	for (auto &item: repeated)
+		matches[item.first] = matches[item.second];
+	for (auto i: search){
+		if (matches[i].name)
+			local_cache.put(CacheKey(&colors[i]), matches[i], capacity);
+	}
+}
+static string color_names_format(const ColorNameMatch &match, bool imprecision_postfix)
+{
+	if (match.name == nullptr) return string("");
+	stringstream s;
+	s << match.name;
+	if (imprecision_postfix) if (match.distance>0.1) s<<" ~";
+	return s.str();
+}
+void color_names_get_multiple(ColorNames* cnames, const Color* colors, size_t count, bool imprecision_postfix, std::string* names)
+{
+	vector<ColorNameMatch> matches(count);
+	color_names_find_nearest_multiple(cnames, colors, count, matches.data());
+	for (size_t i = 0; i < count; i++)
+		names[i] = color_names_format(matches[i], imprecision_postfix);
+}
+string color_names_get(ColorNames* cnames, const Color* color, bool imprecision_postfix)
+{
+	ColorNameMatch match;
+	color_names_find_nearest_multiple(cnames, color, 1, &match);
+	return color_names_format(match, imprecision_postfix);
+}
+void color_names_set_cache_size(ColorNames* cnames, size_t size)
+{
+	cnames->cache->capacity = size;
+}
+void color_names_get_cache_statistics(const ColorNames* cnames, size_t* hits, size_t* misses)
+{
+	ColorNamesCache &cache = *cnames->cache;
+	if (hits) *hits = cache.hits;
+	if (misses) *misses = cache.misses;
 }
@@ -22,23 +22,92 @@
 #include "../Color.h"
 #include <string>
 #include <list>
+#include <vector>
+#include <stdint.h>
+#include <glib.h>
 
-typedef struct ColorNameEntry{
-	std::string name;
-}ColorNameEntry;
+struct ColorNamesCache;
+/** Color name entry. Layout is also used in color name cache files. */
 typedef struct ColorEntry{
-	Color color;
-	ColorNameEntry* name;
+	Color color; /**< Color in color_space_convert color space. */
+	uint32_t name; /**< Offset of zero terminated name in name table. */
+	uint32_t split_axis; /**< Split axis of k-d tree node. */
 }ColorEntry;
+/** Color names loaded from a single file, ordered as an implicit k-d tree. */
+typedef struct ColorNamesSegment{
+	const ColorEntry* entries;
+	size_t entry_count;
+	const char* names;
+	size_t names_size;
+	std::vector<ColorEntry> entry_storage; /**< Entry storage when loaded from text file. */
+	std::vector<char> name_storage; /**< Name storage when loaded from text file. */
+	GMappedFile* mapped_file; /**< Mapped cache file, when loaded from cache file. */
+}ColorNamesSegment;
 typedef struct ColorNames{
-	std::list<ColorNameEntry*> names;
-	std::list<ColorEntry*> colors[8][8][8];
+	std::list<ColorNamesSegment*> segments;
 	void (*color_space_convert)(const Color* a, Color* b);
 	float (*color_space_distance)(const Color* a, const Color* b);
+	/** Lower bound of color_space_distance between a color and any color inside of an axis aligned box. Used to prune k-d tree search. */
+	float (*color_space_distance_bound)(const Color* a, const Color* box_min, const Color* box_max);
+	ColorNamesCache* cache;
 }ColorNames;
+typedef struct ColorNameMatch{
+	const char* name;
+	Color color; /**< Color in color_space_convert color space. */
+	float distance;
+}ColorNameMatch;
 ColorNames* color_names_new();
 int color_names_load_from_file(ColorNames* cnames, const char* filename);
+/**
+ * Load color names from binary cache file. Cache file is used only if it was created from current version of source file.
+ * If cache file is missing or stale, color names are loaded from source text file and cache file is recreated.
+ * @param[in] cnames Color names.
+ * @param[in] filename Source text file name.
+ * @param[in] cache_filename Cache file name.
+ * @return 0 on success, -1 if source file does not exist or can not be read.
+ */
+int color_names_load(ColorNames* cnames, const char* filename, const char* cache_filename);
+/**
+ * Write color names loaded from a single file into binary cache file.
+ * @param[in] segment Color names segment.
+ * @param[in] filename Source text file name. Its path, size and modification time are stored in cache file.
+ * @param[in] cache_filename Cache file name.
+ * @return 0 on success, -1 on failure.
+ */
+int color_names_save_cache(const ColorNamesSegment* segment, const char* filename, const char* cache_filename);
+size_t color_names_get_entry_count(const ColorNames* cnames);
 void color_names_destroy(ColorNames* cnames);
 std::string color_names_get(ColorNames* cnames, const Color* color, bool imprecision_postfix);
+/**
+ * Find color entries nearest to the color.
+ * @param[in] cnames Color names.
+ * @param[in] color Color in RGB color space.
+ * @param[in] count Maximum number of entries to find.
+ * @param[out] matches Found entries, ordered by distance. Must have space for count entries.
+ * @return Number of entries found.
+ */
+size_t color_names_find_nearest(const ColorNames* cnames, const Color* color, size_t count, ColorNameMatch* matches);
+/**
+ * Find nearest color entry for each color. Colors are searched in parallel, and results are stored in a bounded LRU cache.
+ * Each thread has its own cache, keyed by exact RGB values, so cached results are the same as search results.
+ * @param[in] cnames Color names.
+ * @param[in] colors Colors in RGB color space.
+ * @param[in] count Number of colors.
+ * @param[out] matches Found entries. Name is null if there are no color names.
+ */
+void color_names_find_nearest_multiple(ColorNames* cnames, const Color* colors, size_t count, ColorNameMatch* matches);
+/**
+ * Get names for multiple colors.
+ * @see color_names_find_nearest_multiple.
+ */
+void color_names_get_multiple(ColorNames* cnames, const Color* colors, size_t count, bool imprecision_postfix, std::string* names);
+/**
+ * Set maximum number of results kept in name cache of each thread. Zero disables caching.
+ */
+void color_names_set_cache_size(ColorNames* cnames, size_t size);
+/**
+ * Get name cache hit and miss counters.
+ */
+void color_names_get_cache_statistics(const ColorNames* cnames, size_t* hits, size_t* misses);
 
 #endif /* GPICK_COLOR_NAMES_COLOR_NAMES_H_ */
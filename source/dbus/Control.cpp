@@ -19,7 +19,10 @@
 #include "Control.h"
 #ifndef WIN32
 #include "DbusInterface.h"
+#include "../PickStream.h"
+#include "../Color.h"
 #include <iostream>
+#include <map>
 using namespace std;
 
 namespace dbus
@@ -29,22 +32,71 @@ namespace dbus
 		public:
 			Control *m_decl;
 			GDBusObjectManagerServer *m_manager;
+			GpickControl *m_control;
 			guint m_bus_id;
+			PickStream m_pick_stream;
+			map<string, guint> m_owner_watches;
 			Impl(Control *decl):
 				m_decl(decl),
 				m_manager(nullptr),
-				m_bus_id(0)
+				m_control(nullptr),
+				m_bus_id(0),
+				m_pick_stream([this](const string &converter_name, PickSample &sample){
+					return m_decl->onPickSample && m_decl->onPickSample(converter_name, sample);
+				}, [this](uint32_t stream_id, const vector<PickSample> &samples){
+					emitPickSamples(stream_id, samples);
+				})
 			{
 			}
+			~Impl()
+			{
+				stopPickStreams();
+			}
 			void ownName()
 			{
 				m_bus_id = g_bus_own_name(G_BUS_TYPE_SESSION, "org.gpick", GBusNameOwnerFlags(G_BUS_NAME_OWNER_FLAGS_REPLACE), (GBusAcquiredCallback)on_bus_acquired, (GBusNameAcquiredCallback)on_name_acquired, (GBusNameLostCallback)on_name_lost, this, nullptr);
 			}
 			void unownName()
 			{
+				stopPickStreams();
 				g_bus_unown_name(m_bus_id);
 				m_bus_id = 0;
 			}
+			void stopPickStreams()
+			{
+				m_pick_stream.clear();
+				for (auto &watch: m_owner_watches)
+					g_bus_unwatch_name(watch.second);
+				m_owner_watches.clear();
+				if (m_control){
+					g_object_unref(m_control);
+					m_control = nullptr;
+				}
+			}
+			void emitPickSamples(uint32_t stream_id, const vector<PickSample> &samples)
+			{
+				if (!m_control) return;
+				GVariantBuilder builder;
+				g_variant_builder_init(&builder, G_VARIANT_TYPE("a(xiiddds)"));
+				for (auto &sample: samples){
+					g_variant_builder_add(&builder, "(xiiddds)", gint64(sample.time), gint32(sample.position.x), gint32(sample.position.y),
+						double(sample.color.rgb.red), double(sample.color.rgb.green), double(sample.color.rgb.blue), sample.text.c_str());
+				}
+				gpick_control_emit_pick_samples(m_control, stream_id, g_variant_builder_end(&builder));
+			}
+			/** Stop streams of a client when it disconnects from the bus without stopping them. */
+			void watchOwner(GDBusConnection *connection, const string &owner)
+			{
+				if (m_owner_watches.find(owner) != m_owner_watches.end()) return;
+				m_owner_watches[owner] = g_bus_watch_name_on_connection(connection, owner.c_str(), G_BUS_NAME_WATCHER_FLAGS_NONE, nullptr, (GBusNameVanishedCallback)on_owner_vanished, this, nullptr);
+			}
+			void unwatchOwner(const string &owner)
+			{
+				auto i = m_owner_watches.find(owner);
+				if (i == m_owner_watches.end()) return;
+				g_bus_unwatch_name(i->second);
+				m_owner_watches.erase(i);
+			}
 			GDBusObjectManager* getManager()
 			{
 				GDBusObjectManager *manager;
@@ -119,6 +171,121 @@ namespace dbus
 				gpick_control_complete_check_if_running(control, invocation);
 				return true;
 			}
+			static gboolean on_control_start_pick_stream(GpickControl *control, GDBusMethodInvocation *invocation, const char *converter_name, double rate, guint batch_size, Impl *impl)
+			{
+				if (!impl->m_decl->onPickSample){
+					g_dbus_method_invocation_return_error(invocation, G_DBUS_ERROR, G_DBUS_ERROR_NOT_SUPPORTED, "Pick streams are not available");
+					return true;
+				}
+				if (impl->m_decl->onCheckConverter && !impl->m_decl->onCheckConverter(converter_name)){
+					g_dbus_method_invocation_return_error(invocation, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS, "Unknown converter \"%s\"", converter_name);
+					return true;
+				}
+				const char *sender = g_dbus_method_invocation_get_sender(invocation);
+				string owner = sender ? sender : "";
+				uint32_t stream_id = impl->m_pick_stream.start(owner, converter_name, rate, batch_size);
+				if (!stream_id){
+					g_dbus_method_invocation_return_error(invocation, G_DBUS_ERROR, G_DBUS_ERROR_LIMITS_EXCEEDED, "Too many pick streams");
+					return true;
+				}
+				if (sender)
+					impl->watchOwner(g_dbus_method_invocation_get_connection(invocation), owner);
+				gpick_control_complete_start_pick_stream(control, invocation, stream_id);
+				return true;
+			}
+			static gboolean on_control_stop_pick_stream(GpickControl *control, GDBusMethodInvocation *invocation, guint stream_id, Impl *impl)
+			{
+				const char *sender = g_dbus_method_invocation_get_sender(invocation);
+				string owner = sender ? sender : "";
+				if (!impl->m_pick_stream.stop(owner, stream_id)){
+					g_dbus_method_invocation_return_error(invocation, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS, "Unknown pick stream %u", stream_id);
+					return true;
+				}
+				if (impl->m_pick_stream.getStreamCount(owner) == 0)
+					impl->unwatchOwner(owner);
+				gpick_control_complete_stop_pick_stream(control, invocation);
+				return true;
+			}
+			static void get_colors(GVariant *value, vector<Color> &colors)
+			{
+				colors.resize(g_variant_n_children(value));
+				GVariantIter iter;
+				g_variant_iter_init(&iter, value);
+				double red, green, blue;
+				for (size_t i = 0; g_variant_iter_next(&iter, "(ddd)", &red, &green, &blue); i++){
+					color_set(&colors[i], float(red), float(green), float(blue));
+				}
+			}
+			static vector<const char *> get_string_array(const vector<string> &strings)
+			{
+				vector<const char *> result;
+				result.reserve(strings.size() + 1);
+				for (auto &value: strings)
+					result.push_back(value.c_str());
+				result.push_back(nullptr);
+				return result;
+			}
+			static gboolean on_control_convert_colors(GpickControl *control, GDBusMethodInvocation *invocation, const char *converter_name, GVariant *colors, Impl *impl)
+			{
+				if (!impl->m_decl->onConvertColors){
+					g_dbus_method_invocation_return_error(invocation, G_DBUS_ERROR, G_DBUS_ERROR_NOT_SUPPORTED, "Color conversion is not available");
+					return true;
+				}
+				if (impl->m_decl->onCheckConverter && !impl->m_decl->onCheckConverter(converter_name)){
+					g_dbus_method_invocation_return_error(invocation, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS, "Unknown converter \"%s\"", converter_name);
+					return true;
+				}
+				vector<Color> input;
+				get_colors(colors, input);
+				vector<string> texts;
+				if (!impl->m_decl->onConvertColors(converter_name, input, texts)){
+					g_dbus_method_invocation_return_error(invocation, G_DBUS_ERROR, G_DBUS_ERROR_FAILED, "Could not convert colors with converter \"%s\"", converter_name);
+					return true;
+				}
+				gpick_control_complete_convert_colors(control, invocation, get_string_array(texts).data());
+				return true;
+			}
+			static gboolean on_control_parse_colors(GpickControl *control, GDBusMethodInvocation *invocation, const char *const *texts, Impl *impl)
+			{
+				if (!impl->m_decl->onParseColors){
+					g_dbus_method_invocation_return_error(invocation, G_DBUS_ERROR, G_DBUS_ERROR_NOT_SUPPORTED, "Color parsing is not available");
+					return true;
+				}
+				vector<string> input;
+				for (size_t i = 0; texts[i]; i++)
+					input.push_back(texts[i]);
+				vector<Color> colors;
+				vector<bool> valid;
+				impl->m_decl->onParseColors(input, colors, valid);
+				GVariantBuilder builder;
+				g_variant_builder_init(&builder, G_VARIANT_TYPE("a(bddd)"));
+				for (size_t i = 0; i < input.size(); i++){
+					bool is_valid = i < valid.size() && valid[i];
+					Color color = is_valid ? colors[i] : Color();
+					g_variant_builder_add(&builder, "(bddd)", gboolean(is_valid), double(color.rgb.red), double(color.rgb.green), double(color.rgb.blue));
+				}
+				gpick_control_complete_parse_colors(control, invocation, g_variant_builder_end(&builder));
+				return true;
+			}
+			static gboolean on_control_get_color_names(GpickControl *control, GDBusMethodInvocation *invocation, GVariant *colors, Impl *impl)
+			{
+				if (!impl->m_decl->onGetColorNames){
+					g_dbus_method_invocation_return_error(invocation, G_DBUS_ERROR, G_DBUS_ERROR_NOT_SUPPORTED, "Color names are not available");
+					return true;
+				}
+				vector<Color> input;
+				get_colors(colors, input);
+				vector<string> names;
+				impl->m_decl->onGetColorNames(input, names);
+				names.resize(input.size());
+				gpick_control_complete_get_color_names(control, invocation, get_string_array(names).data());
+				return true;
+			}
+			static void on_owner_vanished(GDBusConnection *connection, const gchar *name, Impl *impl)
+			{
+				impl->m_pick_stream.stopOwner(name);
+				impl->unwatchOwner(name);
+			}
 			static gboolean on_single_instance_activate(GpickSingleInstance *single_instance, GDBusMethodInvocation *invocation, Impl *impl)
 			{
 				bool result = impl->m_decl->onSingleInstanceActivate();
@@ -135,10 +302,16 @@ namespace dbus
 				GpickControl *control;
 				control = gpick_control_skeleton_new();
 				gpick_object_skeleton_set_control(object, control);
-				g_object_unref(control);
+				if (impl->m_control) g_object_unref(impl->m_control);
+				impl->m_control = control;
 
 				g_signal_connect(control, "handle-activate-floating-picker", G_CALLBACK(on_control_activate_floating_picker), impl);
 				g_signal_connect(control, "handle-check-if-running", G_CALLBACK(on_control_check_if_running), impl);
+				g_signal_connect(control, "handle-start-pick-stream", G_CALLBACK(on_control_start_pick_stream), impl);
+				g_signal_connect(control, "handle-stop-pick-stream", G_CALLBACK(on_control_stop_pick_stream), impl);
+				g_signal_connect(control, "handle-convert-colors", G_CALLBACK(on_control_convert_colors), impl);
+				g_signal_connect(control, "handle-parse-colors", G_CALLBACK(on_control_parse_colors), impl);
+				g_signal_connect(control, "handle-get-color-names", G_CALLBACK(on_control_get_color_names), impl);
 				g_dbus_object_manager_server_export(manager, G_DBUS_OBJECT_SKELETON(object));
 				g_object_unref(object);
 
@@ -22,6 +22,9 @@
 #include <memory>
 #include <functional>
 #include <string>
+#include <vector>
+struct PickSample;
+struct Color;
 namespace dbus
 {
 	class Control
@@ -36,6 +39,16 @@ namespace dbus
 			bool checkIfRunning();
 			std::function<bool(const char *)> onActivateFloatingPicker;
 			std::function<bool()> onSingleInstanceActivate;
+			/** Checks if converter exists and can serialize colors. Empty name selects default converter. Converter names are not checked when not set. */
+			std::function<bool(const std::string &converter_name)> onCheckConverter;
+			/** Takes one sample for pick streams started with StartPickStream. Pick streams are not available when not set. */
+			std::function<bool(const std::string &converter_name, PickSample &sample)> onPickSample;
+			/** Serializes colors for ConvertColors. Returns false if serialization fails. */
+			std::function<bool(const std::string &converter_name, const std::vector<Color> &colors, std::vector<std::string> &texts)> onConvertColors;
+			/** Deserializes texts for ParseColors. */
+			std::function<void(const std::vector<std::string> &texts, std::vector<Color> &colors, std::vector<bool> &valid)> onParseColors;
+			/** Finds nearest color names for GetColorNames. */
+			std::function<void(const std::vector<Color> &colors, std::vector<std::string> &names)> onGetColorNames;
 		private:
 			class Impl;
 			std::unique_ptr<Impl> m_impl;
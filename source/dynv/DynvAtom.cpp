@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DynvAtom.h"
+#include <boost/functional/hash.hpp>
+#include <string.h>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+using namespace std;
+
+namespace {
+/** Name referenced without copying, so that lookups do not allocate. Keys in the table point to names owned by the table. */
+struct NameKey{
+	const char* name;
+	size_t length;
+	bool operator==(const NameKey& other) const{
+		return length == other.length && memcmp(name, other.name, length) == 0;
+	}
+};
+struct NameKeyHash{
+	size_t operator()(const NameKey& key) const{
+		return boost::hash_range(key.name, key.name + key.length);
+	}
+};
+struct AtomTable{
+	/** Lookups of existing names only take shared lock. */
+	shared_timed_mutex lock;
+	unordered_map<NameKey, dynvAtom, NameKeyHash> atoms;
+	deque<string> names; /**< Name of atom n is at index n - 1. Deque does not move names when it grows. */
+};
+}
+
+static AtomTable& get_atom_table(){
+	// Constructed on first use, so that paths can be created during static initialization
+	static AtomTable table;
+	return table;
+}
+
+dynvAtom dynv_atom_find(const char* name, size_t length){
+	AtomTable& table = get_atom_table();
+	shared_lock<shared_timed_mutex> lock(table.lock);
+	auto i = table.atoms.find(NameKey{name, length});
+	return i != table.atoms.end() ? i->second : 0;
+}
+
+dynvAtom dynv_atom_find(const char* name){
+	return dynv_atom_find(name, strlen(name));
+}
+
+dynvAtom dynv_atom_get(const char* name, size_t length){
+	dynvAtom atom = dynv_atom_find(name, length);
+	if (atom) return atom;
+	AtomTable& table = get_atom_table();
+	lock_guard<shared_timed_mutex> lock(table.lock);
+	auto i = table.atoms.find(NameKey{name, length});
+	if (i != table.atoms.end()) return i->second;
+	table.names.emplace_back(name, length);
+	atom = table.names.size();
+	table.atoms.emplace(NameKey{table.names.back().c_str(), length}, atom);
+	return atom;
+}
+
+dynvAtom dynv_atom_get(const char* name){
+	return dynv_atom_get(name, strlen(name));
+}
+
+const char* dynv_atom_get_name(dynvAtom atom){
+	AtomTable& table = get_atom_table();
+	shared_lock<shared_timed_mutex> lock(table.lock);
+	return table.names[atom - 1].c_str();
+}
+
+dynvPath::dynvPath(const char* path){
+	for (;;){
+		const char* end = strchr(path, '.');
+		if (end == nullptr){
+			atoms.push_back(dynv_atom_get(path));
+			break;
+		}
+		atoms.push_back(dynv_atom_get(path, end - path));
+		path = end + 1;
+	}
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DYNVATOM_H_
+#define DYNVATOM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/** Variable name interned into a number. Zero is never used as atom. */
+typedef uint32_t dynvAtom;
+
+/**
+ * Get atom for a variable name. New atom is allocated on the first use of the name. Safe to call from multiple threads.
+ * @param[in] name Variable name.
+ * @param[in] length Length of the name.
+ * @return Atom.
+ */
+dynvAtom dynv_atom_get(const char* name, size_t length);
+dynvAtom dynv_atom_get(const char* name);
+
+/**
+ * Find atom for a variable name without allocating a new one. Safe to call from multiple threads.
+ * @param[in] name Variable name.
+ * @param[in] length Length of the name.
+ * @return Atom, or zero if the name has not been used yet.
+ */
+dynvAtom dynv_atom_find(const char* name, size_t length);
+dynvAtom dynv_atom_find(const char* name);
+
+/**
+ * Get variable name of an atom.
+ * @param[in] atom Atom returned by dynv_atom_get.
+ * @return Variable name, valid until program exits.
+ */
+const char* dynv_atom_get_name(dynvAtom atom);
+
+/** \struct dynvPath
+ * \brief Dot separated variable path split into atoms.
+ *
+ * Path can be created once and kept by the caller, so that repeated lookups do not parse paths or compare strings.
+ */
+struct dynvPath{
+	explicit dynvPath(const char* path);
+	std::vector<dynvAtom> atoms;
+};
+
+#endif /* DYNVATOM_H_ */
@@ -25,16 +25,83 @@
 #include <stdlib.h>
 #include <stdio.h>
 
+#include <algorithm>
 #include <vector>
 #include <iostream>
 using namespace std;
 
-bool dynvSystem::dynvKeyCompare::operator() (const char* const& x, const char* const& y) const
-{
-	return strcmp(x,y)<0;
+dynvVariableTable::dynvVariableTable(){
+	count = 0;
+}
+
+size_t dynvVariableTable::getIndex(dynvAtom atom) const{
+	// Atoms are consecutive numbers, multiplying them by an odd constant spreads them over all slots
+	return static_cast<uint32_t>(atom * 2654435761u) & (slots.size() - 1);
 }
 
+struct dynvVariable* dynvVariableTable::find(dynvAtom atom) const{
+	if (count == 0 || atom == 0) return nullptr;
+	size_t mask = slots.size() - 1;
+	for (size_t i = getIndex(atom);; i = (i + 1) & mask){
+		if (slots[i].atom == atom) return slots[i].variable;
+		if (slots[i].atom == 0) return nullptr;
+	}
+}
 
+void dynvVariableTable::insert(dynvAtom atom, struct dynvVariable* variable){
+	if ((count + 1) * 2 > slots.size()) grow();
+	size_t mask = slots.size() - 1;
+	size_t i = getIndex(atom);
+	while (slots[i].atom != 0) i = (i + 1) & mask;
+	slots[i].atom = atom;
+	slots[i].variable = variable;
+	count++;
+}
+
+struct dynvVariable* dynvVariableTable::erase(dynvAtom atom){
+	if (count == 0 || atom == 0) return nullptr;
+	size_t mask = slots.size() - 1;
+	size_t i = getIndex(atom);
+	while (slots[i].atom != atom){
+		if (slots[i].atom == 0) return nullptr;
+		i = (i + 1) & mask;
+	}
+	struct dynvVariable* variable = slots[i].variable;
+	// Following entries of the probe sequence are moved back into the hole, so that lookups do not need deletion markers
+	for (size_t j = (i + 1) & mask; slots[j].atom != 0; j = (j + 1) & mask){
+		size_t home = getIndex(slots[j].atom);
+		if (((j - home) & mask) >= ((j - i) & mask)){
+			slots[i] = slots[j];
+			i = j;
+		}
+	}
+	slots[i].atom = 0;
+	slots[i].variable = nullptr;
+	count--;
+	return variable;
+}
+
+void dynvVariableTable::grow(){
+	vector<Slot> old_slots(max<size_t>(slots.size() * 2, 8), Slot{0, nullptr});
+	slots.swap(old_slots);
+	count = 0;
+	for (auto &slot: old_slots){
+		if (slot.atom != 0) insert(slot.atom, slot.variable);
+	}
+}
+
+void dynvVariableTable::clear(){
+	slots.clear();
+	count = 0;
+}
+
+size_t dynvVariableTable::size() const{
+	return count;
+}
+
+const vector<dynvVariableTable::Slot>& dynvVariableTable::getSlots() const{
+	return slots;
+}
 
 struct dynvHandlerMap* dynv_system_get_handler_map(struct dynvSystem* dynv_system){
 	return dynv_handler_map_ref(dynv_system->handler_map);
@@ -58,17 +125,19 @@ struct dynvSystem* dynv_system_create(struct dynvHandlerMap* handler_map){
 	return dynv_system;
 }
 
+static void destroy_variables(struct dynvSystem* dynv_system){
+	for (auto &slot: dynv_system->variables.getSlots()){
+		if (slot.atom != 0) dynv_variable_destroy(slot.variable);
+	}
+	dynv_system->variables.clear();
+}
+
 int dynv_system_release(struct dynvSystem* dynv_system){
 	if (dynv_system->refcnt){
 		dynv_system->refcnt--;
 		return -1;
 	}else{
-		dynvSystem::VariableMap::iterator i;
-
-		for (i=dynv_system->variables.begin(); i != dynv_system->variables.end(); ++i){
-			dynv_variable_destroy((*i).second);
-		}
-		dynv_system->variables.clear();
+		destroy_variables(dynv_system);
 
 		dynv_handler_map_release(dynv_system->handler_map);
 
@@ -82,19 +151,30 @@ struct dynvSystem* dynv_system_ref(struct dynvSystem* dynv_system){
 	return dynv_system;
 }
 
-struct dynvVariable* dynv_system_add_empty(struct dynvSystem* dynv_system, struct dynvHandler* handler, const char* variable_name){
-	struct dynvVariable* variable=nullptr;
+/** Find handler by name. Returns false if handler name is set, but handler does not exist. */
+static bool find_handler(struct dynvSystem* dynv_system, const char* handler_name, struct dynvHandler** handler){
+	*handler = nullptr;
+	if (handler_name == nullptr) return true;
+	dynvHandlerMap::HandlerMap::iterator j;
+	j=dynv_system->handler_map->handlers.find(handler_name);
+	if (j == dynv_system->handler_map->handlers.end()) return false;
+	*handler = (*j).second;
+	return true;
+}
+
+static struct dynvVariable* create_variable(struct dynvSystem* dynv_system, struct dynvHandler* handler, dynvAtom atom){
+	struct dynvVariable* variable=dynv_variable_create(dynv_atom_get_name(atom), handler);
+	dynv_system->variables.insert(atom, variable);
+	variable->handler->create(variable);
+	return variable;
+}
 
-	dynvSystem::VariableMap::iterator i;
-	i=dynv_system->variables.find(variable_name);
-	if (i == dynv_system->variables.end()){
+struct dynvVariable* dynv_system_add_empty(struct dynvSystem* dynv_system, struct dynvHandler* handler, const char* variable_name){
+	dynvAtom atom = dynv_atom_get(variable_name);
+	struct dynvVariable* variable=dynv_system->variables.find(atom);
+	if (variable == nullptr){
 		if (handler == nullptr) return 0;
-		variable=dynv_variable_create(variable_name, handler);
-		dynv_system->variables[variable->name]=variable;
-		variable->handler->create(variable);
-		return variable;
-	}else{
-		variable=(*i).second;
+		return create_variable(dynv_system, handler, atom);
 	}
 
 	if ((variable->flags & dynvVariable::Flag::read_only) != dynvVariable::Flag::none) return 0;
@@ -102,7 +182,7 @@ struct dynvVariable* dynv_system_add_empty(struct dynvSystem* dynv_system, struc
 	if (variable->handler == handler){
 		return variable;
 	}else{
-		if (handler->create != nullptr){
+		if (handler != nullptr && handler->create != nullptr){
 			dynv_variable_destroy_data(variable);
 			variable->handler=handler;
 			variable->handler->create(variable);
@@ -112,30 +192,12 @@ struct dynvVariable* dynv_system_add_empty(struct dynvSystem* dynv_system, struc
 	return 0;
 }
 
-int dynv_system_set(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_name, void* value){
-	struct dynvVariable* variable=nullptr;
-	struct dynvHandler* handler=nullptr;
-
-	if (handler_name != nullptr){
-		dynvHandlerMap::HandlerMap::iterator j;
-		j=dynv_system->handler_map->handlers.find(handler_name);
-		if (j == dynv_system->handler_map->handlers.end()){
-			return -3;
-		}else{
-			handler=(*j).second;
-		}
-	}
-
-	dynvSystem::VariableMap::iterator i;
-	i=dynv_system->variables.find(variable_name);
-	if (i == dynv_system->variables.end()){
+static int system_set(struct dynvSystem* dynv_system, struct dynvHandler* handler, dynvAtom atom, void* value){
+	struct dynvVariable* variable=dynv_system->variables.find(atom);
+	if (variable == nullptr){
 		if (handler == nullptr) return -2;
-		variable=dynv_variable_create(variable_name, handler);
-		dynv_system->variables[variable->name]=variable;
-		variable->handler->create(variable);
+		variable=create_variable(dynv_system, handler, atom);
 		return variable->handler->set(variable, value, false);
-	}else{
-		variable=(*i).second;
 	}
 
 	if ((variable->flags & dynvVariable::Flag::read_only) != dynvVariable::Flag::none) return -4;
@@ -143,7 +205,7 @@ int dynv_system_set(struct dynvSystem* dynv_system, const char* handler_name, co
 	if (variable->handler == handler){
 		return variable->handler->set(variable, value, false);
 	}else{
-		if (handler->create != nullptr){
+		if (handler != nullptr && handler->create != nullptr){
 			dynv_variable_destroy_data(variable);
 			variable->handler=handler;
 			variable->handler->create(variable);
@@ -153,32 +215,16 @@ int dynv_system_set(struct dynvSystem* dynv_system, const char* handler_name, co
 	return -1;
 }
 
+int dynv_system_set(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_name, void* value){
+	struct dynvHandler* handler;
+	if (!find_handler(dynv_system, handler_name, &handler)) return -3;
+	return system_set(dynv_system, handler, dynv_atom_get(variable_name), value);
+}
 
-void* dynv_system_get_r(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_name, int* error){
-	struct dynvVariable* variable=nullptr;
-	struct dynvHandler* handler=nullptr;
-	int error_redir;
-	if (error == nullptr) error = &error_redir;
-
+static void* system_get(struct dynvSystem* dynv_system, struct dynvHandler* handler, dynvAtom atom, int* error){
 	*error = 1;
-
-	if (handler_name != nullptr){
-		dynvHandlerMap::HandlerMap::iterator j;
-		j=dynv_system->handler_map->handlers.find(handler_name);
-		if (j == dynv_system->handler_map->handlers.end()){
-			return 0;
-		}else{
-			handler=(*j).second;
-		}
-	}
-
-	dynvSystem::VariableMap::iterator i;
-	i=dynv_system->variables.find(variable_name);
-	if (i == dynv_system->variables.end()){
-		return 0;
-	}else{
-		variable=(*i).second;
-	}
+	struct dynvVariable* variable=dynv_system->variables.find(atom);
+	if (variable == nullptr || handler == nullptr) return 0;
 
 	if (variable->handler == handler){
 		if (variable->handler->get != nullptr){
@@ -196,35 +242,24 @@ void* dynv_system_get_r(struct dynvSystem* dynv_system, const char* handler_name
 	return 0;
 }
 
-void* dynv_system_get(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_name){
-	return dynv_system_get_r(dynv_system, handler_name, variable_name, 0);
-}
-
-void** dynv_system_get_array_r(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_name, uint32_t *count, int* error){
-	struct dynvVariable* variable=nullptr;
-	struct dynvHandler* handler=nullptr;
+void* dynv_system_get_r(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_name, int* error){
+	struct dynvHandler* handler;
 	int error_redir;
 	if (error == nullptr) error = &error_redir;
 
 	*error = 1;
+	if (!find_handler(dynv_system, handler_name, &handler)) return 0;
+	return system_get(dynv_system, handler, dynv_atom_find(variable_name), error);
+}
 
-	if (handler_name != nullptr){
-		dynvHandlerMap::HandlerMap::iterator j;
-		j=dynv_system->handler_map->handlers.find(handler_name);
-		if (j == dynv_system->handler_map->handlers.end()){
-			return 0;
-		}else{
-			handler=(*j).second;
-		}
-	}
+void* dynv_system_get(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_name){
+	return dynv_system_get_r(dynv_system, handler_name, variable_name, 0);
+}
 
-	dynvSystem::VariableMap::iterator i;
-	i=dynv_system->variables.find(variable_name);
-	if (i == dynv_system->variables.end()){
-		return 0;
-	}else{
-		variable=(*i).second;
-	}
+static void** system_get_array(struct dynvSystem* dynv_system, struct dynvHandler* handler, dynvAtom atom, uint32_t *count, int* error){
+	*error = 1;
+	struct dynvVariable* variable=dynv_system->variables.find(atom);
+	if (variable == nullptr || handler == nullptr) return 0;
 
 	if (variable->handler == handler){
 		uint32_t n = 0;
@@ -262,6 +297,16 @@ void** dynv_system_get_array_r(struct dynvSystem* dynv_system, const char* handl
 	return 0;
 }
 
+void** dynv_system_get_array_r(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_name, uint32_t *count, int* error){
+	struct dynvHandler* handler;
+	int error_redir;
+	if (error == nullptr) error = &error_redir;
+
+	*error = 1;
+	if (!find_handler(dynv_system, handler_name, &handler)) return 0;
+	return system_get_array(dynv_system, handler, dynv_atom_find(variable_name), count, error);
+}
+
 static int build_linked_list(struct dynvVariable* start_variable, void** values, uint32_t count)
 {
 	if (count < 1) return -1;
@@ -281,30 +326,23 @@ static int build_linked_list(struct dynvVariable* start_variable, void** values,
 	return 0;
 }
 
-int dynv_system_set_array(dynvSystem* dynv_system, const char* handler_name, const char* variable_name, void** values, uint32_t count)
+static int system_remove(dynvSystem* dynv_system, dynvAtom atom){
+	struct dynvVariable* variable = dynv_system->variables.erase(atom);
+	if (variable == nullptr) return -1;
+	dynv_variable_destroy(variable);
+	return 0;
+}
+
+static int system_set_array(dynvSystem* dynv_system, dynvHandler* handler, dynvAtom atom, void** values, uint32_t count)
 {
-	dynvHandler* handler = nullptr;
 	if (count < 1){
-		return dynv_system_remove(dynv_system, variable_name);
+		return system_remove(dynv_system, atom);
 	}
-	if (handler_name != nullptr){
-		auto j = dynv_system->handler_map->handlers.find(handler_name);
-		if (j == dynv_system->handler_map->handlers.end()){
-			return -3;
-		}else{
-			handler = (*j).second;
-		}
-	}
-	dynvVariable* variable = nullptr;
-	auto i = dynv_system->variables.find(variable_name);
-	if (i == dynv_system->variables.end()){
+	dynvVariable* variable = dynv_system->variables.find(atom);
+	if (variable == nullptr){
 		if (handler == nullptr) return -2;
-		variable = dynv_variable_create(variable_name, handler);
-		dynv_system->variables[variable->name] = variable;
-		variable->handler->create(variable);
+		variable = create_variable(dynv_system, handler, atom);
 		return build_linked_list(variable, values, count);
-	}else{
-		variable = (*i).second;
 	}
 	if ((variable->flags & dynvVariable::Flag::read_only) != dynvVariable::Flag::none) return -4;
 	dynv_variable_destroy_data(variable);
@@ -313,43 +351,41 @@ int dynv_system_set_array(dynvSystem* dynv_system, const char* handler_name, con
 	return build_linked_list(variable, values, count);
 }
 
+int dynv_system_set_array(dynvSystem* dynv_system, const char* handler_name, const char* variable_name, void** values, uint32_t count)
+{
+	dynvHandler* handler = nullptr;
+	if (count >= 1 && !find_handler(dynv_system, handler_name, &handler)) return -3;
+	return system_set_array(dynv_system, handler, count >= 1 ? dynv_atom_get(variable_name) : dynv_atom_find(variable_name), values, count);
+}
+
 int dynv_system_remove(struct dynvSystem* dynv_system, const char* variable_name){
-	dynvSystem::VariableMap::iterator i;
-	i=dynv_system->variables.find(variable_name);
-	if (i == dynv_system->variables.end()){
-		return -1;
-	}else{
-		dynv_variable_destroy((*i).second);
-		dynv_system->variables.erase(i);
-		return 0;
-	}
+	return system_remove(dynv_system, dynv_atom_find(variable_name));
 }
 
 int dynv_system_remove_all(struct dynvSystem* dynv_system){
-	dynvSystem::VariableMap::iterator i;
-
-	for (i=dynv_system->variables.begin(); i != dynv_system->variables.end(); ++i){
-		dynv_variable_destroy((*i).second);
-	}
-	dynv_system->variables.clear();
+	destroy_variables(dynv_system);
 	return 0;
 }
 
 struct dynvVariable* dynv_system_get_var(struct dynvSystem* dynv_system, const char* variable_name){
+	return dynv_system->variables.find(dynv_atom_find(variable_name));
+}
 
-	dynvSystem::VariableMap::iterator i;
-	i=dynv_system->variables.find(variable_name);
-	if (i == dynv_system->variables.end()){
-		return 0;
-	}else{
-		return (*i).second;
+vector<struct dynvVariable*> dynv_system_get_variables(struct dynvSystem* dynv_system){
+	vector<struct dynvVariable*> variables;
+	variables.reserve(dynv_system->variables.size());
+	for (auto &slot: dynv_system->variables.getSlots()){
+		if (slot.atom != 0) variables.push_back(slot.variable);
 	}
+	sort(variables.begin(), variables.end(), [](const dynvVariable* a, const dynvVariable* b){
+		return strcmp(a->name, b->name) < 0;
+	});
+	return variables;
 }
 
 
 int dynv_system_serialize(struct dynvSystem* dynv_system, struct dynvIO* io){
 
-	dynvSystem::VariableMap::iterator i;
 	uint32_t written, length, id;
 
 	uint32_t variable_count=dynv_system->variables.size();
@@ -364,8 +400,7 @@ int dynv_system_serialize(struct dynvSystem* dynv_system, struct dynvIO* io){
 	else if (handler_count<=0xFFFFFF) handler_bytes=3;
 	else handler_bytes=4;
 
-	for (i=dynv_system->variables.begin(); i != dynv_system->variables.end(); ++i){
-		struct dynvVariable* variable=(*i).second;
+	for (auto variable: dynv_system_get_variables(dynv_system)){
 
 		id=UINT32_TO_LE(variable->handler->id);
 		dynv_io_write(io, &id, handler_bytes, &written);
@@ -478,146 +513,157 @@ struct dynvSystem* dynv_system_copy(struct dynvSystem* dynv_system){
 	struct dynvVariable *variable, *new_variable;
 	struct dynvHandler* handler;
 
-	dynvSystem::VariableMap::iterator i;
-	for (i=dynv_system->variables.begin(); i != dynv_system->variables.end(); ++i){
+	for (auto &slot: dynv_system->variables.getSlots()){
+		if (slot.atom == 0) continue;
 
-		variable = (*i).second;
-		handler = (*i).second->handler;
+		variable = slot.variable;
+		handler = variable->handler;
 
 		bool deref = true;
 		if (handler->get(variable, &value, &deref) == 0){
-			new_variable = dynv_variable_create(variable->name, handler);
-			new_dynv->variables[new_variable->name] = new_variable;
-			new_variable->handler->create(new_variable);
+			new_variable = create_variable(new_dynv, handler, slot.atom);
 			new_variable->handler->set(new_variable, value, false);
 		}
 	}
 	return new_dynv;
 }
 
-int dynv_set(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_path, const void* value){
-	string path(variable_path);
-	size_t found;
+/**
+ * Find dynamic variable system stored in a variable, creating it when requested. Reference to the parent system is released.
+ * @return Referenced variable system, or null if it does not exist and create is false.
+ */
+static struct dynvSystem* get_next_level(struct dynvSystem* dynv_system, struct dynvSystem* dlevel, struct dynvHandler* dynv_handler, dynvAtom atom, bool create){
+	int error;
+	struct dynvSystem* dlevel_new = (struct dynvSystem*)system_get(dlevel, dynv_handler, atom, &error);
+	if (!dlevel_new && create){
+		struct dynvHandlerMap* handler_map = dynv_system_get_handler_map(dynv_system);
+		dlevel_new = dynv_system_create(handler_map);
+		dynv_handler_map_release(handler_map);
+
+		system_set(dlevel, dynv_handler, atom, dlevel_new);
+	}
+	dynv_system_release(dlevel);
+	return dlevel_new;
+}
 
+/**
+ * Find dynamic variable system containing the last path element.
+ * @return Referenced variable system, or null if it does not exist and create is false.
+ */
+static struct dynvSystem* get_path_level(struct dynvSystem* dynv_system, const dynvPath& path, bool create){
 	struct dynvSystem* dlevel = dynv_system_ref(dynv_system);
+	if (path.atoms.size() < 2) return dlevel;
+	struct dynvHandler* dynv_handler;
+	find_handler(dynv_system, "dynv", &dynv_handler);
+	for (size_t i = 0; i + 1 < path.atoms.size(); i++){
+		dlevel = get_next_level(dynv_system, dlevel, dynv_handler, path.atoms[i], create);
+		if (!dlevel) return nullptr;
+	}
+	return dlevel;
+}
 
+/**
+ * Find dynamic variable system containing the last element of a dot separated path, without creating dynvPath.
+ * When create is false, names are only looked up, so that reading variables which do not exist does not allocate atoms.
+ * @param[out] atom Atom of the last path element.
+ * @return Referenced variable system, or null if it does not exist and create is false.
+ */
+static struct dynvSystem* get_path_level(struct dynvSystem* dynv_system, const char* path, bool create, dynvAtom* atom){
+	struct dynvSystem* dlevel = dynv_system_ref(dynv_system);
+	struct dynvHandler* dynv_handler = nullptr;
 	for (;;){
-		found = path.find('.');
-		if (found != string::npos){
-			struct dynvSystem* dlevel_new;
-			dlevel_new = (struct dynvSystem*)dynv_system_get(dlevel, "dynv", path.substr(0, found).c_str());
-			if (dlevel_new){
-				dynv_system_release(dlevel);
-				dlevel = dlevel_new;
-			}else{
-				struct dynvHandlerMap* handler_map = dynv_system_get_handler_map(dynv_system);
-				struct dynvSystem* dlevel_new = dynv_system_create(handler_map);
-				dynv_handler_map_release(handler_map);
-
-				dynv_system_set(dlevel, "dynv", path.substr(0, found).c_str(), dlevel_new);
-
-				dynv_system_release(dlevel);
-				dlevel = dlevel_new;
-			}
-			path = path.substr(found+1);
-		}else break;
+		const char* end = strchr(path, '.');
+		size_t length = end ? end - path : strlen(path);
+		*atom = create ? dynv_atom_get(path, length) : dynv_atom_find(path, length);
+		if (*atom == 0){
+			dynv_system_release(dlevel);
+			return nullptr;
+		}
+		if (end == nullptr) return dlevel;
+		if (dynv_handler == nullptr) find_handler(dynv_system, "dynv", &dynv_handler);
+		dlevel = get_next_level(dynv_system, dlevel, dynv_handler, *atom, create);
+		if (!dlevel) return nullptr;
+		path = end + 1;
 	}
+}
 
-	int r = dynv_system_set(dlevel, handler_name, path.c_str(), (void*)value);
+int dynv_set(struct dynvSystem* dynv_system, const char* handler_name, const dynvPath& variable_path, const void* value){
+	struct dynvHandler* handler;
+	if (!find_handler(dynv_system, handler_name, &handler)) return -3;
+	struct dynvSystem* dlevel = get_path_level(dynv_system, variable_path, true);
+	int r = system_set(dlevel, handler, variable_path.atoms.back(), (void*)value);
+	dynv_system_release(dlevel);
+	return r;
+}
 
+int dynv_set(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_path, const void* value){
+	struct dynvHandler* handler;
+	if (!find_handler(dynv_system, handler_name, &handler)) return -3;
+	dynvAtom atom;
+	struct dynvSystem* dlevel = get_path_level(dynv_system, variable_path, true, &atom);
+	int r = system_set(dlevel, handler, atom, (void*)value);
 	dynv_system_release(dlevel);
 	return r;
 }
 
 int dynv_set_array(dynvSystem* dynv_system, const char* handler_name, const char* variable_path, const void** values, uint32_t count)
 {
-	string path(variable_path);
-	size_t found;
-	dynvSystem* dlevel = dynv_system_ref(dynv_system);
-	for (;;){
-		found = path.find('.');
-		if (found != string::npos){
-			dynvSystem* dlevel_new = (dynvSystem*)dynv_system_get(dlevel, "dynv", path.substr(0, found).c_str());
-			if (dlevel_new){
-				dynv_system_release(dlevel);
-				dlevel = dlevel_new;
-			}else{
-				dynvHandlerMap* handler_map = dynv_system_get_handler_map(dynv_system);
-				dynvSystem* dlevel_new = dynv_system_create(handler_map);
-				dynv_handler_map_release(handler_map);
-				dynv_system_set(dlevel, "dynv", path.substr(0, found).c_str(), dlevel_new);
-				dynv_system_release(dlevel);
-				dlevel = dlevel_new;
-			}
-			path = path.substr(found+1);
-		}else break;
-	}
-	int r = dynv_system_set_array(dlevel, handler_name, path.c_str(), (void**)values, count);
+	dynvHandler* handler = nullptr;
+	if (count >= 1 && !find_handler(dynv_system, handler_name, &handler)) return -3;
+	dynvAtom atom;
+	// Removing a variable does not create missing path levels
+	dynvSystem* dlevel = get_path_level(dynv_system, variable_path, count >= 1, &atom);
+	if (!dlevel) return -1;
+	int r = system_set_array(dlevel, handler, atom, (void**)values, count);
 	dynv_system_release(dlevel);
 	return r;
 }
 
-void* dynv_get(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_path, int* error){
-	string path(variable_path);
-	size_t found;
+void* dynv_get(struct dynvSystem* dynv_system, const char* handler_name, const dynvPath& variable_path, int* error){
 	int error_redir;
 	if (error == nullptr) error = &error_redir;
 
-	*error = 0;
+	*error = 1;
+	struct dynvHandler* handler;
+	if (!find_handler(dynv_system, handler_name, &handler)) return 0;
+	struct dynvSystem* dlevel = get_path_level(dynv_system, variable_path, false);
+	if (!dlevel) return 0;
 
-	struct dynvSystem* dlevel = dynv_system_ref(dynv_system);
+	void* r = system_get(dlevel, handler, variable_path.atoms.back(), error);
 
-	for (;;){
-		found = path.find('.');
-		if (found != string::npos){
-			struct dynvSystem* dlevel_new;
-			dlevel_new = (struct dynvSystem*)dynv_system_get(dlevel, "dynv", path.substr(0, found).c_str());
-			if (dlevel_new){
-				dynv_system_release(dlevel);
-				dlevel = dlevel_new;
-			}else{
-				dynv_system_release(dlevel);
-				*error = 1;
-				return 0;
-			}
-			path = path.substr(found+1);
-		}else break;
-	}
+	dynv_system_release(dlevel);
+	return r;
+}
+
+void* dynv_get(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_path, int* error){
+	int error_redir;
+	if (error == nullptr) error = &error_redir;
+
+	*error = 1;
+	struct dynvHandler* handler;
+	if (!find_handler(dynv_system, handler_name, &handler)) return 0;
+	dynvAtom atom;
+	struct dynvSystem* dlevel = get_path_level(dynv_system, variable_path, false, &atom);
+	if (!dlevel) return 0;
 
-	void* r = dynv_system_get_r(dlevel, handler_name, path.c_str(), error);
+	void* r = system_get(dlevel, handler, atom, error);
 
 	dynv_system_release(dlevel);
 	return r;
 }
 
 void** dynv_get_array(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_path, uint32_t *count, int* error){
-	string path(variable_path);
-	size_t found;
 	int error_redir;
 	if (error == nullptr) error = &error_redir;
 
-	*error = 0;
-
-	struct dynvSystem* dlevel = dynv_system_ref(dynv_system);
-
-	for (;;){
-		found = path.find('.');
-		if (found != string::npos){
-			struct dynvSystem* dlevel_new;
-			dlevel_new = (struct dynvSystem*)dynv_system_get(dlevel, "dynv", path.substr(0, found).c_str());
-			if (dlevel_new){
-				dynv_system_release(dlevel);
-				dlevel = dlevel_new;
-			}else{
-				dynv_system_release(dlevel);
-				*error = 1;
-				return 0;
-			}
-			path = path.substr(found+1);
-		}else break;
-	}
+	*error = 1;
+	struct dynvHandler* handler;
+	if (!find_handler(dynv_system, handler_name, &handler)) return 0;
+	dynvAtom atom;
+	struct dynvSystem* dlevel = get_path_level(dynv_system, variable_path, false, &atom);
+	if (!dlevel) return 0;
 
-	void** r = dynv_system_get_array_r(dlevel, handler_name, path.c_str(), count, error);
+	void** r = system_get_array(dlevel, handler, atom, count, error);
 
 	dynv_system_release(dlevel);
 	return r;
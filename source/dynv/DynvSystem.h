@@ -20,6 +20,7 @@
 #define DYNVSYSTEM_H_
 
 #include "DynvHandler.h"
+#include "DynvAtom.h"
 
 #include <map>
 #include <vector>
@@ -28,14 +29,37 @@
 
 #include <stdint.h>
 
-struct dynvSystem{
-	class dynvKeyCompare{
-	public:
-		bool operator() (const char* const& x, const char* const& y) const;
+struct dynvVariable;
+
+/** \class dynvVariableTable
+ * \brief Open addressing hash table of variables keyed by name atom.
+ */
+class dynvVariableTable{
+public:
+	/** Table slot. Empty slots have zero atom. */
+	struct Slot{
+		dynvAtom atom;
+		struct dynvVariable* variable;
 	};
-	typedef std::map<const char*, struct dynvVariable*, dynvKeyCompare> VariableMap;
+	dynvVariableTable();
+	struct dynvVariable* find(dynvAtom atom) const;
+	/** Add variable. Table must not already contain variable with the same atom. */
+	void insert(dynvAtom atom, struct dynvVariable* variable);
+	/** Remove variable from the table. Returns removed variable or null. */
+	struct dynvVariable* erase(dynvAtom atom);
+	void clear();
+	size_t size() const;
+	const std::vector<Slot>& getSlots() const;
+private:
+	std::vector<Slot> slots;
+	size_t count;
+	size_t getIndex(dynvAtom atom) const;
+	void grow();
+};
+
+struct dynvSystem{
 	uint32_t refcnt;
-	VariableMap variables;
+	dynvVariableTable variables;
 	dynvHandlerMap* handler_map;
 };
 
@@ -55,6 +79,8 @@ int dynv_system_set_array(struct dynvSystem* dynv_system, const char* handler_na
 void** dynv_system_get_array_r(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_name, uint32_t *count, uint32_t data_size, int* error);
 
 struct dynvVariable* dynv_system_get_var(struct dynvSystem* dynv_system, const char* variable_name);
+/** Get all variables sorted by name, so that serialized output does not depend on the order of atoms. */
+std::vector<struct dynvVariable*> dynv_system_get_variables(struct dynvSystem* dynv_system);
 
 int dynv_system_remove(struct dynvSystem* dynv_system, const char* variable_name);
 int dynv_system_remove_all(struct dynvSystem* dynv_system);
@@ -68,6 +94,8 @@ int dynv_system_deserialize(struct dynvSystem* dynv_system, dynvHandlerMap::Hand
 
 int dynv_set(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_path, const void* value);
 void* dynv_get(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_path, int* error);
+int dynv_set(struct dynvSystem* dynv_system, const char* handler_name, const dynvPath& variable_path, const void* value);
+void* dynv_get(struct dynvSystem* dynv_system, const char* handler_name, const dynvPath& variable_path, int* error);
 
 void** dynv_get_array(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_path, uint32_t *count, int* error);
 int dynv_set_array(struct dynvSystem* dynv_system, const char* handler_name, const char* variable_path, const void** values, uint32_t count);
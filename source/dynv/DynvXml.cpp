@@ -29,8 +29,7 @@ using namespace std;
 
 int dynv_xml_serialize(struct dynvSystem* dynv_system, ostream& out)
 {
-	for (auto variable_item: dynv_system->variables){
-		dynvVariable *variable = variable_item.second;
+	for (auto variable: dynv_system_get_variables(dynv_system)){
 		if ((variable->flags & dynvVariable::Flag::no_save) != dynvVariable::Flag::none) continue;
 		if (variable->handler->serialize_xml){
 			if (variable->next){
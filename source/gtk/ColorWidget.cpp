@@ -20,6 +20,7 @@
 #include "../Color.h"
 #include "../MathUtil.h"
 #include <math.h>
+#include <string.h>
 #include <boost/math/special_functions/round.hpp>
 #include <iostream>
 using namespace std;
@@ -140,6 +141,8 @@ void gtk_color_set_roundness(GtkColor* widget, double roundness)
 void gtk_color_set_color(GtkColor* widget, Color* color, const char* text)
 {
 	GtkColorPrivate *ns = GET_PRIVATE(widget);
+	if (color_equal(color, &ns->color) && (text ? (ns->text && strcmp(text, ns->text) == 0) : !ns->text))
+		return;
 	color_copy(color, &ns->color);
 	if (ns->secondary_color){
 	}else{
@@ -157,6 +157,7 @@ void gtk_swatch_set_color(GtkSwatch* swatch, guint32 index, Color* color)
 void gtk_swatch_set_main_color(GtkSwatch* swatch, Color* color)
 {
 	GtkSwatchPrivate *ns = GET_PRIVATE(swatch);
+	if (color_equal(color, &ns->color[0])) return;
 	color_copy(color, &ns->color[0]);
 	gtk_widget_queue_draw(GTK_WIDGET(swatch));
 }
@@ -175,6 +176,7 @@ void gtk_swatch_set_active_color(GtkSwatch* swatch, Color* color)
 void gtk_swatch_set_main_color(GtkSwatch* swatch, guint index, Color* color)
 {
 	GtkSwatchPrivate *ns = GET_PRIVATE(swatch);
+	if (color_equal(color, &ns->color[0])) return;
 	color_copy(color, &ns->color[0]);
 	gtk_widget_queue_draw(GTK_WIDGET(swatch));
 }
@@ -19,6 +19,7 @@
 #include "Zoomed.h"
 #include "../Color.h"
 #include "../MathUtil.h"
+#include "../ScaledTile.h"
 #include <math.h>
 #include <iomanip>
 #include <algorithm>
@@ -47,6 +48,7 @@ struct GtkZoomedPrivate
 	Color color;
 	gfloat zoom;
 	cairo_surface_t *surface;
+	ScaledTile *tile; /**< Keeps surface contents between updates, so only changed pixels are rendered. Surface is a wrapping tile starting at tile origin */
 	vector2 point;
 	vector2 point_size;
 	int32_t width_height;
@@ -57,6 +59,8 @@ struct GtkZoomedPrivate
 	math::Vec2<int> pointer;
 	math::Rect2<int> screen_rect;
 	bool fade;
+	bool updated; /**< Surface contains pointer area at current zoom and size */
+	gfloat updated_zoom;
 #if GTK_MAJOR_VERSION >= 3
 	GtkStyleContext *context;
 #endif
@@ -107,6 +111,8 @@ GtkWidget* gtk_zoomed_new()
 	ns->point.y = 0;
 	ns->width_height = 0;
 	ns->surface = nullptr;
+	ns->tile = new ScaledTile();
+	ns->updated = false;
 #if GTK_MAJOR_VERSION >= 3
 	ns->context = get_style_context(GTK_TYPE_ZOOMED);
 #endif
@@ -128,6 +134,8 @@ void gtk_zoomed_set_size(GtkZoomed *zoomed, int32_t width_height)
 		}
 		ns->width_height = width_height;
 		ns->surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, ns->width_height, ns->width_height);
+		ns->tile->invalidate();
+		ns->updated = false;
 #if GTK_MAJOR_VERSION >= 3
 		gtk_widget_set_size_request(GTK_WIDGET(zoomed), ns->width_height, ns->width_height);
 #else
@@ -148,6 +156,8 @@ static void finalize(GObject *zoomed_obj)
 		cairo_surface_destroy(ns->surface);
 		ns->surface = nullptr;
 	}
+	delete ns->tile;
+	ns->tile = nullptr;
 #if GTK_MAJOR_VERSION >= 3
 	g_object_unref(ns->context);
 #endif
@@ -264,15 +274,22 @@ void gtk_zoomed_update(GtkZoomed *zoomed, math::Vec2<int>& pointer, math::Rect2<
 	ns->point_size.y = yh - yl;
 	int width = right - left;
 	int height = bottom - top;
-	cairo_t *cr = cairo_create(ns->surface);
-	cairo_scale(cr, ns->width_height / (double)width, ns->width_height / (double)height);
-	cairo_set_source_surface(cr, surface, offset.x, offset.y);
-	cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_NEAREST);
-	cairo_rectangle(cr, 0, 0, ns->width_height, ns->width_height);
-	cairo_fill(cr);
-	cairo_destroy(cr);
+	if (offset.x < 0 || offset.y < 0 || offset.x + width > cairo_image_surface_get_width(surface) || offset.y + height > cairo_image_surface_get_height(surface)) return;
+	cairo_surface_flush(surface);
+	cairo_surface_flush(ns->surface);
+	int stride = cairo_image_surface_get_stride(surface);
+	const uint8_t *source = cairo_image_surface_get_data(surface) + offset.y * stride + offset.x * 4;
+	ns->tile->update(source, stride, left, top, width, height, cairo_image_surface_get_data(ns->surface), cairo_image_surface_get_stride(ns->surface), ns->width_height, ns->width_height);
+	cairo_surface_mark_dirty(ns->surface);
+	ns->updated = true;
+	ns->updated_zoom = ns->zoom;
 	gtk_widget_queue_draw(GTK_WIDGET(zoomed));
 }
+bool gtk_zoomed_is_update_needed(GtkZoomed *zoomed, math::Vec2<int>& pointer, math::Rect2<int>& screen_rect)
+{
+	GtkZoomedPrivate *ns = GET_PRIVATE(zoomed);
+	return !ns->updated || ns->updated_zoom != ns->zoom || ns->pointer != pointer || ns->screen_rect != screen_rect;
+}
 void gtk_zoomed_set_zoom(GtkZoomed *zoomed, gfloat zoom)
 {
 	GtkZoomedPrivate *ns = GET_PRIVATE(zoomed);
@@ -306,13 +323,20 @@ static gboolean draw(GtkWidget *widget, cairo_t *cr)
 		gint pixbuf_width = min(ns->width_height - pixbuf_x, ns->width_height);
 		gint pixbuf_height = min(ns->width_height - pixbuf_y, ns->width_height);
 		if (pixbuf_width > 0 && pixbuf_height > 0){
-			cairo_set_source_surface(cr, ns->surface, pixbuf_x, pixbuf_y);
+			int origin_x, origin_y;
+			ns->tile->getOrigin(origin_x, origin_y);
+			cairo_save(cr);
+			cairo_rectangle(cr, pixbuf_x, pixbuf_y, ns->width_height, ns->width_height);
+			cairo_clip(cr);
+			cairo_set_source_surface(cr, ns->surface, pixbuf_x - origin_x, pixbuf_y - origin_y);
 			cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_NEAREST);
+			cairo_pattern_set_extend(cairo_get_source(cr), CAIRO_EXTEND_REPEAT);
 			if (ns->fade){
 				cairo_paint_with_alpha(cr, 0.2);
 			}else{
 				cairo_paint(cr);
 			}
+			cairo_restore(cr);
 		}
 	}
 	if (!ns->fade){
@@ -50,6 +50,14 @@ void gtk_zoomed_set_size(GtkZoomed *zoomed, int32_t width_height);
 void gtk_zoomed_set_mark(GtkZoomed *zoomed, int index, math::Vec2<int>& position);
 void gtk_zoomed_clear_mark(GtkZoomed *zoomed, int index);
 void gtk_zoomed_update(GtkZoomed* zoomed, math::Vec2<int>& pointer, math::Rect2<int>& screen_rect, math::Vec2<int>& offset, cairo_surface_t *surface);
+/**
+ * Check if zoomed area would change for new pointer position when screen contents are the same as during the last update.
+ * @param[in] zoomed Zoomed widget.
+ * @param[in] pointer Pointer position.
+ * @param[in] screen_rect Screen area.
+ * @return True if pointer, screen area, zoom or size differ from the last update.
+ */
+bool gtk_zoomed_is_update_needed(GtkZoomed* zoomed, math::Vec2<int>& pointer, math::Rect2<int>& screen_rect);
 void gtk_zoomed_get_screen_rect(GtkZoomed* zoomed, math::Vec2<int>& pointer, math::Rect2<int>& screen_rect, math::Rect2<int> *rect);
 GType gtk_zoomed_get_type();
 
@@ -23,6 +23,10 @@
 #include "Internationalisation.h"
 #include "version/Version.h"
 #include "DynvHelpers.h"
+#include "BatchMode.h"
+#include "GlobalState.h"
+#include "Color.h"
+#include "StartupTrace.h"
 #include <gtk/gtk.h>
 #include <string>
 using namespace std;
@@ -36,6 +40,16 @@ static gboolean single_color_pick_mode = FALSE;
 static gboolean version_information = FALSE;
 static gboolean do_not_start = FALSE;
 static gchar *converter_name = nullptr;
+static gboolean trace_startup = FALSE;
+static gboolean batch_mode = FALSE;
+static gchar *batch_format = nullptr;
+static gchar *batch_output_directory = nullptr;
+static gchar *batch_sort = nullptr;
+static gboolean batch_reverse = FALSE;
+static gboolean batch_name = FALSE;
+static gint batch_colors = 16;
+static gchar *batch_quantizer = nullptr;
+static gint batch_jobs = 0;
 static GOptionEntry commandline_entries[] =
 {
 	{"geometry", 'g', 0, G_OPTION_ARG_STRING, &commandline_geometry, "Window geometry", "GEOMETRY"},
@@ -44,22 +58,62 @@ static GOptionEntry commandline_entries[] =
 	{"output", 'o', 0, G_OPTION_ARG_NONE, &output_picked_color, "Output picked color", nullptr},
 	{"no-newline", 0, 0, G_OPTION_ARG_NONE, &output_without_newline, "Output picked color without newline", nullptr},
 	{"no-start", 0, 0, G_OPTION_ARG_NONE, &do_not_start, "Do not start Gpick if it is not already running", nullptr},
-	{"converter-name", 'c', 0, G_OPTION_ARG_STRING, &converter_name, "Converter name used for floating picker mode", nullptr},
+	{"converter-name", 'c', 0, G_OPTION_ARG_STRING, &converter_name, "Converter name used for floating picker mode and batch mode text output", nullptr},
 	{"version", 'v', 0, G_OPTION_ARG_NONE, &version_information, "Print version information", nullptr},
+	{"trace-startup", 0, 0, G_OPTION_ARG_NONE, &trace_startup, "Print duration of startup phases", nullptr},
 	{G_OPTION_REMAINING, 0, 0, G_OPTION_ARG_FILENAME_ARRAY, &commandline_filename, nullptr, "[FILE...]"},
 	{nullptr}
 };
+static GOptionEntry batch_entries[] =
+{
+	{"batch", 'b', 0, G_OPTION_ARG_NONE, &batch_mode, "Process FILE arguments without starting user interface. Use - to read colors from standard input", nullptr},
+	{"format", 0, 0, G_OPTION_ARG_STRING, &batch_format, "Export palettes to files of this type instead of writing colors to standard output", "gpa|gpl|ase|txt|mtl|css|html"},
+	{"output-directory", 0, 0, G_OPTION_ARG_FILENAME, &batch_output_directory, "Directory for exported palettes", "DIRECTORY"},
+	{"sort", 0, 0, G_OPTION_ARG_STRING, &batch_sort, "Sort colors, for example by lab_lightness or hsl_hue", "TYPE"},
+	{"reverse", 0, 0, G_OPTION_ARG_NONE, &batch_reverse, "Reverse sort order", nullptr},
+	{"name", 0, 0, G_OPTION_ARG_NONE, &batch_name, "Name colors", nullptr},
+	{"colors", 0, 0, G_OPTION_ARG_INT, &batch_colors, "Number of colors extracted from images", "N"},
+	{"quantizer", 0, 0, G_OPTION_ARG_STRING, &batch_quantizer, "Quantizer used for images", "NAME"},
+	{"jobs", 'j', 0, G_OPTION_ARG_INT, &batch_jobs, "Number of files processed in parallel", "N"},
+	{nullptr}
+};
+static int run_batch_mode()
+{
+	BatchOptions options;
+	for (size_t i = 0; commandline_filename && commandline_filename[i]; i++)
+		options.input_files.push_back(commandline_filename[i]);
+	if (options.input_files.empty()){
+		g_printerr("batch mode requires at least one input file\n");
+		return -1;
+	}
+	if (batch_format) options.output_format = batch_format;
+	if (batch_output_directory) options.output_directory = batch_output_directory;
+	if (converter_name) options.converter_name = converter_name;
+	if (batch_sort) options.sort_type = batch_sort;
+	options.reverse = batch_reverse;
+	options.name_colors = batch_name;
+	options.image_colors = batch_colors > 0 ? batch_colors : 1;
+	if (batch_quantizer) options.quantizer = batch_quantizer;
+	options.jobs = batch_jobs > 0 ? batch_jobs : 0;
+	color_init();
+	GlobalState gs;
+	gs.loadAll();
+	return batch_mode_run(&gs, options);
+}
 int main(int argc, char **argv)
 {
 	setlocale(LC_ALL, "");
-	gtk_init(&argc, &argv);
 	initialize_internationalisation();
 	g_set_application_name(program_name);
 	gchar* tmp;
 	GError *error = nullptr;
 	GOptionContext *context = g_option_context_new("- advanced color picker");
 	g_option_context_add_main_entries(context, commandline_entries, 0);
-	g_option_context_add_group(context, gtk_get_option_group(TRUE));
+	GOptionGroup *batch_group = g_option_group_new("batch", "Batch mode options:", "Show batch mode options", nullptr, nullptr);
+	g_option_group_add_entries(batch_group, batch_entries);
+	g_option_context_add_group(context, batch_group);
+	// GTK options are parsed without opening display, so batch mode can run without display server
+	g_option_context_add_group(context, gtk_get_option_group(FALSE));
 	gchar **argv_copy;
 #ifdef WIN32
 	argv_copy = g_win32_get_command_line();
@@ -82,6 +136,21 @@ int main(int argc, char **argv)
 		g_strfreev(argv_copy);
 		return 0;
 	}
+	startup_trace_enable(trace_startup);
+	startup_trace_mark("options parsed");
+	if (batch_mode){
+		int return_value = run_batch_mode();
+		g_option_context_free(context);
+		g_strfreev(argv_copy);
+		return return_value;
+	}
+	GlobalState *gs = new GlobalState();
+	// Settings file is parsed while GTK is being initialized
+	gs->loadSettingsInBackground();
+	{
+		StartupTracePhase trace("gtk");
+		gtk_init(nullptr, nullptr);
+	}
 	AppOptions options;
 	options.floating_picker_mode = pick_color;
 	options.output_picked_color = output_picked_color;
@@ -90,24 +159,18 @@ int main(int argc, char **argv)
 	options.do_not_start = do_not_start;
 	if (converter_name != nullptr)
 		options.converter_name = converter_name;
+	if (commandline_filename)
+		options.filename = commandline_filename[0];
 	int return_value = 0;
-	AppArgs *args = app_create_main(options, return_value);
+	int64_t create_start_time = g_get_monotonic_time();
+	AppArgs *args = app_create_main(gs, options, return_value);
+	startup_trace_add("create application", create_start_time);
 	if (args){
 		GtkIconTheme *icon_theme;
 		icon_theme = gtk_icon_theme_get_default();
 		gtk_icon_theme_append_search_path(icon_theme, tmp = build_filename(0));
 		g_free(tmp);
-		if (!single_color_pick_mode){
-			if (commandline_filename){
-				app_load_file(args, commandline_filename[0]);
-			}else{
-				if (app_is_autoload_enabled(args)){
-					gchar* autosave_file = build_config_path("autosave.gpa");
-					app_load_file(args, autosave_file, true);
-					g_free(autosave_file);
-				}
-			}
-		}
+		app_load_startup_file(args);
 		if (commandline_geometry) app_parse_geometry(args, commandline_geometry);
 		return_value = app_run(args);
 	}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GPICK_QUANTIZER_FACTORY_H_
+#define GPICK_QUANTIZER_FACTORY_H_
+
+#include "Quantizer.h"
+#include <memory>
+#include <vector>
+
+/** \file source/quantizer/Factory.h
+ * \brief Class for quantizer object creation.
+ */
+
+namespace quantizer {
+
+/** \class Factory
+ * \brief Quantizer object creation management class.
+ */
+class Factory{
+	public:
+		struct TypeInfo{
+			const char *name;
+			const char *human_name;
+			TypeInfo(const char *name, const char *human_name);
+		};
+
+		/**
+		 * Create new quantizer object.
+		 * @param[in] type Name of quantizer object type.
+		 * @return New quantizer object or null pointer if type is unknown.
+		 */
+		static std::shared_ptr<Quantizer> create(const char *type);
+
+		/**
+		 * Get all quantizer object types. Default type is the first one.
+		 * @return Vector of quantizer object type information structures.
+		 */
+		static std::vector<TypeInfo> getAllTypes();
+};
+
+}
+
+#endif /* GPICK_QUANTIZER_FACTORY_H_ */
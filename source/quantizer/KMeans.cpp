@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "KMeans.h"
+#include "../ColorHistogram.h"
+#include "../ColorBatch.h"
+#include "../Internationalisation.h"
+#include <algorithm>
+#include <random>
+
+namespace quantizer {
+
+static const char *quantizer_name = "kmeans";
+/** Maximum number of Lloyd iterations. Iterations stop earlier when no point changes its cluster. */
+static const int max_iterations = 32;
+
+const char *KMeans::getName()
+{
+	return quantizer_name;
+}
+
+const char *KMeans::getReadableName()
+{
+	return _("K-means");
+}
+
+KMeans::KMeans():Quantizer(quantizer_name, getReadableName())
+{
+}
+
+KMeans::~KMeans()
+{
+}
+
+/** Select random point with probability proportional to its weight multiplied by its squared distance to the nearest center. */
+static size_t pick_point(std::mt19937 &generator, const std::vector<double> &weights, const std::vector<float> &distance, double total)
+{
+	double target = generator() / 4294967296.0 * total, sum = 0;
+	size_t last = 0;
+	for (size_t i = 0; i < weights.size(); i++){
+		double value = weights[i] * distance[i];
+		if (value <= 0) continue;
+		sum += value;
+		last = i;
+		if (sum > target) break;
+	}
+	return last;
+}
+
+void KMeans::quantize(const ColorHistogram &histogram, size_t colors, std::vector<Color> &palette)
+{
+	palette.clear();
+	if (colors == 0 || histogram.empty()) return;
+	ColorBuffer points;
+	std::vector<double> weights;
+	getLabPoints(histogram, points, weights);
+	const size_t count = points.size();
+	const float *x = points.plane(0), *y = points.plane(1), *z = points.plane(2);
+	std::vector<float> centers, new_distance(count);
+	// first center is selected using point weights only
+	std::vector<float> distance(count, 1.0f);
+	std::vector<uint32_t> assignment(count), previous_assignment(count, 0);
+	// k-means++ seeding. Fixed seed makes results repeatable.
+	std::mt19937 generator(1);
+	double total = 0;
+	for (size_t i = 0; i < count; i++)
+		total += weights[i];
+	while (centers.size() / 3 < colors && total > 0){
+		size_t point = pick_point(generator, weights, distance, total);
+		centers.push_back(x[point]);
+		centers.push_back(y[point]);
+		centers.push_back(z[point]);
+		color_batch_find_nearest(x, y, z, count, &centers[centers.size() - 3], 1, &assignment[0], &new_distance[0]);
+		total = 0;
+		for (size_t i = 0; i < count; i++){
+			distance[i] = centers.size() == 3 ? new_distance[i] : std::min(distance[i], new_distance[i]);
+			total += weights[i] * distance[i];
+		}
+	}
+	const size_t center_count = centers.size() / 3;
+	std::vector<double> sums(center_count * 3), cluster_weights(center_count);
+	for (int iteration = 0; iteration < max_iterations; iteration++){
+		color_batch_find_nearest(x, y, z, count, &centers[0], center_count, &assignment[0], &distance[0]);
+		if (iteration > 0 && assignment == previous_assignment) break;
+		std::fill(sums.begin(), sums.end(), 0.0);
+		std::fill(cluster_weights.begin(), cluster_weights.end(), 0.0);
+		for (size_t i = 0; i < count; i++){
+			uint32_t cluster = assignment[i];
+			double w = weights[i];
+			cluster_weights[cluster] += w;
+			sums[cluster * 3 + 0] += w * x[i];
+			sums[cluster * 3 + 1] += w * y[i];
+			sums[cluster * 3 + 2] += w * z[i];
+		}
+		for (size_t i = 0; i < center_count; i++){
+			if (cluster_weights[i] > 0){
+				for (int j = 0; j < 3; j++)
+					centers[i * 3 + j] = sums[i * 3 + j] / cluster_weights[i];
+				continue;
+			}
+			// move center of empty cluster to the point with the largest error
+			size_t point = 0;
+			double max_error = -1;
+			for (size_t j = 0; j < count; j++){
+				double error = weights[j] * distance[j];
+				if (error > max_error){
+					max_error = error;
+					point = j;
+				}
+			}
+			centers[i * 3 + 0] = x[point];
+			centers[i * 3 + 1] = y[point];
+			centers[i * 3 + 2] = z[point];
+			distance[point] = 0;
+		}
+		previous_assignment.swap(assignment);
+	}
+	color_batch_find_nearest(x, y, z, count, &centers[0], center_count, &assignment[0], nullptr);
+	std::fill(cluster_weights.begin(), cluster_weights.end(), 0.0);
+	for (size_t i = 0; i < count; i++)
+		cluster_weights[assignment[i]] += weights[i];
+	std::vector<Color> means;
+	std::vector<double> mean_weights;
+	for (size_t i = 0; i < center_count; i++){
+		if (cluster_weights[i] <= 0) continue;
+		Color color;
+		color_zero(&color);
+		for (int j = 0; j < 3; j++)
+			color.ma[j] = centers[i * 3 + j];
+		means.push_back(color);
+		mean_weights.push_back(cluster_weights[i]);
+	}
+	getPalette(means, mean_weights, palette);
+}
+
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MedianCut.h"
+#include "../ColorHistogram.h"
+#include "../Internationalisation.h"
+#include <algorithm>
+#include <numeric>
+
+namespace quantizer {
+
+static const char *quantizer_name = "median_cut";
+
+const char *MedianCut::getName()
+{
+	return quantizer_name;
+}
+
+const char *MedianCut::getReadableName()
+{
+	return _("Median cut");
+}
+
+MedianCut::MedianCut():Quantizer(quantizer_name, getReadableName())
+{
+}
+
+MedianCut::~MedianCut()
+{
+}
+
+struct Box{
+	size_t begin; /**< First point index in point order */
+	size_t end; /**< Point index after the last point in point order */
+	double weight; /**< Sum of point weights */
+	double mean[3]; /**< Weighted mean of points */
+	double error; /**< Weighted sum of squared distances from mean, zero if box can not be split */
+	int axis; /**< Axis with the largest variance */
+};
+
+static Box make_box(size_t begin, size_t end, const ColorBuffer &points, const std::vector<double> &weights, const std::vector<uint32_t> &order)
+{
+	Box box;
+	box.begin = begin;
+	box.end = end;
+	double weight = 0, sum[3] = {0, 0, 0}, squares[3] = {0, 0, 0};
+	for (size_t i = begin; i < end; i++){
+		uint32_t point = order[i];
+		double w = weights[point];
+		weight += w;
+		for (int j = 0; j < 3; j++){
+			double value = points.plane(j)[point];
+			sum[j] += w * value;
+			squares[j] += w * value * value;
+		}
+	}
+	box.weight = weight;
+	box.error = 0;
+	box.axis = 0;
+	double max_error = -1;
+	for (int j = 0; j < 3; j++){
+		box.mean[j] = sum[j] / weight;
+		double error = std::max(squares[j] - sum[j] * sum[j] / weight, 0.0);
+		box.error += error;
+		if (error > max_error){
+			max_error = error;
+			box.axis = j;
+		}
+	}
+	if (end - begin < 2)
+		box.error = 0;
+	return box;
+}
+
+void MedianCut::quantize(const ColorHistogram &histogram, size_t colors, std::vector<Color> &palette)
+{
+	palette.clear();
+	if (colors == 0 || histogram.empty()) return;
+	ColorBuffer points;
+	std::vector<double> weights;
+	getLabPoints(histogram, points, weights);
+	std::vector<uint32_t> order(points.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::vector<Box> boxes;
+	boxes.push_back(make_box(0, order.size(), points, weights, order));
+	while (boxes.size() < colors){
+		auto box = std::max_element(boxes.begin(), boxes.end(), [](const Box &a, const Box &b){
+			return a.error < b.error;
+		});
+		if (box->error <= 0) break;
+		const float *values = points.plane(box->axis);
+		std::sort(order.begin() + box->begin, order.begin() + box->end, [values](uint32_t a, uint32_t b){
+			return values[a] < values[b];
+		});
+		double half = box->weight / 2, weight = 0;
+		size_t split = box->begin;
+		while (split < box->end - 1 && weight + weights[order[split]] / 2 < half){
+			weight += weights[order[split]];
+			split++;
+		}
+		split = std::max(split, box->begin + 1);
+		size_t begin = box->begin, end = box->end;
+		*box = make_box(begin, split, points, weights, order);
+		boxes.push_back(make_box(split, end, points, weights, order));
+	}
+	std::vector<Color> means(boxes.size());
+	std::vector<double> box_weights(boxes.size());
+	for (size_t i = 0; i < boxes.size(); i++){
+		color_zero(&means[i]);
+		for (int j = 0; j < 3; j++)
+			means[i].ma[j] = boxes[i].mean[j];
+		box_weights[i] = boxes[i].weight;
+	}
+	getPalette(means, box_weights, palette);
+}
+
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Quantizer.h"
+#include "../ColorHistogram.h"
+#include <algorithm>
+#include <numeric>
+
+namespace quantizer {
+
+Quantizer::Quantizer(const char *name_, const char *readable_name_):
+	name(name_), readable_name(readable_name_)
+{
+}
+
+Quantizer::~Quantizer()
+{
+}
+
+void Quantizer::getLabPoints(const ColorHistogram &histogram, ColorBuffer &points, std::vector<double> &weights)
+{
+	std::vector<uint32_t> keys;
+	histogram.getKeys(keys);
+	std::vector<Color> colors(keys.size());
+	weights.resize(keys.size());
+	const matrix3x3 *transformation = color_get_sRGB_transformation_matrix();
+	const matrix3x3 *adaptation_matrix = color_get_d65_d50_adaptation_matrix();
+	const vector3 *reference_white = color_get_reference(REFERENCE_ILLUMINANT_D50, REFERENCE_OBSERVER_2);
+	for (size_t i = 0; i < keys.size(); i++){
+		// linear values come from 8-bit table, so no gamma function is evaluated for histogram colors
+		histogram.getLinearColor(keys[i], colors[i]);
+		color_linear_to_xyz(&colors[i], &colors[i], transformation);
+		color_xyz_chromatic_adaptation(&colors[i], &colors[i], adaptation_matrix);
+		color_xyz_to_lab(&colors[i], &colors[i], reference_white);
+		weights[i] = histogram.getBin(keys[i]).pixels;
+	}
+	points = ColorBuffer(ColorSpace::lab, colors);
+}
+
+void Quantizer::getPalette(const std::vector<Color> &colors, const std::vector<double> &weights, std::vector<Color> &palette)
+{
+	std::vector<size_t> order(colors.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&weights](size_t a, size_t b){
+		return weights[a] > weights[b];
+	});
+	palette.resize(colors.size());
+	for (size_t i = 0; i < order.size(); i++){
+		color_lab_to_rgb_d50(&colors[order[i]], &palette[i]);
+		palette[i].ma[3] = 0;
+		color_rgb_normalize(&palette[i]);
+	}
+}
+
+std::string Quantizer::getName() const
+{
+	return name;
+}
+
+std::string Quantizer::getReadableName() const
+{
+	return readable_name;
+}
+
+}
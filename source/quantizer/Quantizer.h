@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GPICK_QUANTIZER_QUANTIZER_H_
+#define GPICK_QUANTIZER_QUANTIZER_H_
+
+#include "../Color.h"
+#include "../ColorBuffer.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+class ColorHistogram;
+
+/** \file source/quantizer/Quantizer.h
+ * \brief Palette quantizer class.
+ */
+
+namespace quantizer {
+
+/** \class Quantizer
+ * \brief Palette quantizer object class.
+ *
+ * Quantizer selects a small number of colors representing all colors of a histogram.
+ */
+class Quantizer{
+	protected:
+		std::string name; /**< System name */
+		std::string readable_name; /**< Human readable name */
+
+		/**
+		 * Get average color of each non-empty histogram bin.
+		 * @param[in] histogram Color histogram.
+		 * @param[out] points Average colors in Lab color space.
+		 * @param[out] weights Number of pixels in each bin.
+		 */
+		static void getLabPoints(const ColorHistogram &histogram, ColorBuffer &points, std::vector<double> &weights);
+
+		/**
+		 * Convert colors to palette. Colors are ordered by decreasing weight and clamped to RGB gamut.
+		 * @param[in] colors Colors in Lab color space.
+		 * @param[in] weights Weight of each color.
+		 * @param[out] palette Palette colors in RGB color space.
+		 */
+		static void getPalette(const std::vector<Color> &colors, const std::vector<double> &weights, std::vector<Color> &palette);
+	public:
+		/**
+		 * Quantizer object constructor.
+		 * @param[in] name Quantizer object system name.
+		 * @param[in] readable_name Quantizer object human readable name.
+		 */
+		Quantizer(const char *name, const char *readable_name);
+
+		/**
+		 * Quantizer object destructor.
+		 */
+		virtual ~Quantizer();
+
+		/**
+		 * Find palette representing histogram colors. Palette is empty if histogram is empty.
+		 * @param[in] histogram Color histogram.
+		 * @param[in] colors Maximum number of palette colors.
+		 * @param[out] palette Palette colors in RGB color space.
+		 */
+		virtual void quantize(const ColorHistogram &histogram, size_t colors, std::vector<Color> &palette) = 0;
+
+		/**
+		 * Get quantizer object system name.
+		 * @return Quantizer object system name.
+		 */
+		std::string getName() const;
+
+		/**
+		 * Get quantizer object human readable name.
+		 * @return Quantizer object human readable name.
+		 */
+		std::string getReadableName() const;
+};
+
+}
+
+#endif /* GPICK_QUANTIZER_QUANTIZER_H_ */
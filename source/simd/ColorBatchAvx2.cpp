@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ColorBatchKernels.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#include "ColorBatchMath.h"
+
+namespace color_batch {
+namespace {
+
+struct Avx2 {
+	typedef __m256 type;
+	typedef __m256i int_type;
+	static const size_t width = 8;
+	static type set(float value) { return _mm256_set1_ps(value); }
+	static type add(type a, type b) { return _mm256_add_ps(a, b); }
+	static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+	static type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+	static type div(type a, type b) { return _mm256_div_ps(a, b); }
+	static type mul_add(type a, type b, type c) { return _mm256_fmadd_ps(a, b, c); }
+	static type min(type a, type b) { return _mm256_min_ps(a, b); }
+	static type max(type a, type b) { return _mm256_max_ps(a, b); }
+	static type sqrt(type a) { return _mm256_sqrt_ps(a); }
+	static type floor(type a) { return _mm256_floor_ps(a); }
+	static type greater(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	static type less(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	static type select(type mask, type a, type b) { return _mm256_blendv_ps(b, a, mask); }
+	static type and_(type a, type b) { return _mm256_and_ps(a, b); }
+	static type and_not(type a, type b) { return _mm256_andnot_ps(a, b); }
+	static type xor_(type a, type b) { return _mm256_xor_ps(a, b); }
+	static int_type to_int(type a) { return _mm256_cvttps_epi32(a); }
+	static type to_float(int_type a) { return _mm256_cvtepi32_ps(a); }
+	static int_type as_int(type a) { return _mm256_castps_si256(a); }
+	static type as_float(int_type a) { return _mm256_castsi256_ps(a); }
+	static int_type int_set(int value) { return _mm256_set1_epi32(value); }
+	static int_type int_add(int_type a, int_type b) { return _mm256_add_epi32(a, b); }
+	static int_type int_sub(int_type a, int_type b) { return _mm256_sub_epi32(a, b); }
+	static int_type int_and(int_type a, int_type b) { return _mm256_and_si256(a, b); }
+	static int_type int_or(int_type a, int_type b) { return _mm256_or_si256(a, b); }
+	static int_type int_equal(int_type a, int_type b) { return _mm256_cmpeq_epi32(a, b); }
+	static int_type shift_left_23(int_type a) { return _mm256_slli_epi32(a, 23); }
+	static int_type shift_left_30(int_type a) { return _mm256_slli_epi32(a, 30); }
+	static int_type shift_right_23(int_type a) { return _mm256_srli_epi32(a, 23); }
+	// Each 256 bit register holds two colors. Transposing 4x4 blocks within 128 bit lanes gives
+	// component vectors with colors in order 0, 2, 4, 6, 1, 3, 5, 7, and the same transpose restores original layout.
+	static void transpose(type &c0, type &c1, type &c2, type &c3)
+	{
+		type t0 = _mm256_unpacklo_ps(c0, c1);
+		type t1 = _mm256_unpackhi_ps(c0, c1);
+		type t2 = _mm256_unpacklo_ps(c2, c3);
+		type t3 = _mm256_unpackhi_ps(c2, c3);
+		c0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+		c1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+		c2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+		c3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+	}
+	static type load_values(const float *values) { return _mm256_loadu_ps(values); }
+	static void store_values(float *values, type a) { _mm256_storeu_ps(values, a); }
+	static void load(const Color *colors, type &c0, type &c1, type &c2, type &c3)
+	{
+		c0 = _mm256_loadu_ps(colors[0].ma);
+		c1 = _mm256_loadu_ps(colors[2].ma);
+		c2 = _mm256_loadu_ps(colors[4].ma);
+		c3 = _mm256_loadu_ps(colors[6].ma);
+		transpose(c0, c1, c2, c3);
+	}
+	static void store(Color *colors, type c0, type c1, type c2, type c3)
+	{
+		transpose(c0, c1, c2, c3);
+		_mm256_storeu_ps(colors[0].ma, c0);
+		_mm256_storeu_ps(colors[2].ma, c1);
+		_mm256_storeu_ps(colors[4].ma, c2);
+		_mm256_storeu_ps(colors[6].ma, c3);
+	}
+};
+
+/** Weighted sums of BGRA pixels. Two pixels are interleaved into 16-bit values within each 128 bit lane and multiplied by their weights with pairwise addition. */
+void accumulate_bgra(const uint8_t *pixels, const int16_t *weights, size_t count, int32_t *sums)
+{
+	const __m256i low_pixels = _mm256_setr_epi8(0, -1, 4, -1, 1, -1, 5, -1, 2, -1, 6, -1, 3, -1, 7, -1, 0, -1, 4, -1, 1, -1, 5, -1, 2, -1, 6, -1, 3, -1, 7, -1);
+	const __m256i high_pixels = _mm256_setr_epi8(8, -1, 12, -1, 9, -1, 13, -1, 10, -1, 14, -1, 11, -1, 15, -1, 8, -1, 12, -1, 9, -1, 13, -1, 10, -1, 14, -1, 11, -1, 15, -1);
+	// low lane holds pixels 0-3 and high lane pixels 4-7, so weight pairs 0 and 2 go with low pixel halves and pairs 1 and 3 with high pixel halves
+	const __m256i low_weights = _mm256_setr_epi32(0, 0, 0, 0, 2, 2, 2, 2);
+	const __m256i high_weights = _mm256_setr_epi32(1, 1, 1, 1, 3, 3, 3, 3);
+	__m256i sum = _mm256_setzero_si256();
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8){
+		__m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i * 4));
+		__m256i pixel_weights = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i)));
+		sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_shuffle_epi8(values, low_pixels), _mm256_permutevar8x32_epi32(pixel_weights, low_weights)));
+		sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_shuffle_epi8(values, high_pixels), _mm256_permutevar8x32_epi32(pixel_weights, high_weights)));
+	}
+	int32_t result[4];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(result), _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1)));
+	for (; i < count; i++){
+		for (int j = 0; j < 4; j++)
+			result[j] += pixels[i * 4 + j] * weights[i];
+	}
+	for (int j = 0; j < 4; j++)
+		sums[j] += result[j];
+}
+
+/** Repeat each pixel factor times. Each pixel is broadcast into a vector, which is stored with overlapping stores when factor is not a multiple of vector width. */
+void replicate_pixels(const uint32_t *pixels, size_t count, size_t factor, uint32_t *output)
+{
+	size_t i = 0;
+	if (factor == 2){
+		for (; i + 8 <= count; i += 8, output += 16){
+			__m256i values = _mm256_permute4x64_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i)), _MM_SHUFFLE(3, 1, 2, 0));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_unpacklo_epi32(values, values));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(output + 8), _mm256_unpackhi_epi32(values, values));
+		}
+	}else if (factor >= 8){
+		for (; i < count; i++, output += factor){
+			__m256i value = _mm256_set1_epi32(pixels[i]);
+			size_t j = 0;
+			for (; j + 8 <= factor; j += 8)
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(output + j), value);
+			if (j < factor)
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(output + factor - 8), value);
+		}
+	}else if (factor >= 4){
+		for (; i < count; i++, output += factor){
+			__m128i value = _mm_set1_epi32(pixels[i]);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output), value);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output + factor - 4), value);
+		}
+	}
+	for (; i < count; i++, output += factor){
+		for (size_t j = 0; j < factor; j++)
+			output[j] = pixels[i];
+	}
+}
+
+}
+
+const Kernels* avx2_kernels()
+{
+	static const Kernels kernels = [](){
+		Kernels kernels = make_kernels<Avx2>();
+		kernels.accumulate_bgra = accumulate_bgra;
+		kernels.replicate_pixels = replicate_pixels;
+		return kernels;
+	}();
+	return &kernels;
+}
+
+}
+
+#else
+
+namespace color_batch {
+
+const Kernels* avx2_kernels()
+{
+	return nullptr;
+}
+
+}
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GPICK_SIMD_COLOR_BATCH_KERNELS_H_
+#define GPICK_SIMD_COLOR_BATCH_KERNELS_H_
+
+#include "../Color.h"
+#include <cstddef>
+#include <cstdint>
+
+/** \file source/simd/ColorBatchKernels.h
+ * \brief Vectorized implementations of batch color conversion functions.
+ */
+
+namespace color_batch {
+
+/** \struct Kernels
+ * \brief Function table of one batch color conversion implementation.
+ *
+ * Matrix parameters are row-major 3x3 float matrices. For RGB to Lab/LCH conversion the matrix combines RGB to XYZ transformation, chromatic adaptation and division by reference white.
+ * For Lab/LCH to RGB conversion the matrix combines multiplication by reference white, inverted chromatic adaptation and inverted transformation.
+ * Linear transformation matrix is applied to linear RGB values.
+ * Nearest center search takes points as three component planes and centers as consecutive triplets of components.
+ */
+struct Kernels {
+	void (*rgb_get_linear)(const Color *input, Color *output, size_t count);
+	void (*linear_get_rgb)(const Color *input, Color *output, size_t count);
+	void (*rgb_to_lab)(const Color *input, Color *output, size_t count, const float *matrix);
+	void (*lab_to_rgb)(const Color *input, Color *output, size_t count, const float *matrix);
+	void (*rgb_to_lch)(const Color *input, Color *output, size_t count, const float *matrix);
+	void (*lch_to_rgb)(const Color *input, Color *output, size_t count, const float *matrix);
+	void (*lab_to_lch)(const Color *input, Color *output, size_t count);
+	void (*lch_to_lab)(const Color *input, Color *output, size_t count);
+	void (*rgb_gamma)(const Color *input, Color *output, size_t count, float exponent);
+	void (*rgb_linear_transform)(const Color *input, Color *output, size_t count, const float *matrix);
+	void (*accumulate_bgra)(const uint8_t *pixels, const int16_t *weights, size_t count, int32_t *sums);
+	void (*find_nearest)(const float *x, const float *y, const float *z, size_t count, const float *centers, size_t center_count, uint32_t *index, float *distance);
+	void (*replicate_pixels)(const uint32_t *pixels, size_t count, size_t factor, uint32_t *output);
+};
+
+/**
+ * Get SSE4.1 kernels.
+ * @return Kernel function table or nullptr, if SSE4.1 kernels were not compiled in.
+ */
+const Kernels* sse41_kernels();
+
+/**
+ * Get AVX2 kernels.
+ * @return Kernel function table or nullptr, if AVX2 kernels were not compiled in.
+ */
+const Kernels* avx2_kernels();
+
+}
+
+#endif /* GPICK_SIMD_COLOR_BATCH_KERNELS_H_ */
@@ -0,0 +1,451 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GPICK_SIMD_COLOR_BATCH_MATH_H_
+#define GPICK_SIMD_COLOR_BATCH_MATH_H_
+
+#include "ColorBatchKernels.h"
+#include "../MathUtil.h"
+#include <string.h>
+
+/** \file source/simd/ColorBatchMath.h
+ * \brief Color conversion kernels written against a generic vector type.
+ *
+ * Included only by translation units compiled with instruction set specific flags. Vector type V must provide
+ * arithmetic, comparison, selection and integer functions used below, V::width and V::load/V::store,
+ * which read and write V::width colors transposed into one vector per color component, and V::load_values/V::store_values, which read and write V::width consecutive values.
+ * Everything is placed into anonymous namespace, so that instantiations compiled with different flags never get merged by the linker.
+ */
+
+namespace color_batch {
+namespace {
+
+// Same constants as in Color.cpp
+const float lab_epsilon = 216.0f / 24389.0f;
+const float lab_kappa = 24389.0f / 27.0f;
+
+template<typename V>
+inline typename V::type log2(typename V::type x)
+{
+	typedef typename V::type T;
+	typedef typename V::int_type I;
+	I bits = V::as_int(x);
+	T exponent = V::to_float(V::int_sub(V::shift_right_23(bits), V::int_set(127)));
+	T mantissa = V::as_float(V::int_or(V::int_and(bits, V::int_set(0x007fffff)), V::int_set(0x3f800000)));
+	T over = V::greater(mantissa, V::set(1.41421356f));
+	mantissa = V::select(over, V::mul(mantissa, V::set(0.5f)), mantissa);
+	exponent = V::select(over, V::add(exponent, V::set(1.0f)), exponent);
+	// log2(m) = 2 / ln(2) * atanh(t), where t = (m - 1) / (m + 1) and |t| <= 0.1716
+	T t = V::div(V::sub(mantissa, V::set(1.0f)), V::add(mantissa, V::set(1.0f)));
+	T t2 = V::mul(t, t);
+	T p = V::set(0.32059889797532520f);
+	p = V::mul_add(p, t2, V::set(0.41219858311113240f));
+	p = V::mul_add(p, t2, V::set(0.57707801635558536f));
+	p = V::mul_add(p, t2, V::set(0.96179669392597560f));
+	p = V::mul_add(p, t2, V::set(2.88539008177792680f));
+	return V::mul_add(p, t, exponent);
+}
+
+template<typename V>
+inline typename V::type exp2(typename V::type x)
+{
+	typedef typename V::type T;
+	x = V::min(V::max(x, V::set(-126.0f)), V::set(126.0f));
+	T n = V::floor(V::add(x, V::set(0.5f)));
+	T f = V::sub(x, n);
+	// 2^f for |f| <= 0.5, truncated Taylor series of e^(f * ln(2))
+	T p = V::set(1.5252733804059840e-05f);
+	p = V::mul_add(p, f, V::set(1.5403530393381608e-04f));
+	p = V::mul_add(p, f, V::set(1.3333558146428443e-03f));
+	p = V::mul_add(p, f, V::set(9.6181291076284772e-03f));
+	p = V::mul_add(p, f, V::set(5.5504108664821580e-02f));
+	p = V::mul_add(p, f, V::set(2.4022650695910071e-01f));
+	p = V::mul_add(p, f, V::set(6.9314718055994531e-01f));
+	p = V::mul_add(p, f, V::set(1.0f));
+	T scale = V::as_float(V::shift_left_23(V::int_add(V::to_int(n), V::int_set(127))));
+	return V::mul(p, scale);
+}
+
+/** Raise positive values to specified power. Result for non-positive values is undefined. */
+template<typename V>
+inline typename V::type pow(typename V::type x, float y)
+{
+	x = V::max(x, V::set(1e-30f));
+	return exp2<V>(V::mul(log2<V>(x), V::set(y)));
+}
+
+template<typename V>
+inline typename V::type gamma_to_linear(typename V::type x)
+{
+	typedef typename V::type T;
+	T power = pow<V>(V::mul(V::add(x, V::set(0.055f)), V::set(1 / 1.055f)), 2.4f);
+	T linear = V::mul(x, V::set(1 / 12.92f));
+	return V::select(V::greater(x, V::set(0.04045f)), power, linear);
+}
+
+template<typename V>
+inline typename V::type linear_to_gamma(typename V::type x)
+{
+	typedef typename V::type T;
+	T power = V::sub(V::mul(pow<V>(x, 1 / 2.4f), V::set(1.055f)), V::set(0.055f));
+	T linear = V::mul(x, V::set(12.92f));
+	return V::select(V::greater(x, V::set(0.0031308f)), power, linear);
+}
+
+template<typename V>
+inline typename V::type lab_f(typename V::type x)
+{
+	typedef typename V::type T;
+	T root = pow<V>(x, 1 / 3.0f);
+	T linear = V::mul(V::add(V::mul(x, V::set(lab_kappa)), V::set(16.0f)), V::set(1 / 116.0f));
+	return V::select(V::greater(x, V::set(lab_epsilon)), root, linear);
+}
+
+template<typename V>
+inline typename V::type lab_f_inverse(typename V::type x)
+{
+	typedef typename V::type T;
+	T cube = V::mul(V::mul(x, x), x);
+	T linear = V::mul(V::sub(V::mul(x, V::set(116.0f)), V::set(16.0f)), V::set(1 / lab_kappa));
+	return V::select(V::greater(cube, V::set(lab_epsilon)), cube, linear);
+}
+
+/** Hue angle in degrees in range [0, 360). */
+template<typename V>
+inline typename V::type hue(typename V::type y, typename V::type x)
+{
+	typedef typename V::type T;
+	T sign_mask = V::set(-0.0f);
+	T abs_x = V::and_not(sign_mask, x);
+	T abs_y = V::and_not(sign_mask, y);
+	T high = V::max(abs_x, abs_y);
+	T low = V::min(abs_x, abs_y);
+	T a = V::div(low, V::max(high, V::set(1e-30f)));
+	// reduce to |a| <= tan(pi / 8)
+	T reduce = V::greater(a, V::set(0.41421356f));
+	a = V::select(reduce, V::div(V::sub(a, V::set(1.0f)), V::add(a, V::set(1.0f))), a);
+	T z = V::mul(a, a);
+	T p = V::set(8.05374449538e-2f);
+	p = V::mul_add(p, z, V::set(-1.38776856032e-1f));
+	p = V::mul_add(p, z, V::set(1.99777106478e-1f));
+	p = V::mul_add(p, z, V::set(-3.33329491539e-1f));
+	T r = V::mul_add(V::mul(p, z), a, a);
+	r = V::add(r, V::and_(reduce, V::set(float(PI / 4))));
+	r = V::select(V::greater(abs_y, abs_x), V::sub(V::set(float(PI / 2)), r), r);
+	r = V::select(V::less(x, V::set(0.0f)), V::sub(V::set(float(PI)), r), r);
+	r = V::mul(r, V::set(float(180.0 / PI)));
+	return V::select(V::less(y, V::set(0.0f)), V::sub(V::set(360.0f), r), r);
+}
+
+/** Sine and cosine of an angle in degrees. */
+template<typename V>
+inline void sin_cos(typename V::type degrees, typename V::type &sine, typename V::type &cosine)
+{
+	typedef typename V::type T;
+	typedef typename V::int_type I;
+	T quadrant = V::floor(V::mul_add(degrees, V::set(1 / 90.0f), V::set(0.5f)));
+	T x = V::mul(V::sub(degrees, V::mul(quadrant, V::set(90.0f))), V::set(float(PI / 180)));
+	T z = V::mul(x, x);
+	T s = V::set(-1.9515295891e-4f);
+	s = V::mul_add(s, z, V::set(8.3321608736e-3f));
+	s = V::mul_add(s, z, V::set(-1.6666654611e-1f));
+	s = V::mul_add(V::mul(s, z), x, x);
+	T c = V::set(2.443315711809948e-5f);
+	c = V::mul_add(c, z, V::set(-1.388731625493765e-3f));
+	c = V::mul_add(c, z, V::set(4.166664568298827e-2f));
+	c = V::mul_add(V::mul(c, z), z, V::sub(V::set(1.0f), V::mul(z, V::set(0.5f))));
+	I q = V::to_int(quadrant);
+	T swap = V::as_float(V::int_equal(V::int_and(q, V::int_set(1)), V::int_set(1)));
+	T sine_sign = V::as_float(V::shift_left_30(V::int_and(q, V::int_set(2))));
+	T cosine_sign = V::as_float(V::shift_left_30(V::int_and(V::int_add(q, V::int_set(1)), V::int_set(2))));
+	sine = V::xor_(V::select(swap, c, s), sine_sign);
+	cosine = V::xor_(V::select(swap, s, c), cosine_sign);
+}
+
+template<typename V>
+inline void multiply(const typename V::type *m, typename V::type &x, typename V::type &y, typename V::type &z)
+{
+	typedef typename V::type T;
+	T rx = V::mul_add(m[0], x, V::mul_add(m[1], y, V::mul(m[2], z)));
+	T ry = V::mul_add(m[3], x, V::mul_add(m[4], y, V::mul(m[5], z)));
+	T rz = V::mul_add(m[6], x, V::mul_add(m[7], y, V::mul(m[8], z)));
+	x = rx;
+	y = ry;
+	z = rz;
+}
+
+/** Run operation over all colors. Last incomplete block is processed in a zero padded temporary buffer. */
+template<typename V, typename Operation>
+inline void for_each_block(const Color *input, Color *output, size_t count, Operation operation)
+{
+	typedef typename V::type T;
+	T c0, c1, c2, c3;
+	size_t i = 0;
+	for (; i + V::width <= count; i += V::width){
+		V::load(input + i, c0, c1, c2, c3);
+		operation(c0, c1, c2);
+		V::store(output + i, c0, c1, c2, c3);
+	}
+	if (i < count){
+		Color tmp[V::width];
+		memset(tmp, 0, sizeof(tmp));
+		memcpy(tmp, input + i, (count - i) * sizeof(Color));
+		V::load(tmp, c0, c1, c2, c3);
+		operation(c0, c1, c2);
+		V::store(tmp, c0, c1, c2, c3);
+		memcpy(output + i, tmp, (count - i) * sizeof(Color));
+	}
+}
+
+template<typename V>
+inline void load_matrix(const float *matrix, typename V::type *m)
+{
+	for (int i = 0; i < 9; i++)
+		m[i] = V::set(matrix[i]);
+}
+
+template<typename V>
+inline void rgb_to_lab_block(const typename V::type *m, typename V::type &c0, typename V::type &c1, typename V::type &c2)
+{
+	typedef typename V::type T;
+	T x = gamma_to_linear<V>(c0), y = gamma_to_linear<V>(c1), z = gamma_to_linear<V>(c2);
+	multiply<V>(m, x, y, z);
+	x = lab_f<V>(x);
+	y = lab_f<V>(y);
+	z = lab_f<V>(z);
+	c0 = V::sub(V::mul(y, V::set(116.0f)), V::set(16.0f));
+	c1 = V::mul(V::sub(x, y), V::set(500.0f));
+	c2 = V::mul(V::sub(y, z), V::set(200.0f));
+}
+
+template<typename V>
+inline void lab_to_rgb_block(const typename V::type *m, typename V::type &c0, typename V::type &c1, typename V::type &c2)
+{
+	typedef typename V::type T;
+	T fy = V::mul(V::add(c0, V::set(16.0f)), V::set(1 / 116.0f));
+	T fx = V::mul_add(c1, V::set(1 / 500.0f), fy);
+	T fz = V::sub(fy, V::mul(c2, V::set(1 / 200.0f)));
+	T x = lab_f_inverse<V>(fx);
+	T y = V::select(V::greater(c0, V::set(lab_kappa * lab_epsilon)), V::mul(V::mul(fy, fy), fy), V::mul(c0, V::set(1 / lab_kappa)));
+	T z = lab_f_inverse<V>(fz);
+	multiply<V>(m, x, y, z);
+	c0 = linear_to_gamma<V>(x);
+	c1 = linear_to_gamma<V>(y);
+	c2 = linear_to_gamma<V>(z);
+}
+
+template<typename V>
+inline void lab_to_lch_block(typename V::type &c0, typename V::type &c1, typename V::type &c2)
+{
+	typedef typename V::type T;
+	T chroma = V::sqrt(V::mul_add(c1, c1, V::mul(c2, c2)));
+	c2 = hue<V>(c2, c1);
+	c1 = chroma;
+}
+
+template<typename V>
+inline void lch_to_lab_block(typename V::type &c0, typename V::type &c1, typename V::type &c2)
+{
+	typedef typename V::type T;
+	T sine, cosine;
+	sin_cos<V>(c2, sine, cosine);
+	c2 = V::mul(c1, sine);
+	c1 = V::mul(c1, cosine);
+}
+
+template<typename V>
+void rgb_get_linear(const Color *input, Color *output, size_t count)
+{
+	typedef typename V::type T;
+	for_each_block<V>(input, output, count, [](T &c0, T &c1, T &c2){
+		c0 = gamma_to_linear<V>(c0);
+		c1 = gamma_to_linear<V>(c1);
+		c2 = gamma_to_linear<V>(c2);
+	});
+}
+
+template<typename V>
+void linear_get_rgb(const Color *input, Color *output, size_t count)
+{
+	typedef typename V::type T;
+	for_each_block<V>(input, output, count, [](T &c0, T &c1, T &c2){
+		c0 = linear_to_gamma<V>(c0);
+		c1 = linear_to_gamma<V>(c1);
+		c2 = linear_to_gamma<V>(c2);
+	});
+}
+
+template<typename V>
+void rgb_to_lab(const Color *input, Color *output, size_t count, const float *matrix)
+{
+	typedef typename V::type T;
+	T m[9];
+	load_matrix<V>(matrix, m);
+	for_each_block<V>(input, output, count, [&m](T &c0, T &c1, T &c2){
+		rgb_to_lab_block<V>(m, c0, c1, c2);
+	});
+}
+
+template<typename V>
+void lab_to_rgb(const Color *input, Color *output, size_t count, const float *matrix)
+{
+	typedef typename V::type T;
+	T m[9];
+	load_matrix<V>(matrix, m);
+	for_each_block<V>(input, output, count, [&m](T &c0, T &c1, T &c2){
+		lab_to_rgb_block<V>(m, c0, c1, c2);
+	});
+}
+
+template<typename V>
+void rgb_to_lch(const Color *input, Color *output, size_t count, const float *matrix)
+{
+	typedef typename V::type T;
+	T m[9];
+	load_matrix<V>(matrix, m);
+	for_each_block<V>(input, output, count, [&m](T &c0, T &c1, T &c2){
+		rgb_to_lab_block<V>(m, c0, c1, c2);
+		lab_to_lch_block<V>(c0, c1, c2);
+	});
+}
+
+template<typename V>
+void lch_to_rgb(const Color *input, Color *output, size_t count, const float *matrix)
+{
+	typedef typename V::type T;
+	T m[9];
+	load_matrix<V>(matrix, m);
+	for_each_block<V>(input, output, count, [&m](T &c0, T &c1, T &c2){
+		lch_to_lab_block<V>(c0, c1, c2);
+		lab_to_rgb_block<V>(m, c0, c1, c2);
+	});
+}
+
+template<typename V>
+void lab_to_lch(const Color *input, Color *output, size_t count)
+{
+	typedef typename V::type T;
+	for_each_block<V>(input, output, count, [](T &c0, T &c1, T &c2){
+		lab_to_lch_block<V>(c0, c1, c2);
+	});
+}
+
+template<typename V>
+void lch_to_lab(const Color *input, Color *output, size_t count)
+{
+	typedef typename V::type T;
+	for_each_block<V>(input, output, count, [](T &c0, T &c1, T &c2){
+		lch_to_lab_block<V>(c0, c1, c2);
+	});
+}
+
+template<typename V>
+inline typename V::type clamp(typename V::type x)
+{
+	return V::min(V::max(x, V::set(0.0f)), V::set(1.0f));
+}
+
+template<typename V>
+void rgb_gamma(const Color *input, Color *output, size_t count, float exponent)
+{
+	typedef typename V::type T;
+	for_each_block<V>(input, output, count, [exponent](T &c0, T &c1, T &c2){
+		c0 = clamp<V>(linear_to_gamma<V>(pow<V>(gamma_to_linear<V>(c0), exponent)));
+		c1 = clamp<V>(linear_to_gamma<V>(pow<V>(gamma_to_linear<V>(c1), exponent)));
+		c2 = clamp<V>(linear_to_gamma<V>(pow<V>(gamma_to_linear<V>(c2), exponent)));
+	});
+}
+
+template<typename V>
+void rgb_linear_transform(const Color *input, Color *output, size_t count, const float *matrix)
+{
+	typedef typename V::type T;
+	T m[9];
+	load_matrix<V>(matrix, m);
+	for_each_block<V>(input, output, count, [&m](T &c0, T &c1, T &c2){
+		T x = gamma_to_linear<V>(c0), y = gamma_to_linear<V>(c1), z = gamma_to_linear<V>(c2);
+		multiply<V>(m, x, y, z);
+		c0 = clamp<V>(linear_to_gamma<V>(x));
+		c1 = clamp<V>(linear_to_gamma<V>(y));
+		c2 = clamp<V>(linear_to_gamma<V>(z));
+	});
+}
+
+/** Find nearest center for each point. Last incomplete block is processed in a zero padded temporary buffer. */
+template<typename V>
+void find_nearest(const float *x, const float *y, const float *z, size_t count, const float *centers, size_t center_count, uint32_t *index, float *distance)
+{
+	typedef typename V::type T;
+	float block[4][V::width];
+	for (size_t i = 0; i < count; i += V::width){
+		size_t n = count - i < V::width ? count - i : V::width;
+		T px, py, pz;
+		if (n == V::width){
+			px = V::load_values(x + i);
+			py = V::load_values(y + i);
+			pz = V::load_values(z + i);
+		}else{
+			memset(block, 0, sizeof(block));
+			memcpy(block[0], x + i, n * sizeof(float));
+			memcpy(block[1], y + i, n * sizeof(float));
+			memcpy(block[2], z + i, n * sizeof(float));
+			px = V::load_values(block[0]);
+			py = V::load_values(block[1]);
+			pz = V::load_values(block[2]);
+		}
+		T best_distance = V::set(3.4e38f), best_index = V::set(0);
+		for (size_t j = 0; j < center_count; j++){
+			T dx = V::sub(px, V::set(centers[j * 3 + 0]));
+			T dy = V::sub(py, V::set(centers[j * 3 + 1]));
+			T dz = V::sub(pz, V::set(centers[j * 3 + 2]));
+			T d = V::mul_add(dx, dx, V::mul_add(dy, dy, V::mul(dz, dz)));
+			T closer = V::less(d, best_distance);
+			best_distance = V::select(closer, d, best_distance);
+			best_index = V::select(closer, V::set(float(j)), best_index);
+		}
+		V::store_values(block[0], best_index);
+		V::store_values(block[1], best_distance);
+		for (size_t j = 0; j < n; j++){
+			index[i + j] = uint32_t(block[0][j]);
+			if (distance) distance[i + j] = block[1][j];
+		}
+	}
+}
+
+template<typename V>
+Kernels make_kernels()
+{
+	Kernels kernels;
+	kernels.rgb_get_linear = rgb_get_linear<V>;
+	kernels.linear_get_rgb = linear_get_rgb<V>;
+	kernels.rgb_to_lab = rgb_to_lab<V>;
+	kernels.lab_to_rgb = lab_to_rgb<V>;
+	kernels.rgb_to_lch = rgb_to_lch<V>;
+	kernels.lch_to_rgb = lch_to_rgb<V>;
+	kernels.lab_to_lch = lab_to_lch<V>;
+	kernels.lch_to_lab = lch_to_lab<V>;
+	kernels.rgb_gamma = rgb_gamma<V>;
+	kernels.rgb_linear_transform = rgb_linear_transform<V>;
+	kernels.find_nearest = find_nearest<V>;
+	return kernels;
+}
+
+}
+}
+
+#endif /* GPICK_SIMD_COLOR_BATCH_MATH_H_ */
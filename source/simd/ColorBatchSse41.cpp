@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ColorBatchKernels.h"
+
+#if defined(__SSE4_1__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#include <smmintrin.h>
+#include "ColorBatchMath.h"
+
+namespace color_batch {
+namespace {
+
+struct Sse41 {
+	typedef __m128 type;
+	typedef __m128i int_type;
+	static const size_t width = 4;
+	static type set(float value) { return _mm_set1_ps(value); }
+	static type add(type a, type b) { return _mm_add_ps(a, b); }
+	static type sub(type a, type b) { return _mm_sub_ps(a, b); }
+	static type mul(type a, type b) { return _mm_mul_ps(a, b); }
+	static type div(type a, type b) { return _mm_div_ps(a, b); }
+	static type mul_add(type a, type b, type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+	static type min(type a, type b) { return _mm_min_ps(a, b); }
+	static type max(type a, type b) { return _mm_max_ps(a, b); }
+	static type sqrt(type a) { return _mm_sqrt_ps(a); }
+	static type floor(type a) { return _mm_floor_ps(a); }
+	static type greater(type a, type b) { return _mm_cmpgt_ps(a, b); }
+	static type less(type a, type b) { return _mm_cmplt_ps(a, b); }
+	static type select(type mask, type a, type b) { return _mm_blendv_ps(b, a, mask); }
+	static type and_(type a, type b) { return _mm_and_ps(a, b); }
+	static type and_not(type a, type b) { return _mm_andnot_ps(a, b); }
+	static type xor_(type a, type b) { return _mm_xor_ps(a, b); }
+	static int_type to_int(type a) { return _mm_cvttps_epi32(a); }
+	static type to_float(int_type a) { return _mm_cvtepi32_ps(a); }
+	static int_type as_int(type a) { return _mm_castps_si128(a); }
+	static type as_float(int_type a) { return _mm_castsi128_ps(a); }
+	static int_type int_set(int value) { return _mm_set1_epi32(value); }
+	static int_type int_add(int_type a, int_type b) { return _mm_add_epi32(a, b); }
+	static int_type int_sub(int_type a, int_type b) { return _mm_sub_epi32(a, b); }
+	static int_type int_and(int_type a, int_type b) { return _mm_and_si128(a, b); }
+	static int_type int_or(int_type a, int_type b) { return _mm_or_si128(a, b); }
+	static int_type int_equal(int_type a, int_type b) { return _mm_cmpeq_epi32(a, b); }
+	static int_type shift_left_23(int_type a) { return _mm_slli_epi32(a, 23); }
+	static int_type shift_left_30(int_type a) { return _mm_slli_epi32(a, 30); }
+	static int_type shift_right_23(int_type a) { return _mm_srli_epi32(a, 23); }
+	static type load_values(const float *values) { return _mm_loadu_ps(values); }
+	static void store_values(float *values, type a) { _mm_storeu_ps(values, a); }
+	static void load(const Color *colors, type &c0, type &c1, type &c2, type &c3)
+	{
+		c0 = _mm_loadu_ps(colors[0].ma);
+		c1 = _mm_loadu_ps(colors[1].ma);
+		c2 = _mm_loadu_ps(colors[2].ma);
+		c3 = _mm_loadu_ps(colors[3].ma);
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+	}
+	static void store(Color *colors, type c0, type c1, type c2, type c3)
+	{
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+		_mm_storeu_ps(colors[0].ma, c0);
+		_mm_storeu_ps(colors[1].ma, c1);
+		_mm_storeu_ps(colors[2].ma, c2);
+		_mm_storeu_ps(colors[3].ma, c3);
+	}
+};
+
+/** Weighted sums of BGRA pixels. Two pixels are interleaved into 16-bit values and multiplied by their weights with pairwise addition. */
+void accumulate_bgra(const uint8_t *pixels, const int16_t *weights, size_t count, int32_t *sums)
+{
+	const __m128i low_pixels = _mm_setr_epi8(0, -1, 4, -1, 1, -1, 5, -1, 2, -1, 6, -1, 3, -1, 7, -1);
+	const __m128i high_pixels = _mm_setr_epi8(8, -1, 12, -1, 9, -1, 13, -1, 10, -1, 14, -1, 11, -1, 15, -1);
+	__m128i sum = _mm_setzero_si128();
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4){
+		__m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4));
+		__m128i pixel_weights = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(weights + i));
+		sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_shuffle_epi8(values, low_pixels), _mm_shuffle_epi32(pixel_weights, _MM_SHUFFLE(0, 0, 0, 0))));
+		sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_shuffle_epi8(values, high_pixels), _mm_shuffle_epi32(pixel_weights, _MM_SHUFFLE(1, 1, 1, 1))));
+	}
+	int32_t result[4];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(result), sum);
+	for (; i < count; i++){
+		for (int j = 0; j < 4; j++)
+			result[j] += pixels[i * 4 + j] * weights[i];
+	}
+	for (int j = 0; j < 4; j++)
+		sums[j] += result[j];
+}
+
+/** Repeat each pixel factor times. Each pixel is broadcast into a vector, which is stored with overlapping stores when factor is not a multiple of vector width. */
+void replicate_pixels(const uint32_t *pixels, size_t count, size_t factor, uint32_t *output)
+{
+	size_t i = 0;
+	if (factor == 2){
+		for (; i + 4 <= count; i += 4, output += 8){
+			__m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_unpacklo_epi32(values, values));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output + 4), _mm_unpackhi_epi32(values, values));
+		}
+	}else if (factor >= 4){
+		for (; i < count; i++, output += factor){
+			__m128i value = _mm_set1_epi32(pixels[i]);
+			size_t j = 0;
+			for (; j + 4 <= factor; j += 4)
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(output + j), value);
+			if (j < factor)
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(output + factor - 4), value);
+		}
+	}
+	for (; i < count; i++, output += factor){
+		for (size_t j = 0; j < factor; j++)
+			output[j] = pixels[i];
+	}
+}
+
+}
+
+const Kernels* sse41_kernels()
+{
+	static const Kernels kernels = [](){
+		Kernels kernels = make_kernels<Sse41>();
+		kernels.accumulate_bgra = accumulate_bgra;
+		kernels.replicate_pixels = replicate_pixels;
+		return kernels;
+	}();
+	return &kernels;
+}
+
+}
+
+#else
+
+namespace color_batch {
+
+const Kernels* sse41_kernels()
+{
+	return nullptr;
+}
+
+}
+
+#endif
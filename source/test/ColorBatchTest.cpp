@@ -0,0 +1,249 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE color_batch
+#include <boost/test/unit_test.hpp>
+#include <vector>
+#include <cmath>
+#include "Color.h"
+#include "ColorBatch.h"
+#include "TestUtils.h"
+using namespace std;
+
+BOOST_GLOBAL_FIXTURE(ColorInit);
+
+static vector<Color> buildRgbColors(size_t count)
+{
+	vector<Color> colors(count);
+	TestRandom random(12345);
+	for (size_t i = 0; i < count; i++){
+		for (int j = 0; j < 4; j++){
+			colors[i].ma[j] = random.nextFloat();
+		}
+	}
+	// include exact boundaries, greys and black
+	if (count > 4){
+		color_set(&colors[0], 0.0f, 0.0f, 0.0f);
+		color_set(&colors[1], 1.0f, 1.0f, 1.0f);
+		color_set(&colors[2], 0.5f, 0.5f, 0.5f);
+		color_set(&colors[3], 0.04045f, 0.0031308f, 0.02f);
+	}
+	return colors;
+}
+static float hueDifference(float a, float b)
+{
+	float d = fabs(a - b);
+	return d > 180 ? 360 - d : d;
+}
+template<typename Batch, typename Single, typename Check>
+static void compare(const vector<Color> &input, Batch batch, Single single, Check check)
+{
+	for (int kernel = COLOR_BATCH_KERNEL_SCALAR; kernel <= COLOR_BATCH_KERNEL_AVX2; kernel++){
+		if (!color_batch_is_kernel_supported(ColorBatchKernel(kernel))) continue;
+		BOOST_TEST_MESSAGE("kernel " << color_batch_get_kernel_name(ColorBatchKernel(kernel)));
+		color_batch_set_kernel(ColorBatchKernel(kernel));
+		vector<Color> output(input.size());
+		batch(&input[0], &output[0], input.size());
+		for (size_t i = 0; i < input.size(); i++){
+			Color expected;
+			single(&input[i], &expected);
+			check(expected, output[i]);
+			BOOST_CHECK_EQUAL(output[i].ma[3], input[i].ma[3]);
+		}
+	}
+	color_batch_set_kernel(COLOR_BATCH_KERNEL_AVX2);
+}
+static void checkRgb(const Color &expected, const Color &result)
+{
+	for (int j = 0; j < 3; j++)
+		BOOST_CHECK_SMALL(expected.ma[j] - result.ma[j], COLOR_BATCH_RGB_TOLERANCE);
+}
+static void checkLab(const Color &expected, const Color &result)
+{
+	for (int j = 0; j < 3; j++)
+		BOOST_CHECK_SMALL(expected.ma[j] - result.ma[j], COLOR_BATCH_LAB_TOLERANCE);
+}
+static void checkLch(const Color &expected, const Color &result)
+{
+	BOOST_CHECK_SMALL(expected.lch.L - result.lch.L, COLOR_BATCH_LAB_TOLERANCE);
+	BOOST_CHECK_SMALL(expected.lch.C - result.lch.C, COLOR_BATCH_LAB_TOLERANCE);
+	if (expected.lch.C > COLOR_BATCH_HUE_CHROMA_THRESHOLD)
+		BOOST_CHECK_SMALL(hueDifference(expected.lch.h, result.lch.h), COLOR_BATCH_HUE_TOLERANCE);
+}
+BOOST_AUTO_TEST_CASE(kernel_selection)
+{
+	BOOST_CHECK(color_batch_is_kernel_supported(COLOR_BATCH_KERNEL_SCALAR));
+	BOOST_CHECK_EQUAL(color_batch_set_kernel(COLOR_BATCH_KERNEL_SCALAR), COLOR_BATCH_KERNEL_SCALAR);
+	BOOST_CHECK(color_batch_is_kernel_supported(color_batch_set_kernel(COLOR_BATCH_KERNEL_AVX2)));
+}
+BOOST_AUTO_TEST_CASE(linear)
+{
+	auto colors = buildRgbColors(1003);
+	compare(colors, color_batch_rgb_get_linear, color_rgb_get_linear, checkRgb);
+	compare(colors, color_batch_linear_get_rgb, color_linear_get_rgb, checkRgb);
+}
+BOOST_AUTO_TEST_CASE(rgb_to_lab)
+{
+	auto colors = buildRgbColors(1003);
+	compare(colors, color_batch_rgb_to_lab_d50, color_rgb_to_lab_d50, checkLab);
+	compare(colors, color_batch_rgb_to_lch_d50, color_rgb_to_lch_d50, checkLch);
+}
+BOOST_AUTO_TEST_CASE(lab_to_rgb)
+{
+	auto colors = buildRgbColors(1003);
+	vector<Color> lab(colors.size()), lch(colors.size());
+	for (size_t i = 0; i < colors.size(); i++){
+		color_rgb_to_lab_d50(&colors[i], &lab[i]);
+		color_rgb_to_lch_d50(&colors[i], &lch[i]);
+		lab[i].ma[3] = lch[i].ma[3] = colors[i].ma[3];
+	}
+	compare(lab, color_batch_lab_to_rgb_d50, color_lab_to_rgb_d50, checkRgb);
+	compare(lch, color_batch_lch_to_rgb_d50, color_lch_to_rgb_d50, checkRgb);
+	compare(lab, color_batch_lab_to_lch, color_lab_to_lch, checkLch);
+	compare(lch, color_batch_lch_to_lab, color_lch_to_lab, checkLab);
+}
+BOOST_AUTO_TEST_CASE(rgb_gamma)
+{
+	auto colors = buildRgbColors(1003);
+	for (float exponent: {0.45f, 1.0f, 2.2f}){
+		compare(colors, [exponent](const Color *a, Color *b, size_t count){
+			color_batch_rgb_gamma(a, b, count, exponent);
+		}, [exponent](const Color *a, Color *b){
+			Color linear;
+			color_rgb_get_linear(a, &linear);
+			for (int i = 0; i < 3; i++)
+				linear.ma[i] = pow(linear.ma[i], exponent);
+			color_linear_get_rgb(&linear, b);
+			color_rgb_normalize(b);
+		}, checkRgb);
+	}
+}
+BOOST_AUTO_TEST_CASE(rgb_linear_transform)
+{
+	auto colors = buildRgbColors(1003);
+	matrix3x3 matrix;
+	const double values[3][3] = {
+		{0.567, 0.433, 0.0},
+		{0.558, 0.442, 0.0},
+		{0.0, 0.242, 0.758},
+	};
+	for (int i = 0; i < 3; i++){
+		for (int j = 0; j < 3; j++)
+			matrix.m[i][j] = values[i][j];
+	}
+	compare(colors, [&matrix](const Color *a, Color *b, size_t count){
+		color_batch_rgb_linear_transform(a, b, count, &matrix);
+	}, [&matrix](const Color *a, Color *b){
+		Color linear;
+		color_rgb_get_linear(a, &linear);
+		vector3 vector;
+		vector3_set(&vector, linear.rgb.red, linear.rgb.green, linear.rgb.blue);
+		vector3_multiply_matrix3x3(&vector, &matrix, &vector);
+		color_set(&linear, vector.x, vector.y, vector.z);
+		color_linear_get_rgb(&linear, b);
+		color_rgb_normalize(b);
+	}, checkRgb);
+}
+BOOST_AUTO_TEST_CASE(in_place)
+{
+	auto colors = buildRgbColors(37);
+	auto expected = colors;
+	for (size_t i = 0; i < expected.size(); i++)
+		color_rgb_to_lab_d50(&expected[i], &expected[i]);
+	color_batch_rgb_to_lab_d50(&colors[0], &colors[0], colors.size());
+	for (size_t i = 0; i < colors.size(); i++)
+		checkLab(expected[i], colors[i]);
+}
+BOOST_AUTO_TEST_CASE(in_place_scalar)
+{
+	auto colors = buildRgbColors(37);
+	vector<Color> expected(colors.size());
+	for (size_t i = 0; i < colors.size(); i++){
+		color_rgb_to_hsl(&colors[i], &expected[i]);
+		expected[i].ma[3] = colors[i].ma[3];
+	}
+	color_batch_rgb_to_hsl(&colors[0], &colors[0], colors.size());
+	for (size_t i = 0; i < colors.size(); i++){
+		for (int j = 0; j < 4; j++)
+			BOOST_CHECK_EQUAL(colors[i].ma[j], expected[i].ma[j]);
+	}
+}
+BOOST_AUTO_TEST_CASE(find_nearest)
+{
+	auto colors = buildRgbColors(1003);
+	vector<float> x(colors.size()), y(colors.size()), z(colors.size()), centers;
+	for (size_t i = 0; i < colors.size(); i++){
+		x[i] = colors[i].rgb.red;
+		y[i] = colors[i].rgb.green;
+		z[i] = colors[i].rgb.blue;
+	}
+	for (size_t i = 0; i < 37; i++){
+		for (int j = 0; j < 3; j++)
+			centers.push_back(colors[i * 7].ma[(j + 1) % 3]);
+	}
+	for (int kernel = COLOR_BATCH_KERNEL_SCALAR; kernel <= COLOR_BATCH_KERNEL_AVX2; kernel++){
+		if (!color_batch_is_kernel_supported(ColorBatchKernel(kernel))) continue;
+		color_batch_set_kernel(ColorBatchKernel(kernel));
+		vector<uint32_t> index(colors.size());
+		vector<float> distance(colors.size());
+		color_batch_find_nearest(&x[0], &y[0], &z[0], colors.size(), &centers[0], centers.size() / 3, &index[0], &distance[0]);
+		for (size_t i = 0; i < colors.size(); i++){
+			float best = 1e30f;
+			for (size_t j = 0; j < centers.size(); j += 3){
+				float dx = x[i] - centers[j], dy = y[i] - centers[j + 1], dz = z[i] - centers[j + 2];
+				best = std::min(best, dx * dx + dy * dy + dz * dz);
+			}
+			BOOST_REQUIRE_LT(index[i], centers.size() / 3);
+			const float *center = &centers[index[i] * 3];
+			float dx = x[i] - center[0], dy = y[i] - center[1], dz = z[i] - center[2];
+			BOOST_CHECK_SMALL(dx * dx + dy * dy + dz * dz - best, 1e-6f);
+			BOOST_CHECK_SMALL(distance[i] - best, 1e-6f);
+		}
+	}
+	color_batch_set_kernel(COLOR_BATCH_KERNEL_AVX2);
+}
+BOOST_AUTO_TEST_CASE(replicate_pixels)
+{
+	vector<uint32_t> pixels(19);
+	for (size_t i = 0; i < pixels.size(); i++)
+		pixels[i] = uint32_t(i * 0x01020304 + 5);
+	for (size_t factor: {1, 2, 3, 4, 5, 7, 8, 9, 16, 21, 40}){
+		for (size_t count: {0, 1, 3, 4, 8, 9, 19}){
+			vector<uint32_t> expected(count * factor + 1, 0xdeadbeef);
+			for (size_t i = 0; i < count * factor; i++)
+				expected[i] = pixels[i / factor];
+			for (int kernel = COLOR_BATCH_KERNEL_SCALAR; kernel <= COLOR_BATCH_KERNEL_AVX2; kernel++){
+				if (!color_batch_is_kernel_supported(ColorBatchKernel(kernel))) continue;
+				color_batch_set_kernel(ColorBatchKernel(kernel));
+				vector<uint32_t> output(count * factor + 1, 0xdeadbeef);
+				color_batch_replicate_pixels(&pixels[0], count, factor, &output[0]);
+				BOOST_CHECK(output == expected);
+			}
+		}
+	}
+	color_batch_set_kernel(COLOR_BATCH_KERNEL_AVX2);
+}
+BOOST_AUTO_TEST_CASE(accumulate_bgra)
+{
+	vector<uint8_t> pixels(4 * 37);
+	vector<int16_t> weights(37);
+	TestRandom random(3);
+	for (auto &value: pixels)
+		value = uint8_t(random.next());
+	for (auto &weight: weights)
+		weight = int16_t(random.next() & 0x7fff);
+	for (size_t count: {0, 1, 3, 4, 8, 11, 37}){
+		int32_t expected[4] = {1, 2, 3, 4};
+		for (size_t i = 0; i < count; i++){
+			for (int j = 0; j < 4; j++)
+				expected[j] += pixels[i * 4 + j] * weights[i];
+		}
+		for (int kernel = COLOR_BATCH_KERNEL_SCALAR; kernel <= COLOR_BATCH_KERNEL_AVX2; kernel++){
+			if (!color_batch_is_kernel_supported(ColorBatchKernel(kernel))) continue;
+			color_batch_set_kernel(ColorBatchKernel(kernel));
+			int32_t sums[4] = {1, 2, 3, 4};
+			color_batch_accumulate_bgra(&pixels[0], &weights[0], count, sums);
+			for (int j = 0; j < 4; j++)
+				BOOST_CHECK_EQUAL(sums[j], expected[j]);
+		}
+	}
+	color_batch_set_kernel(COLOR_BATCH_KERNEL_AVX2);
+}
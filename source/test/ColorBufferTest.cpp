@@ -0,0 +1,211 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE color_buffer
+#include <boost/test/unit_test.hpp>
+#include "ColorBuffer.h"
+#include "ColorBatch.h"
+#include "ColorList.h"
+#include "ColorObject.h"
+#include "DynvHelpers.h"
+#include "dynv/DynvSystem.h"
+#include "TestUtils.h"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+BOOST_GLOBAL_FIXTURE(ColorInit);
+
+static vector<Color> buildColors(size_t count)
+{
+	TestRandom random(7);
+	vector<Color> colors(count);
+	for (auto &color: colors)
+		color_set(&color, random.nextFloat(), random.nextFloat(), random.nextFloat());
+	return colors;
+}
+static void checkPadding(const ColorBuffer &buffer)
+{
+	for (int i = 0; i < buffer.channels(); i++){
+		for (size_t j = buffer.size(); j < buffer.stride(); j++)
+			BOOST_CHECK_EQUAL(buffer.plane(i)[j], 0.0f);
+	}
+}
+BOOST_AUTO_TEST_CASE(planes)
+{
+	for (size_t size: {0, 1, 7, 8, 9, 100}){
+		for (ColorSpace color_space: {ColorSpace::rgb, ColorSpace::cmyk}){
+			ColorBuffer buffer(color_space, size);
+			BOOST_CHECK_EQUAL(buffer.size(), size);
+			BOOST_CHECK_EQUAL(buffer.empty(), size == 0);
+			BOOST_CHECK_EQUAL(buffer.channels(), color_space == ColorSpace::cmyk ? 4 : 3);
+			BOOST_CHECK_EQUAL(buffer.stride() % ColorBuffer::block_size, 0);
+			BOOST_CHECK_GE(buffer.stride(), size);
+			BOOST_CHECK_LT(buffer.stride(), size + ColorBuffer::block_size);
+			if (size == 0) continue;
+			for (int i = 0; i < buffer.channels(); i++){
+				BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(buffer.plane(i)) % ColorBuffer::alignment, 0);
+				if (i > 0)
+					BOOST_CHECK_EQUAL(buffer.plane(i) - buffer.plane(i - 1), ptrdiff_t(buffer.stride()));
+			}
+			checkPadding(buffer);
+		}
+	}
+}
+BOOST_AUTO_TEST_CASE(vector_round_trip)
+{
+	auto colors = buildColors(13);
+	for (auto &color: colors)
+		color.ma[3] = 0.5f;
+	ColorBuffer buffer(ColorSpace::rgb, colors);
+	BOOST_CHECK_EQUAL(buffer.size(), colors.size());
+	checkPadding(buffer);
+	auto result = buffer.toVector();
+	BOOST_REQUIRE_EQUAL(result.size(), colors.size());
+	for (size_t i = 0; i < colors.size(); i++){
+		Color color;
+		buffer.get(i, color);
+		for (int j = 0; j < 3; j++){
+			BOOST_CHECK_EQUAL(result[i].ma[j], colors[i].ma[j]);
+			BOOST_CHECK_EQUAL(color.ma[j], colors[i].ma[j]);
+		}
+		BOOST_CHECK_EQUAL(result[i].ma[3], 0.0f);
+	}
+	ColorBuffer cmyk(ColorSpace::cmyk, colors);
+	result = cmyk.toVector();
+	for (size_t i = 0; i < colors.size(); i++)
+		BOOST_CHECK_EQUAL(result[i].ma[3], 0.5f);
+	ColorBuffer copy(buffer), moved(std::move(copy));
+	BOOST_CHECK(copy.empty());
+	BOOST_CHECK_EQUAL(moved.size(), colors.size());
+	BOOST_CHECK_EQUAL(moved.plane(2)[12], colors[12].ma[2]);
+}
+BOOST_AUTO_TEST_CASE(resize)
+{
+	auto colors = buildColors(10);
+	ColorBuffer buffer(ColorSpace::rgb, colors);
+	buffer.resize(5);
+	BOOST_CHECK_EQUAL(buffer.size(), 5);
+	checkPadding(buffer);
+	buffer.resize(10);
+	for (size_t i = 5; i < 10; i++)
+		BOOST_CHECK_EQUAL(buffer.plane(0)[i], 0.0f);
+	buffer.resize(100);
+	BOOST_CHECK_EQUAL(buffer.size(), 100);
+	checkPadding(buffer);
+	for (size_t i = 0; i < 5; i++){
+		Color color;
+		buffer.get(i, color);
+		for (int j = 0; j < 3; j++)
+			BOOST_CHECK_EQUAL(color.ma[j], colors[i].ma[j]);
+	}
+	for (size_t i = 5; i < 100; i++)
+		BOOST_CHECK_EQUAL(buffer.plane(1)[i], 0.0f);
+	buffer.clear();
+	BOOST_CHECK(buffer.empty());
+}
+BOOST_AUTO_TEST_CASE(set_color_space)
+{
+	auto colors = buildColors(9);
+	ColorBuffer buffer(ColorSpace::rgb, colors);
+	buffer.setColorSpace(ColorSpace::hsv);
+	BOOST_CHECK(buffer.colorSpace() == ColorSpace::hsv);
+	BOOST_CHECK_EQUAL(buffer.plane(0)[3], colors[3].ma[0]);
+	buffer.setColorSpace(ColorSpace::cmyk);
+	BOOST_CHECK_EQUAL(buffer.channels(), 4);
+	for (size_t i = 0; i < colors.size(); i++){
+		for (int j = 0; j < 3; j++)
+			BOOST_CHECK_EQUAL(buffer.plane(j)[i], colors[i].ma[j]);
+		BOOST_CHECK_EQUAL(buffer.plane(3)[i], 0.0f);
+	}
+	checkPadding(buffer);
+	buffer.plane(3)[0] = 1;
+	buffer.setColorSpace(ColorSpace::rgb);
+	BOOST_CHECK_EQUAL(buffer.channels(), 3);
+	BOOST_CHECK_EQUAL(buffer.plane(2)[8], colors[8].ma[2]);
+}
+static float componentDifference(ColorSpace color_space, int channel, float a, float b)
+{
+	float d = fabs(a - b);
+	if ((color_space == ColorSpace::hsv || color_space == ColorSpace::hsl) && channel == 0)
+		return std::min(d, 1 - d);
+	if (color_space == ColorSpace::lch && channel == 2)
+		return std::min(d, 360 - d);
+	return d;
+}
+BOOST_AUTO_TEST_CASE(convert)
+{
+	auto colors = buildColors(300);
+	struct Conversion
+	{
+		ColorSpace color_space;
+		void (*convert)(const Color *a, Color *b);
+		float tolerance;
+	};
+	Conversion conversions[] = {
+		{ColorSpace::linear_rgb, color_rgb_get_linear, COLOR_BATCH_RGB_TOLERANCE},
+		{ColorSpace::hsv, color_rgb_to_hsv, COLOR_BATCH_RGB_TOLERANCE},
+		{ColorSpace::hsl, color_rgb_to_hsl, COLOR_BATCH_RGB_TOLERANCE},
+		{ColorSpace::xyz, [](const Color *a, Color *b){
+			color_rgb_to_xyz(a, b, color_get_sRGB_transformation_matrix());
+		}, COLOR_BATCH_RGB_TOLERANCE},
+		{ColorSpace::lab, color_rgb_to_lab_d50, COLOR_BATCH_LAB_TOLERANCE},
+		{ColorSpace::lch, color_rgb_to_lch_d50, COLOR_BATCH_HUE_TOLERANCE},
+		{ColorSpace::cmy, color_rgb_to_cmy, COLOR_BATCH_RGB_TOLERANCE},
+		{ColorSpace::cmyk, color_rgb_to_cmyk, COLOR_BATCH_RGB_TOLERANCE},
+	};
+	for (auto &conversion: conversions){
+		ColorBuffer buffer(ColorSpace::rgb, colors);
+		buffer.convert(conversion.color_space);
+		BOOST_CHECK(buffer.colorSpace() == conversion.color_space);
+		BOOST_CHECK_EQUAL(buffer.size(), colors.size());
+		checkPadding(buffer);
+		for (size_t i = 0; i < colors.size(); i++){
+			Color expected, result;
+			conversion.convert(&colors[i], &expected);
+			buffer.get(i, result);
+			for (int j = 0; j < buffer.channels(); j++)
+				BOOST_CHECK_SMALL(componentDifference(conversion.color_space, j, expected.ma[j], result.ma[j]), conversion.tolerance);
+		}
+		buffer.convert(ColorSpace::rgb);
+		BOOST_CHECK_EQUAL(buffer.channels(), 3);
+		for (size_t i = 0; i < colors.size(); i++){
+			Color result;
+			buffer.get(i, result);
+			for (int j = 0; j < 3; j++)
+				BOOST_CHECK_SMALL(result.ma[j] - colors[i].ma[j], 1e-4f);
+		}
+	}
+}
+BOOST_AUTO_TEST_CASE(color_list_round_trip)
+{
+	auto colors = buildColors(20);
+	struct dynvHandlerMap *handler_map = dynv_create_default_handler_map();
+	ColorList *color_list = color_list_new(handler_map);
+	for (auto &color: colors)
+		color_list_add_color(color_list, &color);
+	ColorBuffer buffer;
+	color_list_get_colors(color_list, buffer);
+	BOOST_CHECK(buffer.colorSpace() == ColorSpace::rgb);
+	BOOST_REQUIRE_EQUAL(buffer.size(), colors.size());
+	checkPadding(buffer);
+	for (size_t i = 0; i < colors.size(); i++){
+		Color color;
+		buffer.get(i, color);
+		for (int j = 0; j < 3; j++)
+			BOOST_CHECK_EQUAL(color.ma[j], colors[i].ma[j]);
+	}
+	buffer.convert(ColorSpace::lab);
+	ColorList *result = color_list_new(handler_map);
+	color_list_add_colors(result, buffer, false);
+	BOOST_REQUIRE_EQUAL(color_list_get_count(result), colors.size());
+	size_t index = 0;
+	for (auto color_object: result->colors){
+		const Color &color = color_object->getColor();
+		for (int j = 0; j < 3; j++)
+			BOOST_CHECK_SMALL(color.ma[j] - colors[index].ma[j], 1e-4f);
+		index++;
+	}
+	color_list_destroy(result);
+	color_list_destroy(color_list);
+	dynv_handler_map_release(handler_map);
+}
@@ -0,0 +1,85 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE color_lut
+#include <boost/test/unit_test.hpp>
+#include "ColorLut.h"
+#include "TestUtils.h"
+#include <cmath>
+using namespace std;
+
+BOOST_GLOBAL_FIXTURE(ColorInit);
+
+static void smooth(const Color &input, Color &output)
+{
+	output.rgb.red = input.rgb.red * input.rgb.red;
+	output.rgb.green = 0.5f * input.rgb.green + 0.25f * input.rgb.blue;
+	output.rgb.blue = sqrt(0.1f + input.rgb.red * input.rgb.blue);
+}
+BOOST_AUTO_TEST_CASE(linear_function_is_exact)
+{
+	ColorLut lut;
+	auto function = [](const Color &input, Color &output){
+		output.rgb.red = 1 - input.rgb.red;
+		output.rgb.green = 0.2f * input.rgb.red + 0.7f * input.rgb.green + 0.1f * input.rgb.blue;
+		output.rgb.blue = input.rgb.blue;
+	};
+	lut.build(5, function);
+	BOOST_CHECK_EQUAL(lut.getSize(), 5);
+	BOOST_CHECK_SMALL(lut.getError(function, 4), 1e-5f);
+	Color input, output, expected;
+	color_set(&input, 0.3f, 0.61f, 0.97f);
+	lut.apply(input, output);
+	function(input, expected);
+	for (int i = 0; i < 3; i++)
+		BOOST_CHECK_CLOSE(output.ma[i], expected.ma[i], 1e-3);
+}
+BOOST_AUTO_TEST_CASE(nodes_and_range)
+{
+	ColorLut lut;
+	lut.build(9, smooth);
+	Color input, output, expected;
+	for (int i = 0; i <= 8; i += 4){
+		color_set(&input, i / 8.0f, (8 - i) / 8.0f, 1.0f);
+		lut.apply(input, output);
+		smooth(input, expected);
+		for (int j = 0; j < 3; j++)
+			BOOST_CHECK_SMALL(output.ma[j] - expected.ma[j], 1e-5f);
+	}
+	// Inputs outside of unit cube are clamped
+	color_set(&input, -0.5f, 2.0f, 1.0f);
+	lut.apply(input, output);
+	color_set(&input, 0.0f, 1.0f, 1.0f);
+	smooth(input, expected);
+	for (int j = 0; j < 3; j++)
+		BOOST_CHECK_SMALL(output.ma[j] - expected.ma[j], 1e-5f);
+}
+BOOST_AUTO_TEST_CASE(nan_is_clamped)
+{
+	ColorLut lut;
+	lut.build(9, smooth);
+	Color input, output, expected;
+	color_set(&input, NAN, 0.5f, NAN);
+	lut.apply(input, output);
+	color_set(&input, 0.0f, 0.5f, 0.0f);
+	smooth(input, expected);
+	for (int j = 0; j < 3; j++)
+		BOOST_CHECK_SMALL(output.ma[j] - expected.ma[j], 1e-5f);
+}
+BOOST_AUTO_TEST_CASE(error_decreases_with_size)
+{
+	ColorLut small, large;
+	small.build(9, smooth);
+	large.build(33, smooth);
+	float small_error = small.getError(smooth, 8);
+	float large_error = large.getError(smooth, 8);
+	BOOST_CHECK(small_error > 0);
+	BOOST_CHECK(large_error < small_error / 4);
+}
+BOOST_AUTO_TEST_CASE(clear)
+{
+	ColorLut lut;
+	BOOST_CHECK(lut.empty());
+	lut.build(2, smooth);
+	BOOST_CHECK(!lut.empty());
+	lut.clear();
+	BOOST_CHECK(lut.empty());
+}
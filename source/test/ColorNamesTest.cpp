@@ -0,0 +1,172 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE color_names
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <fstream>
+#include <vector>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include "Color.h"
+#include "color_names/ColorNames.h"
+#include "TestUtils.h"
+using namespace std;
+
+static void writeColorNames(const char *filename, int count)
+{
+	ofstream file(filename);
+	TestRandom random(1);
+	for (int i = 0; i < count; i++){
+			file << "! comment\n";
+		for (int j = 0; j < 3; j++)
+			file << (random.next() & 0xff) << " ";
+		file << "color " << i << "\n";
+	}
+}
+struct ColorNamesFixture
+{
+	ColorNames *color_names;
+	ColorNamesFixture()
+	{
+		color_init();
+		const char *filename = "test_color_names.txt";
+		writeColorNames(filename, 20000);
+		color_names = color_names_new();
+		color_names_load_from_file(color_names, filename);
+		remove(filename);
+	}
+	~ColorNamesFixture()
+	{
+		color_names_destroy(color_names);
+	}
+};
+static vector<float> findNearestLinear(ColorNames *color_names, const Color *color, size_t count)
+{
+	Color c;
+	color_names->color_space_convert(color, &c);
+	vector<float> distances;
+	for (auto segment: color_names->segments){
+		for (size_t i = 0; i < segment->entry_count; i++)
+			distances.push_back(color_names->color_space_distance(&segment->entries[i].color, &c));
+	}
+	sort(distances.begin(), distances.end());
+	distances.resize(min(count, distances.size()));
+	return distances;
+}
+BOOST_FIXTURE_TEST_SUITE(color_names, ColorNamesFixture)
+BOOST_AUTO_TEST_CASE(load)
+{
+	BOOST_CHECK_EQUAL(color_names_get_entry_count(color_names), 20000);
+	BOOST_CHECK_EQUAL(color_names->segments.front()->names, "Color 0");
+}
+BOOST_AUTO_TEST_CASE(nearest)
+{
+	TestRandom random(7);
+	for (int i = 0; i < 1000; i++){
+		Color color;
+		for (int j = 0; j < 3; j++)
+			color.ma[j] = random.nextFloat();
+		ColorNameMatch match;
+		BOOST_REQUIRE_EQUAL(color_names_find_nearest(color_names, &color, 1, &match), 1);
+		BOOST_CHECK_EQUAL(match.distance, findNearestLinear(color_names, &color, 1)[0]);
+		BOOST_CHECK_EQUAL(color_names_get(color_names, &color, false), match.name);
+	}
+}
+BOOST_AUTO_TEST_CASE(k_nearest)
+{
+	Color color;
+	color_set(&color, 0.3f, 0.6f, 0.1f);
+	ColorNameMatch matches[20];
+	BOOST_REQUIRE_EQUAL(color_names_find_nearest(color_names, &color, 20, matches), 20);
+	auto expected = findNearestLinear(color_names, &color, 20);
+	for (int i = 0; i < 20; i++)
+		BOOST_CHECK_EQUAL(matches[i].distance, expected[i]);
+}
+BOOST_AUTO_TEST_CASE(multiple)
+{
+	vector<Color> colors(5000);
+	for (size_t i = 0; i < colors.size(); i++)
+		color_set(&colors[i], int(i % 50), int(i % 7) * 30, 128);
+	color_set(&colors[1], 2.0f, 0.5f, -1.0f);
+	vector<string> names(colors.size());
+	color_names_get_multiple(color_names, colors.data(), colors.size(), true, names.data());
+	size_t hits, misses;
+	color_names_get_cache_statistics(color_names, &hits, &misses);
+	BOOST_CHECK_EQUAL(misses, 351);
+	BOOST_CHECK_EQUAL(hits, colors.size() - 351);
+	for (size_t i = 0; i < colors.size(); i++){
+		ColorNameMatch match;
+		BOOST_REQUIRE_EQUAL(color_names_find_nearest(color_names, &colors[i], 1, &match), 1);
+		BOOST_CHECK_EQUAL(names[i].substr(0, strlen(match.name)), match.name);
+	}
+	color_names_set_cache_size(color_names, 0);
+	color_names_get_multiple(color_names, colors.data(), 10, true, names.data());
+	color_names_get_cache_statistics(color_names, &hits, &misses);
+	BOOST_CHECK_EQUAL(misses, 361);
+}
+BOOST_AUTO_TEST_CASE(multiple_exact)
+{
+	// colors closer than any quantization step are cached separately
+	vector<Color> colors(200);
+	for (size_t i = 0; i < colors.size(); i++)
+		color_set(&colors[i], 0.3f + i * 1e-5f, 0.6f - i * 1e-5f, 0.45f);
+	vector<ColorNameMatch> matches(colors.size());
+	for (int pass = 0; pass < 2; pass++){
+		color_names_find_nearest_multiple(color_names, colors.data(), colors.size(), matches.data());
+		for (size_t i = 0; i < colors.size(); i++){
+			ColorNameMatch match;
+			BOOST_REQUIRE_EQUAL(color_names_find_nearest(color_names, &colors[i], 1, &match), 1);
+			BOOST_CHECK_EQUAL(matches[i].name, match.name);
+			BOOST_CHECK_EQUAL(matches[i].distance, match.distance);
+		}
+	}
+	size_t hits, misses;
+	color_names_get_cache_statistics(color_names, &hits, &misses);
+	BOOST_CHECK_EQUAL(misses, colors.size());
+	BOOST_CHECK_EQUAL(hits, colors.size());
+}
+BOOST_AUTO_TEST_CASE(cache)
+{
+	const char *filename = "test_color_names_cache.txt", *cache_filename = "test_color_names.cache";
+	remove(cache_filename);
+	writeColorNames(filename, 1000);
+	ColorNames *text = color_names_new();
+	BOOST_REQUIRE_EQUAL(color_names_load(text, filename, cache_filename), 0);
+	BOOST_CHECK(text->segments.front()->mapped_file == nullptr);
+	ColorNames *cached = color_names_new();
+	BOOST_REQUIRE_EQUAL(color_names_load(cached, filename, cache_filename), 0);
+	BOOST_REQUIRE(cached->segments.front()->mapped_file != nullptr);
+	BOOST_CHECK_EQUAL(color_names_get_entry_count(cached), 1000);
+	Color color;
+	for (int i = 0; i < 100; i++){
+		color_set(&color, i / 99.0f, 1 - i / 99.0f, 0.5f);
+		BOOST_CHECK_EQUAL(color_names_get(cached, &color, true), color_names_get(text, &color, true));
+	}
+	color_names_destroy(cached);
+	// modified source file makes cache stale
+	writeColorNames(filename, 10);
+	cached = color_names_new();
+	BOOST_REQUIRE_EQUAL(color_names_load(cached, filename, cache_filename), 0);
+	BOOST_CHECK(cached->segments.front()->mapped_file == nullptr);
+	BOOST_CHECK_EQUAL(color_names_get_entry_count(cached), 10);
+	color_names_destroy(cached);
+	// cache with name offset outside of name table is rebuilt
+	{
+		fstream file(cache_filename, ios::in | ios::out | ios::binary);
+		size_t entries_offset = 56 + (strlen(filename) + 7) / 8 * 8;
+		file.seekp(entries_offset + offsetof(ColorEntry, name));
+		uint32_t name = 0xffffff;
+		file.write(reinterpret_cast<const char*>(&name), sizeof(name));
+	}
+	cached = color_names_new();
+	BOOST_REQUIRE_EQUAL(color_names_load(cached, filename, cache_filename), 0);
+	BOOST_CHECK(cached->segments.front()->mapped_file == nullptr);
+	BOOST_CHECK_EQUAL(color_names_get_entry_count(cached), 10);
+	color_names_destroy(cached);
+	color_names_destroy(text);
+	BOOST_CHECK_EQUAL(color_names_load(text = color_names_new(), "missing_color_names.txt", cache_filename), -1);
+	color_names_destroy(text);
+	remove(filename);
+	remove(cache_filename);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,79 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE color
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include "Color.h"
+#include "TestUtils.h"
+using namespace std;
+
+BOOST_GLOBAL_FIXTURE(ColorInit);
+
+static double rgbToLinear(double value)
+{
+	if (value > 0.04045)
+		return pow((value + 0.055) / 1.055, 2.4);
+	else
+		return value / 12.92;
+}
+static double linearToRgb(double value)
+{
+	if (value > 0.0031308)
+		return 1.055 * pow(value, 1 / 2.4) - 0.055;
+	else
+		return value * 12.92;
+}
+BOOST_AUTO_TEST_CASE(gamma_8bit)
+{
+	for (int i = 0; i < 256; i++){
+		float expected = rgbToLinear(i / 255.0);
+		BOOST_CHECK_EQUAL(color_rgb8_get_linear_value(i), expected);
+		Color color;
+		color_rgb8_get_linear(i, 255 - i, i / 2, &color);
+		BOOST_CHECK_EQUAL(color.rgb.red, expected);
+		BOOST_CHECK_EQUAL(color.rgb.green, float(rgbToLinear((255 - i) / 255.0)));
+		BOOST_CHECK_EQUAL(color.rgb.blue, float(rgbToLinear((i / 2) / 255.0)));
+	}
+}
+BOOST_AUTO_TEST_CASE(gamma_float)
+{
+	const int steps = 100003;
+	double max_linear_error = 0, max_rgb_error = 0;
+	for (int i = -10; i <= steps + 10; i++){
+		float value = float(i) / steps;
+		Color color, result;
+		color_set(&color, value);
+		color_rgb_get_linear(&color, &result);
+		max_linear_error = std::max(max_linear_error, fabs(result.rgb.red - rgbToLinear(value)));
+		color_linear_get_rgb(&color, &result);
+		if (value >= 0)
+			max_rgb_error = std::max(max_rgb_error, fabs(result.rgb.red - linearToRgb(value)));
+	}
+	BOOST_TEST_MESSAGE("max error: " << max_linear_error << " " << max_rgb_error);
+	BOOST_CHECK_SMALL(max_linear_error, 1e-6);
+	BOOST_CHECK_SMALL(max_rgb_error, 1e-6);
+}
+BOOST_AUTO_TEST_CASE(gamma_round_trip)
+{
+	for (int i = 0; i < 256; i++){
+		Color color, linear, result;
+		color_set(&color, i, 255 - i, i / 2);
+		color_rgb_get_linear(&color, &linear);
+		color_linear_get_rgb(&linear, &result);
+		for (int j = 0; j < 3; j++)
+			BOOST_CHECK_SMALL(result.ma[j] - color.ma[j], 1e-5f);
+	}
+}
+BOOST_AUTO_TEST_CASE(lab_from_8bit_linear)
+{
+	for (int i = 0; i < 256; i++){
+		Color color, linear, expected, result;
+		color_set(&color, i, 255 - i, i / 2);
+		color_rgb_to_lab_d50(&color, &expected);
+		color_rgb8_get_linear(i, 255 - i, i / 2, &linear);
+		color_linear_to_xyz(&linear, &result, color_get_sRGB_transformation_matrix());
+		color_xyz_chromatic_adaptation(&result, &result, color_get_d65_d50_adaptation_matrix());
+		color_xyz_to_lab(&result, &result, color_get_reference(REFERENCE_ILLUMINANT_D50, REFERENCE_OBSERVER_2));
+		for (int j = 0; j < 3; j++)
+			BOOST_CHECK_SMALL(result.ma[j] - expected.ma[j], 1e-3f);
+	}
+}
@@ -0,0 +1,299 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE color_vision_deficiency
+#include <boost/test/unit_test.hpp>
+#include "transformation/ColorVisionDeficiency.h"
+#include "TestUtils.h"
+#include <vector>
+using namespace std;
+using namespace transformation;
+
+BOOST_GLOBAL_FIXTURE(ColorInit);
+
+class TestDeficiency: public ColorVisionDeficiency
+{
+	public:
+		using ColorVisionDeficiency::ColorVisionDeficiency;
+		using ColorVisionDeficiency::apply;
+};
+const int color_count = 12;
+const float inputs[color_count][3] = {
+	{0, 0, 0}, {1, 1, 1}, {0.5f, 0.5f, 0.5f}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1},
+	{1, 1, 0}, {0, 1, 1}, {1, 0, 1}, {0.8f, 0.3f, 0.1f}, {0.2f, 0.6f, 0.9f}, {0.05f, 0.4f, 0.25f},
+};
+const float strengths[] = {0, 0.35f, 1};
+/** Output of per color formula used before matrices were precomputed, for each type and strength. */
+const float expected_outputs[ColorVisionDeficiency::DEFICIENCY_TYPE_COUNT * 3][color_count][3] = {
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{1.0000000f, 1.0000000f, 1.0000000f},
+		{0.5000000f, 0.5000000f, 0.5000000f},
+		{1.0000000f, 0.0000000f, 0.0000000f},
+		{0.0000000f, 1.0000000f, 0.0000000f},
+		{0.0000000f, 0.0000000f, 1.0000000f},
+		{1.0000000f, 1.0000000f, 0.0000000f},
+		{0.0000000f, 1.0000000f, 1.0000000f},
+		{1.0000000f, 0.0000000f, 1.0000000f},
+		{0.8000000f, 0.3000000f, 0.1000000f},
+		{0.2000000f, 0.6000000f, 0.9000000f},
+		{0.0500000f, 0.4000000f, 0.2500000f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{0.8288053f, 1.0000000f, 0.9801596f},
+		{0.4099402f, 0.5817633f, 0.4895626f},
+		{0.7885886f, 0.7499810f, 0.0000000f},
+		{0.3052463f, 0.9443686f, 0.2376002f},
+		{0.0000000f, 0.0000000f, 1.0000000f},
+		{0.8325801f, 1.0000000f, 0.0000000f},
+		{0.2915854f, 0.9396863f, 1.0000000f},
+		{0.7845338f, 0.7436283f, 0.9590704f},
+		{0.6330755f, 0.6497293f, 0.0000000f},
+		{0.2157570f, 0.5741993f, 0.9121040f},
+		{0.1123014f, 0.3783929f, 0.2657618f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{0.5496490f, 1.0000000f, 0.9760346f},
+		{0.2630855f, 0.6524960f, 0.4873927f},
+		{0.4266085f, 1.0000000f, 0.0000000f},
+		{0.3726543f, 0.8994281f, 0.3478668f},
+		{0.0000000f, 0.0000000f, 1.0000000f},
+		{0.5533531f, 1.0000000f, 0.0000000f},
+		{0.3665523f, 0.8746434f, 1.0000000f},
+		{0.4214545f, 1.0000000f, 0.9295361f},
+		{0.3496977f, 0.8503331f, 0.0000000f},
+		{0.2164372f, 0.5345507f, 0.9324592f},
+		{0.1314532f, 0.3593949f, 0.2847156f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{1.0000000f, 1.0000000f, 1.0000000f},
+		{0.5000000f, 0.5000000f, 0.5000000f},
+		{1.0000000f, 0.0000000f, 0.0000000f},
+		{0.0000000f, 1.0000000f, 0.0000000f},
+		{0.0000000f, 0.0000000f, 1.0000000f},
+		{1.0000000f, 1.0000000f, 0.0000000f},
+		{0.0000000f, 1.0000000f, 1.0000000f},
+		{1.0000000f, 0.0000000f, 1.0000000f},
+		{0.8000000f, 0.3000000f, 0.1000000f},
+		{0.2000000f, 0.6000000f, 0.9000000f},
+		{0.0500000f, 0.4000000f, 0.2500000f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{0.8922256f, 1.0000000f, 0.9526954f},
+		{0.4433035f, 0.5704443f, 0.4751147f},
+		{0.8212467f, 0.7228395f, 0.0000000f},
+		{0.4104503f, 0.9212211f, 0.1884826f},
+		{0.0000000f, 0.1554206f, 0.9946130f},
+		{0.8966393f, 1.0000000f, 0.0000000f},
+		{0.3982534f, 0.9313760f, 1.0000000f},
+		{0.8162887f, 0.7367246f, 0.9386707f},
+		{0.6628704f, 0.6274786f, 0.0000000f},
+		{0.2695954f, 0.5809653f, 0.8978717f},
+		{0.1547846f, 0.3706898f, 0.2569736f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{0.8184580f, 1.0000000f, 0.9004616f},
+		{0.4044969f, 0.6158386f, 0.4476362f},
+		{0.6400595f, 0.9360511f, 0.0000000f},
+		{0.5658069f, 0.8392478f, 0.2411714f},
+		{0.0000000f, 0.2291919f, 0.9861944f},
+		{0.8251899f, 1.0000000f, 0.0000000f},
+		{0.5547532f, 0.8626102f, 1.0000000f},
+		{0.6306513f, 0.9563615f, 0.8760839f},
+		{0.5293239f, 0.7793188f, 0.0000000f},
+		{0.3355180f, 0.5625078f, 0.8913814f},
+		{0.2152561f, 0.3405153f, 0.2593390f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{1.0000000f, 1.0000000f, 1.0000000f},
+		{0.5000000f, 0.5000000f, 0.5000000f},
+		{1.0000000f, 0.0000000f, 0.0000000f},
+		{0.0000000f, 1.0000000f, 0.0000000f},
+		{0.0000000f, 0.0000000f, 1.0000000f},
+		{1.0000000f, 1.0000000f, 0.0000000f},
+		{0.0000000f, 1.0000000f, 1.0000000f},
+		{1.0000000f, 0.0000000f, 1.0000000f},
+		{0.8000000f, 0.3000000f, 0.1000000f},
+		{0.2000000f, 0.6000000f, 0.9000000f},
+		{0.0500000f, 0.4000000f, 0.2500000f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{0.9820696f, 1.0000000f, 0.9145437f},
+		{0.4905674f, 0.5487259f, 0.4550444f},
+		{0.9671779f, 0.3633910f, 0.0000000f},
+		{0.1543076f, 0.9749787f, 0.2071256f},
+		{0.1128354f, 0.4506142f, 0.9146553f},
+		{0.9765869f, 1.0000000f, 0.0000000f},
+		{0.1988304f, 1.0000000f, 0.9319356f},
+		{0.9727309f, 0.5655289f, 0.8968183f},
+		{0.7744051f, 0.4050774f, 0.0000000f},
+		{0.2395811f, 0.6937021f, 0.8284559f},
+		{0.0785000f, 0.4024123f, 0.2377551f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{1.0000000f, 1.0000000f, 0.5589550f},
+		{0.5400141f, 0.6103700f, 0.2679811f},
+		{1.0000000f, 0.0000000f, 0.0000000f},
+		{0.0000000f, 0.9689475f, 0.4203800f},
+		{0.0583860f, 0.8496162f, 0.5872788f},
+		{1.0000000f, 0.9328840f, 0.0000000f},
+		{0.0000000f, 1.0000000f, 0.7024617f},
+		{1.0000000f, 0.8063335f, 0.3887517f},
+		{0.8820856f, 0.1854735f, 0.0000000f},
+		{0.1530464f, 0.9252746f, 0.5660925f},
+		{0.0000000f, 0.4347619f, 0.2040139f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{1.0000000f, 1.0000000f, 1.0000000f},
+		{0.5000000f, 0.5000000f, 0.5000000f},
+		{1.0000000f, 0.0000000f, 0.0000000f},
+		{0.0000000f, 1.0000000f, 0.0000000f},
+		{0.0000000f, 0.0000000f, 1.0000000f},
+		{1.0000000f, 1.0000000f, 0.0000000f},
+		{0.0000000f, 1.0000000f, 1.0000000f},
+		{1.0000000f, 0.0000000f, 1.0000000f},
+		{0.8000000f, 0.3000000f, 0.1000000f},
+		{0.2000000f, 0.6000000f, 0.9000000f},
+		{0.0500000f, 0.4000000f, 0.2500000f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{0.9999998f, 1.0000000f, 1.0000000f},
+		{0.4999999f, 0.5000001f, 0.5000000f},
+		{0.8661805f, 0.2680725f, 0.0436161f},
+		{0.6239100f, 0.9672067f, 0.0000000f},
+		{0.0000000f, 0.1347439f, 1.0000000f},
+		{1.0000000f, 0.9935674f, 0.0000000f},
+		{0.5625072f, 0.9739986f, 0.9985173f},
+		{0.8243973f, 0.3023710f, 1.0000000f},
+		{0.7089085f, 0.3547141f, 0.1107093f},
+		{0.3049540f, 0.5922614f, 0.8997375f},
+		{0.2359832f, 0.3873020f, 0.2487329f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{0.9999995f, 1.0000000f, 1.0000000f},
+		{0.4999998f, 0.5000001f, 0.5000001f},
+		{0.4913416f, 0.4453474f, 0.0977282f},
+		{0.9964384f, 0.9020489f, 0.0000000f},
+		{0.0000000f, 0.2388593f, 1.0000000f},
+		{1.0000000f, 0.9814723f, 0.0000000f},
+		{0.9013429f, 0.9231029f, 0.9957561f},
+		{0.0000000f, 0.4984660f, 1.0000000f},
+		{0.4790040f, 0.4355504f, 0.1283700f},
+		{0.4299717f, 0.5775352f, 0.8992499f},
+		{0.3849003f, 0.3622594f, 0.2463599f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{1.0000000f, 1.0000000f, 1.0000000f},
+		{0.5000000f, 0.5000000f, 0.5000000f},
+		{1.0000000f, 0.0000000f, 0.0000000f},
+		{0.0000000f, 1.0000000f, 0.0000000f},
+		{0.0000000f, 0.0000000f, 1.0000000f},
+		{1.0000000f, 1.0000000f, 0.0000000f},
+		{0.0000000f, 1.0000000f, 1.0000000f},
+		{1.0000000f, 0.0000000f, 1.0000000f},
+		{0.8000000f, 0.3000000f, 0.1000000f},
+		{0.2000000f, 0.6000000f, 0.9000000f},
+		{0.0500000f, 0.4000000f, 0.2500000f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{0.9999999f, 1.0000000f, 1.0000000f},
+		{0.4999999f, 0.5000001f, 0.5000000f},
+		{0.9064453f, 0.3790130f, 0.0000000f},
+		{0.5367095f, 0.9317824f, 0.1000619f},
+		{0.0000000f, 0.1992393f, 0.9990215f},
+		{1.0000000f, 0.9868777f, 0.0258783f},
+		{0.4817977f, 0.9465411f, 1.0000000f},
+		{0.8793009f, 0.4238443f, 0.9955179f},
+		{0.7360022f, 0.4020546f, 0.0691956f},
+		{0.2796202f, 0.5842458f, 0.9006181f},
+		{0.2021514f, 0.3736541f, 0.2529759f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{0.9999998f, 1.0000000f, 1.0000000f},
+		{0.4999998f, 0.5000001f, 0.5000001f},
+		{0.6866553f, 0.6171626f, 0.0000000f},
+		{0.8613898f, 0.7836612f, 0.1851468f},
+		{0.0000000f, 0.3387444f, 0.9972008f},
+		{1.0000000f, 0.9618739f, 0.0677216f},
+		{0.7763469f, 0.8349534f, 1.0000000f},
+		{0.5632721f, 0.6865937f, 0.9871223f},
+		{0.5926005f, 0.5348584f, 0.0000000f},
+		{0.3812322f, 0.5534497f, 0.9017646f},
+		{0.3303972f, 0.3175564f, 0.2583981f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{1.0000000f, 1.0000000f, 1.0000000f},
+		{0.5000000f, 0.5000000f, 0.5000000f},
+		{1.0000000f, 0.0000000f, 0.0000000f},
+		{0.0000000f, 1.0000000f, 0.0000000f},
+		{0.0000000f, 0.0000000f, 1.0000000f},
+		{1.0000000f, 1.0000000f, 0.0000000f},
+		{0.0000000f, 1.0000000f, 1.0000000f},
+		{1.0000000f, 0.0000000f, 1.0000000f},
+		{0.8000000f, 0.3000000f, 0.1000000f},
+		{0.2000000f, 0.6000000f, 0.9000000f},
+		{0.0500000f, 0.4000000f, 0.2500000f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{0.9999999f, 1.0000000f, 1.0000000f},
+		{0.4999999f, 0.5000001f, 0.5000000f},
+		{1.0000000f, 0.0000000f, 0.2281275f},
+		{0.2401250f, 0.9667714f, 0.6775454f},
+		{0.0000000f, 0.2369591f, 0.8765551f},
+		{1.0000000f, 0.9756032f, 0.5906546f},
+		{0.1422824f, 0.9875357f, 1.0000000f},
+		{0.9867306f, 0.2402344f, 0.8728792f},
+		{0.8027916f, 0.2844641f, 0.2529292f},
+		{0.1701361f, 0.6113864f, 0.8605524f},
+		{0.0906315f, 0.3892914f, 0.3362355f},
+	},
+	{
+		{0.0000000f, 0.0000000f, 0.0000000f},
+		{0.9999997f, 1.0000000f, 1.0000000f},
+		{0.4999998f, 0.5000001f, 0.5000001f},
+		{1.0000000f, 0.0000000f, 0.3834839f},
+		{0.4020647f, 0.9006844f, 1.0000000f},
+		{0.0000000f, 0.3971617f, 0.5490898f},
+		{1.0000000f, 0.9280128f, 0.9449353f},
+		{0.2505342f, 0.9638169f, 1.0000000f},
+		{0.9614388f, 0.4022341f, 0.5294377f},
+		{0.8079426f, 0.2526169f, 0.3960539f},
+		{0.0908734f, 0.6318390f, 0.7801917f},
+		{0.1398047f, 0.3683830f, 0.4488865f},
+	},
+};
+BOOST_AUTO_TEST_CASE(reference_outputs)
+{
+	for (int type = 0; type < ColorVisionDeficiency::DEFICIENCY_TYPE_COUNT; type++){
+		for (int i = 0; i < 3; i++){
+			TestDeficiency transformation(ColorVisionDeficiency::DeficiencyType(type), strengths[i]);
+			const float (*expected)[3] = expected_outputs[type * 3 + i];
+			vector<Color> colors(color_count), outputs(color_count);
+			for (int j = 0; j < color_count; j++)
+				color_set(&colors[j], inputs[j][0], inputs[j][1], inputs[j][2]);
+			transformation.apply(colors.data(), outputs.data(), color_count);
+			for (int j = 0; j < color_count; j++){
+				Color output;
+				transformation.apply(&colors[j], &output);
+				for (int k = 0; k < 3; k++){
+					BOOST_CHECK_SMALL(output.ma[k] - expected[j][k], 1e-5f);
+					BOOST_CHECK_SMALL(outputs[j].ma[k] - expected[j][k], 1e-5f);
+				}
+			}
+		}
+	}
+}
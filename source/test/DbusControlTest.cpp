@@ -0,0 +1,308 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE dbus_control
+#include <boost/test/unit_test.hpp>
+#include "dbus/Control.h"
+#include "dbus/DbusInterface.h"
+#include "PickStream.h"
+#include <gio/gio.h>
+#include <functional>
+#include <string>
+#include <vector>
+using namespace std;
+
+/** Runs tests against a private session bus, so running instances of gpick are not affected. */
+struct PrivateBus
+{
+	GTestDBus *bus;
+	PrivateBus()
+	{
+		bus = g_test_dbus_new(G_TEST_DBUS_NONE);
+		g_test_dbus_up(bus);
+	}
+	~PrivateBus()
+	{
+		g_test_dbus_down(bus);
+		g_object_unref(bus);
+	}
+};
+BOOST_GLOBAL_FIXTURE(PrivateBus);
+
+static bool iterate_until(const function<bool()> &condition, int timeout)
+{
+	int64_t end = g_get_monotonic_time() + int64_t(timeout) * 1000;
+	while (!condition()){
+		if (g_get_monotonic_time() > end) return false;
+		g_main_context_iteration(nullptr, false);
+		g_usleep(1000);
+	}
+	return true;
+}
+struct Batch
+{
+	guint stream_id;
+	vector<PickSample> samples;
+};
+struct Client
+{
+	GpickControl *proxy;
+	vector<Batch> batches;
+	guint stream_id;
+	GError *error;
+	bool finished;
+	vector<string> *result_strings;
+	GVariant *result_colors;
+	Client():
+		stream_id(0),
+		error(nullptr),
+		finished(false),
+		result_strings(nullptr),
+		result_colors(nullptr)
+	{
+		proxy = gpick_control_proxy_new_for_bus_sync(G_BUS_TYPE_SESSION, GDBusProxyFlags(G_DBUS_PROXY_FLAGS_DO_NOT_LOAD_PROPERTIES | G_DBUS_PROXY_FLAGS_DO_NOT_AUTO_START), "org.gpick", "/org/gpick/Control", nullptr, nullptr);
+		g_signal_connect(proxy, "pick-samples", G_CALLBACK(onPickSamples), this);
+	}
+	~Client()
+	{
+		if (error) g_error_free(error);
+		g_object_unref(proxy);
+	}
+	bool waitForOwner()
+	{
+		return iterate_until([this]{
+			gchar *owner = g_dbus_proxy_get_name_owner(G_DBUS_PROXY(proxy));
+			bool result = owner != nullptr;
+			g_free(owner);
+			return result;
+		}, 5000);
+	}
+	bool start(const char *converter_name, double rate, guint batch_size)
+	{
+		finished = false;
+		g_clear_error(&error);
+		gpick_control_call_start_pick_stream(proxy, converter_name, rate, batch_size, nullptr, (GAsyncReadyCallback)onStarted, this);
+		return iterate_until([this]{ return finished; }, 5000) && !error;
+	}
+	bool stop(guint id)
+	{
+		finished = false;
+		g_clear_error(&error);
+		gpick_control_call_stop_pick_stream(proxy, id, nullptr, (GAsyncReadyCallback)onStopped, this);
+		return iterate_until([this]{ return finished; }, 5000) && !error;
+	}
+	static GVariant *newColors(const vector<Color> &colors)
+	{
+		GVariantBuilder builder;
+		g_variant_builder_init(&builder, G_VARIANT_TYPE("a(ddd)"));
+		for (auto &color: colors)
+			g_variant_builder_add(&builder, "(ddd)", double(color.rgb.red), double(color.rgb.green), double(color.rgb.blue));
+		return g_variant_builder_end(&builder);
+	}
+	static void getStrings(gchar **values, vector<string> &strings)
+	{
+		strings.clear();
+		for (size_t i = 0; values && values[i]; i++)
+			strings.push_back(values[i]);
+		g_strfreev(values);
+	}
+	bool convertColors(const char *converter_name, const vector<Color> &colors, vector<string> &texts)
+	{
+		g_clear_error(&error);
+		finished = false;
+		result_strings = &texts;
+		gpick_control_call_convert_colors(proxy, converter_name, newColors(colors), nullptr, (GAsyncReadyCallback)onConverted, this);
+		return iterate_until([this]{ return finished; }, 5000) && !error;
+	}
+	bool parseColors(const vector<const char *> &texts, vector<Color> &colors, vector<bool> &valid)
+	{
+		g_clear_error(&error);
+		finished = false;
+		vector<const char *> values = texts;
+		values.push_back(nullptr);
+		gpick_control_call_parse_colors(proxy, values.data(), nullptr, (GAsyncReadyCallback)onParsed, this);
+		if (!iterate_until([this]{ return finished; }, 5000) || error) return false;
+		colors.clear();
+		valid.clear();
+		GVariantIter iter;
+		g_variant_iter_init(&iter, result_colors);
+		gboolean is_valid;
+		double red, green, blue;
+		while (g_variant_iter_next(&iter, "(bddd)", &is_valid, &red, &green, &blue)){
+			Color color;
+			color_set(&color, float(red), float(green), float(blue));
+			colors.push_back(color);
+			valid.push_back(is_valid);
+		}
+		g_variant_unref(result_colors);
+		return true;
+	}
+	bool getColorNames(const vector<Color> &colors, vector<string> &names)
+	{
+		g_clear_error(&error);
+		finished = false;
+		result_strings = &names;
+		gpick_control_call_get_color_names(proxy, newColors(colors), nullptr, (GAsyncReadyCallback)onNamed, this);
+		return iterate_until([this]{ return finished; }, 5000) && !error;
+	}
+	static void onConverted(GObject *object, GAsyncResult *result, Client *client)
+	{
+		gchar **texts = nullptr;
+		if (gpick_control_call_convert_colors_finish(client->proxy, &texts, result, &client->error))
+			getStrings(texts, *client->result_strings);
+		client->finished = true;
+	}
+	static void onParsed(GObject *object, GAsyncResult *result, Client *client)
+	{
+		gpick_control_call_parse_colors_finish(client->proxy, &client->result_colors, result, &client->error);
+		client->finished = true;
+	}
+	static void onNamed(GObject *object, GAsyncResult *result, Client *client)
+	{
+		gchar **names = nullptr;
+		if (gpick_control_call_get_color_names_finish(client->proxy, &names, result, &client->error))
+			getStrings(names, *client->result_strings);
+		client->finished = true;
+	}
+	static void onStarted(GObject *object, GAsyncResult *result, Client *client)
+	{
+		gpick_control_call_start_pick_stream_finish(client->proxy, &client->stream_id, result, &client->error);
+		client->finished = true;
+	}
+	static void onStopped(GObject *object, GAsyncResult *result, Client *client)
+	{
+		gpick_control_call_stop_pick_stream_finish(client->proxy, result, &client->error);
+		client->finished = true;
+	}
+	static void onPickSamples(GpickControl *proxy, guint stream_id, GVariant *samples, Client *client)
+	{
+		Batch batch;
+		batch.stream_id = stream_id;
+		GVariantIter iter;
+		g_variant_iter_init(&iter, samples);
+		gint64 time;
+		gint32 x, y;
+		double red, green, blue;
+		const gchar *text;
+		while (g_variant_iter_next(&iter, "(xiiddd&s)", &time, &x, &y, &red, &green, &blue, &text)){
+			PickSample sample;
+			sample.time = time;
+			sample.position = math::Vec2<int>(x, y);
+			color_set(&sample.color, float(red), float(green), float(blue));
+			sample.text = text;
+			batch.samples.push_back(sample);
+		}
+		client->batches.push_back(batch);
+	}
+};
+struct Server
+{
+	dbus::Control control;
+	int samples;
+	Server():
+		samples(0)
+	{
+		control.onCheckConverter = [](const string &converter_name){
+			return converter_name != "unknown";
+		};
+		control.onPickSample = [this](const string &converter_name, PickSample &sample){
+			sample.position = math::Vec2<int>(samples++, 7);
+			color_set(&sample.color, 0.25f, 0.5f, 0.75f);
+			sample.text = "#" + converter_name;
+			return true;
+		};
+		control.onConvertColors = [](const string &converter_name, const vector<Color> &colors, vector<string> &texts){
+			if (converter_name == "broken") return false;
+			for (auto &color: colors)
+				texts.push_back(converter_name + ":" + to_string(int(color.rgb.red * 100 + 0.5f)));
+			return true;
+		};
+		control.onParseColors = [](const vector<string> &texts, vector<Color> &colors, vector<bool> &valid){
+			for (auto &text: texts){
+				bool is_valid = text.size() > 1 && text[0] == '#';
+				Color color;
+				color_set(&color, is_valid ? stoi(text.substr(1)) / 100.0f : 0.0f);
+				colors.push_back(color);
+				valid.push_back(is_valid);
+			}
+		};
+		control.onGetColorNames = [](const vector<Color> &colors, vector<string> &names){
+			for (auto &color: colors)
+				names.push_back(color.rgb.red < 0.5f ? "dark" : "light");
+		};
+		control.ownName();
+	}
+	~Server()
+	{
+		control.unownName();
+	}
+};
+BOOST_AUTO_TEST_CASE(pick_stream)
+{
+	Server server;
+	Client client;
+	BOOST_REQUIRE(client.waitForOwner());
+	BOOST_REQUIRE(client.start("hex", 50, 4));
+	guint id = client.stream_id;
+	BOOST_CHECK(id != 0);
+	BOOST_REQUIRE(iterate_until([&]{ return client.batches.size() >= 3; }, 5000));
+	vector<PickSample> samples;
+	for (auto &batch: client.batches){
+		BOOST_CHECK_EQUAL(batch.stream_id, id);
+		BOOST_CHECK_EQUAL(batch.samples.size(), 4);
+		samples.insert(samples.end(), batch.samples.begin(), batch.samples.end());
+	}
+	for (size_t i = 1; i < samples.size(); i++)
+		BOOST_CHECK_EQUAL(samples[i].position.x, samples[i - 1].position.x + 1);
+	BOOST_CHECK_EQUAL(samples[0].text, "#hex");
+	BOOST_CHECK_CLOSE(samples[0].color.rgb.green, 0.5f, 1e-4f);
+	// Samples are spaced by requested interval on average, with some tolerance for timer latency.
+	BOOST_CHECK_GE(samples.back().time - samples.front().time, int64_t(samples.size() - 2) * 20000);
+	BOOST_REQUIRE(client.stop(id));
+	size_t batches = client.batches.size();
+	iterate_until([]{ return false; }, 200);
+	BOOST_CHECK_EQUAL(client.batches.size(), batches);
+	BOOST_CHECK(!client.stop(id));
+	BOOST_CHECK(!client.start("unknown", 50, 4));
+}
+BOOST_AUTO_TEST_CASE(rate_limit)
+{
+	Server server;
+	Client client;
+	BOOST_REQUIRE(client.waitForOwner());
+	BOOST_REQUIRE(client.start("", 100000, 1));
+	int64_t start = g_get_monotonic_time();
+	iterate_until([]{ return false; }, 500);
+	double elapsed = (g_get_monotonic_time() - start) / 1000000.0;
+	BOOST_REQUIRE(client.stop(client.stream_id));
+	BOOST_CHECK_LE(client.batches.size(), size_t(PickStream::default_max_rate * elapsed) + 2);
+	BOOST_CHECK_GT(client.batches.size(), 0);
+}
+BOOST_AUTO_TEST_CASE(batch_conversion)
+{
+	Server server;
+	Client client;
+	BOOST_REQUIRE(client.waitForOwner());
+	vector<Color> colors(3);
+	color_set(&colors[0], 0.25f, 0, 0);
+	color_set(&colors[1], 0.5f, 0, 0);
+	color_set(&colors[2], 1.0f, 0, 0);
+	vector<string> texts;
+	BOOST_REQUIRE(client.convertColors("hex", colors, texts));
+	BOOST_REQUIRE_EQUAL(texts.size(), 3);
+	BOOST_CHECK_EQUAL(texts[0], "hex:25");
+	BOOST_CHECK_EQUAL(texts[2], "hex:100");
+	BOOST_CHECK(!client.convertColors("unknown", colors, texts));
+	BOOST_CHECK(g_error_matches(client.error, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS));
+	BOOST_CHECK(!client.convertColors("broken", colors, texts));
+	BOOST_CHECK(g_error_matches(client.error, G_DBUS_ERROR, G_DBUS_ERROR_FAILED));
+	vector<Color> parsed;
+	vector<bool> valid;
+	BOOST_REQUIRE(client.parseColors({"#20", "invalid", "#75"}, parsed, valid));
+	BOOST_REQUIRE_EQUAL(parsed.size(), 3);
+	BOOST_CHECK(valid[0] && !valid[1] && valid[2]);
+	BOOST_CHECK_CLOSE(parsed[2].rgb.green, 0.75f, 1e-4f);
+	vector<string> names;
+	BOOST_REQUIRE(client.getColorNames(colors, names));
+	BOOST_REQUIRE_EQUAL(names.size(), 3);
+	BOOST_CHECK_EQUAL(names[0], "dark");
+	BOOST_CHECK_EQUAL(names[1], "light");
+}
@@ -3,6 +3,8 @@
 #include <boost/test/unit_test.hpp>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include "dynv/DynvSystem.h"
 #include "dynv/DynvXml.h"
 #include "dynv/DynvVarString.h"
@@ -88,3 +90,88 @@ BOOST_AUTO_TEST_CASE(string_array_overwrite)
 	delete [] values;
 	BOOST_CHECK(dynv_system_release(dynv) == 0);
 }
+BOOST_AUTO_TEST_CASE(path_handle)
+{
+	auto dynv = buildDynv();
+	dynvPath path("a.b.value");
+	int32_t value = 5;
+	BOOST_CHECK(dynv_set(dynv, "int32", path, &value) == 0);
+	int error;
+	int32_t *result = (int32_t*)dynv_get(dynv, "int32", "a.b.value", &error);
+	BOOST_CHECK(error == 0);
+	BOOST_CHECK(result != nullptr && *result == 5);
+	value = 7;
+	BOOST_CHECK(dynv_set(dynv, "int32", "a.b.value", &value) == 0);
+	result = (int32_t*)dynv_get(dynv, "int32", path, &error);
+	BOOST_CHECK(error == 0);
+	BOOST_CHECK(result != nullptr && *result == 7);
+	dynv_get(dynv, "int32", dynvPath("a.c.value"), &error);
+	BOOST_CHECK(error != 0);
+	dynv_get(dynv, "string", path, &error);
+	BOOST_CHECK(error != 0);
+	BOOST_CHECK(dynv_atom_get("value") == path.atoms.back());
+	BOOST_CHECK(string(dynv_atom_get_name(path.atoms.front())) == "a");
+	BOOST_CHECK(dynv_system_release(dynv) == 0);
+}
+BOOST_AUTO_TEST_CASE(failed_get_does_not_allocate_atoms)
+{
+	auto dynv = buildDynv();
+	int error;
+	BOOST_CHECK(dynv_get(dynv, "int32", "unused_level.unused_value", &error) == nullptr);
+	BOOST_CHECK(error != 0);
+	BOOST_CHECK(dynv_system_get_r(dynv, "int32", "unused_variable", &error) == nullptr);
+	BOOST_CHECK(error != 0);
+	BOOST_CHECK(dynv_get_array(dynv, "int32", "unused_level.unused_array", nullptr, &error) == nullptr);
+	BOOST_CHECK(dynv_atom_find("unused_level") == 0);
+	BOOST_CHECK(dynv_atom_find("unused_value") == 0);
+	BOOST_CHECK(dynv_atom_find("unused_variable") == 0);
+	BOOST_CHECK(dynv_atom_find("unused_array") == 0);
+	BOOST_CHECK(dynv_system_remove(dynv, "unused_variable") != 0);
+	BOOST_CHECK(dynv_atom_find("unused_variable") == 0);
+	int32_t value = 4;
+	BOOST_CHECK(dynv_set(dynv, "int32", "unused_level.unused_value", &value) == 0);
+	BOOST_CHECK(dynv_atom_find("unused_value") != 0);
+	BOOST_CHECK(dynv_atom_find("unused_value") == dynv_atom_get("unused_value"));
+	int32_t *result = (int32_t*)dynv_get(dynv, "int32", "unused_level.unused_value", &error);
+	BOOST_CHECK(error == 0);
+	BOOST_CHECK(result != nullptr && *result == 4);
+	BOOST_CHECK(dynv_system_release(dynv) == 0);
+}
+BOOST_AUTO_TEST_CASE(many_variables)
+{
+	auto dynv = buildDynv();
+	const int count = 1000;
+	for (int32_t i = 0; i < count; i++){
+		string name = "variable" + to_string(i);
+		BOOST_CHECK(dynv_system_set(dynv, "int32", name.c_str(), &i) == 0);
+	}
+	// Every other variable is removed, so that remaining variables have to be found after moved entries
+	for (int i = 0; i < count; i += 2){
+		string name = "variable" + to_string(i);
+		BOOST_CHECK(dynv_system_remove(dynv, name.c_str()) == 0);
+		BOOST_CHECK(dynv_system_remove(dynv, name.c_str()) != 0);
+	}
+	BOOST_CHECK(dynv->variables.size() == count / 2);
+	for (int i = 0; i < count; i++){
+		string name = "variable" + to_string(i);
+		int error;
+		int32_t *value = (int32_t*)dynv_system_get_r(dynv, "int32", name.c_str(), &error);
+		if (i % 2){
+			BOOST_CHECK(error == 0 && value != nullptr && *value == i);
+		}else{
+			BOOST_CHECK(error != 0);
+		}
+	}
+	BOOST_CHECK(dynv_system_release(dynv) == 0);
+}
+BOOST_AUTO_TEST_CASE(serialization_order)
+{
+	auto dynv = buildDynv();
+	const char *names[] = {"zeta", "alpha", "mu", "beta"};
+	for (int32_t i = 0; i < 4; i++)
+		dynv_system_set(dynv, "int32", names[i], &i);
+	stringstream out;
+	BOOST_CHECK(dynv_xml_serialize(dynv, out) == 0);
+	BOOST_CHECK(out.str() == "<alpha type=\"int32\">1</alpha>\n<beta type=\"int32\">3</beta>\n<mu type=\"int32\">2</mu>\n<zeta type=\"int32\">0</zeta>\n");
+	BOOST_CHECK(dynv_system_release(dynv) == 0);
+}
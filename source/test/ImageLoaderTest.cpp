@@ -0,0 +1,82 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE image_loader
+#include <boost/test/unit_test.hpp>
+#include <png.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <cstdint>
+#include "ImageLoader.h"
+#include "ColorHistogram.h"
+#include "TestUtils.h"
+using namespace std;
+
+const char *png_file = "image_loader_test.png";
+const size_t width = 301, height = 257;
+
+static void writePng(const char *filename, const vector<uint8_t> &image, size_t bytes)
+{
+	FILE *file = fopen(filename, "wb");
+	BOOST_REQUIRE(file);
+	png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+	png_infop info = png_create_info_struct(png);
+	png_init_io(png, file);
+	png_set_IHDR(png, info, width, height, 8, PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+	png_write_info(png, info);
+	for (size_t y = 0; y < height; y++)
+		png_write_row(png, const_cast<uint8_t*>(&image[y * width * 3]));
+	png_write_end(png, info);
+	png_destroy_write_struct(&png, &info);
+	fclose(file);
+	if (bytes > 0){
+		vector<char> data(bytes);
+		file = fopen(filename, "rb");
+		data.resize(fread(data.data(), 1, bytes, file));
+		fclose(file);
+		file = fopen(filename, "wb");
+		fwrite(data.data(), 1, data.size(), file);
+		fclose(file);
+	}
+}
+static bool sameHistograms(const ColorHistogram &a, const ColorHistogram &b)
+{
+	if (a.getPixelCount() != b.getPixelCount()) return false;
+	for (uint32_t i = 0; i < ColorHistogram::bin_count; i++){
+		if (memcmp(&a.getBin(i), &b.getBin(i), sizeof(ColorHistogram::Bin)) != 0) return false;
+	}
+	return true;
+}
+BOOST_AUTO_TEST_CASE(png_rows)
+{
+	auto image = buildImage(width * height, 3);
+	writePng(png_file, image, 0);
+	for (size_t stride: {1, 3}){
+		ColorHistogram expected, histogram;
+		expected.addImage(image.data(), (width + stride - 1) / stride, (height + stride - 1) / stride, width * 3 * stride, 3 * stride);
+		std::atomic<size_t> processed_rows(0), total_rows(0);
+		BOOST_CHECK(image_loader_add_to_histogram(png_file, stride, histogram, &processed_rows, &total_rows, nullptr, nullptr));
+		BOOST_CHECK_EQUAL(total_rows, (height + stride - 1) / stride);
+		BOOST_CHECK_EQUAL(processed_rows, total_rows);
+		BOOST_CHECK(sameHistograms(histogram, expected));
+	}
+	remove(png_file);
+}
+BOOST_AUTO_TEST_CASE(truncated_png)
+{
+	writePng(png_file, buildImage(width * height, 3), 10000);
+	ColorHistogram histogram;
+	GError *error = nullptr;
+	BOOST_CHECK(!image_loader_add_to_histogram(png_file, 1, histogram, nullptr, nullptr, nullptr, &error));
+	BOOST_CHECK(error != nullptr);
+	if (error) g_error_free(error);
+	remove(png_file);
+}
+BOOST_AUTO_TEST_CASE(cancel)
+{
+	writePng(png_file, buildImage(width * height, 3), 0);
+	ColorHistogram histogram;
+	std::atomic<bool> cancel(true);
+	BOOST_CHECK(!image_loader_add_to_histogram(png_file, 1, histogram, nullptr, nullptr, &cancel, nullptr));
+	BOOST_CHECK(histogram.empty());
+	remove(png_file);
+}
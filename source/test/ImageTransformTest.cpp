@@ -0,0 +1,96 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE image_transform
+#include <boost/test/unit_test.hpp>
+#include "ImageTransform.h"
+#include "transformation/Chain.h"
+#include "transformation/Invert.h"
+#include "TestUtils.h"
+#include <boost/make_shared.hpp>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+using namespace transformation;
+
+BOOST_GLOBAL_FIXTURE(ColorInit);
+
+static vector<uint8_t> make_pixels(size_t size)
+{
+	vector<uint8_t> pixels(size);
+	TestRandom random(7);
+	for (auto &pixel: pixels)
+		pixel = random.next() & 0xff;
+	return pixels;
+}
+BOOST_AUTO_TEST_CASE(tile_count)
+{
+	BOOST_CHECK_EQUAL(image_transform_get_tile_count(0, 10), 0);
+	BOOST_CHECK_EQUAL(image_transform_get_tile_count(image_transform_tile_size, image_transform_tile_size), 1);
+	BOOST_CHECK_EQUAL(image_transform_get_tile_count(image_transform_tile_size + 1, 2 * image_transform_tile_size), 4);
+}
+BOOST_AUTO_TEST_CASE(matches_single_color_chain)
+{
+	Chain chain;
+	chain.add(boost::make_shared<Invert>());
+	// Size is not a multiple of tile size, and stride has padding, so partial tiles and row offsets are covered
+	const int width = 150, height = 70;
+	const size_t stride = width * 4 + 8;
+	vector<uint8_t> input = make_pixels(stride * height), output(stride * height);
+	ImageView input_view{input.data(), width, height, stride, ImagePixelFormat::rgba};
+	ImageView output_view{output.data(), width, height, stride, ImagePixelFormat::rgba};
+	atomic<size_t> processed_tiles(0);
+	BOOST_CHECK(image_transform_apply(chain, input_view, output_view, &processed_tiles, nullptr));
+	BOOST_CHECK_EQUAL(processed_tiles.load(), image_transform_get_tile_count(width, height));
+	size_t mismatches = 0;
+	for (int y = 0; y < height; y++){
+		for (int x = 0; x < width; x++){
+			const uint8_t *source = &input[y * stride + x * 4], *pixel = &output[y * stride + x * 4];
+			Color color, expected;
+			color_set(&color, source[0] / 255.0f, source[1] / 255.0f, source[2] / 255.0f);
+			chain.apply(&color, &expected);
+			for (int i = 0; i < 3; i++){
+				int value = static_cast<int>(expected.ma[i] * 255 + 0.5f);
+				if (abs(value - pixel[i]) > 1) mismatches++;
+			}
+			if (pixel[3] != source[3]) mismatches++;
+		}
+	}
+	BOOST_CHECK_EQUAL(mismatches, 0);
+}
+BOOST_AUTO_TEST_CASE(empty_chain_converts_format)
+{
+	Chain chain;
+	const int width = 67, height = 3;
+	vector<uint8_t> input = make_pixels(width * height * 4), output(width * height * 3);
+	ImageView input_view{input.data(), width, height, size_t(width * 4), ImagePixelFormat::argb32};
+	ImageView output_view{output.data(), width, height, size_t(width * 3), ImagePixelFormat::rgb};
+	BOOST_CHECK(image_transform_apply(chain, input_view, output_view, nullptr, nullptr));
+	for (int i = 0; i < width * height; i++){
+		uint32_t value = *reinterpret_cast<const uint32_t*>(&input[i * 4]);
+		BOOST_CHECK_EQUAL(output[i * 3 + 0], (value >> 16) & 0xff);
+		BOOST_CHECK_EQUAL(output[i * 3 + 1], (value >> 8) & 0xff);
+		BOOST_CHECK_EQUAL(output[i * 3 + 2], value & 0xff);
+	}
+}
+BOOST_AUTO_TEST_CASE(in_place)
+{
+	Chain chain;
+	chain.add(boost::make_shared<Invert>());
+	const int width = 10, height = 10;
+	vector<uint8_t> pixels = make_pixels(width * height * 3), original = pixels;
+	ImageView view{pixels.data(), width, height, size_t(width * 3), ImagePixelFormat::rgb};
+	BOOST_CHECK(image_transform_apply(chain, view, view, nullptr, nullptr));
+	for (size_t i = 0; i < pixels.size(); i++)
+		BOOST_CHECK_LE(abs(pixels[i] - (255 - original[i])), 1);
+}
+BOOST_AUTO_TEST_CASE(cancel)
+{
+	Chain chain;
+	chain.add(boost::make_shared<Invert>());
+	const int width = 200, height = 200;
+	vector<uint8_t> pixels(width * height * 3);
+	ImageView view{pixels.data(), width, height, size_t(width * 3), ImagePixelFormat::rgb};
+	atomic<size_t> processed_tiles(0);
+	atomic<bool> cancel(true);
+	BOOST_CHECK(!image_transform_apply(chain, view, view, &processed_tiles, &cancel));
+	BOOST_CHECK_EQUAL(processed_tiles.load(), 0);
+}
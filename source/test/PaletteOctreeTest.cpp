@@ -0,0 +1,137 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE palette_octree
+#include <boost/test/unit_test.hpp>
+#include <vector>
+#include <cstdint>
+#include "PaletteOctree.h"
+#include "ColorHistogram.h"
+#include "TestUtils.h"
+using namespace std;
+
+BOOST_AUTO_TEST_CASE(single_color)
+{
+	uint8_t pixels[] = {10, 20, 30, 255, 10, 20, 30, 0};
+	PaletteOctree octree;
+	octree.add(pixels, 2, 4);
+	BOOST_CHECK_EQUAL(octree.getPixelCount(), 2);
+	vector<Color> colors;
+	octree.getColors(colors);
+	BOOST_REQUIRE_EQUAL(colors.size(), 1);
+	BOOST_CHECK_CLOSE(colors[0].rgb.red, 10 / 255.0f, 1e-4);
+	BOOST_CHECK_CLOSE(colors[0].rgb.blue, 30 / 255.0f, 1e-4);
+}
+BOOST_AUTO_TEST_CASE(reduce_colors)
+{
+	auto image = buildImage(100000, 3);
+	PaletteOctree octree;
+	octree.add(image.data(), 100000, 3);
+	BOOST_CHECK_EQUAL(octree.getPixelCount(), 100000);
+	for (uint32_t colors: {200, 50, 6, 1}){
+		octree.reduce(colors);
+		BOOST_CHECK_LE(octree.getColorCount(), colors);
+		BOOST_CHECK_EQUAL(octree.getPixelCount(), 100000);
+	}
+}
+BOOST_AUTO_TEST_CASE(copy_on_write)
+{
+	auto image = buildImage(10000, 4);
+	PaletteOctree octree;
+	octree.add(image.data(), 10000, 4);
+	octree.reduce(200);
+	size_t count = octree.getColorCount();
+	PaletteOctree copy = octree;
+	copy.reduce(10);
+	BOOST_CHECK_LE(copy.getColorCount(), 10);
+	BOOST_CHECK_EQUAL(octree.getColorCount(), count);
+}
+BOOST_AUTO_TEST_CASE(add_octree)
+{
+	auto image = buildImage(10000, 3);
+	PaletteOctree octree, first, second;
+	octree.add(image.data(), 10000, 3);
+	second.add(image.data() + 3 * 4000, 6000, 3);
+	first.add(image.data(), 4000, 3);
+	first.add(second);
+	octree.reduce(16);
+	first.reduce(16);
+	vector<Color> expected, colors;
+	octree.getColors(expected);
+	first.getColors(colors);
+	BOOST_REQUIRE_EQUAL(colors.size(), expected.size());
+	for (size_t i = 0; i < colors.size(); i++){
+		for (int j = 0; j < 3; j++)
+			BOOST_CHECK_EQUAL(colors[i].ma[j], expected[i].ma[j]);
+	}
+}
+BOOST_AUTO_TEST_CASE(add_histogram)
+{
+	auto image = buildImage(10000, 4);
+	PaletteOctree expected_octree, octree;
+	expected_octree.add(image.data(), 10000, 4);
+	ColorHistogram histogram;
+	histogram.add(image.data(), 10000, 4);
+	octree.add(histogram);
+	BOOST_CHECK_EQUAL(octree.getPixelCount(), 10000);
+	BOOST_CHECK_EQUAL(octree.getColorCount(), histogram.getColorCount());
+	expected_octree.reduce(40);
+	octree.reduce(40);
+	vector<Color> expected, colors;
+	expected_octree.getColors(expected);
+	octree.getColors(colors);
+	BOOST_REQUIRE_EQUAL(colors.size(), expected.size());
+	for (size_t i = 0; i < colors.size(); i++){
+		for (int j = 0; j < 3; j++)
+			BOOST_CHECK_EQUAL(colors[i].ma[j], expected[i].ma[j]);
+	}
+}
+BOOST_AUTO_TEST_CASE(add_image)
+{
+	const size_t width = 301, height = 257, rowstride = width * 4 + 12;
+	auto image = buildImage(rowstride * height / 4, 4);
+	PaletteOctree expected_octree, octree;
+	for (size_t y = 0; y < height; y++)
+		expected_octree.add(image.data() + rowstride * y, width, 4);
+	ColorHistogram histogram;
+	atomic<size_t> processed_rows(0);
+	BOOST_REQUIRE(histogram.addImage(image.data(), width, height, rowstride, 4, &processed_rows));
+	BOOST_CHECK_EQUAL(processed_rows, height);
+	octree.add(histogram);
+	BOOST_CHECK_EQUAL(octree.getPixelCount(), width * height);
+	expected_octree.reduce(40);
+	octree.reduce(40);
+	vector<Color> expected, colors;
+	expected_octree.getColors(expected);
+	octree.getColors(colors);
+	BOOST_REQUIRE_EQUAL(colors.size(), expected.size());
+	for (size_t i = 0; i < colors.size(); i++){
+		for (int j = 0; j < 3; j++)
+			BOOST_CHECK_EQUAL(colors[i].ma[j], expected[i].ma[j]);
+	}
+	atomic<bool> cancel(true);
+	ColorHistogram cancelled;
+	processed_rows = 0;
+	BOOST_CHECK(!cancelled.addImage(image.data(), width, height, rowstride, 4, &processed_rows, &cancel));
+	BOOST_CHECK_EQUAL(processed_rows, 0);
+	BOOST_CHECK(cancelled.empty());
+}
+BOOST_AUTO_TEST_CASE(reduce_in_steps)
+{
+	// Palette from image used to reduce to 200 colors before reducing to requested color count. Result must not depend on that step.
+	auto image = buildImage(100000, 3);
+	PaletteOctree octree;
+	octree.add(image.data(), 100000, 3);
+	for (uint32_t colors: {1, 8, 32, 100}){
+		PaletteOctree direct = octree, in_steps = octree;
+		direct.reduce(colors);
+		in_steps.reduce(200);
+		in_steps.reduce(colors);
+		vector<Color> expected, result;
+		direct.getColors(expected);
+		in_steps.getColors(result);
+		BOOST_REQUIRE_EQUAL(result.size(), expected.size());
+		for (size_t i = 0; i < result.size(); i++){
+			for (int j = 0; j < 3; j++)
+				BOOST_CHECK_EQUAL(result[i].ma[j], expected[i].ma[j]);
+		}
+	}
+}
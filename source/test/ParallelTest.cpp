@@ -0,0 +1,95 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE parallel
+#include <boost/test/unit_test.hpp>
+#include "Parallel.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+using namespace std;
+
+BOOST_AUTO_TEST_CASE(parallel_for_covers_range)
+{
+	vector<int> counts(1000, 0);
+	parallel_for(counts.size(), 10, [&](size_t begin, size_t end){
+		for (size_t i = begin; i < end; i++)
+			counts[i]++;
+	});
+	for (auto count: counts)
+		BOOST_CHECK_EQUAL(count, 1);
+}
+BOOST_AUTO_TEST_CASE(task_group_wait)
+{
+	TaskGroup group(4);
+	atomic<int> finished(0);
+	for (int i = 0; i < 100; i++){
+		group.run([&]{
+			this_thread::sleep_for(chrono::microseconds(100));
+			finished++;
+		});
+	}
+	group.wait();
+	BOOST_CHECK_EQUAL(finished, 100);
+	group.run([&]{
+		finished++;
+	});
+	group.wait();
+	BOOST_CHECK_EQUAL(finished, 101);
+}
+BOOST_AUTO_TEST_CASE(task_group_thread_limit)
+{
+	mutex lock;
+	set<thread::id> threads;
+	{
+		TaskGroup group(2);
+		for (int i = 0; i < 20; i++){
+			group.run([&]{
+				this_thread::sleep_for(chrono::milliseconds(1));
+				lock_guard<mutex> guard(lock);
+				threads.insert(this_thread::get_id());
+			});
+		}
+	}
+	BOOST_CHECK(threads.size() >= 1);
+	BOOST_CHECK(threads.size() <= 2);
+	BOOST_CHECK(threads.find(this_thread::get_id()) == threads.end());
+}
+BOOST_AUTO_TEST_CASE(task_group_runs_tasks_concurrently)
+{
+	TaskGroup group(2);
+	promise<void> first_started;
+	auto first_started_future = first_started.get_future();
+	promise<void> release;
+	auto release_future = release.get_future().share();
+	group.run([&]{
+		first_started.set_value();
+		release_future.wait();
+	});
+	first_started_future.wait();
+	// Second task must not be blocked by the first one
+	promise<void> second_finished;
+	auto second_finished_future = second_finished.get_future();
+	group.run([&]{
+		second_finished.set_value();
+	});
+	BOOST_CHECK(second_finished_future.wait_for(chrono::seconds(10)) == future_status::ready);
+	release.set_value();
+	group.wait();
+}
+BOOST_AUTO_TEST_CASE(task_group_destructor_waits)
+{
+	atomic<int> finished(0);
+	{
+		TaskGroup group;
+		for (int i = 0; i < 10; i++){
+			group.run([&]{
+				this_thread::sleep_for(chrono::milliseconds(1));
+				finished++;
+			});
+		}
+	}
+	BOOST_CHECK_EQUAL(finished, 10);
+}
@@ -0,0 +1,102 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE pick_stream
+#include <boost/test/unit_test.hpp>
+#include "PickStream.h"
+#include <glib.h>
+#include <map>
+#include <vector>
+using namespace std;
+
+struct Recorder
+{
+	int samples;
+	map<uint32_t, vector<vector<PickSample>>> batches;
+	PickStream stream;
+	Recorder():
+		samples(0),
+		stream([this](const string &converter_name, PickSample &sample){
+			samples++;
+			sample.position = math::Vec2<int>(samples, converter_name.length());
+			color_set(&sample.color, 0.5f);
+			sample.text = converter_name;
+			return true;
+		}, [this](uint32_t stream_id, const vector<PickSample> &samples){
+			batches[stream_id].push_back(samples);
+		})
+	{
+	}
+};
+BOOST_AUTO_TEST_CASE(rate_limit)
+{
+	Recorder recorder;
+	recorder.stream.setLimits(10, 256, 8);
+	uint32_t id = recorder.stream.start("client", "", 1000, 1);
+	int64_t now = g_get_monotonic_time();
+	BOOST_CHECK(id != 0);
+	BOOST_CHECK_EQUAL(recorder.stream.step(now), 100);
+	BOOST_CHECK_EQUAL(recorder.batches[id].size(), 1);
+	BOOST_CHECK_EQUAL(recorder.stream.step(now + 50000), 50);
+	BOOST_CHECK_EQUAL(recorder.batches[id].size(), 1);
+	BOOST_CHECK_EQUAL(recorder.stream.step(now + 100000), 100);
+	BOOST_CHECK_EQUAL(recorder.batches[id].size(), 2);
+	// Missed samples are skipped instead of being taken in a burst.
+	BOOST_CHECK_EQUAL(recorder.stream.step(now + 1000000), 100);
+	BOOST_CHECK_EQUAL(recorder.stream.step(now + 1000000), 100);
+	BOOST_CHECK_EQUAL(recorder.batches[id].size(), 3);
+	BOOST_CHECK_EQUAL(recorder.samples, 3);
+}
+BOOST_AUTO_TEST_CASE(batching)
+{
+	Recorder recorder;
+	uint32_t id = recorder.stream.start("client", "hex", 50, 5);
+	int64_t now = g_get_monotonic_time();
+	for (int i = 0; i < 12; i++)
+		recorder.stream.step(now + i * 20000);
+	auto &batches = recorder.batches[id];
+	BOOST_REQUIRE_EQUAL(batches.size(), 2);
+	for (auto &batch: batches){
+		BOOST_REQUIRE_EQUAL(batch.size(), 5);
+		for (size_t i = 1; i < batch.size(); i++)
+			BOOST_CHECK_EQUAL(batch[i].time - batch[i - 1].time, 20000);
+		BOOST_CHECK_EQUAL(batch[0].text, "hex");
+	}
+	BOOST_CHECK(recorder.stream.stop("client", id));
+	BOOST_REQUIRE_EQUAL(batches.size(), 3);
+	BOOST_CHECK_EQUAL(batches[2].size(), 2);
+	BOOST_CHECK_EQUAL(recorder.stream.getStreamCount(), 0);
+	BOOST_CHECK_EQUAL(recorder.stream.step(now + 1000000), -1);
+}
+BOOST_AUTO_TEST_CASE(shared_samples)
+{
+	Recorder recorder;
+	uint32_t a = recorder.stream.start("a", "hex", 10, 1);
+	uint32_t b = recorder.stream.start("b", "hex", 10, 1);
+	uint32_t c = recorder.stream.start("c", "rgb", 10, 1);
+	int64_t now = g_get_monotonic_time();
+	recorder.stream.step(now);
+	BOOST_CHECK_EQUAL(recorder.samples, 2);
+	BOOST_REQUIRE_EQUAL(recorder.batches[a].size(), 1);
+	BOOST_REQUIRE_EQUAL(recorder.batches[b].size(), 1);
+	BOOST_REQUIRE_EQUAL(recorder.batches[c].size(), 1);
+	BOOST_CHECK_EQUAL(recorder.batches[a][0][0].position.x, recorder.batches[b][0][0].position.x);
+	BOOST_CHECK_EQUAL(recorder.batches[c][0][0].text, "rgb");
+}
+BOOST_AUTO_TEST_CASE(owners)
+{
+	Recorder recorder;
+	recorder.stream.setLimits(60, 16, 2);
+	uint32_t a = recorder.stream.start("a", "", 10, 100);
+	BOOST_CHECK(recorder.stream.start("a", "", 10, 1) != 0);
+	BOOST_CHECK_EQUAL(recorder.stream.start("a", "", 10, 1), 0);
+	uint32_t b = recorder.stream.start("b", "", 10, 1);
+	BOOST_CHECK(b != 0);
+	BOOST_CHECK(!recorder.stream.stop("b", a));
+	BOOST_CHECK(!recorder.stream.stop("a", 12345));
+	recorder.stream.step(g_get_monotonic_time());
+	BOOST_CHECK_EQUAL(recorder.batches[a].size(), 0);
+	BOOST_CHECK_EQUAL(recorder.batches[b].size(), 1);
+	recorder.stream.stopOwner("a");
+	BOOST_CHECK_EQUAL(recorder.batches[a].size(), 0);
+	BOOST_CHECK_EQUAL(recorder.stream.getStreamCount(), 1);
+	BOOST_CHECK_EQUAL(recorder.stream.getStreamCount("b"), 1);
+}
@@ -0,0 +1,127 @@
+/*
+ * Color picker sampling benchmark. Recorded or generated pointer movement is replayed through ScreenReader and Sampler
+ * the same way color picker reads sampler and zoom areas, and per update latency and amount of captured screen data are printed.
+ * Zoom area is rendered at 20x into a magnifier sized for 4K screens.
+ * Usage: picker_benchmark [recording file]
+ */
+#include "ScreenReader.h"
+#include "ReplayScreenSource.h"
+#include "Sampler.h"
+#include "ScaledTile.h"
+#include "Color.h"
+#include "TestUtils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+using namespace math;
+using namespace std;
+
+static void generateRecording(ReplayScreenSource &source)
+{
+	const int width = 1920, height = 1080;
+	TestRandom random(1);
+	Vec2<int> pointer(width / 2, height / 2);
+	for (int frame = 0; frame < 3; frame++){
+		cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+		cairo_surface_flush(surface);
+		unsigned char *data = cairo_image_surface_get_data(surface);
+		int stride = cairo_image_surface_get_stride(surface);
+		for (int y = 0; y < height; y++){
+			uint32_t *row = reinterpret_cast<uint32_t*>(data + y * stride);
+			for (int x = 0; x < width; x++){
+				row[x] = 0xff000000 | ((x / 16 + frame * 40) & 0xff) << 16 | ((y / 16) & 0xff) << 8 | (random.next() & 0x3f);
+			}
+		}
+		cairo_surface_mark_dirty(surface);
+		source.addFrame(surface);
+		cairo_surface_destroy(surface);
+		// Alternate between small pointer movements, jumps and idle periods.
+		for (int i = 0; i < 1000; i++){
+			int mode = random.next() % 100;
+			if (mode < 60){
+				pointer.x += int(random.next() % 9) - 4;
+				pointer.y += int(random.next() % 9) - 4;
+			}else if (mode < 62){
+				pointer.x = random.next() % width;
+				pointer.y = random.next() % height;
+			}
+			pointer.x = std::min(std::max(pointer.x, 0), width - 1);
+			pointer.y = std::min(std::max(pointer.y, 0), height - 1);
+			source.addPointer(pointer);
+		}
+	}
+}
+static void printLatency(const char *name, const vector<double> &times)
+{
+	vector<double> sorted = times;
+	sort(sorted.begin(), sorted.end());
+	double mean = 0;
+	for (auto time: times)
+		mean += time;
+	mean /= times.size();
+	printf("%s [us]: mean %.3f, median %.3f, p99 %.3f, max %.3f\n", name, mean, sorted[sorted.size() / 2], sorted[sorted.size() * 99 / 100], sorted.back());
+}
+int main(int argc, char **argv)
+{
+	color_init();
+	auto source = new ReplayScreenSource();
+	ScreenReader *screen_reader = screen_reader_new(unique_ptr<ScreenSource>(source));
+	Sampler *sampler = sampler_new(screen_reader);
+	sampler_set_oversample(sampler, 2);
+	if (argc > 1){
+		if (!source->load(argv[1])) return 1;
+	}else{
+		generateRecording(*source);
+	}
+	const int zoom_area = 30, zoom_size = 600;
+	vector<uint32_t> zoomed(zoom_size * zoom_size);
+	ScaledTile tile;
+	size_t zoom_pixels = 0;
+	vector<double> times, zoom_times;
+	times.reserve(source->getPointerCount());
+	zoom_times.reserve(source->getPointerCount());
+	double color_sum = 0;
+	auto start = chrono::steady_clock::now();
+	do{
+		auto update_start = chrono::steady_clock::now();
+		Vec2<int> pointer;
+		Rect2<int> screen_rect;
+		if (!screen_reader_get_pointer(screen_reader, pointer, screen_rect)) break;
+		Rect2<int> sampler_rect, final_rect;
+		screen_reader_reset_rect(screen_reader);
+		sampler_get_screen_rect(sampler, pointer, screen_rect, &sampler_rect);
+		screen_reader_add_rect(screen_reader, sampler_rect);
+		Rect2<int> zoomed_rect = screen_rect.positionInside(Rect2<int>(pointer.x - zoom_area / 2, pointer.y - zoom_area / 2, pointer.x + zoom_area - zoom_area / 2, pointer.y + zoom_area - zoom_area / 2));
+		screen_reader_add_rect(screen_reader, zoomed_rect);
+		screen_reader_update_surface(screen_reader, &final_rect);
+		Vec2<int> offset(sampler_rect.getX() - final_rect.getX(), sampler_rect.getY() - final_rect.getY());
+		Color color;
+		sampler_get_color_sample(sampler, pointer, screen_rect, offset, &color);
+		color_sum += color.rgb.red;
+		auto zoom_start = chrono::steady_clock::now();
+		cairo_surface_t *surface = screen_reader_get_surface(screen_reader);
+		int stride = cairo_image_surface_get_stride(surface);
+		const uint8_t *zoom_source = cairo_image_surface_get_data(surface) + (zoomed_rect.getY() - final_rect.getY()) * stride + (zoomed_rect.getX() - final_rect.getX()) * 4;
+		zoom_pixels += tile.update(zoom_source, stride, zoomed_rect.getX(), zoomed_rect.getY(), zoomed_rect.getWidth(), zoomed_rect.getHeight(), reinterpret_cast<uint8_t*>(&zoomed[0]), zoom_size * 4, zoom_size, zoom_size);
+		auto update_end = chrono::steady_clock::now();
+		zoom_times.push_back(chrono::duration<double, micro>(update_end - zoom_start).count());
+		times.push_back(chrono::duration<double, micro>(update_end - update_start).count());
+	}while (source->next());
+	double total_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	ScreenReaderStatistics statistics;
+	screen_reader_get_statistics(screen_reader, &statistics);
+	if (times.empty()) return 1;
+	printf("updates: %zu, frames: %zu\n", times.size(), source->getFrameCount());
+	printLatency("latency", times);
+	printLatency("zoom latency", zoom_times);
+	printf("zoom: %.1f source pixels rendered per update\n", double(zoom_pixels) / times.size());
+	printf("captures: %llu full, %llu partial, %llu skipped\n", (unsigned long long)statistics.captures, (unsigned long long)statistics.partial_captures, (unsigned long long)statistics.skipped);
+	printf("captured: %llu bytes, %.1f bytes per update, %.1f bytes per second\n", (unsigned long long)statistics.bytes_captured, double(statistics.bytes_captured) / times.size(), statistics.bytes_captured / total_time);
+	printf("checksum: %f\n", color_sum);
+	sampler_destroy(sampler);
+	screen_reader_destroy(screen_reader);
+	return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * Palette quantizer benchmark. Each quantizer is run on the same fixed corpus of generated images,
+ * and average runtime and mean color error in Lab color space are printed for each image and palette size.
+ */
+#include "ColorHistogram.h"
+#include "ColorBuffer.h"
+#include "ColorBatch.h"
+#include "quantizer/Factory.h"
+#include "TestUtils.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+using namespace std;
+
+struct Image
+{
+	string name;
+	size_t width, height;
+	vector<uint8_t> pixels;
+	Image(const char *name_, size_t width_, size_t height_):
+		name(name_), width(width_), height(height_), pixels(width_ * height_ * 3)
+	{
+	}
+	void set(size_t x, size_t y, double red, double green, double blue)
+	{
+		uint8_t *pixel = &pixels[(y * width + x) * 3];
+		pixel[0] = uint8_t(std::min(std::max(red, 0.0), 1.0) * 255 + 0.5);
+		pixel[1] = uint8_t(std::min(std::max(green, 0.0), 1.0) * 255 + 0.5);
+		pixel[2] = uint8_t(std::min(std::max(blue, 0.0), 1.0) * 255 + 0.5);
+	}
+};
+static vector<Image> buildCorpus()
+{
+	const size_t size = 512;
+	vector<Image> corpus;
+	TestRandom random(7);
+	Image gradient("gradient", size, size);
+	for (size_t y = 0; y < size; y++){
+		for (size_t x = 0; x < size; x++){
+			Color hsv, rgb;
+			hsv.hsv.hue = double(x) / size;
+			hsv.hsv.saturation = 0.3 + 0.7 * double(y) / size;
+			hsv.hsv.value = 1.0 - 0.6 * double(y) / size;
+			color_hsv_to_rgb(&hsv, &rgb);
+			gradient.set(x, y, rgb.rgb.red, rgb.rgb.green, rgb.rgb.blue);
+		}
+	}
+	corpus.push_back(gradient);
+	Image clusters("clusters", size, size);
+	double centers[12][3];
+	for (auto &center: centers){
+		for (auto &value: center)
+			value = random.nextFloat();
+	}
+	for (size_t y = 0; y < size; y++){
+		for (size_t x = 0; x < size; x++){
+			const double *center = centers[size_t(random.nextFloat() * 11.999)];
+			clusters.set(x, y, center[0] + (random.nextFloat() - 0.5) * 0.15, center[1] + (random.nextFloat() - 0.5) * 0.15, center[2] + (random.nextFloat() - 0.5) * 0.15);
+		}
+	}
+	corpus.push_back(clusters);
+	Image landscape("landscape", size, size);
+	for (size_t y = 0; y < size; y++){
+		for (size_t x = 0; x < size; x++){
+			double u = double(x) / size, v = double(y) / size;
+			double hills = 0.55 + 0.08 * sin(u * 9.0) + 0.05 * sin(u * 23.0 + 1.3);
+			double noise = (random.nextFloat() - 0.5) * 0.06;
+			if (v < hills){
+				// sky getting lighter towards horizon, with sun glow
+				double glow = exp(-((u - 0.7) * (u - 0.7) + (v - 0.25) * (v - 0.25)) * 40);
+				landscape.set(x, y, 0.35 + 0.4 * v + glow * 0.6 + noise, 0.55 + 0.3 * v + glow * 0.4 + noise, 0.9 - 0.1 * v + noise);
+			}else{
+				double shade = 0.5 + 0.5 * sin(u * 40.0 + v * 13.0);
+				landscape.set(x, y, 0.15 + 0.25 * shade * v + noise, 0.3 + 0.3 * shade * (1 - v) + noise, 0.1 + 0.1 * shade + noise);
+			}
+		}
+	}
+	corpus.push_back(landscape);
+	Image noise("noise", size, size);
+	for (size_t y = 0; y < size; y++){
+		for (size_t x = 0; x < size; x++)
+			noise.set(x, y, random.nextFloat(), random.nextFloat(), random.nextFloat());
+	}
+	corpus.push_back(noise);
+	return corpus;
+}
+/** Mean distance in Lab color space from each pixel to the nearest palette color. */
+static double meanError(const ColorBuffer &lab_pixels, const vector<Color> &palette)
+{
+	vector<float> centers;
+	for (auto &color: palette){
+		Color lab;
+		color_rgb_to_lab_d50(&color, &lab);
+		for (int i = 0; i < 3; i++)
+			centers.push_back(lab.ma[i]);
+	}
+	size_t count = lab_pixels.size();
+	vector<uint32_t> index(count);
+	vector<float> distance(count);
+	color_batch_find_nearest(lab_pixels.plane(0), lab_pixels.plane(1), lab_pixels.plane(2), count, &centers[0], palette.size(), &index[0], &distance[0]);
+	double sum = 0;
+	for (size_t i = 0; i < count; i++)
+		sum += sqrt(distance[i]);
+	return sum / count;
+}
+int main(int argc, char **argv)
+{
+	color_init();
+	const int runs = 5;
+	const size_t palette_sizes[] = {8, 32, 100};
+	auto corpus = buildCorpus();
+	auto types = quantizer::Factory::getAllTypes();
+	printf("%-10s %-10s %7s %12s %10s\n", "image", "quantizer", "colors", "time [ms]", "mean dE");
+	vector<double> total_time(types.size() * 3, 0), total_error(types.size() * 3, 0);
+	for (auto &image: corpus){
+		ColorHistogram histogram;
+		auto start = chrono::steady_clock::now();
+		histogram.addImage(image.pixels.data(), image.width, image.height, image.width * 3, 3);
+		double histogram_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+		printf("%-10s %-10s %7zu %12.3f\n", image.name.c_str(), "histogram", histogram.getColorCount(), histogram_time);
+		vector<Color> pixels(image.width * image.height);
+		for (size_t i = 0; i < pixels.size(); i++)
+			color_set(&pixels[i], image.pixels[i * 3], image.pixels[i * 3 + 1], image.pixels[i * 3 + 2]);
+		ColorBuffer lab_pixels(ColorSpace::rgb, pixels);
+		lab_pixels.convert(ColorSpace::lab);
+		for (size_t i = 0; i < types.size(); i++){
+			auto instance = quantizer::Factory::create(types[i].name);
+			for (size_t j = 0; j < 3; j++){
+				vector<Color> palette;
+				start = chrono::steady_clock::now();
+				for (int run = 0; run < runs; run++)
+					instance->quantize(histogram, palette_sizes[j], palette);
+				double time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / runs;
+				double error = meanError(lab_pixels, palette);
+				total_time[i * 3 + j] += time;
+				total_error[i * 3 + j] += error;
+				printf("%-10s %-10s %7zu %12.3f %10.3f\n", image.name.c_str(), types[i].name, palette.size(), time, error);
+			}
+		}
+	}
+	printf("\naverage over %zu images\n", corpus.size());
+	for (size_t i = 0; i < types.size(); i++){
+		for (size_t j = 0; j < 3; j++)
+			printf("%-10s %-10s %7zu %12.3f %10.3f\n", "", types[i].name, palette_sizes[j], total_time[i * 3 + j] / corpus.size(), total_error[i * 3 + j] / corpus.size());
+	}
+	return 0;
+}
@@ -0,0 +1,161 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE quantizer
+#include <boost/test/unit_test.hpp>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include "ColorHistogram.h"
+#include "quantizer/Factory.h"
+#include "TestUtils.h"
+using namespace std;
+
+BOOST_GLOBAL_FIXTURE(ColorInit);
+
+/** Mean distance in Lab color space from each pixel to the nearest palette color. */
+static double meanError(const vector<uint8_t> &image, size_t channels, const vector<Color> &palette)
+{
+	vector<Color> lab_palette(palette.size());
+	for (size_t i = 0; i < palette.size(); i++)
+		color_rgb_to_lab_d50(&palette[i], &lab_palette[i]);
+	double sum = 0;
+	size_t count = image.size() / channels;
+	for (size_t i = 0; i < count; i++){
+		Color color, lab;
+		color_set(&color, image[i * channels], image[i * channels + 1], image[i * channels + 2]);
+		color_rgb_to_lab_d50(&color, &lab);
+		double best = 1e10;
+		for (auto &center: lab_palette){
+			double d = 0;
+			for (int j = 0; j < 3; j++)
+				d += (lab.ma[j] - center.ma[j]) * (lab.ma[j] - center.ma[j]);
+			best = std::min(best, d);
+		}
+		sum += sqrt(best);
+	}
+	return sum / count;
+}
+BOOST_AUTO_TEST_CASE(histogram)
+{
+	uint8_t pixels[] = {10, 20, 30, 255, 11, 21, 31, 0, 200, 0, 0, 0};
+	ColorHistogram histogram;
+	histogram.add(pixels, 3, 4);
+	BOOST_CHECK_EQUAL(histogram.getPixelCount(), 3);
+	BOOST_CHECK_EQUAL(histogram.getColorCount(), 2);
+	uint32_t key = ColorHistogram::getKey(10, 20, 30);
+	BOOST_CHECK_EQUAL(histogram.getBin(key).pixels, 2);
+	BOOST_CHECK_EQUAL(histogram.getBin(key).sum[1], 41);
+	Color color;
+	histogram.getColor(key, color);
+	BOOST_CHECK_CLOSE(color.rgb.red, 10.5f / 255, 1e-4);
+	ColorHistogram copy;
+	copy.add(histogram);
+	copy.add(histogram);
+	BOOST_CHECK_EQUAL(copy.getPixelCount(), 6);
+	BOOST_CHECK_EQUAL(copy.getBin(key).pixels, 4);
+	copy.clear();
+	BOOST_CHECK(copy.empty());
+}
+BOOST_AUTO_TEST_CASE(histogram_linear_color)
+{
+	auto image = buildImage(10000, 3);
+	ColorHistogram histogram;
+	histogram.add(image.data(), 10000, 3);
+	vector<uint32_t> keys;
+	histogram.getKeys(keys);
+	for (auto key: keys){
+		Color color, linear;
+		histogram.getColor(key, color);
+		histogram.getLinearColor(key, linear);
+		for (int i = 0; i < 3; i++){
+			double value = color.ma[i];
+			double expected = value > 0.04045 ? pow((value + 0.055) / 1.055, 2.4) : value / 12.92;
+			BOOST_CHECK_SMALL(linear.ma[i] - expected, 1e-5);
+		}
+	}
+}
+BOOST_AUTO_TEST_CASE(add_image)
+{
+	const size_t width = 301, height = 257, rowstride = width * 4 + 12;
+	auto image = buildImage(rowstride * height / 4, 4);
+	ColorHistogram expected, histogram;
+	for (size_t y = 0; y < height; y++)
+		expected.add(image.data() + rowstride * y, width, 4);
+	atomic<size_t> processed_rows(0);
+	BOOST_REQUIRE(histogram.addImage(image.data(), width, height, rowstride, 4, &processed_rows));
+	BOOST_CHECK_EQUAL(processed_rows, height);
+	BOOST_CHECK_EQUAL(histogram.getPixelCount(), width * height);
+	for (uint32_t key = 0; key < ColorHistogram::bin_count; key++){
+		BOOST_CHECK_EQUAL(histogram.getBin(key).pixels, expected.getBin(key).pixels);
+		BOOST_CHECK_EQUAL(histogram.getBin(key).squares, expected.getBin(key).squares);
+	}
+	atomic<bool> cancel(true);
+	ColorHistogram cancelled;
+	BOOST_CHECK(!cancelled.addImage(image.data(), width, height, rowstride, 4, nullptr, &cancel));
+	BOOST_CHECK(cancelled.empty());
+}
+BOOST_AUTO_TEST_CASE(factory)
+{
+	auto types = quantizer::Factory::getAllTypes();
+	BOOST_REQUIRE_EQUAL(types.size(), 3);
+	for (auto &type: types){
+		auto instance = quantizer::Factory::create(type.name);
+		BOOST_REQUIRE(instance);
+		BOOST_CHECK_EQUAL(instance->getName(), type.name);
+	}
+	BOOST_CHECK(!quantizer::Factory::create("unknown"));
+}
+BOOST_AUTO_TEST_CASE(empty)
+{
+	ColorHistogram histogram;
+	for (auto &type: quantizer::Factory::getAllTypes()){
+		vector<Color> palette(1);
+		quantizer::Factory::create(type.name)->quantize(histogram, 10, palette);
+		BOOST_CHECK(palette.empty());
+	}
+}
+BOOST_AUTO_TEST_CASE(exact_colors)
+{
+	uint8_t pixels[] = {255, 0, 0, 255, 0, 0, 0, 0, 255, 20, 200, 100};
+	ColorHistogram histogram;
+	histogram.add(pixels, 4, 3);
+	for (auto &type: quantizer::Factory::getAllTypes()){
+		BOOST_TEST_MESSAGE(type.name);
+		vector<Color> palette;
+		quantizer::Factory::create(type.name)->quantize(histogram, 5, palette);
+		BOOST_REQUIRE_EQUAL(palette.size(), 3);
+		vector<uint8_t> image(pixels, pixels + sizeof(pixels));
+		BOOST_CHECK_SMALL(meanError(image, 3, palette), 0.01);
+		palette.clear();
+		quantizer::Factory::create(type.name)->quantize(histogram, 1, palette);
+		BOOST_CHECK_EQUAL(palette.size(), 1);
+	}
+}
+BOOST_AUTO_TEST_CASE(clusters)
+{
+	auto image = buildImage(50000, 3);
+	ColorHistogram histogram;
+	histogram.add(image.data(), 50000, 3);
+	double kmeans_error = 0, median_cut_error = 0;
+	for (auto &type: quantizer::Factory::getAllTypes()){
+		auto instance = quantizer::Factory::create(type.name);
+		vector<Color> palette, repeated;
+		instance->quantize(histogram, 16, palette);
+		BOOST_CHECK_LE(palette.size(), 16);
+		BOOST_CHECK_GE(palette.size(), 6);
+		instance->quantize(histogram, 16, repeated);
+		BOOST_REQUIRE_EQUAL(palette.size(), repeated.size());
+		for (size_t i = 0; i < palette.size(); i++){
+			for (int j = 0; j < 3; j++)
+				BOOST_CHECK_EQUAL(palette[i].ma[j], repeated[i].ma[j]);
+		}
+		double error = meanError(image, 3, palette);
+		BOOST_TEST_MESSAGE(type.name << " mean error " << error);
+		BOOST_CHECK_LT(error, 15);
+		if (strcmp(type.name, "kmeans") == 0)
+			kmeans_error = error;
+		else if (strcmp(type.name, "median_cut") == 0)
+			median_cut_error = error;
+	}
+	BOOST_CHECK_LE(kmeans_error, median_cut_error);
+}
@@ -0,0 +1,41 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE refresh_scheduler
+#include <boost/test/unit_test.hpp>
+#include "RefreshScheduler.h"
+using namespace std;
+
+BOOST_AUTO_TEST_CASE(back_off_when_idle)
+{
+	RefreshScheduler scheduler([](){ return false; });
+	scheduler.setRates(50, 5);
+	scheduler.setIdleDelay(100);
+	int64_t now = 0;
+	BOOST_CHECK_EQUAL(scheduler.step(true, now), 20);
+	now += 50000;
+	BOOST_CHECK_EQUAL(scheduler.step(false, now), 20);
+	now += 50000;
+	BOOST_CHECK_EQUAL(scheduler.step(false, now), 40);
+	now += 40000;
+	BOOST_CHECK_EQUAL(scheduler.step(false, now), 80);
+	now += 80000;
+	BOOST_CHECK_EQUAL(scheduler.step(false, now), 160);
+	now += 160000;
+	BOOST_CHECK_EQUAL(scheduler.step(false, now), 200);
+	now += 200000;
+	BOOST_CHECK_EQUAL(scheduler.step(false, now), 200);
+	BOOST_CHECK_CLOSE(scheduler.getStatistics().rate, 5.0, 1e-6);
+	now += 200000;
+	BOOST_CHECK_EQUAL(scheduler.step(true, now), 20);
+	BOOST_CHECK_CLOSE(scheduler.getStatistics().rate, 50.0, 1e-6);
+}
+BOOST_AUTO_TEST_CASE(rates)
+{
+	RefreshScheduler scheduler([](){ return false; });
+	scheduler.setRates(30, 60);
+	scheduler.setIdleDelay(0);
+	BOOST_CHECK_EQUAL(scheduler.step(true, 0), 33);
+	BOOST_CHECK_EQUAL(scheduler.step(false, 1000000), 33);
+	scheduler.setRates(0, 0);
+	BOOST_CHECK_EQUAL(scheduler.step(false, 2000000), 1000);
+	BOOST_CHECK(!scheduler.isRunning());
+}
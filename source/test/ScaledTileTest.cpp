@@ -0,0 +1,98 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE scaled_tile
+#include <boost/test/unit_test.hpp>
+#include "ScaledTile.h"
+#include "ColorBatch.h"
+#include <random>
+#include <vector>
+using namespace std;
+
+struct Screen
+{
+	int width, height;
+	vector<uint32_t> pixels;
+	Screen(int width, int height):
+		width(width),
+		height(height),
+		pixels(width * height)
+	{
+		mt19937 random(1);
+		for (auto &pixel: pixels)
+			pixel = random();
+	}
+	const uint8_t *at(int x, int y) const
+	{
+		return reinterpret_cast<const uint8_t*>(&pixels[y * width + x]);
+	}
+};
+static bool matches(const Screen &screen, int left, int top, int area_width, int area_height, const ScaledTile &tile, const vector<uint32_t> &output, int width, int height)
+{
+	int origin_x, origin_y;
+	tile.getOrigin(origin_x, origin_y);
+	for (int y = 0; y < height; y++){
+		int source_y = int((y + 0.5) * area_height / height);
+		for (int x = 0; x < width; x++){
+			int source_x = int((x + 0.5) * area_width / width);
+			if (output[((y + origin_y) % height) * width + (x + origin_x) % width] != screen.pixels[(top + source_y) * screen.width + left + source_x])
+				return false;
+		}
+	}
+	return true;
+}
+static void checkMoves(int area_width, int area_height, int width, int height)
+{
+	Screen screen(200, 150);
+	vector<uint32_t> output(width * height);
+	uint8_t *data = reinterpret_cast<uint8_t*>(&output[0]);
+	mt19937 random(2);
+	for (int kernel = COLOR_BATCH_KERNEL_SCALAR; kernel <= COLOR_BATCH_KERNEL_AVX2; kernel++){
+		if (!color_batch_is_kernel_supported(ColorBatchKernel(kernel))) continue;
+		BOOST_TEST_MESSAGE("kernel " << color_batch_get_kernel_name(ColorBatchKernel(kernel)));
+		color_batch_set_kernel(ColorBatchKernel(kernel));
+		ScaledTile tile;
+		int left = 50, top = 50, mismatches = 0;
+		for (int i = 0; i < 300; i++){
+			if (random() % 4 == 0){
+				screen.pixels[(top + random() % area_height) * screen.width + left + random() % area_width] = random();
+			}else{
+				left = max(0, min(screen.width - area_width, left + int(random() % 5) - 2));
+				top = max(0, min(screen.height - area_height, top + int(random() % 5) - 2));
+			}
+			tile.update(screen.at(left, top), screen.width * 4, left, top, area_width, area_height, data, width * 4, width, height);
+			if (!matches(screen, left, top, area_width, area_height, tile, output, width, height))
+				mismatches++;
+		}
+		BOOST_CHECK_EQUAL(mismatches, 0);
+	}
+	color_batch_set_kernel(COLOR_BATCH_KERNEL_AVX2);
+}
+BOOST_AUTO_TEST_CASE(integer_factor)
+{
+	checkMoves(15, 10, 150, 100);
+	checkMoves(7, 7, 147, 147);
+}
+BOOST_AUTO_TEST_CASE(non_integer_factor)
+{
+	checkMoves(13, 11, 150, 100);
+	checkMoves(40, 30, 150, 100);
+}
+BOOST_AUTO_TEST_CASE(renders_only_exposed_pixels)
+{
+	Screen screen(100, 100);
+	vector<uint32_t> output(200 * 200);
+	uint8_t *data = reinterpret_cast<uint8_t*>(&output[0]);
+	ScaledTile tile;
+	BOOST_CHECK_EQUAL(tile.update(screen.at(10, 10), 400, 10, 10, 20, 20, data, 800, 200, 200), 400);
+	BOOST_CHECK_EQUAL(tile.update(screen.at(10, 10), 400, 10, 10, 20, 20, data, 800, 200, 200), 0);
+	BOOST_CHECK_EQUAL(tile.update(screen.at(11, 10), 400, 11, 10, 20, 20, data, 800, 200, 200), 20);
+	BOOST_CHECK_EQUAL(tile.update(screen.at(11, 12), 400, 11, 12, 20, 20, data, 800, 200, 200), 40);
+	int origin_x, origin_y;
+	tile.getOrigin(origin_x, origin_y);
+	BOOST_CHECK_EQUAL(origin_x, 10);
+	BOOST_CHECK_EQUAL(origin_y, 20);
+	screen.pixels[15 * 100 + 15] ^= 1;
+	BOOST_CHECK_EQUAL(tile.update(screen.at(11, 12), 400, 11, 12, 20, 20, data, 800, 200, 200), 1);
+	BOOST_CHECK(matches(screen, 11, 12, 20, 20, tile, output, 200, 200));
+	tile.invalidate();
+	BOOST_CHECK_EQUAL(tile.update(screen.at(11, 12), 400, 11, 12, 20, 20, data, 800, 200, 200), 400);
+}
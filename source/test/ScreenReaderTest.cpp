@@ -0,0 +1,171 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE screen_reader
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <cstdint>
+#include "ScreenReader.h"
+#include "ReplayScreenSource.h"
+#include "Sampler.h"
+#include "Color.h"
+#include "TestUtils.h"
+using namespace math;
+using namespace std;
+
+static uint32_t pixelValue(int x, int y, int frame)
+{
+	return 0xff000000 | (((x * 3 + frame * 50) & 0xff) << 16) | (((y * 5) & 0xff) << 8) | (((x + y) * 7) & 0xff);
+}
+static cairo_surface_t *buildFrame(int width, int height, int frame)
+{
+	cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+	cairo_surface_flush(surface);
+	unsigned char *data = cairo_image_surface_get_data(surface);
+	int stride = cairo_image_surface_get_stride(surface);
+	for (int y = 0; y < height; y++){
+		uint32_t *row = reinterpret_cast<uint32_t*>(data + y * stride);
+		for (int x = 0; x < width; x++)
+			row[x] = pixelValue(x, y, frame);
+	}
+	cairo_surface_mark_dirty(surface);
+	return surface;
+}
+struct Replay
+{
+	ReplayScreenSource *source;
+	ScreenReader *screen_reader;
+	Sampler *sampler;
+	Replay()
+	{
+		source = new ReplayScreenSource();
+		screen_reader = screen_reader_new(unique_ptr<ScreenSource>(source));
+		sampler = sampler_new(screen_reader);
+	}
+	~Replay()
+	{
+		sampler_destroy(sampler);
+		screen_reader_destroy(screen_reader);
+	}
+	void addFrame(int width, int height, int frame)
+	{
+		cairo_surface_t *surface = buildFrame(width, height, frame);
+		source->addFrame(surface);
+		cairo_surface_destroy(surface);
+	}
+	/** Read sampler and zoom areas around current pointer position and check read pixels against expected frame. */
+	bool check(int frame, int zoom_size, Color &color)
+	{
+		Vec2<int> pointer;
+		Rect2<int> screen_rect;
+		if (!screen_reader_get_pointer(screen_reader, pointer, screen_rect)) return false;
+		Rect2<int> sampler_rect, final_rect;
+		screen_reader_reset_rect(screen_reader);
+		sampler_get_screen_rect(sampler, pointer, screen_rect, &sampler_rect);
+		screen_reader_add_rect(screen_reader, sampler_rect);
+		Rect2<int> zoomed_rect = screen_rect.positionInside(Rect2<int>(pointer.x - zoom_size / 2, pointer.y - zoom_size / 2, pointer.x + zoom_size - zoom_size / 2, pointer.y + zoom_size - zoom_size / 2));
+		screen_reader_add_rect(screen_reader, zoomed_rect);
+		screen_reader_update_surface(screen_reader, &final_rect);
+		Vec2<int> offset(sampler_rect.getX() - final_rect.getX(), sampler_rect.getY() - final_rect.getY());
+		sampler_get_color_sample(sampler, pointer, screen_rect, offset, &color);
+		cairo_surface_t *surface = screen_reader_get_surface(screen_reader);
+		cairo_surface_flush(surface);
+		unsigned char *data = cairo_image_surface_get_data(surface);
+		int stride = cairo_image_surface_get_stride(surface);
+		for (int y = final_rect.getTop(); y < final_rect.getBottom(); y++){
+			const uint32_t *row = reinterpret_cast<const uint32_t*>(data + (y - final_rect.getY()) * stride);
+			for (int x = final_rect.getLeft(); x < final_rect.getRight(); x++){
+				if (row[x - final_rect.getX()] != pixelValue(x, y, frame))
+					return false;
+			}
+		}
+		return true;
+	}
+};
+BOOST_AUTO_TEST_CASE(replay_pointer_path)
+{
+	Replay replay;
+	replay.addFrame(200, 150, 0);
+	TestRandom random(7);
+	Vec2<int> pointer(100, 75);
+	for (int i = 0; i < 200; i++){
+		pointer.x = std::min(std::max(pointer.x + int(random.next() % 21) - 10, 0), 199);
+		pointer.y = std::min(std::max(pointer.y + int(random.next() % 21) - 10, 0), 149);
+		replay.source->addPointer(pointer);
+	}
+	int index = 0;
+	do{
+		Color color;
+		BOOST_REQUIRE(replay.check(0, 40, color));
+		Vec2<int> position;
+		Rect2<int> screen_rect;
+		screen_reader_get_pointer(replay.screen_reader, position, screen_rect);
+		uint32_t expected = pixelValue(position.x, position.y, 0);
+		BOOST_CHECK_SMALL(color.rgb.red - ((expected >> 16) & 0xff) / 255.0f, 1e-5f);
+		BOOST_CHECK_SMALL(color.rgb.green - ((expected >> 8) & 0xff) / 255.0f, 1e-5f);
+		BOOST_CHECK_SMALL(color.rgb.blue - (expected & 0xff) / 255.0f, 1e-5f);
+		index++;
+	}while (replay.source->next());
+	BOOST_CHECK_EQUAL(index, 200);
+	ScreenReaderStatistics statistics;
+	screen_reader_get_statistics(replay.screen_reader, &statistics);
+	BOOST_CHECK_EQUAL(statistics.captures + statistics.partial_captures + statistics.skipped, 200);
+	BOOST_CHECK_GT(statistics.partial_captures, 0);
+}
+BOOST_AUTO_TEST_CASE(skip_unchanged)
+{
+	Replay replay;
+	replay.addFrame(100, 100, 0);
+	replay.source->addPointer(Vec2<int>(50, 50));
+	replay.source->addPointer(Vec2<int>(50, 50));
+	replay.addFrame(100, 100, 1);
+	replay.source->addPointer(Vec2<int>(50, 50));
+	Color color;
+	ScreenReaderStatistics statistics;
+	BOOST_CHECK(replay.check(0, 20, color));
+	replay.source->next();
+	BOOST_CHECK(replay.check(0, 20, color));
+	screen_reader_get_statistics(replay.screen_reader, &statistics);
+	BOOST_CHECK_EQUAL(statistics.captures, 1);
+	BOOST_CHECK_EQUAL(statistics.skipped, 1);
+	BOOST_CHECK_EQUAL(statistics.bytes_captured, 20 * 20 * 4);
+	replay.source->next();
+	BOOST_CHECK(replay.check(1, 20, color));
+	screen_reader_invalidate(replay.screen_reader);
+	BOOST_CHECK(replay.check(1, 20, color));
+	screen_reader_get_statistics(replay.screen_reader, &statistics);
+	BOOST_CHECK_EQUAL(statistics.captures, 3);
+	BOOST_CHECK_EQUAL(statistics.skipped, 1);
+	BOOST_CHECK(!replay.source->next());
+}
+BOOST_AUTO_TEST_CASE(load_recording)
+{
+	auto path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+	boost::filesystem::create_directories(path);
+	for (int frame = 0; frame < 2; frame++){
+		cairo_surface_t *surface = buildFrame(64, 48, frame);
+		BOOST_REQUIRE_EQUAL(cairo_surface_write_to_png(surface, (path / ("frame" + to_string(frame) + ".png")).string().c_str()), CAIRO_STATUS_SUCCESS);
+		cairo_surface_destroy(surface);
+	}
+	{
+		ofstream recording((path / "recording.txt").string());
+		recording << "# test recording\nframe frame0.png\npointer 10 10\npointer 12 11\n\nframe frame1.png\npointer 63 47\n";
+	}
+	Replay replay;
+	BOOST_CHECK(replay.source->load((path / "recording.txt").string().c_str()));
+	BOOST_CHECK_EQUAL(replay.source->getFrameCount(), 2);
+	BOOST_CHECK_EQUAL(replay.source->getPointerCount(), 3);
+	Color color;
+	BOOST_CHECK(replay.check(0, 16, color));
+	BOOST_CHECK(replay.source->next());
+	BOOST_CHECK(replay.check(0, 16, color));
+	BOOST_CHECK(replay.source->next());
+	BOOST_CHECK(replay.check(1, 16, color));
+	BOOST_CHECK(!replay.source->next());
+	{
+		ofstream recording((path / "invalid.txt").string());
+		recording << "pointer 1 1\n";
+	}
+	ReplayScreenSource invalid;
+	BOOST_CHECK(!invalid.load((path / "invalid.txt").string().c_str()));
+	boost::filesystem::remove_all(path);
+}
@@ -0,0 +1,162 @@
+/*
+ * Startup loading benchmark. Generated settings file, color names file and palette file are loaded
+ * one after another and then in parallel on a TaskGroup, the same way GlobalState loads them at startup,
+ * and average wall-clock time of both variants is printed.
+ * Lua initialization is not included, as it needs installed data files.
+ */
+#include "Parallel.h"
+#include "ColorList.h"
+#include "ColorObject.h"
+#include "FileFormat.h"
+#include "DynvHelpers.h"
+#include "Color.h"
+#include "color_names/ColorNames.h"
+#include "dynv/DynvSystem.h"
+#include "dynv/DynvXml.h"
+#include "TestUtils.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+using namespace std;
+
+static const char *settings_filename = "startup_benchmark_settings.xml";
+static const char *color_names_filename = "startup_benchmark_colors.txt";
+static const char *color_names_cache_filename = "startup_benchmark_colors.cache";
+static const char *palette_filename = "startup_benchmark_palette.gpa";
+
+static void writeFiles()
+{
+	TestRandom random(3);
+	struct dynvHandlerMap* handler_map = dynv_create_default_handler_map();
+	dynvSystem *settings = dynv_system_create(handler_map);
+	for (int i = 0; i < 5000; i++){
+		string path = "gpick.section" + to_string(i / 50) + ".value" + to_string(i % 50);
+		switch (i % 4){
+			case 0:
+				dynv_set_int32(settings, path.c_str(), random.next());
+				break;
+			case 1:
+				dynv_set_float(settings, path.c_str(), random.nextFloat());
+				break;
+			case 2:
+				dynv_set_string(settings, path.c_str(), ("string value " + to_string(random.next())).c_str());
+				break;
+			default:{
+				Color color;
+				color_set(&color, random.nextFloat(), random.nextFloat(), random.nextFloat());
+				dynv_set_color(settings, path.c_str(), &color);
+			}
+		}
+	}
+	ofstream settings_file(settings_filename);
+	dynv_xml_serialize(settings, settings_file);
+	settings_file.close();
+	dynv_system_release(settings);
+	ofstream color_names_file(color_names_filename);
+	for (int i = 0; i < 30000; i++)
+		color_names_file << (random.next() & 0xff) << " " << (random.next() & 0xff) << " " << (random.next() & 0xff) << " color " << i << "\n";
+	color_names_file.close();
+	ColorList *color_list = color_list_new(handler_map);
+	for (int i = 0; i < 20000; i++){
+		Color color;
+		color_set(&color, random.nextFloat(), random.nextFloat(), random.nextFloat());
+		ColorObject *color_object = color_list_new_color_object(color_list, &color);
+		color_object->setName("palette color " + to_string(i));
+		color_object->setPosition(i);
+		color_list_add_color_object(color_list, color_object, true);
+		color_object->release();
+	}
+	palette_file_save(palette_filename, color_list);
+	color_list_destroy(color_list);
+	dynv_handler_map_release(handler_map);
+}
+static void removeFiles()
+{
+	remove(settings_filename);
+	remove(color_names_filename);
+	remove(color_names_cache_filename);
+	remove(palette_filename);
+}
+struct Loaded
+{
+	dynvSystem *settings;
+	ColorNames *color_names;
+	ColorList *palette;
+	void release()
+	{
+		dynv_system_release(settings);
+		color_names_destroy(color_names);
+		color_list_destroy(palette);
+	}
+};
+static dynvSystem *loadSettings()
+{
+	struct dynvHandlerMap* handler_map = dynv_create_default_handler_map();
+	dynvSystem *settings = dynv_system_create(handler_map);
+	dynv_handler_map_release(handler_map);
+	ifstream settings_file(settings_filename);
+	dynv_xml_deserialize(settings, settings_file);
+	return settings;
+}
+static ColorNames *loadColorNames()
+{
+	ColorNames *color_names = color_names_new();
+	color_names_load(color_names, color_names_filename, color_names_cache_filename);
+	return color_names;
+}
+static ColorList *loadPalette()
+{
+	struct dynvHandlerMap* handler_map = dynv_create_default_handler_map();
+	ColorList *color_list = color_list_new(handler_map);
+	dynv_handler_map_release(handler_map);
+	palette_file_load(palette_filename, color_list);
+	return color_list;
+}
+static double sequential(Loaded &loaded)
+{
+	auto start = chrono::steady_clock::now();
+	loaded.settings = loadSettings();
+	loaded.color_names = loadColorNames();
+	loaded.palette = loadPalette();
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+static double parallel(Loaded &loaded)
+{
+	auto start = chrono::steady_clock::now();
+	{
+		TaskGroup group(4);
+		group.run([&]{ loaded.settings = loadSettings(); });
+		group.run([&]{ loaded.color_names = loadColorNames(); });
+		group.run([&]{ loaded.palette = loadPalette(); });
+		group.wait();
+	}
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+int main(int argc, char **argv)
+{
+	color_init();
+	writeFiles();
+	const int runs = 10;
+	Loaded loaded;
+	// First load creates color names cache, as first start of the program does
+	sequential(loaded);
+	loaded.release();
+	double sequential_time = 0, parallel_time = 0;
+	for (int run = 0; run < runs; run++){
+		sequential_time += sequential(loaded);
+		if (run == 0)
+			printf("loaded %zu settings bytes, %zu color names, %zu colors\n", size_t(ifstream(settings_filename, ios::ate).tellg()), color_names_get_entry_count(loaded.color_names), loaded.palette->colors.size());
+		loaded.release();
+		parallel_time += parallel(loaded);
+		loaded.release();
+	}
+	removeFiles();
+	printf("%zu hardware threads\n", parallel_get_thread_count());
+	printf("%-12s %12s\n", "loading", "time [ms]");
+	printf("%-12s %12.3f\n", "sequential", sequential_time / runs);
+	printf("%-12s %12.3f\n", "parallel", parallel_time / runs);
+	printf("%-12s %11.1f%%\n", "improvement", 100.0 * (sequential_time - parallel_time) / sequential_time);
+	return 0;
+}
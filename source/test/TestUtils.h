@@ -0,0 +1,66 @@
+#ifndef GPICK_TEST_TEST_UTILS_H_
+#define GPICK_TEST_TEST_UTILS_H_
+
+#include "Color.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** \file source/test/TestUtils.h
+ * \brief Fixtures and data generators shared by tests and benchmarks.
+ */
+
+/** Global fixture which initializes color conversion functions. */
+struct ColorInit
+{
+	ColorInit()
+	{
+		color_init();
+	}
+};
+
+/** \class TestRandom
+ * \brief Linear congruential generator, so that generated data is the same on every platform and standard library.
+ */
+class TestRandom
+{
+	public:
+		TestRandom(uint32_t seed):
+			m_state(seed)
+		{
+		}
+		/** Get next 16-bit value. */
+		uint32_t next()
+		{
+			m_state = m_state * 1103515245 + 12345;
+			return m_state >> 16;
+		}
+		/** Get next value in [0, 1] range with 16-bit resolution. */
+		float nextFloat()
+		{
+			m_state = m_state * 1103515245 + 12345;
+			return ((m_state >> 8) & 0xffff) / 65535.0f;
+		}
+	private:
+		uint32_t m_state;
+};
+
+/**
+ * Build image of pixels grouped around six colors.
+ * @param[in] pixels Number of pixels.
+ * @param[in] channels Number of bytes in each pixel. Every channel, including alpha, gets a value.
+ * @return Pixel bytes.
+ */
+inline std::vector<uint8_t> buildImage(size_t pixels, size_t channels)
+{
+	std::vector<uint8_t> image(pixels * channels);
+	TestRandom random(5);
+	for (size_t i = 0; i < image.size(); i += channels){
+		int cluster = random.next() % 6;
+		for (size_t j = 0; j < channels; j++)
+			image[i + j] = uint8_t((cluster * 40 + j * 70) % 256 + random.next() % 40);
+	}
+	return image;
+}
+
+#endif /* GPICK_TEST_TEST_UTILS_H_ */
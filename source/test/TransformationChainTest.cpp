@@ -0,0 +1,149 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE transformation_chain
+#include <boost/test/unit_test.hpp>
+#include "transformation/Chain.h"
+#include "transformation/Invert.h"
+#include "TestUtils.h"
+#include <boost/make_shared.hpp>
+#include <cmath>
+#include <vector>
+using namespace std;
+using namespace transformation;
+
+BOOST_GLOBAL_FIXTURE(ColorInit);
+
+class Square: public Transformation
+{
+	public:
+		float exponent;
+		Square(): Transformation("square", "Square"), exponent(2) {}
+	protected:
+		virtual void apply(Color *input, Color *output)
+		{
+			for (int i = 0; i < 3; i++)
+				output->ma[i] = pow(input->ma[i], exponent);
+		}
+};
+class Step: public Transformation
+{
+	public:
+		Step(): Transformation("step", "Step") {}
+	protected:
+		virtual void apply(Color *input, Color *output)
+		{
+			for (int i = 0; i < 3; i++)
+				output->ma[i] = input->ma[i] < 0.51f ? 0.0f : 1.0f;
+		}
+};
+static void checkChain(Chain &chain, float tolerance)
+{
+	for (int i = 0; i <= 10; i++){
+		Color input, output, exact;
+		color_set(&input, i / 10.0f, 0.37f, (10 - i) / 13.0f);
+		chain.apply(&input, &output);
+		chain.applyExact(&input, &exact);
+		for (int j = 0; j < 3; j++)
+			BOOST_CHECK_SMALL(output.ma[j] - exact.ma[j], tolerance);
+	}
+}
+BOOST_AUTO_TEST_CASE(smooth_chain_is_compiled)
+{
+	Chain chain;
+	chain.add(boost::make_shared<Invert>());
+	chain.add(boost::make_shared<Square>());
+	BOOST_CHECK(chain.isCompiled());
+	checkChain(chain, Chain::lut_error_bound);
+	Color input, output;
+	color_set(&input, 0.25f, 0.5f, 1.0f);
+	chain.apply(&input, &output);
+	BOOST_CHECK_CLOSE(output.rgb.red, 0.5625f, 0.5);
+	BOOST_CHECK_SMALL(output.rgb.blue, 1e-4f);
+}
+BOOST_AUTO_TEST_CASE(discontinuous_chain_is_exact)
+{
+	Chain chain;
+	chain.add(boost::make_shared<Square>());
+	chain.add(boost::make_shared<Step>());
+	BOOST_CHECK(!chain.isCompiled());
+	checkChain(chain, 0);
+}
+BOOST_AUTO_TEST_CASE(invalidate)
+{
+	Chain chain;
+	auto square = boost::make_shared<Square>();
+	chain.add(square);
+	BOOST_CHECK(chain.isCompiled());
+	square->exponent = 3;
+	chain.invalidate();
+	Color input, output;
+	color_set(&input, 0.5f, 0.5f, 0.5f);
+	chain.apply(&input, &output);
+	BOOST_CHECK_CLOSE(output.rgb.red, 0.125f, 0.5);
+	chain.remove(square.get());
+	BOOST_CHECK(!chain.isCompiled());
+	chain.apply(&input, &output);
+	BOOST_CHECK_CLOSE(output.rgb.red, 0.5f, 1e-4);
+}
+BOOST_AUTO_TEST_CASE(color_array)
+{
+	Chain chain;
+	chain.add(boost::make_shared<Invert>());
+	chain.add(boost::make_shared<Square>());
+	chain.add(boost::make_shared<Step>());
+	vector<Color> input(100), output(100);
+	for (size_t i = 0; i < input.size(); i++){
+		color_set(&input[i], i / 99.0f, 1 - i / 99.0f, 0.5f);
+		input[i].ma[3] = 0.25f;
+	}
+	chain.apply(input.data(), output.data(), input.size());
+	for (size_t i = 0; i < input.size(); i++){
+		Color expected;
+		chain.applyExact(&input[i], &expected);
+		for (int j = 0; j < 3; j++)
+			BOOST_CHECK_EQUAL(output[i].ma[j], expected.ma[j]);
+		BOOST_CHECK_EQUAL(output[i].ma[3], 0.25f);
+	}
+	chain.apply(input.data(), input.data(), input.size());
+	for (size_t i = 0; i < input.size(); i++){
+		for (int j = 0; j < 4; j++)
+			BOOST_CHECK_EQUAL(input[i].ma[j], output[i].ma[j]);
+	}
+}
+BOOST_AUTO_TEST_CASE(non_finite_colors_are_exact)
+{
+	Chain chain;
+	chain.add(boost::make_shared<Invert>());
+	chain.add(boost::make_shared<Square>());
+	BOOST_REQUIRE(chain.isCompiled());
+	vector<Color> input(3), output(3);
+	color_set(&input[0], NAN, 0.5f, 0.5f);
+	color_set(&input[1], 0.5f, INFINITY, 0.5f);
+	color_set(&input[2], 0.5f, 0.5f, -INFINITY);
+	chain.apply(input.data(), output.data(), input.size());
+	for (size_t i = 0; i < input.size(); i++){
+		Color single, expected;
+		chain.apply(&input[i], &single);
+		chain.applyExact(&input[i], &expected);
+		for (int j = 0; j < 3; j++){
+			BOOST_CHECK_EQUAL(std::isnan(output[i].ma[j]), std::isnan(expected.ma[j]));
+			BOOST_CHECK_EQUAL(std::isnan(single.ma[j]), std::isnan(expected.ma[j]));
+			if (!std::isnan(expected.ma[j])){
+				BOOST_CHECK_EQUAL(output[i].ma[j], expected.ma[j]);
+				BOOST_CHECK_EQUAL(single.ma[j], expected.ma[j]);
+			}
+		}
+	}
+}
+BOOST_AUTO_TEST_CASE(disabled)
+{
+	Chain chain;
+	chain.add(boost::make_shared<Invert>());
+	BOOST_CHECK(chain.isEnabled());
+	chain.setEnabled(false);
+	BOOST_CHECK(!chain.isEnabled());
+	BOOST_CHECK(!chain.isCompiled());
+	Color input, output;
+	color_set(&input, 0.25f, 0.5f, 1.0f);
+	chain.apply(&input, &output);
+	BOOST_CHECK_EQUAL(output.rgb.red, 0.25f);
+}
@@ -19,6 +19,7 @@
 #include "ColorSpaceSampler.h"
 #include "../ColorList.h"
 #include "../ColorObject.h"
+#include "../ColorBatch.h"
 #include "../GlobalState.h"
 #include "../Internationalisation.h"
 #include "../DynvHelpers.h"
@@ -65,10 +66,6 @@ class ColorSpaceSamplerNameAssigner: public ToolColorNameAssigner
 			ToolColorNameAssigner(gs)
 		{
 		}
-		void assign(ColorObject *color_object, const Color *color)
-		{
-			ToolColorNameAssigner::assign(color_object, color);
-		}
 		virtual std::string getToolSpecificName(ColorObject *color_object, const Color *color)
 		{
 			m_stream.str("");
@@ -108,42 +105,42 @@ static void calc(ColorSpaceSamplerArgs *args, bool preview, size_t limit)
 			}
 		}
 	}
-	Color t;
+	if (value_count == 0) return;
+	switch (args->color_space){
+		case 0:
+			break;
+		case 1:
+			color_batch_hsv_to_rgb(&values[0], &values[0], value_count);
+			break;
+		case 2:
+			color_batch_hsl_to_rgb(&values[0], &values[0], value_count);
+			break;
+		case 3:
+			for (size_t i = 0; i < value_count; i++){
+				values[i].lab.L *= 100;
+				values[i].lab.a = (values[i].lab.a - 0.5) * 290;
+				values[i].lab.b = (values[i].lab.b - 0.5) * 290;
+			}
+			color_batch_lab_to_rgb_d50(&values[0], &values[0], value_count);
+			break;
+		case 4:
+			for (size_t i = 0; i < value_count; i++){
+				values[i].lch.L *= 100;
+				values[i].lch.C *= 136;
+				values[i].lch.h *= 360;
+			}
+			color_batch_lch_to_rgb_d50(&values[0], &values[0], value_count);
+			break;
+	}
+	if (args->linearization)
+		color_batch_linear_get_rgb(&values[0], &values[0], value_count);
+	vector<ColorObject*> color_objects(value_count);
 	for (size_t i = 0; i < value_count; i++){
-		if (preview){
-			if (limit <= 0) return;
-			limit--;
-		}
-		switch (args->color_space){
-			case 0:
-				color_copy(&values[i], &t);
-				break;
-			case 1:
-				color_hsv_to_rgb(&values[i], &t);
-				break;
-			case 2:
-				color_hsl_to_rgb(&values[i], &t);
-				break;
-			case 3:
-				color_copy(&values[i], &t);
-				t.lab.L *= 100;
-				t.lab.a = (t.lab.a - 0.5) * 290;
-				t.lab.b = (t.lab.b - 0.5) * 290;
-				color_lab_to_rgb_d50(&t, &t);
-				break;
-			case 4:
-				color_copy(&values[i], &t);
-				t.lch.L *= 100;
-				t.lch.C *= 136;
-				t.lch.h *= 360;
-				color_lch_to_rgb_d50(&t, &t);
-				break;
-		}
-		if (args->linearization)
-			color_linear_get_rgb(&t, &t);
-		color_rgb_normalize(&t);
-		ColorObject *color_object = color_list_new_color_object(color_list, &t);
-		name_assigner.assign(color_object, &t);
+		color_rgb_normalize(&values[i]);
+		color_objects[i] = color_list_new_color_object(color_list, &values[i]);
+	}
+	name_assigner.assignMultiple(color_objects.data(), values.data(), value_count);
+	for (auto color_object: color_objects){
 		color_list_add_color_object(color_list, color_object, 1);
 		color_object->release();
 	}
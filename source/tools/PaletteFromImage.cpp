@@ -25,52 +25,56 @@
 #include "../ToolColorNaming.h"
 #include "../DynvHelpers.h"
 #include "../Internationalisation.h"
+#include "../ColorHistogram.h"
+#include "../quantizer/Factory.h"
+#include "../ImageLoader.h"
 #include <string.h>
 #include <iostream>
 #include <sstream>
 #include <stack>
 #include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
 using namespace std;
 
 /** \file PaletteFromImage.cpp
  * \brief
  */
 
-/** \struct Node
- * \brief Node is a cube in space with color information
- *
- * Each node can b
- */
-typedef struct Node{
-	uint32_t n_pixels; /**< Number of colors in current Node and its children */
-	uint32_t n_pixels_in; /**< Number of colors in current Node */
-	float color[3]; /**< Sum of color values */
-	float distance; /**< Squared distances from Node center of colors in Node */
-	Node *child[8]; /**< Pointers to child Nodes */
-	Node *parent; /**< Pointer to parent Node */
-}Node;
-
-/** \struct Cube
- * \brief Cube structure holds all information necessary to define cube size and position in space
+/** \struct PaletteFromImageJob
+ * \brief Image decoding and histogram building running in a background thread
  */
-typedef struct Cube{
-	float x; /**< X position */
-	float w; /**< Width */
-	float y; /**< Y position */
-	float h; /**< Height */
-	float z; /**< Z position */
-	float d; /**< Depth */
-}Cube;
+typedef struct PaletteFromImageJob{
+	string filename;
+	size_t sampling_step;
+	thread worker;
+	atomic<size_t> processed_rows;
+	atomic<size_t> total_rows; /**< Zero while image is being decoded */
+	atomic<bool> cancel;
+	atomic<bool> finished;
+	ColorHistogram *histogram; /**< Result, null if image could not be processed */
+}PaletteFromImageJob;
 
 typedef struct PaletteFromImageArgs{
 	GtkWidget *file_browser;
 	GtkWidget *range_colors;
+	GtkWidget *range_sampling_step;
+	GtkWidget *quantizer_type;
 	GtkWidget *merge_threshold;
 	GtkWidget *preview_expander;
+	GtkWidget *progress_bar;
+	GtkWidget *cancel_button;
+	PaletteFromImageJob *job;
+	guint job_timeout;
+	bool apply_when_ready;
 	string filename;
 	uint32_t n_colors;
+	size_t sampling_step;
+	string quantizer;
 	string previous_filename;
-	Node *previous_node;
+	size_t previous_sampling_step;
+	ColorHistogram *previous_histogram;
 	ColorList *color_list;
 	ColorList *preview_color_list;
 	struct dynvSystem *params;
@@ -88,302 +92,119 @@ class PaletteColorNameAssigner: public ToolColorNameAssigner {
 		{
 			m_index = 0;
 		}
-		void assign(ColorObject *color_object, const Color *color, const char *filename, const int index)
+		void assign(ColorObject **color_objects, const Color *colors, size_t count, const char *filename)
 		{
 			m_filename = filename;
-			m_index = index;
-			ToolColorNameAssigner::assign(color_object, color);
+			m_index = 0;
+			ToolColorNameAssigner::assignMultiple(color_objects, colors, count);
 		}
 		virtual std::string getToolSpecificName(ColorObject *color_object, const Color *color)
 		{
 			m_stream.str("");
-			m_stream << m_filename << " #" << m_index;
+			m_stream << m_filename << " #" << m_index++;
 			return m_stream.str();
 		}
 };
 
-/**
- * Allocate and initialize a new node with specified parent
- * @param[in] parent Parent node
- * @return New node
- */
-static Node* node_new(Node *parent){
-	Node *n = new Node;
-	n->color[0] = n->color[1] = n->color[2] = 0;
-	n->distance = 0;
-	n->n_pixels = 0;
-	n->n_pixels_in = 0;
-	n->parent = parent;
-	for (int i = 0; i < 8; i++){
-		n->child[i] = 0;
-	}
-	return n;
-}
-
-/**
- * Deallocate node and its children
- * @param[in] node Node to deallocate
- */
-static void node_delete(Node *node){
-	for (int i = 0; i < 8; i++){
-		if (node->child[i]){
-			node_delete(node->child[i]);
-		}
-	}
-
-	delete node;
-}
-
-/**
- * Copy node and assing new parent
- * @param[in] node Node to copy
- * @param[in] parent Parent of copied node
- * @return A copy of node
- */
-static Node* node_copy(Node *node, Node *parent){
-	Node *n = node_new(0);
-	memcpy(n, node, sizeof(Node));
-	n->parent = parent;
-
-	for (int i = 0; i < 8; i++){
-		if (node->child[i]){
-			n->child[i] = node_copy(node->child[i], n);
-		}else{
-			n->child[i] = 0;
-		}
-	}
-	return n;
-}
-
-/**
- * Get the number of nodes with available color information in them
- * @param[in] node Start from this node
- * @return Number of nodes with available color information in them
- */
-static uint32_t node_count_leafs(Node *node){
-	uint32_t r = 0;
-	if (node->n_pixels_in) r++;
-	for (int i = 0; i < 8; i++){
-		if (node->child[i])
-			r += node_count_leafs(node->child[i]);
-	}
-	return r;
-}
-
-/**
- * Call callback on all nodes with available color information in them
- * @param[in] node Start from this node
- * @param[in] leaf_cb Callback function
- * @param[in] userdata User supplied pointer which is passed when calling callback
- */
-static void node_leaf_callback(Node *node, void (*leaf_cb)(Node* node, void* userdata), void* userdata){
-	if (node->n_pixels_in > 0) leaf_cb(node, userdata);
-
-	for (int i = 0; i < 8; i++){
-		if (node->child[i])
-			node_leaf_callback(node->child[i], leaf_cb, userdata);
-	}
-}
-
-/**
- * Merge node information into its parent node
- * @param[in] node Node to merge
- */
-static void node_prune(Node *node){
-
-	for (int i = 0; i < 8; i++){
-		if (node->child[i]){
-			node_prune(node->child[i]);
-			node->child[i] = 0;
-
-		}
-	}
-
-	if (node->parent){
-		node->parent->n_pixels_in += node->n_pixels_in;
-
-		node->parent->color[0] += node->color[0];
-		node->parent->color[1] += node->color[1];
-		node->parent->color[2] += node->color[2];
-	}
-
-	node_delete(node);
-}
-
-typedef struct PruneData{
-	float threshold;
-	float min_distance;
-	uint32_t n_colors;
-	uint32_t n_colors_target;
-
-	Node *prune_node;
-	uint32_t distant_nodes;
-}PruneData;
-
-static bool node_prune_threshold(Node *node, PruneData *prune_data){
-	if (node->distance <= prune_data->threshold){
-		uint32_t colors_removed = node_count_leafs(node);
-		node_prune(node);
-		prune_data->n_colors -= colors_removed;
-		return true;
-	}
-
-	if (node->distance < prune_data->min_distance){
-		prune_data->min_distance = node->distance;
-	}
-
-	uint32_t n = node->n_pixels_in;
-
-	for (int i = 0; i < 8; i++){
-		if (node->child[i]){
-			if (node_prune_threshold(node->child[i], prune_data)){
-				node->child[i] = 0;
-			}
+static void job_run(PaletteFromImageJob *job){
+	GError *error = nullptr;
+	ColorHistogram *histogram = new ColorHistogram();
+	if (image_loader_add_to_histogram(job->filename.c_str(), job->sampling_step, *histogram, &job->processed_rows, &job->total_rows, &job->cancel, &error)){
+		job->histogram = histogram;
+	}else{
+		if (error){
+			cout << error->message << endl;
+			g_error_free(error);
 		}
+		delete histogram;
 	}
-
-	if (node->n_pixels_in > 0 && n == 0) prune_data->n_colors++;
-
-	return false;
+	job->finished = true;
 }
 
-static void node_reduce(Node *node, uint32_t colors){
-	PruneData prune_data;
-	prune_data.n_colors = node_count_leafs(node);
-	prune_data.n_colors_target = colors;
-	prune_data.threshold = 0;
-
-	while (prune_data.n_colors > colors){
-		prune_data.min_distance = node->distance;
-
-		if (node_prune_threshold(node, &prune_data)) break;
-
-		prune_data.threshold = prune_data.min_distance;
+static void job_stop(PaletteFromImageArgs *args){
+	if (!args->job) return;
+	args->job->cancel = true;
+	args->job->worker.join();
+	if (args->job->histogram) delete args->job->histogram;
+	delete args->job;
+	args->job = nullptr;
+	if (args->job_timeout){
+		g_source_remove(args->job_timeout);
+		args->job_timeout = 0;
 	}
+	args->apply_when_ready = false;
+	gtk_widget_hide(args->progress_bar);
+	gtk_widget_hide(args->cancel_button);
 }
 
-static void node_update(Node *node, Color *color, Cube *cube, uint32_t max_depth){
-	Cube new_cube;
-
-	new_cube.w = cube->w / 2;
-	new_cube.h = cube->h / 2;
-	new_cube.d = cube->d / 2;
-
-	node->n_pixels++;
-
-	node->distance += (color->xyz.x - (cube->x + new_cube.w)) * (color->xyz.x - (cube->x + new_cube.w)) +
-		(color->xyz.y - (cube->y + new_cube.h)) * (color->xyz.y - (cube->y + new_cube.h)) +
-		(color->xyz.z - (cube->z + new_cube.d)) * (color->xyz.z - (cube->z + new_cube.d));
-
-	if (!max_depth){
-		node->n_pixels_in++;
-
-		node->color[0] += color->xyz.x;
-		node->color[1] += color->xyz.y;
-		node->color[2] += color->xyz.z;
-
-	}else{
-		int x, y, z;
-
-		if (color->xyz.x - cube->x < new_cube.w)
-			x = 0;
-		else
-			x = 1;
-
-		if (color->xyz.y - cube->y < new_cube.h)
-			y = 0;
-		else
-			y = 1;
+static void calc(PaletteFromImageArgs *args, bool preview, int limit);
+static void update(GtkWidget *widget, PaletteFromImageArgs *args);
 
-		if (color->xyz.z - cube->z < new_cube.d)
-			z = 0;
+static gboolean job_progress_cb(PaletteFromImageArgs *args){
+	PaletteFromImageJob *job = args->job;
+	if (!job->finished){
+		size_t total_rows = job->total_rows;
+		if (total_rows)
+			gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(args->progress_bar), double(job->processed_rows) / total_rows);
 		else
-			z = 1;
-
-		new_cube.x = cube->x + new_cube.w * x;
-		new_cube.y = cube->y + new_cube.h * y;
-		new_cube.z = cube->z + new_cube.d * z;
-
-		int i = x | (y<<1) | (z<<2);
-
-		if (!node->child[i])
-			node->child[i] = node_new(node);
-
-		node->n_pixels++;
-
-		node_update(node->child[x | (y<<1) | (z<<2)], color, &new_cube, max_depth - 1);
+			gtk_progress_bar_pulse(GTK_PROGRESS_BAR(args->progress_bar));
+		return TRUE;
+	}
+	job->worker.join();
+	args->previous_histogram = job->histogram;
+	delete job;
+	args->job = nullptr;
+	args->job_timeout = 0;
+	gtk_widget_hide(args->progress_bar);
+	gtk_widget_hide(args->cancel_button);
+	update(nullptr, args);
+	if (args->apply_when_ready){
+		args->apply_when_ready = false;
+		calc(args, false, 0);
 	}
+	return FALSE;
 }
 
-static void leaf_cb(Node *node, void *userdata){
-	list<Color> *l = static_cast<list<Color>*>(userdata);
-
-	Color c;
-	c.xyz.x = node->color[0] / node->n_pixels_in;
-	c.xyz.y = node->color[1] / node->n_pixels_in;
-	c.xyz.z = node->color[2] / node->n_pixels_in;
-
-	l->push_back(c);
+static void job_start(PaletteFromImageArgs *args, const char *filename){
+	PaletteFromImageJob *job = new PaletteFromImageJob;
+	job->filename = filename;
+	job->sampling_step = args->sampling_step;
+	job->processed_rows = 0;
+	job->total_rows = 0;
+	job->cancel = false;
+	job->finished = false;
+	job->histogram = nullptr;
+	job->worker = thread(job_run, job);
+	args->job = job;
+	args->job_timeout = g_timeout_add(100, (GSourceFunc)job_progress_cb, args);
+	gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(args->progress_bar), 0);
+	gtk_widget_show(args->progress_bar);
+	gtk_widget_show(args->cancel_button);
 }
 
-static Node* process_image(PaletteFromImageArgs *args, const char *filename, Node* node){
+/**
+ * Get histogram of image colors. Image is processed in a background thread, and preview is updated when processing finishes.
+ * @return Histogram or null if it is not available yet.
+ */
+static const ColorHistogram *process_image(PaletteFromImageArgs *args, const char *filename){
 
-	if (args->previous_filename == filename){
-		if (args->previous_node)
-			return node_copy(args->previous_node, 0);
-		else
-			return 0;
-	}
+	if (args->previous_filename == filename && args->previous_sampling_step == args->sampling_step)
+		return args->previous_histogram;
 
+	job_stop(args);
 	args->previous_filename = filename;
-	if (args->previous_node){
-		node_delete(args->previous_node);
-		args->previous_node = 0;
+	args->previous_sampling_step = args->sampling_step;
+	if (args->previous_histogram){
+		delete args->previous_histogram;
+		args->previous_histogram = nullptr;
 	}
+	job_start(args, filename);
+	return nullptr;
+}
 
-	GError *error = nullptr;
-	GdkPixbuf *pixbuf = gdk_pixbuf_new_from_file(filename, &error);
-	if (error){
-		cout << error->message << endl;
-		g_error_free(error);
-		return 0;
-	}
-
-	int channels = gdk_pixbuf_get_n_channels(pixbuf);
-	int width = gdk_pixbuf_get_width(pixbuf);
-	int height = gdk_pixbuf_get_height(pixbuf);
-	int rowstride = gdk_pixbuf_get_rowstride(pixbuf);
-	guchar *image_data = gdk_pixbuf_get_pixels(pixbuf);
-	guchar *ptr = image_data;
-
-	Cube cube;
-	cube.x = 0;
-	cube.y = 0;
-	cube.z = 0;
-	cube.w = 1;
-	cube.h = 1;
-	cube.d = 1;
-
-	Color color;
-
-	args->previous_node = node_new(0);
-
-	for (int y = 0; y < height; y++){
-		ptr = image_data + rowstride * y;
-		for (int x = 0; x < width; x++){
-
-			color.xyz.x = ptr[0] / 255.0;
-			color.xyz.y = ptr[1] / 255.0;
-			color.xyz.z = ptr[2] / 255.0;
-
-			node_update(args->previous_node, &color, &cube, 5);
-
-			ptr += channels;
-		}
-	}
-	g_object_unref(pixbuf);
-	node_reduce(args->previous_node, 200);
-	return node_copy(args->previous_node, 0);
+static void cancel_cb(GtkWidget *widget, PaletteFromImageArgs *args){
+	job_stop(args);
+	args->previous_filename.clear();
 }
 
 static void get_settings(PaletteFromImageArgs *args){
@@ -397,10 +218,16 @@ static void get_settings(PaletteFromImageArgs *args){
 	}
 
 	args->n_colors = gtk_spin_button_get_value(GTK_SPIN_BUTTON(args->range_colors));
+	args->sampling_step = gtk_spin_button_get_value(GTK_SPIN_BUTTON(args->range_sampling_step));
+	auto quantizer_types = quantizer::Factory::getAllTypes();
+	gint quantizer_index = gtk_combo_box_get_active(GTK_COMBO_BOX(args->quantizer_type));
+	args->quantizer = quantizer_types[quantizer_index >= 0 ? quantizer_index : 0].name;
 }
 
 static void save_settings(PaletteFromImageArgs *args){
 	dynv_set_int32(args->params, "colors", args->n_colors);
+	dynv_set_int32(args->params, "sampling_step", args->sampling_step);
+	dynv_set_string(args->params, "quantizer", args->quantizer.c_str());
 	gchar *current_folder = gtk_file_chooser_get_current_folder(GTK_FILE_CHOOSER(args->file_browser));
 	if (current_folder){
 		dynv_set_string(args->params, "current_folder", current_folder);
@@ -415,12 +242,11 @@ static void save_settings(PaletteFromImageArgs *args){
 
 static void calc(PaletteFromImageArgs *args, bool preview, int limit){
 
-	Node *root_node = 0;
-	int index = 0;
+	const ColorHistogram *histogram = nullptr;
 	gchar *name = g_path_get_basename(args->filename.c_str());
 	PaletteColorNameAssigner name_assigner(args->gs);
 	if (!args->filename.empty())
-		root_node = process_image(args, args->filename.c_str(), root_node);
+		histogram = process_image(args, args->filename.c_str());
 
 	ColorList *color_list;
 
@@ -429,20 +255,19 @@ static void calc(PaletteFromImageArgs *args, bool preview, int limit){
 	else
 		color_list = args->gs->getColorList();
 
-	list<Color> tmp_list;
-
-	if (root_node){
-		node_reduce(root_node, args->n_colors);
-		node_leaf_callback(root_node, leaf_cb, &tmp_list);
-		node_delete(root_node);
+	vector<Color> colors;
+	if (histogram){
+		auto palette_quantizer = quantizer::Factory::create(args->quantizer.c_str());
+		palette_quantizer->quantize(*histogram, args->n_colors, colors);
 	}
 
-	for (list<Color>::iterator i = tmp_list.begin(); i != tmp_list.end(); i++){
-		ColorObject *color_object = color_list_new_color_object(color_list, &(*i));
-		name_assigner.assign(color_object, &(*i), name, index);
+	vector<ColorObject*> color_objects(colors.size());
+	for (size_t i = 0; i < colors.size(); i++)
+		color_objects[i] = color_list_new_color_object(color_list, &colors[i]);
+	name_assigner.assign(color_objects.data(), colors.data(), colors.size(), name);
+	for (auto color_object: color_objects){
 		color_list_add_color_object(color_list, color_object, 1);
 		color_object->release();
-		index++;
 	}
 }
 
@@ -458,7 +283,8 @@ static gchar* format_threshold_value_cb(GtkScale *scale, gdouble value){
 
 static void destroy_cb(GtkWidget* widget, PaletteFromImageArgs *args){
 
-	if (args->previous_node) node_delete(args->previous_node);
+	job_stop(args);
+	if (args->previous_histogram) delete args->previous_histogram;
 
 	color_list_destroy(args->preview_color_list);
 	dynv_system_release(args->params);
@@ -480,7 +306,10 @@ static void response_cb(GtkWidget* widget, gint response_id, PaletteFromImageArg
 
 	switch (response_id){
 		case GTK_RESPONSE_APPLY:
-			calc(args, false, 0);
+			if (args->job)
+				args->apply_when_ready = true;
+			else
+				calc(args, false, 0);
 			break;
 		case GTK_RESPONSE_DELETE_EVENT:
 			break;
@@ -494,9 +323,13 @@ void tools_palette_from_image_show(GtkWindow* parent, GlobalState* gs)
 {
 	PaletteFromImageArgs *args = new PaletteFromImageArgs;
 	args->previous_filename = "";
+	args->previous_sampling_step = 0;
 	args->gs = gs;
 	args->params = dynv_get_dynv(args->gs->getSettings(), "gpick.tools.palette_from_image");
-	args->previous_node = 0;
+	args->previous_histogram = nullptr;
+	args->job = nullptr;
+	args->job_timeout = 0;
+	args->apply_when_ready = false;
 	GtkWidget *table, *table_m, *widget;
 	GtkWidget *dialog = gtk_dialog_new_with_buttons(_("Palette from image"), parent, GtkDialogFlags(GTK_DIALOG_DESTROY_WITH_PARENT), GTK_STOCK_CLOSE, GTK_RESPONSE_CLOSE, GTK_STOCK_ADD, GTK_RESPONSE_APPLY, nullptr);
 	gtk_window_set_default_size(GTK_WINDOW(dialog), dynv_get_int32_wd(args->params, "window.width", -1),
@@ -568,6 +401,13 @@ void tools_palette_from_image_show(GtkWindow* parent, GlobalState* gs)
 	}
 	if (formats) g_slist_free(formats);
 
+	args->progress_bar = widget = gtk_progress_bar_new();
+	gtk_table_attach(GTK_TABLE(table), widget, 0, 2, table_y, table_y+1, GtkAttachOptions(GTK_FILL | GTK_EXPAND), GTK_FILL, 5, 5);
+	args->cancel_button = widget = gtk_button_new_from_stock(GTK_STOCK_CANCEL);
+	gtk_table_attach(GTK_TABLE(table), widget, 2, 3, table_y, table_y+1, GtkAttachOptions(GTK_FILL), GTK_FILL, 5, 5);
+	g_signal_connect(G_OBJECT(widget), "clicked", G_CALLBACK(cancel_cb), args);
+	table_y++;
+
 	frame = gtk_frame_new(_("Options"));
 	gtk_frame_set_shadow_type(GTK_FRAME(frame), GTK_SHADOW_NONE);
 	gtk_table_attach(GTK_TABLE(table_m), frame, 0, 1, table_m_y, table_m_y+1, GtkAttachOptions(GTK_FILL | GTK_EXPAND), GtkAttachOptions(GTK_FILL), 5, 5);
@@ -583,6 +423,29 @@ void tools_palette_from_image_show(GtkWindow* parent, GlobalState* gs)
 	g_signal_connect(G_OBJECT(args->range_colors), "value-changed", G_CALLBACK(update), args);
 	table_y++;
 
+	gtk_table_attach(GTK_TABLE(table), gtk_label_aligned_new(_("Sampling step:"),0,0,0,0),0,1,table_y,table_y+1,GtkAttachOptions(GTK_FILL),GTK_FILL,5,5);
+	args->range_sampling_step = widget = gtk_spin_button_new_with_range (1, 16, 1);
+	gtk_spin_button_set_value(GTK_SPIN_BUTTON(args->range_sampling_step), dynv_get_int32_wd(args->params, "sampling_step", 1));
+	gtk_widget_set_tooltip_text(widget, _("Use only every n-th pixel of every n-th row for faster processing of large images"));
+	gtk_table_attach(GTK_TABLE(table), widget,1,3,table_y,table_y+1,GtkAttachOptions(GTK_FILL | GTK_EXPAND),GTK_FILL,3,3);
+	g_signal_connect(G_OBJECT(args->range_sampling_step), "value-changed", G_CALLBACK(update), args);
+	table_y++;
+
+	gtk_table_attach(GTK_TABLE(table), gtk_label_aligned_new(_("Algorithm:"),0,0.5,0,0),0,1,table_y,table_y+1,GtkAttachOptions(GTK_FILL),GTK_FILL,5,5);
+	args->quantizer_type = widget = gtk_combo_box_text_new();
+	const char *quantizer_name = dynv_get_string_wd(args->params, "quantizer", "");
+	auto quantizer_types = quantizer::Factory::getAllTypes();
+	for (size_t i = 0; i < quantizer_types.size(); i++){
+		gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(widget), quantizer_types[i].human_name);
+		if (strcmp(quantizer_types[i].name, quantizer_name) == 0)
+			gtk_combo_box_set_active(GTK_COMBO_BOX(widget), i);
+	}
+	if (gtk_combo_box_get_active(GTK_COMBO_BOX(widget)) < 0)
+		gtk_combo_box_set_active(GTK_COMBO_BOX(widget), 0);
+	gtk_table_attach(GTK_TABLE(table), widget,1,3,table_y,table_y+1,GtkAttachOptions(GTK_FILL | GTK_EXPAND),GTK_FILL,3,3);
+	g_signal_connect(G_OBJECT(args->quantizer_type), "changed", G_CALLBACK(update), args);
+	table_y++;
+
 	ColorList* preview_color_list = nullptr;
 	gtk_table_attach(GTK_TABLE(table_m), args->preview_expander = palette_list_preview_new(gs, true, dynv_get_bool_wd(args->params, "show_preview", true), gs->getColorList(), &preview_color_list), 0, 1, table_m_y, table_m_y+1 , GtkAttachOptions(GTK_FILL | GTK_EXPAND), GtkAttachOptions(GTK_FILL | GTK_EXPAND), 5, 5);
 	table_m_y++;
@@ -590,6 +453,8 @@ void tools_palette_from_image_show(GtkWindow* parent, GlobalState* gs)
 	args->preview_color_list = preview_color_list;
 
 	gtk_widget_show_all(table_m);
+	gtk_widget_hide(args->progress_bar);
+	gtk_widget_hide(args->cancel_button);
 	gtk_container_add(GTK_CONTAINER(gtk_dialog_get_content_area(GTK_DIALOG(dialog))), table_m);
 
 	g_signal_connect(G_OBJECT(dialog), "destroy", G_CALLBACK(destroy_cb), args);
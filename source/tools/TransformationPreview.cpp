@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2009-2016, Albertas Vyšniauskas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the software author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "TransformationPreview.h"
+#include "../GlobalState.h"
+#include "../DynvHelpers.h"
+#include "../Internationalisation.h"
+#include "../ImageTransform.h"
+#include "../ScreenReader.h"
+#include "../transformation/Chain.h"
+#include "../transformation/Factory.h"
+#include <string>
+#include <thread>
+#include <atomic>
+using namespace std;
+
+/** \file TransformationPreview.cpp
+ * \brief Preview of transformation chain applied to a whole image or screen capture.
+ */
+
+/** \struct TransformationPreviewJob
+ * \brief Image loading and transformation running in a background thread
+ */
+typedef struct TransformationPreviewJob{
+	string filename; /**< Image file, empty when source image is already available */
+	GdkPixbuf *source;
+	GdkPixbuf *result; /**< Transformed image, null if image could not be processed */
+	string error; /**< Error message, set if image could not be loaded */
+	transformation::Chain chain; /**< Copy of transformation chain, so that chain can be changed while image is processed */
+	thread worker;
+	atomic<size_t> processed_tiles;
+	atomic<size_t> total_tiles; /**< Zero while image is being loaded */
+	atomic<bool> cancel;
+	atomic<bool> finished;
+}TransformationPreviewJob;
+
+typedef struct TransformationPreviewArgs{
+	GtkWidget *file_browser;
+	GtkWidget *show_original;
+	GtkWidget *image;
+	GtkWidget *progress_bar;
+	GtkWidget *cancel_button;
+	TransformationPreviewJob *job;
+	guint job_timeout;
+	GdkPixbuf *source;
+	GdkPixbuf *result;
+	struct dynvSystem *params;
+	GlobalState* gs;
+}TransformationPreviewArgs;
+
+static ImageView get_image_view(GdkPixbuf *pixbuf)
+{
+	ImageView view;
+	view.pixels = gdk_pixbuf_get_pixels(pixbuf);
+	view.width = gdk_pixbuf_get_width(pixbuf);
+	view.height = gdk_pixbuf_get_height(pixbuf);
+	view.stride = gdk_pixbuf_get_rowstride(pixbuf);
+	view.format = gdk_pixbuf_get_n_channels(pixbuf) == 4 ? ImagePixelFormat::rgba : ImagePixelFormat::rgb;
+	return view;
+}
+
+static void copy_chain(GlobalState *gs, transformation::Chain &chain)
+{
+	auto handler_map = dynv_system_get_handler_map(gs->getSettings());
+	chain.setEnabled(gs->getTransformationChain()->isEnabled());
+	for (auto &transformation: gs->getTransformationChain()->getAll()){
+		auto copy = transformation::Factory::create(transformation->getName().c_str());
+		if (!copy) continue;
+		auto dv = dynv_system_create(handler_map);
+		transformation->serialize(dv);
+		copy->deserialize(dv);
+		dynv_system_release(dv);
+		chain.add(copy);
+	}
+	dynv_handler_map_release(handler_map);
+}
+
+/**
+ * Read pixels of the monitor containing the pointer.
+ * @return New image or null if screen could not be read.
+ */
+static GdkPixbuf *capture_screen()
+{
+	ScreenReader *screen_reader = screen_reader_new();
+	math::Vec2<int> pointer;
+	math::Rect2<int> screen_rect, update_rect;
+	GdkPixbuf *pixbuf = nullptr;
+	if (screen_reader_get_pointer(screen_reader, pointer, screen_rect)){
+		screen_reader_add_rect(screen_reader, screen_rect);
+		if (screen_reader_update_surface(screen_reader, &update_rect)){
+			cairo_surface_t *surface = screen_reader_get_surface(screen_reader);
+			cairo_surface_flush(surface);
+			ImageView input;
+			input.pixels = cairo_image_surface_get_data(surface);
+			input.width = update_rect.getWidth();
+			input.height = update_rect.getHeight();
+			input.stride = cairo_image_surface_get_stride(surface);
+			input.format = ImagePixelFormat::argb32;
+			pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, input.width, input.height);
+			// Empty chain only converts pixel format
+			transformation::Chain chain;
+			image_transform_apply(chain, input, get_image_view(pixbuf), nullptr, nullptr);
+		}
+	}
+	screen_reader_destroy(screen_reader);
+	return pixbuf;
+}
+
+static void job_run(TransformationPreviewJob *job){
+	if (!job->source){
+		GError *error = nullptr;
+		job->source = gdk_pixbuf_new_from_file(job->filename.c_str(), &error);
+		if (!job->source){
+			if (error){
+				job->error = error->message;
+				g_error_free(error);
+			}
+			job->finished = true;
+			return;
+		}
+	}
+	int width = gdk_pixbuf_get_width(job->source);
+	int height = gdk_pixbuf_get_height(job->source);
+	job->total_tiles = image_transform_get_tile_count(width, height);
+	GdkPixbuf *result = gdk_pixbuf_new(GDK_COLORSPACE_RGB, gdk_pixbuf_get_has_alpha(job->source), 8, width, height);
+	if (image_transform_apply(job->chain, get_image_view(job->source), get_image_view(result), &job->processed_tiles, &job->cancel))
+		job->result = result;
+	else
+		g_object_unref(result);
+	job->finished = true;
+}
+
+static void job_stop(TransformationPreviewArgs *args){
+	if (!args->job) return;
+	args->job->cancel = true;
+	args->job->worker.join();
+	if (args->job->source) g_object_unref(args->job->source);
+	if (args->job->result) g_object_unref(args->job->result);
+	delete args->job;
+	args->job = nullptr;
+	if (args->job_timeout){
+		g_source_remove(args->job_timeout);
+		args->job_timeout = 0;
+	}
+	gtk_widget_hide(args->progress_bar);
+	gtk_widget_hide(args->cancel_button);
+}
+
+static void update_image(TransformationPreviewArgs *args){
+	bool show_original = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(args->show_original));
+	GdkPixbuf *pixbuf = show_original ? args->source : args->result;
+	if (pixbuf)
+		gtk_image_set_from_pixbuf(GTK_IMAGE(args->image), pixbuf);
+	else
+		gtk_image_clear(GTK_IMAGE(args->image));
+}
+
+static gboolean job_progress_cb(TransformationPreviewArgs *args){
+	TransformationPreviewJob *job = args->job;
+	if (!job->finished){
+		size_t total_tiles = job->total_tiles;
+		if (total_tiles)
+			gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(args->progress_bar), double(job->processed_tiles) / total_tiles);
+		else
+			gtk_progress_bar_pulse(GTK_PROGRESS_BAR(args->progress_bar));
+		return TRUE;
+	}
+	job->worker.join();
+	if (args->source) g_object_unref(args->source);
+	if (args->result) g_object_unref(args->result);
+	args->source = job->source;
+	args->result = job->result;
+	string error = job->error;
+	delete job;
+	args->job = nullptr;
+	args->job_timeout = 0;
+	gtk_widget_hide(args->progress_bar);
+	gtk_widget_hide(args->cancel_button);
+	update_image(args);
+	if (!error.empty()){
+		GtkWidget *message = gtk_message_dialog_new(GTK_WINDOW(gtk_widget_get_toplevel(args->image)), GtkDialogFlags(GTK_DIALOG_DESTROY_WITH_PARENT), GTK_MESSAGE_ERROR, GTK_BUTTONS_OK, "%s", _("Image could not be loaded"));
+		gtk_message_dialog_format_secondary_text(GTK_MESSAGE_DIALOG(message), "%s", error.c_str());
+		gtk_window_set_title(GTK_WINDOW(message), _("Transformation preview"));
+		g_signal_connect(message, "response", G_CALLBACK(gtk_widget_destroy), nullptr);
+		gtk_widget_show(message);
+	}
+	return FALSE;
+}
+
+/**
+ * Start transforming an image in a background thread. Image is loaded from file when source is null.
+ * @param[in] args Tool arguments.
+ * @param[in] filename Image file name.
+ * @param[in] source Source image. Job takes ownership of it.
+ */
+static void job_start(TransformationPreviewArgs *args, const char *filename, GdkPixbuf *source){
+	job_stop(args);
+	TransformationPreviewJob *job = new TransformationPreviewJob;
+	job->filename = filename ? filename : "";
+	job->source = source;
+	job->result = nullptr;
+	copy_chain(args->gs, job->chain);
+	job->processed_tiles = 0;
+	job->total_tiles = 0;
+	job->cancel = false;
+	job->finished = false;
+	job->worker = thread(job_run, job);
+	args->job = job;
+	args->job_timeout = g_timeout_add(50, (GSourceFunc)job_progress_cb, args);
+	gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(args->progress_bar), 0);
+	gtk_widget_show(args->progress_bar);
+	gtk_widget_show(args->cancel_button);
+}
+
+static void file_set_cb(GtkWidget *widget, TransformationPreviewArgs *args){
+	gchar *filename = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(args->file_browser));
+	if (filename){
+		job_start(args, filename, nullptr);
+		g_free(filename);
+	}
+}
+
+static void capture_cb(GtkWidget *widget, TransformationPreviewArgs *args){
+	GdkPixbuf *pixbuf = capture_screen();
+	if (pixbuf)
+		job_start(args, nullptr, pixbuf);
+}
+
+static void cancel_cb(GtkWidget *widget, TransformationPreviewArgs *args){
+	job_stop(args);
+}
+
+static void show_original_cb(GtkWidget *widget, TransformationPreviewArgs *args){
+	update_image(args);
+}
+
+static void destroy_cb(GtkWidget* widget, TransformationPreviewArgs *args){
+	job_stop(args);
+	if (args->source) g_object_unref(args->source);
+	if (args->result) g_object_unref(args->result);
+	dynv_system_release(args->params);
+	delete args;
+}
+
+static void response_cb(GtkWidget* widget, gint response_id, TransformationPreviewArgs *args){
+	gint width, height;
+	gtk_window_get_size(GTK_WINDOW(widget), &width, &height);
+	dynv_set_int32(args->params, "window.width", width);
+	dynv_set_int32(args->params, "window.height", height);
+	gchar *current_folder = gtk_file_chooser_get_current_folder(GTK_FILE_CHOOSER(args->file_browser));
+	if (current_folder){
+		dynv_set_string(args->params, "current_folder", current_folder);
+		g_free(current_folder);
+	}
+
+	switch (response_id){
+		case GTK_RESPONSE_APPLY:
+			// Transformation chain could have changed since the image was processed
+			if (args->source){
+				g_object_ref(args->source);
+				job_start(args, nullptr, args->source);
+			}
+			break;
+		case GTK_RESPONSE_DELETE_EVENT:
+			break;
+		case GTK_RESPONSE_CLOSE:
+			gtk_widget_destroy(widget);
+			break;
+	}
+}
+
+void tools_transformation_preview_show(GtkWindow* parent, GlobalState* gs)
+{
+	TransformationPreviewArgs *args = new TransformationPreviewArgs;
+	args->gs = gs;
+	args->params = dynv_get_dynv(args->gs->getSettings(), "gpick.tools.transformation_preview");
+	args->job = nullptr;
+	args->job_timeout = 0;
+	args->source = nullptr;
+	args->result = nullptr;
+	GtkWidget *table, *widget;
+	GtkWidget *dialog = gtk_dialog_new_with_buttons(_("Transformation preview"), parent, GtkDialogFlags(GTK_DIALOG_DESTROY_WITH_PARENT), GTK_STOCK_CLOSE, GTK_RESPONSE_CLOSE, GTK_STOCK_REFRESH, GTK_RESPONSE_APPLY, nullptr);
+	gtk_window_set_default_size(GTK_WINDOW(dialog), dynv_get_int32_wd(args->params, "window.width", 640),
+		dynv_get_int32_wd(args->params, "window.height", 480));
+	gtk_dialog_set_alternative_button_order(GTK_DIALOG(dialog), GTK_RESPONSE_APPLY, GTK_RESPONSE_CLOSE, -1);
+
+	gint table_y = 0;
+	table = gtk_table_new(4, 3, FALSE);
+
+	args->file_browser = widget = gtk_file_chooser_button_new(_("Image file"), GTK_FILE_CHOOSER_ACTION_OPEN);
+	gtk_file_chooser_set_current_folder(GTK_FILE_CHOOSER(widget), dynv_get_string_wd(args->params, "current_folder", ""));
+	GtkFileFilter *filter = gtk_file_filter_new();
+	gtk_file_filter_set_name(filter, _("All images"));
+	gtk_file_filter_add_pixbuf_formats(filter);
+	gtk_file_chooser_add_filter(GTK_FILE_CHOOSER(widget), filter);
+	gtk_table_attach(GTK_TABLE(table), widget, 0, 2, table_y, table_y+1, GtkAttachOptions(GTK_FILL | GTK_EXPAND), GTK_FILL, 3, 3);
+	g_signal_connect(G_OBJECT(widget), "file-set", G_CALLBACK(file_set_cb), args);
+	widget = gtk_button_new_with_mnemonic(_("_Capture screen"));
+	gtk_widget_set_tooltip_text(widget, _("Use pixels of the screen containing the pointer"));
+	gtk_table_attach(GTK_TABLE(table), widget, 2, 3, table_y, table_y+1, GtkAttachOptions(GTK_FILL), GTK_FILL, 3, 3);
+	g_signal_connect(G_OBJECT(widget), "clicked", G_CALLBACK(capture_cb), args);
+	table_y++;
+
+	args->show_original = widget = gtk_check_button_new_with_mnemonic(_("Show _original"));
+	gtk_table_attach(GTK_TABLE(table), widget, 0, 3, table_y, table_y+1, GtkAttachOptions(GTK_FILL | GTK_EXPAND), GTK_FILL, 3, 3);
+	g_signal_connect(G_OBJECT(widget), "toggled", G_CALLBACK(show_original_cb), args);
+	table_y++;
+
+	args->progress_bar = widget = gtk_progress_bar_new();
+	gtk_table_attach(GTK_TABLE(table), widget, 0, 2, table_y, table_y+1, GtkAttachOptions(GTK_FILL | GTK_EXPAND), GTK_FILL, 5, 5);
+	args->cancel_button = widget = gtk_button_new_from_stock(GTK_STOCK_CANCEL);
+	gtk_table_attach(GTK_TABLE(table), widget, 2, 3, table_y, table_y+1, GtkAttachOptions(GTK_FILL), GTK_FILL, 5, 5);
+	g_signal_connect(G_OBJECT(widget), "clicked", G_CALLBACK(cancel_cb), args);
+	table_y++;
+
+	GtkWidget *scrolled = gtk_scrolled_window_new(nullptr, nullptr);
+	gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(scrolled), GTK_POLICY_AUTOMATIC, GTK_POLICY_AUTOMATIC);
+	args->image = gtk_image_new();
+	gtk_scrolled_window_add_with_viewport(GTK_SCROLLED_WINDOW(scrolled), args->image);
+	gtk_table_attach(GTK_TABLE(table), scrolled, 0, 3, table_y, table_y+1, GtkAttachOptions(GTK_FILL | GTK_EXPAND), GtkAttachOptions(GTK_FILL | GTK_EXPAND), 3, 3);
+	table_y++;
+
+	gtk_widget_show_all(table);
+	gtk_widget_hide(args->progress_bar);
+	gtk_widget_hide(args->cancel_button);
+	gtk_box_pack_start(GTK_BOX(gtk_dialog_get_content_area(GTK_DIALOG(dialog))), table, TRUE, TRUE, 5);
+
+	g_signal_connect(G_OBJECT(dialog), "destroy", G_CALLBACK(destroy_cb), args);
+	g_signal_connect(G_OBJECT(dialog), "response", G_CALLBACK(response_cb), args);
+
+	gtk_widget_show(dialog);
+}
@@ -17,17 +17,118 @@
  */
 
 #include "Chain.h"
+#include <string.h>
 
 using namespace std;
 
 namespace transformation {
 
-Chain::Chain()
+const float Chain::lut_error_bound = 0.5f / 255;
+/** Lookup table sizes tried in order. Larger table is tried only if error of the smaller one is close enough to the bound. */
+static const size_t lut_sizes[] = {33, 65};
+
+Chain::Chain():
+	lut_state(LutState::invalid)
 {
 	enabled = true;
 }
 
+/** Check if color can be looked up in table. Comparisons are written so that NaN components are out of range. */
+static bool in_lut_range(const Color &color)
+{
+	for (int i = 0; i < 3; i++){
+		if (!(color.ma[i] >= 0 && color.ma[i] <= 1))
+			return false;
+	}
+	return true;
+}
+
 void Chain::apply(const Color *input, Color *output)
+{
+	if (!enabled || transformation_chain.empty()) {
+		color_copy(input, output);
+		return;
+	}
+	if (lut_state.load() == LutState::invalid)
+		compile();
+	if (lut_state.load() == LutState::valid){
+		if (in_lut_range(*input)){
+			lut.apply(*input, *output);
+			return;
+		}
+	}
+	applyExact(input, output);
+}
+
+void Chain::apply(const Color *input, Color *output, size_t count)
+{
+	if (!enabled || transformation_chain.empty()) {
+		if (input != output)
+			memmove(output, input, count * sizeof(Color));
+		return;
+	}
+	if (lut_state.load() == LutState::invalid)
+		compile();
+	if (lut_state.load() != LutState::valid){
+		applyExact(input, output, count);
+		return;
+	}
+	for (size_t i = 0; i < count; i++){
+		if (in_lut_range(input[i]))
+			lut.apply(input[i], output[i]);
+		else
+			applyExact(&input[i], &output[i]);
+	}
+}
+
+void Chain::applyExact(const Color *input, Color *output, size_t count)
+{
+	if (input != output)
+		memmove(output, input, count * sizeof(Color));
+	if (!enabled) return;
+	for (auto &transformation: transformation_chain)
+		transformation->apply(output, output, count);
+}
+
+void Chain::compile()
+{
+	lock_guard<mutex> lock(lut_lock);
+	if (lut_state.load() != LutState::invalid) return;
+	ColorLut::Function function = [this](const Color &input, Color &output){
+		applyExact(&input, &output);
+	};
+	for (auto size: lut_sizes){
+		lut.build(size, function);
+		// Every cell is checked, so discontinuities, for example in quantization, are not missed
+		float error = lut.getError(function, size - 1);
+		if (error <= lut_error_bound){
+			lut_state = LutState::valid;
+			return;
+		}
+		// Interpolation error of smooth functions drops about four times when grid size is doubled
+		if (error > lut_error_bound * 8)
+			break;
+	}
+	lut.clear();
+	lut_state = LutState::unusable;
+}
+
+void Chain::invalidate()
+{
+	lock_guard<mutex> lock(lut_lock);
+	lut.clear();
+	lut_state = LutState::invalid;
+}
+
+bool Chain::isCompiled()
+{
+	if (!enabled || transformation_chain.empty()) return false;
+	if (lut_state.load() == LutState::invalid)
+		compile();
+	return lut_state.load() == LutState::valid;
+}
+
+void Chain::applyExact(const Color *input, Color *output)
 {
 	if (!enabled) {
 		color_copy(input, output);
@@ -55,6 +156,7 @@ void Chain::apply(const Color *input, Color *output)
 void Chain::add(boost::shared_ptr<Transformation> transformation)
 {
 	transformation_chain.push_back(transformation);
+	invalidate();
 }
 
 void Chain::remove(const Transformation *transformation)
@@ -62,6 +164,7 @@ void Chain::remove(const Transformation *transformation)
 	for (TransformationList::iterator i = transformation_chain.begin(); i != transformation_chain.end(); i++){
 		if ((*i).get() == transformation){
 			transformation_chain.erase(i);
+			invalidate();
 			return;
 		}
 	}
@@ -70,6 +173,7 @@ void Chain::remove(const Transformation *transformation)
 void Chain::clear()
 {
 	transformation_chain.clear();
+	invalidate();
 }
 
 Chain::TransformationList& Chain::getAll()
@@ -82,4 +186,9 @@ void Chain::setEnabled(bool enabled_)
 	enabled = enabled_;
 }
 
+bool Chain::isEnabled() const
+{
+	return enabled;
+}
+
 }
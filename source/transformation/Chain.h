@@ -20,8 +20,11 @@
 #define TRANSFORMATION_CHAIN_H_
 
 #include "Transformation.h"
+#include "../ColorLut.h"
 #include <boost/shared_ptr.hpp>
+#include <atomic>
 #include <list>
+#include <mutex>
 
 /** \file source/transformation/Chain.h
  * \brief Class for transformation object list handling.
@@ -31,13 +34,28 @@ namespace transformation {
 
 /** \class Chain
  * \brief Transformation object chain management class.
+ *
+ * Whole chain is compiled into a 3D lookup table when it is first applied after a change, so each color costs one table lookup
+ * regardless of the number of transformations. Table is used only if its error, checked against exact chain, is within lut_error_bound.
+ * Otherwise, for example when chain contains quantization, colors are transformed exactly.
  */
 class Chain{
 	public:
 		typedef std::list<boost::shared_ptr<Transformation> > TransformationList;
+		/** Largest allowed difference of a single RGB component between lookup table and exact chain. */
+		static const float lut_error_bound;
 	protected:
 		TransformationList transformation_chain;
 		bool enabled;
+		ColorLut lut;
+		enum class LutState: int{
+			invalid,
+			valid,
+			unusable,
+		};
+		std::atomic<LutState> lut_state;
+		std::mutex lut_lock;
+		void compile();
 	public:
 		/**
 		 * Chain constructor.
@@ -45,12 +63,48 @@ class Chain{
 		Chain();
 
 		/**
-		 * Apply transformation chain to color.
+		 * Apply transformation chain to color. Compiled lookup table is used when available and all components are in [0, 1] range.
+		 * Colors with components outside of this range, including NaN, are transformed exactly.
 		 * @param[in] input Source color in RGB color space.
 		 * @param[out] output Destination color in RGB color space.
 		 */
 		void apply(const Color *input, Color *output);
 
+		/**
+		 * Apply each transformation in the chain to color without using lookup table.
+		 * @param[in] input Source color in RGB color space.
+		 * @param[out] output Destination color in RGB color space.
+		 */
+		void applyExact(const Color *input, Color *output);
+
+		/**
+		 * Apply transformation chain to an array of colors. Compiled lookup table is used when available.
+		 * Otherwise each transformation is applied to all colors before the next one.
+		 * @param[in] input Source colors in RGB color space.
+		 * @param[out] output Destination colors in RGB color space. Can be the same array as input.
+		 * @param[in] count Number of colors.
+		 */
+		void apply(const Color *input, Color *output, size_t count);
+
+		/**
+		 * Apply each transformation in the chain to all colors without using lookup table.
+		 * @param[in] input Source colors in RGB color space.
+		 * @param[out] output Destination colors in RGB color space. Can be the same array as input.
+		 * @param[in] count Number of colors.
+		 */
+		void applyExact(const Color *input, Color *output, size_t count);
+
+		/**
+		 * Discard compiled lookup table. Must be called after transformation object in the chain is reconfigured.
+		 */
+		void invalidate();
+
+		/**
+		 * Check if chain is applied using lookup table. Compiles lookup table if needed.
+		 * @return True if lookup table is used.
+		 */
+		bool isCompiled();
+
 		/**
 		 * Add transformation object into the list.
 		 * @param[in] transformation Transformation object.
@@ -75,7 +129,13 @@ class Chain{
 		void setEnabled(bool enabled);
 
 		/**
-		 * Get the list of transformation objects.
+		 * Check if transformation chain is enabled.
+		 * @return True if enabled.
+		 */
+		bool isEnabled() const;
+
+		/**
+		 * Get the list of transformation objects. Call invalidate() after the list is modified.
 		 * @return Transformation object list.
 		 */
 		TransformationList& getAll();
@@ -18,6 +18,7 @@
 
 #include "ColorVisionDeficiency.h"
 #include "../MathUtil.h"
+#include "../ColorBatch.h"
 #include "../uiUtilities.h"
 #include "../Internationalisation.h"
 #include <gtk/gtk.h>
@@ -189,95 +190,159 @@ static void load_vector(const Color *color, vector3 *vector)
 	vector->z = color->rgb.blue;
 }
 
-void ColorVisionDeficiency::apply(Color *input, Color *output)
+/** Projection onto the plane of colors which are seen the same by normal and dichromat observers. Replaces LMS component which is missing for dichromat. */
+static void load_projection(ColorVisionDeficiency::DeficiencyType type, const vector3 &abc, matrix3x3 *matrix)
 {
-	Color linear_input, linear_output;
-	color_rgb_get_linear(input, &linear_input);
-	vector3 vi, vo1, vo2;
-	load_vector(&linear_input, &vi);
-	matrix3x3 matrix1, matrix2;
-	int index = floor(strength * 10);
-	int index_secondary = std::min(index + 1, 10);
-	float interpolation_factor = 1 - ((strength * 10) - index);
-
-	vector3 lms;
-	if ((type == PROTANOPIA) || (type == DEUTERANOPIA) || (type == TRITANOPIA)){
-		load_matrix(rgb_to_lms, &matrix1);
-		load_matrix(lms_to_rgb, &matrix2);
-		vector3_multiply_matrix3x3(&vi, &matrix1, &lms);
+	matrix3x3_identity(matrix);
+	switch (type){
+		case ColorVisionDeficiency::PROTANOPIA:
+			matrix->m[0][0] = 0;
+			matrix->m[0][1] = -abc.y / abc.x;
+			matrix->m[0][2] = -abc.z / abc.x;
+			break;
+		case ColorVisionDeficiency::DEUTERANOPIA:
+			matrix->m[1][0] = -abc.x / abc.y;
+			matrix->m[1][1] = 0;
+			matrix->m[1][2] = -abc.z / abc.y;
+			break;
+		case ColorVisionDeficiency::TRITANOPIA:
+			matrix->m[2][0] = -abc.x / abc.z;
+			matrix->m[2][1] = -abc.y / abc.z;
+			matrix->m[2][2] = 0;
+			break;
+		default:
+			break;
 	}
+}
 
+/** Mix matrix with identity matrix. */
+static void mix_with_identity(const matrix3x3 &matrix, double factor, matrix3x3 *result)
+{
+	for (int i = 0; i < 3; i++){
+		for (int j = 0; j < 3; j++){
+			result->m[i][j] = matrix.m[i][j] * factor + (i == j ? 1 - factor : 0);
+		}
+	}
+}
+
+void ColorVisionDeficiency::updateMatrices()
+{
+	vector3_set(&plane_selector, 0, 0, 0);
+	const double (*anomaly)[9] = nullptr;
+	const vector3 *abc = nullptr;
+	// Projection plane is selected by comparing the ratio of two LMS components with the ratio of RGB anchor
+	int numerator = 0, denominator = 0;
 	switch (type){
 		case PROTANOMALY:
-			load_matrix(protanomaly[index], &matrix1);
-			load_matrix(protanomaly[index_secondary], &matrix2);
-			vector3_multiply_matrix3x3(&vi, &matrix1, &vo1);
-			vector3_multiply_matrix3x3(&vi, &matrix2, &vo2);
+			anomaly = protanomaly;
 			break;
 		case DEUTERANOMALY:
-			load_matrix(deuteranomaly[index], &matrix1);
-			load_matrix(deuteranomaly[index_secondary], &matrix2);
-			vector3_multiply_matrix3x3(&vi, &matrix1, &vo1);
-			vector3_multiply_matrix3x3(&vi, &matrix2, &vo2);
+			anomaly = deuteranomaly;
 			break;
 		case TRITANOMALY:
-			load_matrix(tritanomaly[index], &matrix1);
-			load_matrix(tritanomaly[index_secondary], &matrix2);
-			vector3_multiply_matrix3x3(&vi, &matrix1, &vo1);
-			vector3_multiply_matrix3x3(&vi, &matrix2, &vo2);
+			anomaly = tritanomaly;
 			break;
 		case PROTANOPIA:
-			if (lms.z / lms.y < rgb_anchor[2] / rgb_anchor[1]){
-				lms.x = -(protanopia_abc[0].y * lms.y + protanopia_abc[0].z * lms.z) / protanopia_abc[0].x;
-			}else{
-				lms.x = -(protanopia_abc[1].y * lms.y + protanopia_abc[1].z * lms.z) / protanopia_abc[1].x;
-			}
-			vector3_multiply_matrix3x3(&lms, &matrix2, &vo1);
-			load_vector(&linear_input, &vo2);
-			interpolation_factor = strength;
+			abc = protanopia_abc;
+			numerator = 2;
+			denominator = 1;
 			break;
 		case DEUTERANOPIA:
-			if (lms.z / lms.x < rgb_anchor[2] / rgb_anchor[0]){
-				lms.y = -(deuteranopia_abc[0].x * lms.x + deuteranopia_abc[0].z * lms.z) / deuteranopia_abc[0].y;
-			}else{
-				lms.y = -(deuteranopia_abc[1].x * lms.x + deuteranopia_abc[1].z * lms.z) / deuteranopia_abc[1].y;
-			}
-			vector3_multiply_matrix3x3(&lms, &matrix2, &vo1);
-			load_vector(&linear_input, &vo2);
-			interpolation_factor = strength;
+			abc = deuteranopia_abc;
+			numerator = 2;
+			denominator = 0;
 			break;
 		case TRITANOPIA:
-			if (lms.y / lms.x < rgb_anchor[1] / rgb_anchor[0]){
-				lms.z = -(tritanopia_abc[0].x * lms.x + tritanopia_abc[0].y * lms.y) / tritanopia_abc[0].z;
-			}else{
-				lms.z = -(tritanopia_abc[1].x * lms.x + tritanopia_abc[1].y * lms.y) / tritanopia_abc[1].z;
-			}
-			vector3_multiply_matrix3x3(&lms, &matrix2, &vo1);
-			load_vector(&linear_input, &vo2);
-			interpolation_factor = strength;
+			abc = tritanopia_abc;
+			numerator = 1;
+			denominator = 0;
 			break;
 		default:
-			color_copy(input, output);
+			matrix3x3_identity(&matrix[0]);
+			matrix3x3_identity(&matrix[1]);
 			return;
 	}
+	if (anomaly){
+		int index = floor(strength * 10);
+		int index_secondary = std::min(index + 1, 10);
+		float interpolation_factor = 1 - ((strength * 10) - index);
+		// Interpolating results of two matrices is the same as transforming by interpolated matrix
+		matrix3x3 matrix1, matrix2;
+		load_matrix(anomaly[index], &matrix1);
+		load_matrix(anomaly[index_secondary], &matrix2);
+		for (int i = 0; i < 3; i++){
+			for (int j = 0; j < 3; j++){
+				matrix[0].m[i][j] = matrix1.m[i][j] * interpolation_factor + matrix2.m[i][j] * (1 - interpolation_factor);
+			}
+		}
+		matrix[1] = matrix[0];
+		return;
+	}
+	matrix3x3 to_lms, to_rgb, projection, dichromacy;
+	load_matrix(rgb_to_lms, &to_lms);
+	load_matrix(lms_to_rgb, &to_rgb);
+	for (int i = 0; i < 2; i++){
+		load_projection(type, abc[i], &projection);
+		// matrix3x3_multiply(a, b, result) applies a first and then b
+		matrix3x3_multiply(&to_lms, &projection, &dichromacy);
+		matrix3x3_multiply(&dichromacy, &to_rgb, &dichromacy);
+		mix_with_identity(dichromacy, strength, &matrix[i]);
+	}
+	// lms[numerator] / lms[denominator] < rgb_anchor[numerator] / rgb_anchor[denominator], with LMS components written as dot products of linear RGB
+	plane_selector.x = rgb_anchor[denominator] * to_lms.m[numerator][0] - rgb_anchor[numerator] * to_lms.m[denominator][0];
+	plane_selector.y = rgb_anchor[denominator] * to_lms.m[numerator][1] - rgb_anchor[numerator] * to_lms.m[denominator][1];
+	plane_selector.z = rgb_anchor[denominator] * to_lms.m[numerator][2] - rgb_anchor[numerator] * to_lms.m[denominator][2];
+}
 
-	linear_output.rgb.red = vo1.x * interpolation_factor + vo2.x * (1 - interpolation_factor);
-	linear_output.rgb.green = vo1.y * interpolation_factor + vo2.y * (1 - interpolation_factor);
-	linear_output.rgb.blue = vo1.z * interpolation_factor + vo2.z * (1 - interpolation_factor);
+void ColorVisionDeficiency::apply(Color *input, Color *output)
+{
+	Color linear_input, linear_output;
+	color_rgb_get_linear(input, &linear_input);
+	vector3 vi, vo;
+	load_vector(&linear_input, &vi);
+	const matrix3x3 &selected = vector3_dot(&vi, &plane_selector) < 0 ? matrix[0] : matrix[1];
+	vector3_multiply_matrix3x3(&vi, &selected, &vo);
+	linear_output.rgb.red = vo.x;
+	linear_output.rgb.green = vo.y;
+	linear_output.rgb.blue = vo.z;
 	color_linear_get_rgb(&linear_output, output);
 	color_rgb_normalize(output);
 }
 
+void ColorVisionDeficiency::apply(const Color *input, Color *output, size_t count)
+{
+	if (type != PROTANOPIA && type != DEUTERANOPIA && type != TRITANOPIA){
+		color_batch_rgb_linear_transform(input, output, count, &matrix[0]);
+		return;
+	}
+	color_batch_rgb_get_linear(input, output, count);
+	for (size_t i = 0; i < count; i++){
+		vector3 vi;
+		load_vector(&output[i], &vi);
+		const matrix3x3 &selected = vector3_dot(&vi, &plane_selector) < 0 ? matrix[0] : matrix[1];
+		output[i].rgb.red = vi.x * selected.m[0][0] + vi.y * selected.m[0][1] + vi.z * selected.m[0][2];
+		output[i].rgb.green = vi.x * selected.m[1][0] + vi.y * selected.m[1][1] + vi.z * selected.m[1][2];
+		output[i].rgb.blue = vi.x * selected.m[2][0] + vi.y * selected.m[2][1] + vi.z * selected.m[2][2];
+	}
+	color_batch_linear_get_rgb(output, output, count);
+	for (size_t i = 0; i < count; i++){
+		for (int j = 0; j < 3; j++)
+			output[i].ma[j] = clamp_float(output[i].ma[j], 0, 1);
+	}
+}
+
 ColorVisionDeficiency::ColorVisionDeficiency():Transformation(transformation_name, getReadableName())
 {
 	type = PROTANOMALY;
 	strength = 0.5;
+	updateMatrices();
 }
 
 ColorVisionDeficiency::ColorVisionDeficiency(DeficiencyType type_, float strength_):Transformation(transformation_name, getReadableName())
 {
 	type = type_;
 	strength = strength_;
+	updateMatrices();
 }
 
 ColorVisionDeficiency::~ColorVisionDeficiency()
@@ -307,6 +372,7 @@ void ColorVisionDeficiency::deserialize(struct dynvSystem *dynv)
 {
 	strength = dynv_get_float_wd(dynv, "strength", 0.5);
 	type = typeFromString(dynv_get_string_wd(dynv, "type", "protanomaly"));
+	updateMatrices();
 }
 
 
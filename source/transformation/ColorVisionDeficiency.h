@@ -20,6 +20,7 @@
 #define TRANSFORMATION_COLOR_VISION_DEFICIENCY_H_
 
 #include "Transformation.h"
+#include "../MathUtil.h"
 
 namespace transformation {
 
@@ -61,7 +62,11 @@ class ColorVisionDeficiency: public Transformation{
 	protected:
 		float strength;
 		DeficiencyType type;
+		matrix3x3 matrix[2]; /**< Linear RGB transformation for each side of selector plane. Both matrices are the same for anomalous trichromacy. */
+		vector3 plane_selector; /**< Linear RGB colors with negative dot product with this vector are transformed by the first matrix */
+		void updateMatrices();
 		virtual void apply(Color *input, Color *output);
+		virtual void apply(const Color *input, Color *output, size_t count);
 
 	public:
 		ColorVisionDeficiency();
@@ -18,6 +18,7 @@
 
 #include "GammaModification.h"
 #include "../MathUtil.h"
+#include "../ColorBatch.h"
 #include "../uiUtilities.h"
 #include "../Internationalisation.h"
 #include <gtk/gtk.h>
@@ -49,6 +50,11 @@ void GammaModification::apply(Color *input, Color *output)
 	color_rgb_normalize(output);
 }
 
+void GammaModification::apply(const Color *input, Color *output, size_t count)
+{
+	color_batch_rgb_gamma(input, output, count, value);
+}
+
 GammaModification::GammaModification():Transformation(transformation_name, getReadableName())
 {
 	value = 1;
@@ -44,6 +44,7 @@ class GammaModification: public Transformation{
 	protected:
 		float value;
 		virtual void apply(Color *input, Color *output);
+		virtual void apply(const Color *input, Color *output, size_t count);
 	public:
 		GammaModification();
 		GammaModification(float value);
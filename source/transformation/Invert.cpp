@@ -27,6 +27,17 @@ void Invert::apply(Color *input, Color *output)
 	output->rgb.blue = 1 - input->rgb.blue;
 }
 
+void Invert::apply(const Color *input, Color *output, size_t count)
+{
+	// Simple loop over consecutive colors, which compiler vectorizes
+	for (size_t i = 0; i < count; i++){
+		output[i].rgb.red = 1 - input[i].rgb.red;
+		output[i].rgb.green = 1 - input[i].rgb.green;
+		output[i].rgb.blue = 1 - input[i].rgb.blue;
+		output[i].ma[3] = input[i].ma[3];
+	}
+}
+
 Invert::Invert():Transformation("invert", "Invert")
 {
 
@@ -26,6 +26,7 @@ namespace transformation {
 class Invert : public Transformation{
 	protected:
 		virtual void apply(Color *input, Color *output);
+		virtual void apply(const Color *input, Color *output, size_t count);
 	public:
 		Invert();
 		virtual ~Invert();
@@ -55,6 +55,17 @@ void Quantization::apply(Color *input, Color *output)
 	}
 }
 
+void Quantization::apply(const Color *input, Color *output, size_t count)
+{
+	float scale = clip_top ? value : value - 1;
+	float max_intensity = clip_top ? (value - 1) / value : 1e30f;
+	for (size_t i = 0; i < count; i++){
+		for (int j = 0; j < 3; j++)
+			output[i].ma[j] = MIN(max_intensity, boost::math::round(input[i].ma[j] * scale) / scale);
+		output[i].ma[3] = input[i].ma[3];
+	}
+}
+
 Quantization::Quantization():Transformation(transformation_name, getReadableName())
 {
 	value = 16;
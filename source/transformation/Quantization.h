@@ -46,6 +46,7 @@ class Quantization: public Transformation{
 		float value;
 		bool clip_top;
 		virtual void apply(Color *input, Color *output);
+		virtual void apply(const Color *input, Color *output, size_t count);
 	public:
 		Quantization();
 		Quantization(float value);
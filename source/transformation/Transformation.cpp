@@ -36,6 +36,15 @@ void Transformation::apply(Color *input, Color *output)
 	color_copy(input, output);
 }
 
+void Transformation::apply(const Color *input, Color *output, size_t count)
+{
+	for (size_t i = 0; i < count; i++){
+		Color color = input[i];
+		apply(&color, &output[i]);
+		output[i].ma[3] = color.ma[3];
+	}
+}
+
 std::string Transformation::getName() const
 {
 	return name;
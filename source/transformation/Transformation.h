@@ -45,6 +45,15 @@ class Transformation{
 		 * @param[out] output Destination color in RGB color space.
 		 */
 		virtual void apply(Color *input, Color *output);
+
+		/**
+		 * Apply transformation to an array of colors. Default implementation applies per-color transformation to each color.
+		 * Fourth color component is copied from source to destination unchanged.
+		 * @param[in] input Source colors in RGB color space.
+		 * @param[out] output Destination colors in RGB color space. Can be the same array as input.
+		 * @param[in] count Number of colors.
+		 */
+		virtual void apply(const Color *input, Color *output, size_t count);
 	public:
 		/**
 		 * Transformation object constructor.
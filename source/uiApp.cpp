@@ -47,7 +47,12 @@
 #include "tools/PaletteFromImage.h"
 #include "tools/PaletteFromCssFile.h"
 #include "tools/ColorSpaceSampler.h"
+#include "tools/TransformationPreview.h"
 #include "dbus/Control.h"
+#include "PickStream.h"
+#include "ScreenReader.h"
+#include "Sampler.h"
+#include "StartupTrace.h"
 #include "DynvHelpers.h"
 #include "FileFormat.h"
 #include "MathUtil.h"
@@ -94,6 +99,7 @@ typedef struct AppArgs{
 	gint width, height;
 	bool initialization;
 	dbus::Control dbus_control;
+	ScreenReader *pick_stream_screen_reader;
 }AppArgs;
 
 static void app_release(AppArgs *args);
@@ -299,21 +305,34 @@ int app_load_file(AppArgs *args, const char *filename, bool autoload)
 {
 	bool imported = false;
 	bool return_value = false;
-	ImportExport import_export(args->gs->getColorList(), filename, args->gs);
-	switch (ImportExport::getFileType(filename)){
-		case FileType::gpl:
-			return_value = import_export.importGPL();
-			imported = true;
-			break;
-		case FileType::ase:
-			return_value = import_export.importASE();
-			imported = true;
-			break;
-		case FileType::gpa:
-			return_value = import_export.importGPA();
-			break;
-		default:
-			return_value = import_export.importGPA();
+	FileType type = ImportExport::getFileType(filename);
+	if (type == FileType::gpl || type == FileType::ase)
+		imported = true;
+	ColorList *color_list;
+	if (args->gs->takePreloadedPalette(filename, color_list)){
+		if (color_list){
+			for (auto color_object: color_list->colors){
+				// Palette files keep positions of colors which were in the palette, imported files add all colors to the palette
+				color_list_add_color_object(args->gs->getColorList(), color_object, imported || color_object->isPositionSet());
+			}
+			color_list_destroy(color_list);
+			return_value = true;
+		}
+	}else{
+		ImportExport import_export(args->gs->getColorList(), filename, args->gs);
+		switch (type){
+			case FileType::gpl:
+				return_value = import_export.importGPL();
+				break;
+			case FileType::ase:
+				return_value = import_export.importASE();
+				break;
+			case FileType::gpa:
+				return_value = import_export.importGPA();
+				break;
+			default:
+				return_value = import_export.importGPA();
+		}
 	}
 	if (args->current_filename) g_free(args->current_filename);
 	args->current_filename = nullptr;
@@ -631,6 +650,10 @@ static void color_space_sampler_cb(GtkWidget *widget, AppArgs* args)
 {
 	tools_color_space_sampler_show(GTK_WINDOW(args->window), args->gs);
 }
+static void transformation_preview_cb(GtkWidget *widget, AppArgs* args)
+{
+	tools_transformation_preview_show(GTK_WINDOW(args->window), args->gs);
+}
 static void destroy_file_menu_items(FileMenuItems *items)
 {
 	delete items;
@@ -820,6 +843,9 @@ static void create_menu(GtkMenuBar *menu_bar, AppArgs *args, GtkAccelGroup *acce
 	item = gtk_menu_item_new_with_mnemonic(_("Color Space _Sampler..."));
 	gtk_menu_shell_append(GTK_MENU_SHELL(menu), item);
 	g_signal_connect(G_OBJECT(item), "activate", G_CALLBACK(color_space_sampler_cb), args);
+	item = gtk_menu_item_new_with_mnemonic(_("_Transformation Preview..."));
+	gtk_menu_shell_append(GTK_MENU_SHELL(menu), item);
+	g_signal_connect(G_OBJECT(item), "activate", G_CALLBACK(transformation_preview_cb), args);
 	file_item = gtk_menu_item_new_with_mnemonic(_("_Tools"));
 	gtk_menu_item_set_submenu(GTK_MENU_ITEM(file_item), GTK_WIDGET(menu));
 	gtk_menu_shell_append(GTK_MENU_SHELL(menu_bar), file_item);
@@ -1368,6 +1394,30 @@ bool app_is_autoload_enabled(AppArgs *args)
 	return dynv_get_bool_wd(args->params, "main.save_restore_palette", true);
 }
 
+static bool app_get_startup_file(AppArgs *args, string &filename, bool &autoload)
+{
+	if (args->options.single_color_pick_mode) return false;
+	if (!args->options.filename.empty()){
+		filename = args->options.filename;
+		autoload = false;
+		return true;
+	}
+	if (!app_is_autoload_enabled(args)) return false;
+	gchar* autosave_file = build_config_path("autosave.gpa");
+	filename = autosave_file;
+	g_free(autosave_file);
+	autoload = true;
+	return true;
+}
+
+int app_load_startup_file(AppArgs *args)
+{
+	string filename;
+	bool autoload;
+	if (!app_get_startup_file(args, filename, autoload)) return 0;
+	return app_load_file(args, filename.c_str(), autoload);
+}
+
 static void app_initialize_variables(AppArgs *args)
 {
 	args->current_filename = 0;
@@ -1378,7 +1428,6 @@ static void app_initialize_variables(AppArgs *args)
 	args->secondary_source_widget = 0;
 	args->secondary_source_scrolled_viewpoint = 0;
 	args->gs->loadAll();
-	dialog_options_update(args->gs->getLua(), args->gs->getSettings());
 	args->params = dynv_get_dynv(args->gs->getSettings(), "gpick.main");
 	args->csm = color_source_manager_create();
 	register_sources(args->csm);
@@ -1399,6 +1448,44 @@ static void app_initialize_floating_picker(AppArgs *args)
 	args->floating_picker = floating_picker_new(args->gs);
 }
 
+/**
+ * Find converter for D-Bus clients.
+ * @param[in] args Application.
+ * @param[in] converter_name Converter name. Empty name selects display converter.
+ * @return Converter, or null if converter does not exist or can not serialize colors.
+ */
+static Converter *app_get_converter(AppArgs *args, const string &converter_name)
+{
+	Converters *converters = args->gs->getConverters();
+	Converter *converter = converter_name.empty() ? converters_get_first(converters, ConverterArrayType::display) : converters_get(converters, converter_name.c_str());
+	if (converter == nullptr || !converter->serialize_available) return nullptr;
+	return converter;
+}
+
+static bool app_pick_sample(AppArgs *args, const string &converter_name, PickSample &sample)
+{
+	// Pick streams use their own screen reader, so that read area and surface of the floating picker are not disturbed
+	if (!args->pick_stream_screen_reader){
+		args->pick_stream_screen_reader = screen_reader_new();
+		screen_reader_set_max_age(args->pick_stream_screen_reader, 0);
+	}
+	ScreenReader *screen_reader = args->pick_stream_screen_reader;
+	math::Rect2<int> screen_rect, sampler_rect, final_rect;
+	if (!screen_reader_get_pointer(screen_reader, sample.position, screen_rect)) return false;
+	screen_reader_reset_rect(screen_reader);
+	sampler_get_screen_rect(args->gs->getSampler(), sample.position, screen_rect, &sampler_rect);
+	screen_reader_add_rect(screen_reader, sampler_rect);
+	screen_reader_update_surface(screen_reader, &final_rect);
+	math::Vec2<int> offset(sampler_rect.getX() - final_rect.getX(), sampler_rect.getY() - final_rect.getY());
+	sampler_get_color_sample(args->gs->getSampler(), sample.position, screen_rect, offset, &sample.color);
+	Converter *converter = app_get_converter(args, converter_name);
+	if (!converter) return false;
+	ColorObject *color_object = color_list_new_color_object(args->gs->getColorList(), &sample.color);
+	bool result = converter_get_text(color_object, converter, args->gs, sample.text);
+	color_object->release();
+	return result;
+}
+
 static void app_initialize_picker(AppArgs *args, GtkWidget *notebook)
 {
 	ColorSource *source;
@@ -1415,13 +1502,14 @@ static void app_initialize_picker(AppArgs *args, GtkWidget *notebook)
 	gtk_widget_show(widget);
 }
 
-AppArgs* app_create_main(const AppOptions &options, int &return_value)
+AppArgs* app_create_main(GlobalState *gs, const AppOptions &options, int &return_value)
 {
 	AppArgs* args = new AppArgs;
 	args->initialization = true;
+	args->pick_stream_screen_reader = nullptr;
 	args->options = options;
 	color_init();
-	args->gs = new GlobalState();
+	args->gs = gs;
 	args->gs->loadSettings();
 	if (args->options.single_color_pick_mode){
 		app_initialize_variables(args);
@@ -1442,6 +1530,23 @@ AppArgs* app_create_main(const AppOptions &options, int &return_value)
 			main_show_window(args->window, args->params);
 			return true;
 		};
+		args->dbus_control.onCheckConverter = [args](const string &converter_name){
+			return app_get_converter(args, converter_name) != nullptr;
+		};
+		args->dbus_control.onPickSample = [args](const string &converter_name, PickSample &sample){
+			return app_pick_sample(args, converter_name, sample);
+		};
+		args->dbus_control.onConvertColors = [args](const string &converter_name, const vector<Color> &colors, vector<string> &texts){
+			return converter_get_texts(colors, app_get_converter(args, converter_name), texts);
+		};
+		args->dbus_control.onParseColors = [args](const vector<string> &texts, vector<Color> &colors, vector<bool> &valid){
+			converter_get_colors(texts, args->gs, colors, valid);
+		};
+		args->dbus_control.onGetColorNames = [args](const vector<Color> &colors, vector<string> &names){
+			names.resize(colors.size());
+			bool imprecision_postfix = dynv_get_bool_wd(args->gs->getSettings(), "gpick.color_names.imprecision_postfix", true);
+			color_names_get_multiple(args->gs->getColorNames(), colors.data(), colors.size(), imprecision_postfix, names.data());
+		};
 		args->dbus_control.ownName();
 		bool cancel_startup = false;
 		if (!cancel_startup && args->options.floating_picker_mode){
@@ -1464,11 +1569,18 @@ AppArgs* app_create_main(const AppOptions &options, int &return_value)
 			}
 		}
 		if (cancel_startup){
+			delete args->gs;
 			delete args;
 			return 0;
 		}
 		app_initialize_variables(args);
 		app_initialize_color_list(args);
+		string startup_filename;
+		bool autoload;
+		if (app_get_startup_file(args, startup_filename, autoload)){
+			// Palette is parsed while main window is being created and added to the color list by app_load_startup_file
+			args->gs->preloadPalette(startup_filename.c_str());
+		}
 	}
 	args->window = gtk_window_new(GTK_WINDOW_TOPLEVEL);
 	set_main_window_icon();
@@ -1706,6 +1818,7 @@ int app_run(AppArgs *args)
 		});
 		floating_picker_enable_custom_pick_action(args->floating_picker);
 		floating_picker_activate(args->floating_picker, false, true, args->options.converter_name.c_str());
+		startup_trace_mark("floating picker active");
 		gtk_main();
 		app_release(args);
 	}else{
@@ -1719,9 +1832,12 @@ int app_run(AppArgs *args)
 		gtk_paned_set_position(GTK_PANED(args->vpaned), dynv_get_int32_wd(args->params, "vertical_paned_position", -1));
 		if (args->options.floating_picker_mode)
 			floating_picker_activate(args->floating_picker, false, false, args->options.converter_name.c_str());
+		startup_trace_mark("main window ready");
 		gtk_main();
 		app_save_recent_file_list(args);
 		args->dbus_control.unownName();
+		if (args->pick_stream_screen_reader)
+			screen_reader_destroy(args->pick_stream_screen_reader);
 		status_icon_destroy(args->status_icon);
 	}
 	args->gs->writeSettings();
@@ -38,10 +38,20 @@ struct AppOptions
 	bool output_without_newline;
 	bool single_color_pick_mode;
 	bool do_not_start;
+	std::string filename;
 };
 
-AppArgs* app_create_main(const AppOptions &options, int &return_value);
+/**
+ * Create main application window.
+ * @param[in] gs Global state. Ownership is transferred to the application.
+ * @param[in] options Application options.
+ * @param[out] return_value Process return value when application is not created.
+ * @return Application or null if startup was cancelled.
+ */
+AppArgs* app_create_main(GlobalState *gs, const AppOptions &options, int &return_value);
 int app_load_file(AppArgs *args, const char *filename, bool autoload = false);
+/** Load palette file given in options, or automatically saved palette if palette restoring is enabled. */
+int app_load_startup_file(AppArgs *args);
 int app_run(AppArgs *args);
 int app_parse_geometry(AppArgs *args, const char *geometry);
 
@@ -71,31 +71,7 @@ typedef struct DialogOptionsArgs{
 
 int dialog_options_update(lua_State *lua, dynvSystem *settings)
 {
-	if (lua == nullptr || settings == nullptr) return -1;
-	lua_State* L = lua;
-	int status;
-	int stack_top = lua_gettop(L);
-	lua_getglobal(L, "gpick");
-	int gpick_namespace = lua_gettop(L);
-	if (lua_type(L, -1) != LUA_TNIL){
-		lua_pushstring(L, "options_update");
-		lua_gettable(L, gpick_namespace);
-		if (lua_type(L, -1) != LUA_TNIL){
-			lua_pushdynvsystem(L, settings);
-			status = lua_pcall(L, 1, 0, 0);
-			dynv_system_release(settings);
-			if (status == 0){
-				lua_settop(L, stack_top);
-				return 0;
-			}else{
-				cerr << "gpick.options_update: " << lua_tostring(L, -1) << endl;
-			}
-		}else{
-			cerr << "gpick.options_update: no such function \"options_update\"" << endl;
-		}
-	}
-	lua_settop(L, stack_top);
-	return -1;
+	return lua_ext_options_update(lua, settings);
 }
 
 static void calc( DialogOptionsArgs *args, bool preview, int limit)
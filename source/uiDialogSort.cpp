@@ -25,6 +25,7 @@
 #include "DynvHelpers.h"
 #include "GlobalState.h"
 #include "ColorRYB.h"
+#include "ColorSort.h"
 #include "Noise.h"
 #include "GenerateScheme.h"
 #include "Internationalisation.h"
@@ -51,103 +52,11 @@ typedef struct DialogSortArgs{
 	GlobalState* gs;
 }DialogSortArgs;
 
-typedef struct SortType{
-	const char *name;
-	double (*get_value)(Color *color);
-}SortType;
-
 typedef struct GroupType{
 	const char *name;
 	double (*get_group)(Color *color);
 }GroupType;
 
-static double sort_rgb_red(Color *color)
-{
-	return color->rgb.red;
-}
-static double sort_rgb_green(Color *color)
-{
-	return color->rgb.green;
-}
-static double sort_rgb_blue(Color *color)
-{
-	return color->rgb.blue;
-}
-static double sort_rgb_grayscale(Color *color)
-{
-	return (color->rgb.red + color->rgb.green + color->rgb.blue) / 3.0;
-}
-static double sort_hsl_hue(Color *color)
-{
-	Color hsl;
-	color_rgb_to_hsl(color, &hsl);
-	return hsl.hsl.hue;
-}
-static double sort_hsl_saturation(Color *color)
-{
-	Color hsl;
-	color_rgb_to_hsl(color, &hsl);
-	return hsl.hsl.saturation;
-}
-static double sort_hsl_lightness(Color *color)
-{
-	Color hsl;
-	color_rgb_to_hsl(color, &hsl);
-	return hsl.hsl.lightness;
-}
-static double sort_lab_lightness(Color *color)
-{
-	Color lab;
-	color_rgb_to_lab_d50(color, &lab);
-	return lab.lab.L;
-}
-static double sort_lab_a(Color *color)
-{
-	Color lab;
-	color_rgb_to_lab_d50(color, &lab);
-	return lab.lab.a;
-}
-static double sort_lab_b(Color *color)
-{
-	Color lab;
-	color_rgb_to_lab_d50(color, &lab);
-	return lab.lab.b;
-}
-static double sort_lch_lightness(Color *color)
-{
-	Color lch;
-	color_rgb_to_lch_d50(color, &lch);
-	return lch.lch.L;
-}
-static double sort_lch_chroma(Color *color)
-{
-	Color lch;
-	color_rgb_to_lch_d50(color, &lch);
-	return lch.lch.C;
-}
-static double sort_lch_hue(Color *color)
-{
-	Color lch;
-	color_rgb_to_lch_d50(color, &lch);
-	return lch.lch.h;
-}
-
-const SortType sort_types[] = {
-	{N_("RGB Red"), sort_rgb_red},
-	{N_("RGB Green"), sort_rgb_green},
-	{N_("RGB Blue"), sort_rgb_blue},
-	{N_("RGB Grayscale"), sort_rgb_grayscale},
-	{N_("HSL Hue"), sort_hsl_hue},
-	{N_("HSL Saturation"), sort_hsl_saturation},
-	{N_("HSL Lightness"), sort_hsl_lightness},
-	{N_("Lab Lightness"), sort_lab_lightness},
-	{N_("Lab A"), sort_lab_a},
-	{N_("Lab B"), sort_lab_b},
-	{N_("LCh Lightness"), sort_lch_lightness},
-	{N_("LCh Chroma"), sort_lch_chroma},
-	{N_("LCh Hue"), sort_lch_hue},
-};
-
 static double group_rgb_red(Color *color)
 {
 	return color->rgb.red;
@@ -456,7 +365,8 @@ static void calc(DialogSortArgs *args, bool preview, int limit){
 	SortedGroups sorted_groups;
 
 	const GroupType *group = &group_types[group_type];
-	const SortType *sort = &sort_types[sort_type];
+	size_t sort_type_count;
+	const ColorSortType *sort = &color_sort_get_types(sort_type_count)[sort_type];
 
 	Color in;
 	Node *group_nodes = node_new(0);
@@ -587,8 +497,10 @@ bool dialog_sort_show(GtkWindow* parent, ColorList *selected_color_list, ColorLi
 
 	gtk_table_attach(GTK_TABLE(table), gtk_label_aligned_new(_("Sort type:"),0,0.5,0,0),2,3,table_y,table_y+1,GtkAttachOptions(GTK_FILL),GTK_FILL,5,5);
 	args->sort_type = gtk_combo_box_text_new();
-	for (uint32_t i = 0; i < sizeof(sort_types) / sizeof(SortType); i++){
-		gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(args->sort_type), _(sort_types[i].name));
+	size_t sort_type_count;
+	const ColorSortType *sort_types = color_sort_get_types(sort_type_count);
+	for (size_t i = 0; i < sort_type_count; i++){
+		gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(args->sort_type), _(sort_types[i].human_name));
 	}
 	gtk_combo_box_set_active(GTK_COMBO_BOX(args->sort_type), dynv_get_int32_wd(args->params, "sort_type", 0));
 	g_signal_connect (G_OBJECT (args->sort_type), "changed", G_CALLBACK(update), args);
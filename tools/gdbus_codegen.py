@@ -0,0 +1,22 @@
+#!/usr/bin/env python
+from SCons.Script import *
+from SCons.Script.SConscript import SConsEnvironment
+import SCons.Script.SConscript
+
+def addGDBusCodegenBuilder(env):
+	GDBusCodegenAction = SCons.Action.Action("$GDBUS_CODEGENCOM", "$GDBUS_CODEGENCOMSTR")
+	env["GDBUS_CODEGEN"] = env.Detect("gdbus-codegen")
+	env["GDBUS_CODEGENCOM"] = "$GDBUS_CODEGEN $GDBUS_CODEGENFLAGS --output-directory ${TARGET.dir} --generate-c-code ${TARGET.filebase} $SOURCE"
+	env["GDBUS_CODEGENFLAGS"] = SCons.Util.CLVar("")
+
+	def headerEmitter(target, source, env):
+		target.append(SCons.Util.splitext(str(target[0]))[0] + '.h')
+		return (target, source)
+
+	builder = Builder(
+		action = GDBusCodegenAction,
+		suffix = '.c',
+		src_suffix = '.xml',
+		emitter = headerEmitter,
+		single_source = True)
+	env.Append(BUILDERS = {'GDBusCodegen': builder})
@@ -11,6 +11,7 @@ from flex import *
 from gettext import *
 from resource_template import *
 from ragel import *
+from gdbus_codegen import *
 from template import *
 from SCons.Script import *
 from SCons.Util import *
@@ -82,6 +83,7 @@ class GpickEnvironment(SConsEnvironment):
 		addResourceTemplateBuilder(self)
 		addTemplateBuilder(self)
 		addRagelBuilder(self)
+		addGDBusCodegenBuilder(self)
 		
 	def DefineLibrary(self, library_name, library):
 		self.extern_libs[library_name] = library